@@ -30,10 +30,18 @@ constexpr uint16_t DISPLAY_STACK_SIZE = 4096;
 constexpr UBaseType_t DISPLAY_PRIORITY = 3; //!< Highest - UI must stay responsive
 constexpr BaseType_t DISPLAY_CORE = 0;
 
+constexpr uint16_t DISPLAY_FLUSH_STACK_SIZE = 2048;
+constexpr UBaseType_t DISPLAY_FLUSH_PRIORITY = 2; //!< Below the UI: input handling preempts a flush
+constexpr BaseType_t DISPLAY_FLUSH_CORE = 0;
+
 constexpr uint16_t SENSOR_STACK_SIZE = 4096;
 constexpr UBaseType_t SENSOR_PRIORITY = 2;
 constexpr BaseType_t SENSOR_CORE = 1;
 
+constexpr uint16_t PLANT_STACK_SIZE = 4096;
+constexpr UBaseType_t PLANT_PRIORITY = 2;
+constexpr BaseType_t PLANT_CORE = 1; //!< Health evaluation stays off the display core
+
 constexpr uint16_t IOT_STACK_SIZE = 8192; //!< Larger stack for TLS + JSON
 constexpr UBaseType_t IOT_PRIORITY = 1;   //!< Lowest - networking is best-effort
 constexpr BaseType_t IOT_CORE = 1;        //!< Separate from display core
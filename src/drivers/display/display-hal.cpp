@@ -1,6 +1,14 @@
 // display-hal.cpp
 #include "drivers/display/display-hal.h"
+#include <algorithm>
 #include <cstdarg>
+#include <cstring>
+
+#define SH1107_CONTROL_COMMAND 0x00 //!< Control byte: command stream follows
+#define SH1107_CONTROL_DATA 0x40    //!< Control byte: display RAM data follows
+#define SH1107_CMD_PAGE_ADDR 0xB0   //!< Set page address (+ page)
+#define SH1107_CMD_COLUMN_HIGH 0x10 //!< Set column address high nibble (+ nibble)
+#define SH1107_CMD_COLUMN_LOW 0x00  //!< Set column address low nibble (+ nibble)
 
 namespace PlantMonitor {
 namespace Drivers {
@@ -8,24 +16,61 @@ namespace Drivers {
 DisplayHAL::DisplayHAL()
     : m_display(Config::DISPLAY_WIDTH,
                 Config::DISPLAY_HEIGHT,
-                &Wire,
-                Config::DISPLAY_RESET_PIN),
-      m_initialized(false) {
+                &I2cBus::wire(),
+                Config::DISPLAY_RESET_PIN,
+                Config::I2C_FREQUENCY,
+                Config::I2C_FREQUENCY), // Keep the shared bus at full speed after Adafruit transfers
+      m_initialized(false),
+      m_stats(),
+      m_mailbox(),
+      m_front(nullptr),
+      m_panelBuffer(nullptr),
+      m_flusher(nullptr) {
+}
+
+DisplayHAL::~DisplayHAL() {
+    if (m_flusher != nullptr) {
+        vTaskDelete(m_flusher);
+    }
+    // Adafruit frees its buffer on destruction: give it back whichever slot it ended up in
+    if (m_panelBuffer != nullptr) {
+        m_display.swapBuffer(m_panelBuffer);
+    }
 }
 
-bool DisplayHAL::begin() {
-    Wire.begin();
-    Wire.setClock(Config::I2C_FREQUENCY);
+bool DisplayHAL::begin(uint32_t stackSize, UBaseType_t priority, BaseType_t core) {
+    {
+        // Wire itself is started by I2cBus::begin()
+        I2cLease lease(I2cClient::Display, I2cPriority::Normal);
+        if (!lease.held()) {
+            Serial.println("[DisplayHAL] ERROR: I2C bus unavailable!");
+            return false;
+        }
 
-    // IMPORTANT: pass true as second parameter for reset
-    if (!m_display.begin(Config::DISPLAY_I2C_ADDR, true)) {
-        Serial.println("[DisplayHAL] ERROR: SH1107 initialization failed!");
-        return false;
+        // IMPORTANT: pass true as second parameter for reset
+        if (!m_display.begin(Config::DISPLAY_I2C_ADDR, true)) {
+            Serial.println("[DisplayHAL] ERROR: SH1107 initialization failed!");
+            return false;
+        }
+
+        m_display.setRotation(0);
+        m_display.clearDisplay();
     }
+    m_shadow.invalidate(); // Panel RAM state unknown after reset
 
-    m_display.setRotation(0);
-    m_display.clearDisplay();
-    m_display.display();
+    if (m_panelBuffer == nullptr) {
+        // Three buffers circulate: drawn into, parked in the mailbox, being sent
+        m_panelBuffer = m_display.getBuffer();
+        std::memset(m_frames, 0, sizeof(m_frames));
+        m_mailbox.reset(m_frames[0]);
+        m_front = m_frames[1];
+
+        if (xTaskCreatePinnedToCore(flushThunk, "DisplayFlush", stackSize, this, priority, &m_flusher, core) != pdPASS) {
+            m_flusher = nullptr;
+            Serial.println("[DisplayHAL] WARNING: flusher task not started, flushing synchronously");
+        }
+    }
+    update();
 
     m_initialized = true;
     Serial.println("[DisplayHAL] SH1107 initialized successfully");
@@ -37,12 +82,137 @@ void DisplayHAL::clear() {
     m_display.clearDisplay();
 }
 
-void DisplayHAL::update() {
-    m_display.display();
+bool DisplayHAL::update() {
+    m_stats.presentedFrames.fetch_add(1, std::memory_order_relaxed);
+    if (m_flusher == nullptr) {
+        m_stats.frames.fetch_add(1, std::memory_order_relaxed);
+        return flush(m_display.getBuffer());
+    }
+
+    // O(1) hand-off: the finished frame goes to the mailbox, a free buffer comes back
+    bool superseded = false;
+    m_display.swapBuffer(m_mailbox.publish(m_display.getBuffer(), &superseded));
+    if (superseded) {
+        m_stats.supersededFrames.fetch_add(1, std::memory_order_relaxed);
+    }
+    xTaskNotifyGive(m_flusher);
+    return true;
+}
+
+DisplayFlushStats DisplayHAL::flushStats() const {
+    DisplayFlushStats out;
+    out.presentedFrames = m_stats.presentedFrames.load(std::memory_order_relaxed);
+    out.supersededFrames = m_stats.supersededFrames.load(std::memory_order_relaxed);
+    out.frames = m_stats.frames.load(std::memory_order_relaxed);
+    out.skippedFrames = m_stats.skippedFrames.load(std::memory_order_relaxed);
+    out.failedFrames = m_stats.failedFrames.load(std::memory_order_relaxed);
+    out.lastFrameBytes = m_stats.lastFrameBytes.load(std::memory_order_relaxed);
+    out.maxFrameBytes = m_stats.maxFrameBytes.load(std::memory_order_relaxed);
+    out.totalBytes = m_stats.totalBytes.load(std::memory_order_relaxed);
+    return out;
+}
+
+void DisplayHAL::flushThunk(void *arg) {
+    static_cast<DisplayHAL *>(arg)->flushLoop();
+}
+
+void DisplayHAL::flushLoop() {
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        // Drain: a frame published during the flush is picked up right after it
+        while (uint8_t *frame = m_mailbox.take(m_front)) {
+            m_front = frame;
+            m_stats.frames.fetch_add(1, std::memory_order_relaxed);
+            uint8_t attempt = 1;
+            while (!flush(m_front)) {
+                // Unsent blocks stay dirty in the shadow, so a newer frame resends them anyway
+                if (m_mailbox.pending()) {
+                    break;
+                }
+                if (attempt++ >= DISPLAY_FLUSH_RETRIES) {
+                    m_stats.failedFrames.fetch_add(1, std::memory_order_relaxed);
+                    break;
+                }
+                vTaskDelay(pdMS_TO_TICKS(DISPLAY_FLUSH_RETRY_MS));
+            }
+        }
+    }
+}
+
+bool DisplayHAL::flush(const uint8_t *frame) {
+    m_stats.lastFrameBytes.store(0, std::memory_order_relaxed);
+
+    // Redrawing the same content is the common case: leave the bus alone
+    if (!m_shadow.differs(frame)) {
+        m_stats.skippedFrames.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    I2cLease lease(I2cClient::Display, I2cPriority::Normal);
+    if (!lease.held()) {
+        return false;
+    }
+
+    uint32_t bytes = 0;
+    bool ok = true;
+    for (uint8_t page = 0; page < DISPLAY_PAGE_COUNT && ok; ++page) {
+        Utils::FrameSpan spans[Shadow::kMaxSpans];
+        size_t count = m_shadow.dirtySpans(frame, page, spans);
+        if (count == 0) {
+            continue;
+        }
+        for (size_t i = 0; i < count && ok; ++i) {
+            ok = writeSpan(frame, spans[i], bytes);
+            if (ok) {
+                m_shadow.commit(frame, spans[i]);
+            }
+        }
+        // Let a waiting sensor transaction run between pages
+        ok = ok && lease.yieldIfContended();
+    }
+
+    m_stats.lastFrameBytes.store(bytes, std::memory_order_relaxed);
+    m_stats.totalBytes.fetch_add(bytes, std::memory_order_relaxed);
+    if (bytes > m_stats.maxFrameBytes.load(std::memory_order_relaxed)) {
+        m_stats.maxFrameBytes.store(bytes, std::memory_order_relaxed); // Only the flushing task writes it
+    }
+    return ok;
+}
+
+bool DisplayHAL::writeSpan(const uint8_t *frame, const Utils::FrameSpan &span, uint32_t &bytes) {
+    TwoWire &wire = I2cBus::wire();
+    const uint8_t *data = frame + static_cast<size_t>(span.page) * Config::DISPLAY_WIDTH;
+    uint8_t column = DISPLAY_COLUMN_OFFSET + span.column;
+
+    wire.beginTransmission(Config::DISPLAY_I2C_ADDR);
+    wire.write(SH1107_CONTROL_COMMAND);
+    wire.write(SH1107_CMD_PAGE_ADDR + span.page);
+    wire.write(SH1107_CMD_COLUMN_HIGH + (column >> 4));
+    wire.write(SH1107_CMD_COLUMN_LOW + (column & 0x0F));
+    if (wire.endTransmission() != 0) {
+        return false;
+    }
+    bytes += 4;
+
+    // The column address auto-increments across the data writes
+    size_t end = static_cast<size_t>(span.column) + span.length;
+    for (size_t offset = span.column; offset < end; offset += DISPLAY_I2C_CHUNK) {
+        size_t length = std::min(static_cast<size_t>(DISPLAY_I2C_CHUNK), end - offset);
+        wire.beginTransmission(Config::DISPLAY_I2C_ADDR);
+        wire.write(SH1107_CONTROL_DATA);
+        wire.write(data + offset, length);
+        if (wire.endTransmission() != 0) {
+            return false;
+        }
+        bytes += 1 + length;
+    }
+    return true;
 }
 
 void DisplayHAL::setBrightness(uint8_t level) {
     // SH1107 supports contrast 0-255
+    I2cLease lease(I2cClient::Display, I2cPriority::Normal);
     m_display.setContrast(level);
     Serial.printf("[DisplayHAL] Contrast set to %d/255\n", level);
 }
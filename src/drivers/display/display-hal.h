@@ -4,7 +4,12 @@
 #include <Adafruit_GFX.h>
 #include <Adafruit_SH110X.h>
 #include <Wire.h>
+#include <atomic>
 #include "app-config.h"
+#include "drivers/i2c/i2c-bus.h"
+#include "utils/frame-mailbox/frame-mailbox.h"
+#include "utils/glyph-font/glyph-font.h"
+#include "utils/shadow-frame/shadow-frame.h"
 
 /*!
  * \file display-hal.h
@@ -14,8 +19,30 @@
  * High-level UI rendering is managed by ScreenManager.
  * 
  * \note Thread-safe when used with proper mutex in DisplayService
+ *
+ * The framebuffer is flushed page by page under an I2cBus lease; between pages
+ * the flush steps aside for a waiting sensor read, so a full-screen update
+ * never blocks the BME280 for more than one 128-byte page.
+ *
+ * A shadow of the frame last sent is kept: a flush only transmits the
+ * DISPLAY_DIFF_BLOCK-column blocks that changed, and does not take the bus
+ * at all when the frame is identical.
+ *
+ * Flushing runs in its own task ("DisplayFlush"). Drawing goes into a back
+ * buffer; update() hands it to the flusher through a FrameMailbox and returns
+ * at once with a free buffer to draw the next frame in, so the display task
+ * never waits for the I2C transfer. If frames come faster than the bus, only
+ * the newest one is sent.
  */
 
+#define DISPLAY_PAGE_COUNT (Config::DISPLAY_HEIGHT / 8) //!< 8-pixel-high pages in the framebuffer
+#define DISPLAY_I2C_CHUNK 64                            //!< Data bytes per I2C write (fits the Wire buffer)
+#define DISPLAY_COLUMN_OFFSET 0                         //!< First RAM column used by the 128-wide panel
+#define DISPLAY_DIFF_BLOCK 16                           //!< Columns compared (and resent) as one unit
+#define DISPLAY_FRAME_BYTES (Config::DISPLAY_WIDTH * DISPLAY_PAGE_COUNT) //!< Framebuffer size
+#define DISPLAY_FLUSH_RETRIES 3                         //!< Attempts per frame before waiting for the next one
+#define DISPLAY_FLUSH_RETRY_MS 20                       //!< Delay between attempts (bus busy or NACK)
+
 namespace PlantMonitor {
 namespace Drivers {
 
@@ -23,6 +50,41 @@ namespace Drivers {
 constexpr uint16_t COLOR_BLACK = SH110X_BLACK;
 constexpr uint16_t COLOR_WHITE = SH110X_WHITE;
 
+/*!
+ * \struct DisplayFlushStats
+ * \brief Frames handed to the flusher and their I2C traffic
+ */
+struct DisplayFlushStats {
+    uint32_t presentedFrames;  //!< update() calls
+    uint32_t supersededFrames; //!< Frames replaced by a newer one before being flushed
+    uint32_t frames;           //!< Frames flushed
+    uint32_t skippedFrames;    //!< Flushed frames identical to the panel content (bus not taken)
+    uint32_t failedFrames;     //!< Frames abandoned after DISPLAY_FLUSH_RETRIES attempts
+    uint32_t lastFrameBytes;   //!< Bytes written for the most recent frame (commands + data)
+    uint32_t maxFrameBytes;    //!< Largest frame so far
+    uint32_t totalBytes;       //!< Bytes written since begin()
+};
+
+/*!
+ * \class SH1107Panel
+ * \brief Adafruit_SH1107 whose drawing buffer can be exchanged
+ */
+class SH1107Panel : public Adafruit_SH1107 {
+  public:
+    using Adafruit_SH1107::Adafruit_SH1107;
+
+    /*!
+     * \brief Make GFX draw into another framebuffer
+     * \param next Buffer of DISPLAY_FRAME_BYTES bytes
+     * \return Buffer drawn into until now
+     */
+    uint8_t *swapBuffer(uint8_t *next) {
+        uint8_t *previous = buffer;
+        buffer = next;
+        return previous;
+    }
+};
+
 /*!
  * \class DisplayHAL
  * \brief Low-level driver for SH1107 128x128 monochrome OLED
@@ -35,15 +97,21 @@ class DisplayHAL {
     DisplayHAL();
 
     /*!
-     * \brief Destructor
+     * \brief Destructor (stops the flusher)
      */
-    ~DisplayHAL() = default;
+    ~DisplayHAL();
 
     /*!
-     * \brief Initialize display hardware
+     * \brief Initialize display hardware and start the flusher task
+     * \param stackSize Flusher stack size
+     * \param priority Flusher priority (below the display task)
+     * \param core Core the flusher runs on
      * \return true if successful, false otherwise
+     * \note If the flusher cannot be started, update() flushes synchronously.
      */
-    bool begin();
+    bool begin(uint32_t stackSize = Config::Tasks::DISPLAY_FLUSH_STACK_SIZE,
+               UBaseType_t priority = Config::Tasks::DISPLAY_FLUSH_PRIORITY,
+               BaseType_t core = Config::Tasks::DISPLAY_FLUSH_CORE);
 
     /*!
      * \brief Clear display buffer (does not update screen)
@@ -51,10 +119,29 @@ class DisplayHAL {
     void clear();
 
     /*!
-     * \brief Flush buffer to physical display
-     * \note Call this after drawing operations to make them visible
+     * \brief Queue the drawn frame for the panel
+     * \note Call this after drawing operations to make them visible. Returns
+     *       without waiting for the transfer; only the blocks that differ from
+     *       the panel content are sent.
+     * \warning Drawing continues in another buffer whose content is stale:
+     *          start every frame with clear().
+     * \return false if the frame was flushed synchronously and the bus could
+     *         not be acquired or a transfer failed
      */
-    void update();
+    bool update();
+
+    /*!
+     * \brief Check whether a queued frame is still waiting for the flusher
+     */
+    bool flushPending() const {
+        return m_mailbox.pending();
+    }
+
+    /*!
+     * \brief Copy the flush traffic counters (updated by the flusher task)
+     * \return Snapshot; each counter is read atomically, not the set as a whole
+     */
+    DisplayFlushStats flushStats() const;
 
     /*!
      * \brief Set display contrast/brightness
@@ -211,9 +298,70 @@ class DisplayHAL {
      */
     void getTextBounds(const char *text, int16_t x, int16_t y, int16_t *x1, int16_t *y1, uint16_t *w, uint16_t *h);
 
+    /*!
+     * \brief Draw digits / units with the pre-scaled glyphs (white, transparent)
+     * \tparam Scale Text size, as setTextSize()
+     * \param x Left edge
+     * \param page Top page (y / 8)
+     * \param text Characters supported by Utils::GlyphFont
+     * \note Same pixels as print() at (x, page * 8) and size Scale, without per-pixel plotting.
+     */
+    template <uint8_t Scale>
+    void drawGlyphText(int16_t x, uint8_t page, const char *text) {
+        Utils::GlyphFont<Scale>::draw(m_display.getBuffer(), Config::DISPLAY_WIDTH, DISPLAY_PAGE_COUNT, x, page, text);
+    }
+
   private:
-    Adafruit_SH1107 m_display; //!< Adafruit GFX driver instance
-    bool m_initialized;        //!< Initialization status flag
+    using Shadow = Utils::ShadowFrame<Config::DISPLAY_WIDTH, DISPLAY_PAGE_COUNT, DISPLAY_DIFF_BLOCK>;
+
+    /*!
+     * \struct FlushCounters
+     * \brief DisplayFlushStats as atomics: written by the drawing and flusher tasks, read by any task
+     */
+    struct FlushCounters {
+        std::atomic<uint32_t> presentedFrames{0};  //!< update() calls (drawing task)
+        std::atomic<uint32_t> supersededFrames{0}; //!< Frames replaced before being flushed (drawing task)
+        std::atomic<uint32_t> frames{0};           //!< Frames flushed
+        std::atomic<uint32_t> skippedFrames{0};    //!< Flushed frames identical to the panel content
+        std::atomic<uint32_t> failedFrames{0};     //!< Frames abandoned after DISPLAY_FLUSH_RETRIES attempts
+        std::atomic<uint32_t> lastFrameBytes{0};   //!< Bytes written for the most recent frame
+        std::atomic<uint32_t> maxFrameBytes{0};    //!< Largest frame so far
+        std::atomic<uint32_t> totalBytes{0};       //!< Bytes written since begin()
+    };
+
+    /// \brief Flusher task entry point.
+    static void flushThunk(void *arg);
+
+    /*!
+     * \brief Send every frame taken from the mailbox (flusher task, never returns)
+     */
+    void flushLoop();
+
+    /*!
+     * \brief Send the blocks of a frame that differ from the panel content
+     * \param frame Framebuffer to send
+     * \return false if the bus could not be acquired or a transfer failed
+     */
+    bool flush(const uint8_t *frame);
+
+    /*!
+     * \brief Send a run of columns of one page to the panel (caller holds the bus)
+     * \param frame Framebuffer the span is taken from
+     * \param span Page and columns to send
+     * \param[in,out] bytes Incremented by the bytes written
+     * \return true if every transfer was acknowledged
+     */
+    bool writeSpan(const uint8_t *frame, const Utils::FrameSpan &span, uint32_t &bytes);
+
+    SH1107Panel m_display;          //!< Adafruit GFX driver instance (draws into the back buffer)
+    bool m_initialized;             //!< Initialization status flag
+    Shadow m_shadow;                //!< Panel RAM content as last sent
+    FlushCounters m_stats;          //!< Flush traffic counters
+    Utils::FrameMailbox m_mailbox;  //!< Newest frame waiting for the flusher
+    uint8_t *m_front;               //!< Frame owned by the flusher
+    uint8_t *m_panelBuffer;         //!< Buffer allocated by Adafruit (handed back on destruction)
+    TaskHandle_t m_flusher;         //!< Flusher task (nullptr: update() flushes synchronously)
+    alignas(4) uint8_t m_frames[2][DISPLAY_FRAME_BYTES]; //!< Buffers added to Adafruit's own (FrameMailbox needs 2-byte alignment)
 
     // Prevent copying
     DisplayHAL(const DisplayHAL &) = delete;
@@ -0,0 +1,167 @@
+#include "i2c-bus.h"
+
+namespace PlantMonitor {
+namespace Drivers {
+
+SemaphoreHandle_t I2cBus::s_mutex = nullptr;
+SemaphoreHandle_t I2cBus::s_statsMutex = nullptr;
+std::atomic<uint32_t> I2cBus::s_highWaiters(0);
+uint32_t I2cBus::s_acquiredAt = 0;
+I2cClientStats I2cBus::s_stats[static_cast<size_t>(I2cClient::Count)] = {};
+
+/*!
+ * \brief Check that a client value indexes the statistics table
+ */
+static bool prv_valid_client(I2cClient client) {
+    return static_cast<size_t>(client) < static_cast<size_t>(I2cClient::Count);
+}
+
+bool I2cBus::begin(uint32_t frequency) {
+    if (!s_mutex) {
+        s_mutex = xSemaphoreCreateMutex();
+        if (!s_mutex) {
+            Serial.println("[I2C] ERROR: failed to create bus mutex");
+            return false;
+        }
+    }
+    if (!s_statsMutex) {
+        s_statsMutex = xSemaphoreCreateMutex();
+        if (!s_statsMutex) {
+            Serial.println("[I2C] ERROR: failed to create statistics mutex");
+            return false;
+        }
+    }
+
+    Wire.begin();
+    Wire.setClock(frequency);
+    return true;
+}
+
+TwoWire &I2cBus::wire() {
+    return Wire;
+}
+
+bool I2cBus::acquire(I2cClient client, I2cPriority priority, TickType_t timeout) {
+    if (!s_mutex || !prv_valid_client(client)) {
+        return false;
+    }
+
+    const uint32_t startUs = micros();
+    const TickType_t startTick = xTaskGetTickCount();
+    bool taken;
+
+    if (priority == I2cPriority::High) {
+        s_highWaiters.fetch_add(1, std::memory_order_acq_rel);
+        taken = xSemaphoreTake(s_mutex, timeout) == pdTRUE;
+        s_highWaiters.fetch_sub(1, std::memory_order_acq_rel);
+    } else {
+        // Let waiting high-priority clients go first
+        while (s_highWaiters.load(std::memory_order_acquire) > 0) {
+            if (timeout != portMAX_DELAY && xTaskGetTickCount() - startTick >= timeout) {
+                return false;
+            }
+            vTaskDelay(I2C_BUS_HIGH_WAIT_POLL_TICKS);
+        }
+
+        TickType_t remaining = timeout;
+        if (timeout != portMAX_DELAY) {
+            TickType_t elapsed = xTaskGetTickCount() - startTick;
+            remaining = (elapsed < timeout) ? timeout - elapsed : 0;
+        }
+        taken = xSemaphoreTake(s_mutex, remaining) == pdTRUE;
+    }
+
+    if (!taken) {
+        return false;
+    }
+
+    uint32_t now = micros();
+    uint32_t waited = now - startUs;
+    xSemaphoreTake(s_statsMutex, portMAX_DELAY);
+    I2cClientStats &stats = s_stats[static_cast<size_t>(client)];
+    stats.waitUs += waited;
+    if (waited > stats.maxWaitUs) {
+        stats.maxWaitUs = waited;
+    }
+    xSemaphoreGive(s_statsMutex);
+    s_acquiredAt = now;
+    return true;
+}
+
+void I2cBus::release(I2cClient client) {
+    if (!s_mutex) {
+        return;
+    }
+
+    if (prv_valid_client(client)) {
+        uint32_t busy = micros() - s_acquiredAt;
+        xSemaphoreTake(s_statsMutex, portMAX_DELAY);
+        I2cClientStats &stats = s_stats[static_cast<size_t>(client)];
+        stats.leases++;
+        stats.busyUs += busy;
+        if (busy > stats.maxBusyUs) {
+            stats.maxBusyUs = busy;
+        }
+        xSemaphoreGive(s_statsMutex);
+    }
+
+    xSemaphoreGive(s_mutex);
+}
+
+bool I2cBus::shouldYield() {
+    return s_highWaiters.load(std::memory_order_acquire) > 0;
+}
+
+bool I2cBus::getStats(I2cClient client, I2cClientStats &out) {
+    if (!s_statsMutex || !prv_valid_client(client)) {
+        return false;
+    }
+    xSemaphoreTake(s_statsMutex, portMAX_DELAY);
+    out = s_stats[static_cast<size_t>(client)];
+    xSemaphoreGive(s_statsMutex);
+    return true;
+}
+
+void I2cBus::resetStats() {
+    if (!s_statsMutex) {
+        return;
+    }
+    xSemaphoreTake(s_statsMutex, portMAX_DELAY);
+    for (I2cClientStats &stats : s_stats) {
+        stats = {};
+    }
+    xSemaphoreGive(s_statsMutex);
+}
+
+// ============================================================================
+// I2cLease
+// ============================================================================
+
+I2cLease::I2cLease(I2cClient client, I2cPriority priority, TickType_t timeout)
+    : m_client(client),
+      m_priority(priority),
+      m_timeout(timeout),
+      m_held(I2cBus::acquire(client, priority, timeout)) {
+}
+
+I2cLease::~I2cLease() {
+    if (m_held) {
+        I2cBus::release(m_client);
+    }
+}
+
+bool I2cLease::yieldIfContended() {
+    if (!m_held || !I2cBus::shouldYield()) {
+        return m_held;
+    }
+
+    xSemaphoreTake(I2cBus::s_statsMutex, portMAX_DELAY);
+    I2cBus::s_stats[static_cast<size_t>(m_client)].yields++;
+    xSemaphoreGive(I2cBus::s_statsMutex);
+    I2cBus::release(m_client);
+    m_held = I2cBus::acquire(m_client, m_priority, m_timeout);
+    return m_held;
+}
+
+} // namespace Drivers
+} // namespace PlantMonitor
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include "app-config.h"
+
+/*!
+ * \file i2c-bus.h
+ * \brief Shared I2C bus arbitration for the display and the BME280
+ *
+ * The SH1107 display (display task, core 0) and the BME280 (sensor task,
+ * core 1) share one Wire instance. I2cBus owns it: every transfer happens
+ * inside a lease, so transactions from both tasks are serialized.
+ *
+ * Waiting clients queue on a FreeRTOS mutex. High-priority clients (short
+ * sensor reads) are served before normal ones (display flushes): a normal
+ * client does not take the bus while a high-priority client is waiting, and
+ * a long transfer can call I2cLease::yieldIfContended() between chunks to
+ * let a waiting sensor read through.
+ *
+ * Bus time and wait time are accounted per client.
+ *
+ * Typical usage:
+ * \code
+ * I2cLease lease(I2cClient::Display, I2cPriority::Normal);
+ * for (uint8_t page = 0; page < 16; page++) {
+ *     writePage(page);
+ *     lease.yieldIfContended();
+ * }
+ * \endcode
+ */
+
+#define I2C_BUS_HIGH_WAIT_POLL_TICKS 1 //!< Back-off of normal clients while a high-priority client waits
+
+namespace PlantMonitor {
+namespace Drivers {
+
+/*!
+ * \enum I2cClient
+ * \brief Devices on the shared bus (index into the statistics table)
+ */
+enum class I2cClient : uint8_t {
+    Display = 0, //!< SH1107 OLED
+    Bme280,      //!< BME280 environmental sensor
+    Count        //!< Number of clients
+};
+
+/*!
+ * \enum I2cPriority
+ * \brief Arbitration priority of a lease
+ */
+enum class I2cPriority : uint8_t {
+    Normal = 0, //!< Bulk transfers that may be split (display)
+    High        //!< Short, latency-sensitive transfers (sensors)
+};
+
+/*!
+ * \struct I2cClientStats
+ * \brief Bus usage of one client
+ */
+struct I2cClientStats {
+    uint32_t leases;    //!< Completed leases
+    uint64_t busyUs;    //!< Total time holding the bus
+    uint32_t maxBusyUs; //!< Longest single lease
+    uint64_t waitUs;    //!< Total time spent waiting for the bus
+    uint32_t maxWaitUs; //!< Longest single wait
+    uint32_t yields;    //!< Leases given up early for a high-priority client
+};
+
+/*!
+ * \class I2cBus
+ * \brief Owner and arbiter of the shared Wire instance
+ * \note Not meant to be instantiated (all methods are static), like ConfigHandler.
+ */
+class I2cBus {
+  public:
+    /*!
+     * \brief Start Wire and create the arbitration and statistics mutexes (call once from setup())
+     * \param frequency Bus clock in Hz
+     * \return true on success
+     */
+    static bool begin(uint32_t frequency = Config::I2C_FREQUENCY);
+
+    /*!
+     * \brief Get the Wire instance (only use it while holding a lease)
+     */
+    static TwoWire &wire();
+
+    /*!
+     * \brief Take the bus
+     * \param client Requesting device
+     * \param priority Arbitration priority
+     * \param timeout Maximum ticks to wait
+     * \return true if the bus was acquired
+     */
+    static bool acquire(I2cClient client, I2cPriority priority, TickType_t timeout = portMAX_DELAY);
+
+    /*!
+     * \brief Give the bus back and account the time it was held
+     * \param client Device that acquired it
+     */
+    static void release(I2cClient client);
+
+    /*!
+     * \brief Check whether a high-priority client is waiting for the bus
+     */
+    static bool shouldYield();
+
+    /*!
+     * \brief Copy the statistics of a client
+     * \param client Device
+     * \param[out] out Statistics
+     * \return false for an invalid client
+     * \note Takes the statistics mutex only, so it may be called while holding a lease.
+     */
+    static bool getStats(I2cClient client, I2cClientStats &out);
+
+    /*!
+     * \brief Clear every client's statistics
+     */
+    static void resetStats();
+
+  private:
+    friend class I2cLease;
+
+    static SemaphoreHandle_t s_mutex;                                          //!< Bus ownership
+    static SemaphoreHandle_t s_statsMutex;                                     //!< Guards s_stats (short hold, independent of leases)
+    static std::atomic<uint32_t> s_highWaiters;                                //!< High-priority clients waiting
+    static uint32_t s_acquiredAt;                                              //!< micros() when the current lease started
+    static I2cClientStats s_stats[static_cast<size_t>(I2cClient::Count)];      //!< Per-client statistics (guarded by s_statsMutex)
+};
+
+/*!
+ * \class I2cLease
+ * \brief RAII bus lease
+ */
+class I2cLease {
+  public:
+    /*!
+     * \brief Acquire the bus
+     * \param client Requesting device
+     * \param priority Arbitration priority
+     * \param timeout Maximum ticks to wait
+     */
+    I2cLease(I2cClient client, I2cPriority priority, TickType_t timeout = portMAX_DELAY);
+
+    /*!
+     * \brief Release the bus if still held
+     */
+    ~I2cLease();
+
+    /*!
+     * \brief Check whether the bus is held
+     */
+    bool held() const {
+        return m_held;
+    }
+
+    /*!
+     * \brief Hand the bus to a waiting high-priority client, then take it back
+     * \return true if the lease is still held afterwards
+     */
+    bool yieldIfContended();
+
+  private:
+    I2cClient m_client;     //!< Device owning the lease
+    I2cPriority m_priority; //!< Priority used to re-acquire after a yield
+    TickType_t m_timeout;   //!< Timeout used to re-acquire after a yield
+    bool m_held;            //!< Bus currently held
+
+    // Prevent copying
+    I2cLease(const I2cLease &) = delete;
+    I2cLease &operator=(const I2cLease &) = delete;
+};
+
+} // namespace Drivers
+} // namespace PlantMonitor
@@ -0,0 +1,149 @@
+#include "adc-continuous-backend.h"
+#include <driver/adc.h>
+#include <cinttypes>
+
+namespace PlantMonitor {
+namespace Drivers {
+
+/*!
+ * \brief Map a GPIO to its ADC1 channel
+ * \return Channel number, or -1 if the GPIO is not an ADC1 input
+ */
+static int prv_gpio_to_adc1_channel(uint8_t pin) {
+    switch (pin) {
+        case 36:
+            return ADC1_CHANNEL_0;
+        case 37:
+            return ADC1_CHANNEL_1;
+        case 38:
+            return ADC1_CHANNEL_2;
+        case 39:
+            return ADC1_CHANNEL_3;
+        case 32:
+            return ADC1_CHANNEL_4;
+        case 33:
+            return ADC1_CHANNEL_5;
+        case 34:
+            return ADC1_CHANNEL_6;
+        case 35:
+            return ADC1_CHANNEL_7;
+        default:
+            return -1;
+    }
+}
+
+ContinuousAdcBackend::ContinuousAdcBackend()
+    : m_count(0), m_running(false) {
+}
+
+ContinuousAdcBackend::~ContinuousAdcBackend() {
+    end();
+}
+
+bool ContinuousAdcBackend::begin(const uint8_t *pins, size_t count, uint32_t sampleRateHz) {
+    if (m_running || count == 0 || count > ADC_ENGINE_MAX_CHANNELS) {
+        return false;
+    }
+
+    uint16_t channelMask = 0;
+    adc_digi_pattern_config_t pattern[ADC_ENGINE_MAX_CHANNELS] = {};
+
+    for (size_t i = 0; i < count; ++i) {
+        int channel = prv_gpio_to_adc1_channel(pins[i]);
+        if (channel < 0) {
+            Serial.printf("[AdcEngine] GPIO %d is not an ADC1 input\n", pins[i]);
+            return false;
+        }
+        m_pins[i] = pins[i];
+        m_channels[i] = static_cast<uint8_t>(channel);
+        channelMask |= BIT(channel);
+
+        pattern[i].atten = ADC_ATTEN_DB_11;
+        pattern[i].channel = channel;
+        pattern[i].unit = 0; // ADC1
+        pattern[i].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+    }
+    m_count = count;
+
+    adc_digi_init_config_t initConfig = {};
+    initConfig.max_store_buf_size = ADC_CONTINUOUS_BUFFER_BYTES;
+    initConfig.conv_num_each_intr = ADC_CONTINUOUS_FRAME_BYTES;
+    initConfig.adc1_chan_mask = channelMask;
+    initConfig.adc2_chan_mask = 0;
+
+    if (adc_digi_initialize(&initConfig) != ESP_OK) {
+        Serial.println("[AdcEngine] ERROR: continuous ADC init failed");
+        return false;
+    }
+
+    adc_digi_configuration_t digiConfig = {};
+    digiConfig.conv_limit_en = true; // Required on the original ESP32
+    digiConfig.conv_limit_num = 250;
+    digiConfig.pattern_num = count;
+    digiConfig.adc_pattern = pattern;
+    digiConfig.sample_freq_hz = sampleRateHz;
+    digiConfig.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+    digiConfig.format = ADC_DIGI_OUTPUT_FORMAT_TYPE1;
+
+    if (adc_digi_controller_configure(&digiConfig) != ESP_OK || adc_digi_start() != ESP_OK) {
+        Serial.println("[AdcEngine] ERROR: continuous ADC start failed");
+        adc_digi_deinitialize();
+        return false;
+    }
+
+    m_running = true;
+    Serial.printf("[AdcEngine] Continuous ADC running at %" PRIu32 " Hz on %u channel(s)\n", sampleRateHz,
+                  static_cast<unsigned>(count));
+    return true;
+}
+
+size_t ContinuousAdcBackend::read(AdcSample *out, size_t max) {
+    if (!m_running || max == 0) {
+        return 0;
+    }
+
+    uint8_t raw[ADC_ENGINE_PUMP_BATCH * SOC_ADC_DIGI_RESULT_BYTES];
+    const uint32_t wanted = min(max, (size_t)ADC_ENGINE_PUMP_BATCH) * SOC_ADC_DIGI_RESULT_BYTES;
+    uint32_t length = 0;
+
+    // ESP_ERR_INVALID_STATE only reports that the DMA ring overflowed; the
+    // returned data is still valid, so keep it.
+    esp_err_t err = adc_digi_read_bytes(raw, wanted, &length, 0);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+        return 0;
+    }
+
+    size_t n = 0;
+    for (uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= length && n < max; i += SOC_ADC_DIGI_RESULT_BYTES) {
+        auto *result = reinterpret_cast<adc_digi_output_data_t *>(&raw[i]);
+        uint8_t pin = pinForChannel(result->type1.channel);
+        if (pin == 0xFF) {
+            continue;
+        }
+        out[n].pin = pin;
+        out[n].value = result->type1.data;
+        n++;
+    }
+    return n;
+}
+
+void ContinuousAdcBackend::end() {
+    if (!m_running) {
+        return;
+    }
+    adc_digi_stop();
+    adc_digi_deinitialize();
+    m_running = false;
+}
+
+uint8_t ContinuousAdcBackend::pinForChannel(uint8_t channel) const {
+    for (size_t i = 0; i < m_count; ++i) {
+        if (m_channels[i] == channel) {
+            return m_pins[i];
+        }
+    }
+    return 0xFF;
+}
+
+} // namespace Drivers
+} // namespace PlantMonitor
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <Arduino.h>
+#include "adc-engine.h"
+
+/*!
+ * \file adc-continuous-backend.h
+ * \brief AdcBackend driving the ESP32 ADC1 in continuous (DMA) mode
+ *
+ * Conversions are scheduled by the ADC digital controller and moved to RAM by
+ * DMA, so no CPU time is spent waiting for individual samples. All channels
+ * must live on ADC1 (GPIO 32-39).
+ *
+ * \note While this backend is running, analogRead() must not be used on ADC1.
+ */
+
+#define ADC_CONTINUOUS_BUFFER_BYTES 1024 //!< DMA ring size in bytes
+#define ADC_CONTINUOUS_FRAME_BYTES 256   //!< Bytes per DMA conversion frame
+
+namespace PlantMonitor {
+namespace Drivers {
+
+/*!
+ * \class ContinuousAdcBackend
+ * \brief ESP32 ADC1 continuous-mode backend for AdcEngine
+ */
+class ContinuousAdcBackend : public AdcBackend {
+  public:
+    ContinuousAdcBackend();
+    ~ContinuousAdcBackend() override;
+
+    bool begin(const uint8_t *pins, size_t count, uint32_t sampleRateHz) override;
+    size_t read(AdcSample *out, size_t max) override;
+    void end() override;
+
+  private:
+    /*!
+     * \brief Map an ADC1 channel number back to its GPIO
+     * \return GPIO number, or 0xFF if the channel is not registered
+     */
+    uint8_t pinForChannel(uint8_t channel) const;
+
+    uint8_t m_pins[ADC_ENGINE_MAX_CHANNELS];      //!< Registered GPIOs
+    uint8_t m_channels[ADC_ENGINE_MAX_CHANNELS];  //!< Matching ADC1 channels
+    size_t m_count;                               //!< Number of channels
+    bool m_running;                               //!< Digital controller started
+};
+
+} // namespace Drivers
+} // namespace PlantMonitor
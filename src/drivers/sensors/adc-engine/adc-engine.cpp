@@ -0,0 +1,215 @@
+#include "adc-engine.h"
+
+namespace PlantMonitor {
+namespace Drivers {
+
+// ============================================================================
+// ReaderAdcBackend
+// ============================================================================
+
+ReaderAdcBackend::ReaderAdcBackend(AnalogReader reader)
+    : m_reader(reader ? reader : [](uint8_t pin) { return analogRead(pin); }),
+      m_count(0),
+      m_next(0) {
+}
+
+bool ReaderAdcBackend::begin(const uint8_t *pins, size_t count, uint32_t) {
+    if (count == 0 || count > ADC_ENGINE_MAX_CHANNELS) {
+        return false;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        m_pins[i] = pins[i];
+    }
+    m_count = count;
+    m_next = 0;
+    return true;
+}
+
+size_t ReaderAdcBackend::read(AdcSample *out, size_t max) {
+    if (m_count == 0) {
+        return 0;
+    }
+
+    for (size_t i = 0; i < max; ++i) {
+        const uint8_t pin = m_pins[m_next];
+        int raw = m_reader(pin);
+        out[i].pin = pin;
+        out[i].value = static_cast<uint16_t>(constrain(raw, 0, 0xFFFF));
+        m_next = (m_next + 1) % m_count;
+    }
+    return max;
+}
+
+void ReaderAdcBackend::end() {
+    m_count = 0;
+}
+
+// ============================================================================
+// AdcEngine
+// ============================================================================
+
+AdcEngine::AdcEngine(AdcBackend &backend, uint16_t blockSize)
+    : m_backend(backend),
+      m_blockSize(blockSize > 0 ? blockSize : 1),
+      m_channelCount(0),
+      m_running(false) {
+}
+
+AdcEngine::~AdcEngine() {
+    if (m_running) {
+        m_backend.end();
+    }
+}
+
+bool AdcEngine::addChannel(uint8_t pin) {
+    if (m_running || m_channelCount >= ADC_ENGINE_MAX_CHANNELS || findChannel(pin)) {
+        return false;
+    }
+
+    Channel &ch = m_channels[m_channelCount++];
+    ch.pin = pin;
+    ch.block.configure(m_blockSize);
+    ch.average.store(0, std::memory_order_relaxed);
+    ch.fine.store(0, std::memory_order_relaxed);
+    ch.blocks.store(0, std::memory_order_relaxed);
+    return true;
+}
+
+bool AdcEngine::begin(uint32_t sampleRateHz) {
+    if (m_running || m_channelCount == 0) {
+        return m_running;
+    }
+
+    uint8_t pins[ADC_ENGINE_MAX_CHANNELS];
+    for (size_t i = 0; i < m_channelCount; ++i) {
+        pins[i] = m_channels[i].pin;
+    }
+
+    m_running = m_backend.begin(pins, m_channelCount, sampleRateHz);
+    return m_running;
+}
+
+bool AdcEngine::start(uint32_t sampleRateHz, uint32_t stackSize, UBaseType_t priority, BaseType_t core) {
+    if (!begin(sampleRateHz)) {
+        return false;
+    }
+
+    if (xTaskCreatePinnedToCore(taskThunk, "AdcEngine", stackSize, this, priority, nullptr, core) != pdPASS) {
+        // Nobody would drain the backend: release it so the caller can fall back
+        m_backend.end();
+        m_running = false;
+        return false;
+    }
+    return true;
+}
+
+size_t AdcEngine::pump() {
+    if (!m_running) {
+        return 0;
+    }
+
+    AdcSample batch[ADC_ENGINE_PUMP_BATCH];
+    size_t total = 0;
+    size_t n;
+
+    do {
+        n = m_backend.read(batch, ADC_ENGINE_PUMP_BATCH);
+        for (size_t i = 0; i < n; ++i) {
+            Channel *ch = findChannel(batch[i].pin);
+            if (!ch) {
+                continue;
+            }
+
+            if (ch->block.push(batch[i].value)) {
+                ch->average.store(static_cast<uint16_t>(ch->block.value(ADC_ENGINE_RAW_BITS, ADC_ENGINE_RAW_BITS)),
+                                  std::memory_order_relaxed);
+                ch->fine.store(static_cast<uint16_t>(ch->block.value(ADC_ENGINE_RAW_BITS, ADC_ENGINE_FINE_BITS)),
+                               std::memory_order_relaxed);
+                ch->blocks.fetch_add(1, std::memory_order_release);
+            }
+        }
+        total += n;
+    } while (n == ADC_ENGINE_PUMP_BATCH && total < m_blockSize * m_channelCount);
+
+    return total;
+}
+
+bool AdcEngine::getBlockAverage(uint8_t pin, uint16_t &value) const {
+    const Channel *ch = findChannel(pin);
+    if (!ch || ch->blocks.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+    value = ch->average.load(std::memory_order_relaxed);
+    return true;
+}
+
+bool AdcEngine::getBlockValueFine(uint8_t pin, uint16_t &value) const {
+    const Channel *ch = findChannel(pin);
+    if (!ch || ch->blocks.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+    value = ch->fine.load(std::memory_order_relaxed);
+    return true;
+}
+
+uint32_t AdcEngine::blockCount(uint8_t pin) const {
+    const Channel *ch = findChannel(pin);
+    return ch ? ch->blocks.load(std::memory_order_acquire) : 0;
+}
+
+bool AdcEngine::isReady() const {
+    if (m_channelCount == 0) {
+        return false;
+    }
+    for (size_t i = 0; i < m_channelCount; ++i) {
+        if (m_channels[i].blocks.load(std::memory_order_acquire) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+AdcEngine::AnalogReader AdcEngine::reader() const {
+    return [this](uint8_t pin) {
+        uint16_t value = 0;
+        getBlockAverage(pin, value);
+        return static_cast<int>(value);
+    };
+}
+
+AdcEngine::AnalogReader AdcEngine::fineReader() const {
+    return [this](uint8_t pin) {
+        uint16_t value = 0;
+        getBlockValueFine(pin, value);
+        return static_cast<int>(value);
+    };
+}
+
+AdcEngine::Channel *AdcEngine::findChannel(uint8_t pin) {
+    for (size_t i = 0; i < m_channelCount; ++i) {
+        if (m_channels[i].pin == pin) {
+            return &m_channels[i];
+        }
+    }
+    return nullptr;
+}
+
+const AdcEngine::Channel *AdcEngine::findChannel(uint8_t pin) const {
+    for (size_t i = 0; i < m_channelCount; ++i) {
+        if (m_channels[i].pin == pin) {
+            return &m_channels[i];
+        }
+    }
+    return nullptr;
+}
+
+void AdcEngine::taskThunk(void *arg) {
+    auto *self = static_cast<AdcEngine *>(arg);
+    while (true) {
+        self->pump();
+        vTaskDelay(pdMS_TO_TICKS(ADC_ENGINE_PUMP_PERIOD_MS));
+    }
+}
+
+} // namespace Drivers
+} // namespace PlantMonitor
@@ -0,0 +1,250 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+#include <functional>
+#include "app-config.h"
+#include "utils/cic-decimator/cic-decimator.h"
+
+/*!
+ * \file adc-engine.h
+ * \brief Background ADC acquisition engine with pluggable sample backends
+ *
+ * The engine drains raw conversions from a backend (ESP32 continuous/DMA mode
+ * on hardware, a synthetic AnalogReader stream in native tests), accumulates
+ * them per channel and publishes the average of every completed block.
+ * Consumers read the latest block average without waiting, so the sensor
+ * task never sleeps inside a driver.
+ *
+ * Each block is an accumulate-and-dump (order 1 CIC) decimation. Besides the
+ * 12-bit average, the engine publishes the block at ADC_ENGINE_FINE_BITS:
+ * averaging 1024 noisy conversions gains about 5 bits, so the fine value
+ * carries real resolution below one 12-bit LSB.
+ *
+ * Typical usage:
+ * \code
+ * ContinuousAdcBackend backend;
+ * AdcEngine engine(backend);
+ * engine.addChannel(Config::SOIL_MOISTURE_PIN);
+ * engine.addChannel(Config::LIGHT_SENSOR_PIN);
+ * engine.start();
+ *
+ * MoistureSensorHAL moisture(3724, 0, engine.reader(), 1);
+ * \endcode
+ */
+
+#define ADC_ENGINE_MAX_CHANNELS 4          //!< Maximum number of channels handled by one engine
+#define ADC_ENGINE_DEFAULT_BLOCK_SIZE 1024 //!< Default samples averaged per channel block
+#define ADC_ENGINE_DEFAULT_RATE_HZ 20000   //!< Default aggregate conversion rate (all channels)
+#define ADC_ENGINE_PUMP_BATCH 64           //!< Samples drained from the backend per read call
+#define ADC_ENGINE_PUMP_PERIOD_MS 10       //!< Engine task sleep between backend drains
+#define ADC_ENGINE_RAW_BITS 12             //!< Resolution of one conversion
+#define ADC_ENGINE_FINE_BITS 16            //!< Resolution of the published fine block value
+
+namespace PlantMonitor {
+namespace Drivers {
+
+/*!
+ * \struct AdcSample
+ * \brief One raw conversion produced by a backend
+ */
+struct AdcSample {
+    uint8_t pin;    //!< GPIO the conversion belongs to
+    uint16_t value; //!< Raw ADC value
+};
+
+/*!
+ * \class AdcBackend
+ * \brief Source of raw ADC conversions for the AdcEngine
+ */
+class AdcBackend {
+  public:
+    virtual ~AdcBackend() = default;
+
+    /*!
+     * \brief Configure and start conversions
+     * \param pins GPIO pins to convert
+     * \param count Number of pins
+     * \param sampleRateHz Aggregate conversion rate over all pins
+     * \return true on success
+     */
+    virtual bool begin(const uint8_t *pins, size_t count, uint32_t sampleRateHz) = 0;
+
+    /*!
+     * \brief Drain the conversions available right now (non-blocking)
+     * \param[out] out Destination buffer
+     * \param max Capacity of \p out
+     * \return Number of samples written
+     */
+    virtual size_t read(AdcSample *out, size_t max) = 0;
+
+    /*!
+     * \brief Stop conversions and release the hardware
+     */
+    virtual void end() = 0;
+};
+
+/*!
+ * \class ReaderAdcBackend
+ * \brief Backend polling an AnalogReader round-robin
+ *
+ * Used by native tests to feed synthetic sample streams, and usable on
+ * hardware as an analogRead() fallback.
+ */
+class ReaderAdcBackend : public AdcBackend {
+  public:
+    /*!
+     * \brief Type alias for a custom analog read function
+     */
+    using AnalogReader = std::function<int(uint8_t)>;
+
+    /*!
+     * \brief Constructor
+     * \param reader Function returning one conversion for a pin (default: analogRead)
+     */
+    explicit ReaderAdcBackend(AnalogReader reader = nullptr);
+
+    bool begin(const uint8_t *pins, size_t count, uint32_t sampleRateHz) override;
+    size_t read(AdcSample *out, size_t max) override;
+    void end() override;
+
+  private:
+    AnalogReader m_reader;                    //!< Conversion source
+    uint8_t m_pins[ADC_ENGINE_MAX_CHANNELS];  //!< Pins to poll
+    size_t m_count;                           //!< Number of pins
+    size_t m_next;                            //!< Next pin in round-robin order
+};
+
+/*!
+ * \class AdcEngine
+ * \brief Per-channel block averaging on top of an AdcBackend
+ *
+ * pump() is the only writer (the engine task, or the test); block averages
+ * are published through atomics and can be read from any task.
+ */
+class AdcEngine {
+  public:
+    /*!
+     * \brief Type alias matching the sensor HALs' analog read hook
+     */
+    using AnalogReader = std::function<int(uint8_t)>;
+
+    /*!
+     * \brief Constructor
+     * \param backend Conversion source (must outlive the engine)
+     * \param blockSize Samples averaged per channel block
+     */
+    explicit AdcEngine(AdcBackend &backend, uint16_t blockSize = ADC_ENGINE_DEFAULT_BLOCK_SIZE);
+
+    /*!
+     * \brief Destructor (stops the backend)
+     */
+    ~AdcEngine();
+
+    /*!
+     * \brief Register a pin (before begin())
+     * \param pin GPIO pin
+     * \return false if the channel table is full
+     */
+    bool addChannel(uint8_t pin);
+
+    /*!
+     * \brief Start the backend without a background task (caller pumps)
+     * \param sampleRateHz Aggregate conversion rate
+     * \return true on success
+     */
+    bool begin(uint32_t sampleRateHz = ADC_ENGINE_DEFAULT_RATE_HZ);
+
+    /*!
+     * \brief Start the backend and a FreeRTOS task that pumps it
+     * \param sampleRateHz Aggregate conversion rate
+     * \param stackSize Task stack size
+     * \param priority Task priority
+     * \param core Core to pin the task to
+     * \return true on success; if the task cannot be created the backend is
+     *         stopped again and false is returned
+     */
+    bool start(uint32_t sampleRateHz = ADC_ENGINE_DEFAULT_RATE_HZ,
+               uint32_t stackSize = 2048,
+               UBaseType_t priority = Config::Tasks::SENSOR_PRIORITY,
+               BaseType_t core = Config::Tasks::SENSOR_CORE);
+
+    /*!
+     * \brief Drain the backend into the block accumulators
+     * \return Number of samples consumed
+     */
+    size_t pump();
+
+    /*!
+     * \brief Get the average of the latest completed block
+     * \param pin GPIO pin
+     * \param[out] value Block average (raw ADC units)
+     * \return false if the pin is unknown or no block completed yet
+     */
+    bool getBlockAverage(uint8_t pin, uint16_t &value) const;
+
+    /*!
+     * \brief Get the latest completed block at ADC_ENGINE_FINE_BITS resolution
+     * \param pin GPIO pin
+     * \param[out] value Block value (0 to 2^ADC_ENGINE_FINE_BITS - 1)
+     * \return false if the pin is unknown or no block completed yet
+     */
+    bool getBlockValueFine(uint8_t pin, uint16_t &value) const;
+
+    /*!
+     * \brief Get the number of blocks completed on a pin
+     * \param pin GPIO pin
+     * \return Block count (0 if unknown)
+     */
+    uint32_t blockCount(uint8_t pin) const;
+
+    /*!
+     * \brief Check whether every channel has completed at least one block
+     */
+    bool isReady() const;
+
+    /*!
+     * \brief Get an AnalogReader returning the latest block average of a pin
+     * \return Reader suitable for MoistureSensorHAL / LightSensor (0 before the first block)
+     */
+    AnalogReader reader() const;
+
+    /*!
+     * \brief Get an AnalogReader returning the latest fine block value of a pin
+     * \return Reader producing ADC_ENGINE_FINE_BITS values (0 before the first block)
+     */
+    AnalogReader fineReader() const;
+
+  private:
+    /*!
+     * \struct Channel
+     * \brief Accumulator and published result for one pin
+     */
+    struct Channel {
+        uint8_t pin;                    //!< GPIO pin
+        Utils::CicDecimator<1> block;   //!< Accumulate-and-dump over m_blockSize samples
+        std::atomic<uint16_t> average;  //!< Latest completed block average
+        std::atomic<uint16_t> fine;     //!< Latest completed block at ADC_ENGINE_FINE_BITS
+        std::atomic<uint32_t> blocks;   //!< Completed block count
+    };
+
+    /// \brief Look up the channel registered for a pin (nullptr if unknown).
+    Channel *findChannel(uint8_t pin);
+    const Channel *findChannel(uint8_t pin) const;
+
+    /// \brief Task entry point pumping the backend forever.
+    static void taskThunk(void *arg);
+
+    AdcBackend &m_backend;                         //!< Conversion source
+    uint16_t m_blockSize;                          //!< Samples per block
+    Channel m_channels[ADC_ENGINE_MAX_CHANNELS];   //!< Channel table
+    size_t m_channelCount;                         //!< Registered channels
+    bool m_running;                                //!< Backend started
+
+    // Prevent copying
+    AdcEngine(const AdcEngine &) = delete;
+    AdcEngine &operator=(const AdcEngine &) = delete;
+};
+
+} // namespace Drivers
+} // namespace PlantMonitor
@@ -3,8 +3,9 @@
 namespace PlantMonitor {
 namespace Drivers {
 
-LightSensor::LightSensor(uint8_t pin)
-    : _pin(pin) {
+LightSensor::LightSensor(uint8_t pin, AnalogReader reader)
+    : _pin(pin),
+      _reader(reader ? reader : [](uint8_t p) { return analogRead(p); }) {
 }
 
 void LightSensor::begin() {
@@ -12,7 +13,7 @@ void LightSensor::begin() {
 }
 
 int LightSensor::readRaw() {
-    return analogRead(_pin);
+    return _reader(_pin);
 }
 
 int LightSensor::readRawAverage(uint8_t samples) {
@@ -21,7 +22,7 @@ int LightSensor::readRawAverage(uint8_t samples) {
 
     uint32_t sum = 0;
     for (uint8_t i = 0; i < samples; i++) {
-        sum += analogRead(_pin);
+        sum += _reader(_pin);
         if (i < samples - 1) {
             delayMicroseconds(100); // Small delay between readings
         }
@@ -30,13 +31,33 @@ int LightSensor::readRawAverage(uint8_t samples) {
     return sum / samples;
 }
 
+int LightSensor::readRawFiltered(uint8_t samples, Utils::SampleReduction reduction) {
+    if (reduction == Utils::SampleReduction::Mean) {
+        return readRawAverage(samples);
+    }
+    if (samples == 0)
+        samples = 1;
+    if (samples > MEDIAN_MAX_WINDOW)
+        samples = MEDIAN_MAX_WINDOW;
+
+    int reads[MEDIAN_MAX_WINDOW];
+    for (uint8_t i = 0; i < samples; i++) {
+        reads[i] = _reader(_pin);
+        if (i < samples - 1) {
+            delayMicroseconds(100); // Small delay between readings
+        }
+    }
+
+    return static_cast<int>(lroundf(Utils::reduceSamples(reads, samples, reduction)));
+}
+
 float LightSensor::readVoltage(float vref) {
-    int raw = analogRead(_pin);
+    int raw = _reader(_pin);
     return raw / 4095.0f;
 }
 
 float LightSensor::readPercentage(int minRaw, int maxRaw) {
-    int raw = analogRead(_pin);
+    int raw = _reader(_pin);
 
     // Clamp
     if (raw < minRaw)
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <Arduino.h>
+#include <functional>
 #include "app-config.h"
+#include "utils/median-filter/median-filter.h"
 
 /*!
  * \file light-sensor.h
@@ -22,7 +24,17 @@ namespace Drivers {
  */
 class LightSensor {
   public:
-    LightSensor(uint8_t pin = LIGHT_SENSOR_DEFAULT_PIN);
+    /*!
+     * \brief Type alias for a custom analog read function
+     */
+    using AnalogReader = std::function<int(uint8_t)>;
+
+    /*!
+     * \brief Constructor
+     * \param pin GPIO pin number
+     * \param reader Optional custom analogRead function (for unit tests or AdcEngine::reader())
+     */
+    LightSensor(uint8_t pin = LIGHT_SENSOR_DEFAULT_PIN, AnalogReader reader = nullptr);
 
     /*!
      * \brief Initialize the light sensor
@@ -42,6 +54,16 @@ class LightSensor {
      */
     int readRawAverage(uint8_t samples = 10);
 
+    /*!
+     * \brief Read multiple samples and reduce them to one value
+     * \param samples Number of samples (capped to MEDIAN_MAX_WINDOW for median / Hampel)
+     * \param reduction How the samples are combined
+     * \return Reduced raw analog value
+     * \note Use Median or Hampel when the line picks up spikes: a mean spreads
+     *       a single bad read over the whole result.
+     */
+    int readRawFiltered(uint8_t samples, Utils::SampleReduction reduction);
+
     /*!
      * \brief Read the voltage from the light sensor
      * \param vref Reference voltage for ADC conversion (default: 3.3V)
@@ -58,7 +80,8 @@ class LightSensor {
     float readPercentage(int minRaw = ADC_MIN_VALUE, int maxRaw = ADC_MAX_VALUE);
 
   private:
-    uint8_t _pin; //!< GPIO pin number
+    uint8_t _pin;          //!< GPIO pin number
+    AnalogReader _reader;  //!< Function to read analog values
 };
 
 } // namespace Drivers
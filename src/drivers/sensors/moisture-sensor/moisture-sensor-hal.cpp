@@ -5,11 +5,20 @@ namespace Drivers {
 
 MoistureSensorHAL::MoistureSensorHAL(uint16_t dryValue,
                                      uint16_t wetValue,
-                                     AnalogReader reader)
+                                     AnalogReader reader,
+                                     uint8_t samples,
+                                     Utils::SampleReduction reduction,
+                                     uint8_t readerBits)
     : m_moisture_pin(Config::SOIL_MOISTURE_PIN),
       m_dryValue(dryValue),
       m_wetValue(wetValue),
-      m_reader(reader ? reader : [](uint8_t pin) { return analogRead(pin); }) {
+      m_reader(reader ? reader : [](uint8_t pin) { return analogRead(pin); }),
+      m_samples(samples > 0 ? samples : 1),
+      m_reduction(reduction),
+      m_readerScale(static_cast<float>(1u << MOISTURE_CALIBRATION_BITS) / static_cast<float>(1ul << readerBits)) {
+    if (m_reduction != Utils::SampleReduction::Mean && m_samples > MEDIAN_MAX_WINDOW) {
+        m_samples = MEDIAN_MAX_WINDOW;
+    }
 }
 
 bool MoistureSensorHAL::begin() {
@@ -20,27 +29,46 @@ bool MoistureSensorHAL::begin() {
     return true;
 }
 
-int MoistureSensorHAL::readAveragedAnalog(uint8_t samples) {
-    long sum = 0;
-    for (uint8_t i = 0; i < samples; ++i) {
-        sum += m_reader(m_moisture_pin);
-        delay(10);
+float MoistureSensorHAL::readAveragedAnalog() {
+    if (m_reduction == Utils::SampleReduction::Mean) {
+        long sum = 0;
+        for (uint8_t i = 0; i < m_samples; ++i) {
+            sum += m_reader(m_moisture_pin);
+            if (i < m_samples - 1) {
+                delay(MOISTURE_SAMPLE_INTERVAL_MS);
+            }
+        }
+        return static_cast<float>(sum) / m_samples * m_readerScale;
+    }
+
+    // Median / Hampel: a single spike does not drag the result
+    int reads[MEDIAN_MAX_WINDOW];
+    for (uint8_t i = 0; i < m_samples; ++i) {
+        reads[i] = m_reader(m_moisture_pin);
+        if (i < m_samples - 1) {
+            delay(MOISTURE_SAMPLE_INTERVAL_MS);
+        }
     }
-    return static_cast<int>(sum / samples);
+    return Utils::reduceSamples(reads, m_samples, m_reduction) * m_readerScale;
 }
 
 uint8_t MoistureSensorHAL::readMoistureLevel() {
-    int analog_value = readAveragedAnalog();
+    return static_cast<uint8_t>(lroundf(readMoisturePercent()));
+}
+
+float MoistureSensorHAL::readMoisturePercent() {
+    float analog_value = readAveragedAnalog();
 
     if (analog_value >= m_dryValue) {
-        return 0; // Completely dry
+        return 0.0f; // Completely dry
     }
 
-    uint8_t moisture_percentage = map(analog_value, m_dryValue, m_wetValue, 0, 100);
-    moisture_percentage = constrain(moisture_percentage, 0, 100);
+    // Linear map without integer truncation (map() would drop the extra bits)
+    float moisture_percentage = (m_dryValue - analog_value) * 100.0f / (m_dryValue - m_wetValue);
+    moisture_percentage = constrain(moisture_percentage, 0.0f, 100.0f);
 
 #ifdef MOISTURE_DEBUG
-    Serial.printf("[MoistureSensorHAL] Analog Value: %d, Moisture Level: %d%%\n",
+    Serial.printf("[MoistureSensorHAL] Analog Value: %.2f, Moisture Level: %.2f%%\n",
                   analog_value,
                   moisture_percentage);
 #endif
@@ -3,6 +3,11 @@
 #include <Arduino.h>
 #include <functional>
 #include "app-config.h"
+#include "utils/median-filter/median-filter.h"
+
+#define MOISTURE_DEFAULT_SAMPLES 5        //!< Reads reduced per measurement when polling analogRead()
+#define MOISTURE_SAMPLE_INTERVAL_MS 10    //!< Delay between two reads of a measurement
+#define MOISTURE_CALIBRATION_BITS 12      //!< Resolution of the dry / wet calibration values
 
 namespace PlantMonitor {
 namespace Drivers {
@@ -23,11 +28,20 @@ class MoistureSensorHAL {
      * \brief Constructor
      * \param dryValue ADC value representing completely dry soil
      * \param wetValue ADC value representing fully wet soil
-     * \param reader Optional custom analogRead function (for unit tests)
+     * \param reader Optional custom analogRead function (for unit tests or AdcEngine::reader())
+     * \param samples Reads per measurement (1 = single read, no delay; at most
+     *        MEDIAN_MAX_WINDOW for the median and Hampel reductions)
+     * \param reduction How the reads are combined (mean, median or Hampel)
+     * \param readerBits Resolution of the values returned by \p reader (e.g.
+     *        ADC_ENGINE_FINE_BITS for AdcEngine::fineReader()); calibration
+     *        values stay in 12-bit counts
      */
     explicit MoistureSensorHAL(uint16_t dryValue = 3724,
                                uint16_t wetValue = 0,
-                               AnalogReader reader = nullptr);
+                               AnalogReader reader = nullptr,
+                               uint8_t samples = MOISTURE_DEFAULT_SAMPLES,
+                               Utils::SampleReduction reduction = Utils::SampleReduction::Mean,
+                               uint8_t readerBits = MOISTURE_CALIBRATION_BITS);
 
     /*!
      * \brief Destructor
@@ -46,18 +60,28 @@ class MoistureSensorHAL {
      */
     uint8_t readMoistureLevel();
 
+    /*!
+     * \brief Read soil moisture level with sub-percent resolution
+     * \return Moisture level in percent (0.0-100.0)
+     * \note The extra resolution is only real with an oversampled reader
+     *       (AdcEngine::fineReader()) or a multi-sample burst.
+     */
+    float readMoisturePercent();
+
   private:
     /*!
-     * \brief Read and average multiple analog samples
-     * \param samples Number of samples
-     * \return Averaged analog value
+     * \brief Read the configured number of analog samples and reduce them to one value
+     * \return Reduced analog value in 12-bit counts (fractional part kept)
      */
-    int readAveragedAnalog(uint8_t samples = 5);
+    float readAveragedAnalog();
 
     uint8_t m_moisture_pin; //!< Analog pin for soil moisture sensor
     uint16_t m_dryValue;    //!< ADC value for dry soil
     uint16_t m_wetValue;    //!< ADC value for wet soil
     AnalogReader m_reader;  //!< Function to read analog values
+    uint8_t m_samples;      //!< Reads per measurement
+    Utils::SampleReduction m_reduction; //!< How the reads are combined
+    float m_readerScale;    //!< Factor from reader units to 12-bit counts
 };
 
 } // namespace Drivers
@@ -0,0 +1,136 @@
+#include "bme280-compensation.h"
+#include <cmath>
+
+namespace PlantMonitor {
+namespace Drivers {
+
+#define BME280_ADC_SKIPPED_20BIT 0x80000 //!< Raw T/P value when the channel is disabled
+#define BME280_ADC_SKIPPED_16BIT 0x8000  //!< Raw H value when the channel is disabled
+
+static uint16_t prv_u16_le(const uint8_t *p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+static int16_t prv_s16_le(const uint8_t *p) {
+    return static_cast<int16_t>(prv_u16_le(p));
+}
+
+void bme280ParseCalibration(const uint8_t *tp, const uint8_t *h, Bme280Calibration &calib) {
+    calib.dig_T1 = prv_u16_le(&tp[0]);
+    calib.dig_T2 = prv_s16_le(&tp[2]);
+    calib.dig_T3 = prv_s16_le(&tp[4]);
+
+    calib.dig_P1 = prv_u16_le(&tp[6]);
+    calib.dig_P2 = prv_s16_le(&tp[8]);
+    calib.dig_P3 = prv_s16_le(&tp[10]);
+    calib.dig_P4 = prv_s16_le(&tp[12]);
+    calib.dig_P5 = prv_s16_le(&tp[14]);
+    calib.dig_P6 = prv_s16_le(&tp[16]);
+    calib.dig_P7 = prv_s16_le(&tp[18]);
+    calib.dig_P8 = prv_s16_le(&tp[20]);
+    calib.dig_P9 = prv_s16_le(&tp[22]);
+
+    calib.dig_H1 = tp[25]; // 0xA1 (0xA0 is reserved)
+    calib.dig_H2 = prv_s16_le(&h[0]);
+    calib.dig_H3 = h[2];
+    // H4 and H5 are 12-bit values sharing the nibbles of 0xE5
+    calib.dig_H4 = static_cast<int16_t>((static_cast<int8_t>(h[3]) * 16) | (h[4] & 0x0F));
+    calib.dig_H5 = static_cast<int16_t>((static_cast<int8_t>(h[5]) * 16) | (h[4] >> 4));
+    calib.dig_H6 = static_cast<int8_t>(h[6]);
+}
+
+int32_t bme280CompensateTemperature(const Bme280Calibration &calib, int32_t adcT, int32_t &tFine) {
+    int32_t var1 = ((((adcT >> 3) - (static_cast<int32_t>(calib.dig_T1) << 1))) *
+                    static_cast<int32_t>(calib.dig_T2)) >> 11;
+    int32_t var2 = (((((adcT >> 4) - static_cast<int32_t>(calib.dig_T1)) *
+                      ((adcT >> 4) - static_cast<int32_t>(calib.dig_T1))) >> 12) *
+                    static_cast<int32_t>(calib.dig_T3)) >> 14;
+    tFine = var1 + var2;
+    return (tFine * 5 + 128) >> 8;
+}
+
+uint32_t bme280CompensatePressure(const Bme280Calibration &calib, int32_t adcP, int32_t tFine) {
+    int64_t var1 = static_cast<int64_t>(tFine) - 128000;
+    int64_t var2 = var1 * var1 * static_cast<int64_t>(calib.dig_P6);
+    var2 = var2 + ((var1 * static_cast<int64_t>(calib.dig_P5)) * 131072);
+    var2 = var2 + (static_cast<int64_t>(calib.dig_P4) * 34359738368LL);
+    var1 = ((var1 * var1 * static_cast<int64_t>(calib.dig_P3)) >> 8) +
+           ((var1 * static_cast<int64_t>(calib.dig_P2)) * 4096);
+    var1 = ((static_cast<int64_t>(1) << 47) + var1) * static_cast<int64_t>(calib.dig_P1) >> 33;
+    if (var1 == 0) {
+        return 0; // Avoid division by zero
+    }
+
+    int64_t p = 1048576 - adcP;
+    p = (((p << 31) - var2) * 3125) / var1;
+    var1 = (static_cast<int64_t>(calib.dig_P9) * (p >> 13) * (p >> 13)) >> 25;
+    var2 = (static_cast<int64_t>(calib.dig_P8) * p) >> 19;
+    p = ((p + var1 + var2) >> 8) + (static_cast<int64_t>(calib.dig_P7) << 4);
+    return static_cast<uint32_t>(p);
+}
+
+uint32_t bme280CompensateHumidity(const Bme280Calibration &calib, int32_t adcH, int32_t tFine) {
+    int32_t v = tFine - 76800;
+    v = (((((adcH << 14) - (static_cast<int32_t>(calib.dig_H4) * 1048576) - (static_cast<int32_t>(calib.dig_H5) * v)) +
+           16384) >> 15) *
+         (((((((v * static_cast<int32_t>(calib.dig_H6)) >> 10) *
+              (((v * static_cast<int32_t>(calib.dig_H3)) >> 11) + 32768)) >> 10) +
+            2097152) * static_cast<int32_t>(calib.dig_H2) + 8192) >> 14));
+    v = v - (((((v >> 15) * (v >> 15)) >> 7) * static_cast<int32_t>(calib.dig_H1)) >> 4);
+    v = (v < 0) ? 0 : v;
+    v = (v > 419430400) ? 419430400 : v; // 100 %RH in Q22.10 << 12
+    return static_cast<uint32_t>(v >> 12);
+}
+
+bool bme280Compensate(const Bme280Calibration &calib, const uint8_t *burst, Bme280Reading &out) {
+    int32_t adcP = (static_cast<int32_t>(burst[0]) << 12) | (burst[1] << 4) | (burst[2] >> 4);
+    int32_t adcT = (static_cast<int32_t>(burst[3]) << 12) | (burst[4] << 4) | (burst[5] >> 4);
+    int32_t adcH = (static_cast<int32_t>(burst[6]) << 8) | burst[7];
+
+    out.temperature = NAN;
+    out.pressure = NAN;
+    out.humidity = NAN;
+
+    if (adcT == BME280_ADC_SKIPPED_20BIT) {
+        return false;
+    }
+
+    int32_t tFine;
+    out.temperature = bme280CompensateTemperature(calib, adcT, tFine) / 100.0f;
+
+    if (adcP != BME280_ADC_SKIPPED_20BIT) {
+        out.pressure = bme280CompensatePressure(calib, adcP, tFine) / 25600.0f; // Q24.8 Pa -> hPa
+    }
+    if (adcH != BME280_ADC_SKIPPED_16BIT) {
+        out.humidity = bme280CompensateHumidity(calib, adcH, tFine) / 1024.0f;
+    }
+    return true;
+}
+
+/*!
+ * \brief Oversampling factor for a register code (0 when the channel is skipped)
+ */
+static uint32_t prv_oversampling_factor(uint8_t osrs) {
+    if (osrs == 0) {
+        return 0;
+    }
+    return 1u << ((osrs > 5 ? 5 : osrs) - 1); // Codes above 5 also mean x16
+}
+
+uint32_t bme280MeasurementTimeUs(uint8_t osrsT, uint8_t osrsP, uint8_t osrsH) {
+    uint32_t t = prv_oversampling_factor(osrsT);
+    uint32_t p = prv_oversampling_factor(osrsP);
+    uint32_t h = prv_oversampling_factor(osrsH);
+
+    uint32_t us = 1250 + 2300 * t;
+    if (p) {
+        us += 2300 * p + 575;
+    }
+    if (h) {
+        us += 2300 * h + 575;
+    }
+    return us;
+}
+
+} // namespace Drivers
+} // namespace PlantMonitor
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/*!
+ * \file bme280-compensation.h
+ * \brief Bosch BME280 raw-data decoding and fixed-point compensation
+ *
+ * Hardware-independent part of the BME280 driver: it turns the calibration
+ * registers and one 8-byte burst of measurement registers (0xF7..0xFE) into
+ * temperature, pressure and humidity using the integer formulas from the
+ * Bosch datasheet (section 4.2.3). Kept free of I2C so it can be unit tested.
+ */
+
+#define BME280_CALIB_TP_LENGTH 26  //!< Bytes in calibration block 0x88..0xA1
+#define BME280_CALIB_H_LENGTH 7    //!< Bytes in calibration block 0xE1..0xE7
+#define BME280_BURST_LENGTH 8      //!< Bytes in measurement burst 0xF7..0xFE
+
+namespace PlantMonitor {
+namespace Drivers {
+
+/*!
+ * \struct Bme280Calibration
+ * \brief Factory trimming parameters stored in the sensor NVM
+ */
+struct Bme280Calibration {
+    uint16_t dig_T1;
+    int16_t dig_T2;
+    int16_t dig_T3;
+
+    uint16_t dig_P1;
+    int16_t dig_P2;
+    int16_t dig_P3;
+    int16_t dig_P4;
+    int16_t dig_P5;
+    int16_t dig_P6;
+    int16_t dig_P7;
+    int16_t dig_P8;
+    int16_t dig_P9;
+
+    uint8_t dig_H1;
+    int16_t dig_H2;
+    uint8_t dig_H3;
+    int16_t dig_H4;
+    int16_t dig_H5;
+    int8_t dig_H6;
+};
+
+/*!
+ * \struct Bme280Reading
+ * \brief One compensated measurement (fields are NAN when the channel was skipped)
+ */
+struct Bme280Reading {
+    float temperature; //!< Air temperature in °C
+    float humidity;    //!< Relative humidity in %
+    float pressure;    //!< Pressure in hPa
+};
+
+/*!
+ * \brief Decode the calibration registers
+ * \param tp Registers 0x88..0xA1 (BME280_CALIB_TP_LENGTH bytes)
+ * \param h Registers 0xE1..0xE7 (BME280_CALIB_H_LENGTH bytes)
+ * \param[out] calib Decoded parameters
+ */
+void bme280ParseCalibration(const uint8_t *tp, const uint8_t *h, Bme280Calibration &calib);
+
+/*!
+ * \brief Compensate raw temperature
+ * \param calib Calibration parameters
+ * \param adcT 20-bit raw temperature
+ * \param[out] tFine Fine temperature carried into pressure / humidity compensation
+ * \return Temperature in 0.01 °C
+ */
+int32_t bme280CompensateTemperature(const Bme280Calibration &calib, int32_t adcT, int32_t &tFine);
+
+/*!
+ * \brief Compensate raw pressure
+ * \param calib Calibration parameters
+ * \param adcP 20-bit raw pressure
+ * \param tFine Fine temperature from bme280CompensateTemperature()
+ * \return Pressure in Pa as Q24.8 (divide by 256)
+ */
+uint32_t bme280CompensatePressure(const Bme280Calibration &calib, int32_t adcP, int32_t tFine);
+
+/*!
+ * \brief Compensate raw humidity
+ * \param calib Calibration parameters
+ * \param adcH 16-bit raw humidity
+ * \param tFine Fine temperature from bme280CompensateTemperature()
+ * \return Relative humidity in % as Q22.10 (divide by 1024)
+ */
+uint32_t bme280CompensateHumidity(const Bme280Calibration &calib, int32_t adcH, int32_t tFine);
+
+/*!
+ * \brief Decode a measurement burst and compensate every channel
+ * \param calib Calibration parameters
+ * \param burst Registers 0xF7..0xFE (BME280_BURST_LENGTH bytes)
+ * \param[out] out Compensated reading
+ * \return false if the temperature channel was skipped (nothing can be compensated)
+ */
+bool bme280Compensate(const Bme280Calibration &calib, const uint8_t *burst, Bme280Reading &out);
+
+/*!
+ * \brief Maximum forced-mode conversion time (datasheet section 9.1)
+ * \param osrsT Temperature oversampling register code (0 = skipped, 1..5 = x1..x16)
+ * \param osrsP Pressure oversampling register code
+ * \param osrsH Humidity oversampling register code
+ * \return Conversion time in microseconds
+ */
+uint32_t bme280MeasurementTimeUs(uint8_t osrsT, uint8_t osrsP, uint8_t osrsH);
+
+} // namespace Drivers
+} // namespace PlantMonitor
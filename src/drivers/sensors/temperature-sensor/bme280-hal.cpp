@@ -1,33 +1,141 @@
 #include "bme280-hal.h"
 
+#define BME280_REG_CALIB_TP 0x88  //!< First temperature / pressure calibration register
+#define BME280_REG_CALIB_H 0xE1   //!< First humidity calibration register (dig_H2)
+#define BME280_REG_STATUS 0xF3    //!< Status register
+#define BME280_REG_CTRL_MEAS 0xF4 //!< Oversampling T/P and mode
+#define BME280_REG_DATA 0xF7      //!< First measurement register (press_msb)
+#define BME280_STATUS_MEASURING 0x08
+#define BME280_MODE_FORCED 0x01
+
 namespace PlantMonitor {
 namespace Drivers {
 
-Bme280Hal::Bme280Hal() {
+Bme280Hal::Bme280Hal(const Bme280Settings &settings)
+    : m_settings(settings),
+      m_calib(),
+      m_ctrlMeas(0),
+      m_conversionUs(0) {
 }
 
 bool Bme280Hal::begin() {
-    if (!bme.begin(BME280_I2C_ADDRESS, &Wire)) {
-        Serial.print("[ BME ] Error: not found!");
+    {
+        I2cLease lease(I2cClient::Bme280, I2cPriority::High);
+        if (!lease.held() || !bme.begin(BME280_I2C_ADDRESS, &I2cBus::wire())) {
+            Serial.print("[ BME ] Error: not found!");
+            return false;
+        }
+    }
+
+    uint8_t tp[BME280_CALIB_TP_LENGTH];
+    uint8_t h[BME280_CALIB_H_LENGTH];
+    if (!readRegisters(BME280_REG_CALIB_TP, tp, sizeof(tp)) || !readRegisters(BME280_REG_CALIB_H, h, sizeof(h))) {
+        Serial.print("[ BME ] Error: calibration read failed!");
         return false;
     }
+    bme280ParseCalibration(tp, h, m_calib);
+
+    {
+        // Writes ctrl_hum, config and ctrl_meas in the order the datasheet requires
+        I2cLease lease(I2cClient::Bme280, I2cPriority::High);
+        bme.setSampling(Adafruit_BME280::MODE_FORCED,
+                        m_settings.temperatureOversampling,
+                        m_settings.pressureOversampling,
+                        m_settings.humidityOversampling,
+                        m_settings.filter);
+    }
+
+    m_ctrlMeas = static_cast<uint8_t>((m_settings.temperatureOversampling << 5) |
+                                      (m_settings.pressureOversampling << 2) |
+                                      BME280_MODE_FORCED);
+    m_conversionUs = bme280MeasurementTimeUs(m_settings.temperatureOversampling,
+                                             m_settings.pressureOversampling,
+                                             m_settings.humidityOversampling);
     return true;
 }
 
+bool Bme280Hal::readAll(Bme280Reading &out) {
+    if (!writeRegister(BME280_REG_CTRL_MEAS, m_ctrlMeas)) {
+        return false;
+    }
+
+    // Sleep through the conversion instead of polling the status register
+    vTaskDelay(pdMS_TO_TICKS((m_conversionUs + 999) / 1000) + 1);
+
+    uint8_t status = BME280_STATUS_MEASURING;
+    for (uint8_t i = 0; i < BME280_MEASURING_POLL_RETRIES; ++i) {
+        if (!readRegisters(BME280_REG_STATUS, &status, 1)) {
+            return false;
+        }
+        if (!(status & BME280_STATUS_MEASURING)) {
+            break;
+        }
+        delay(1);
+    }
+    if (status & BME280_STATUS_MEASURING) {
+        return false;
+    }
+
+    uint8_t burst[BME280_BURST_LENGTH];
+    if (!readRegisters(BME280_REG_DATA, burst, sizeof(burst))) {
+        return false;
+    }
+    return bme280Compensate(m_calib, burst, out);
+}
+
 float Bme280Hal::readTemperature() {
-    return bme.readTemperature();
+    Bme280Reading reading;
+    return readAll(reading) ? reading.temperature : NAN;
 }
 
 float Bme280Hal::readHumidity() {
-    return bme.readHumidity();
+    Bme280Reading reading;
+    return readAll(reading) ? reading.humidity : NAN;
 }
 
 float Bme280Hal::readAltitude() {
-    return bme.readAltitude(SEA_LEVEL_PRESSURE_HPA);
+    float pressure = readPressure();
+    return 44330.0f * (1.0f - powf(pressure / SEA_LEVEL_PRESSURE_HPA, 0.1903f));
 }
 
 float Bme280Hal::readPressure() {
-    return bme.readPressure() / 100.0f; // Convert to hPa
+    Bme280Reading reading;
+    return readAll(reading) ? reading.pressure : NAN; // Already in hPa
 }
+
+bool Bme280Hal::readRegisters(uint8_t reg, uint8_t *buffer, size_t length) {
+    I2cLease lease(I2cClient::Bme280, I2cPriority::High);
+    if (!lease.held()) {
+        return false;
+    }
+
+    TwoWire &wire = I2cBus::wire();
+    wire.beginTransmission(BME280_I2C_ADDRESS);
+    wire.write(reg);
+    if (wire.endTransmission(false) != 0) {
+        return false;
+    }
+    if (wire.requestFrom(static_cast<uint8_t>(BME280_I2C_ADDRESS), static_cast<uint8_t>(length)) != length) {
+        return false;
+    }
+    for (size_t i = 0; i < length; ++i) {
+        buffer[i] = wire.read();
+    }
+    return true;
+}
+
+bool Bme280Hal::writeRegister(uint8_t reg, uint8_t value) {
+    I2cLease lease(I2cClient::Bme280, I2cPriority::High);
+    if (!lease.held()) {
+        return false;
+    }
+
+    TwoWire &wire = I2cBus::wire();
+    wire.beginTransmission(BME280_I2C_ADDRESS);
+    wire.write(reg);
+    wire.write(value);
+    return wire.endTransmission() == 0;
+}
+
 } // namespace Drivers
 } // namespace PlantMonitor
\ No newline at end of file
@@ -2,18 +2,42 @@
 
 #include <Wire.h>
 #include <Adafruit_BME280.h>
+#include "bme280-compensation.h"
+#include "drivers/i2c/i2c-bus.h"
 /*!
  * \file temperature_sensor.h
  * \brief bme280 sensor hardware abstraction layer (HAL)
  *
  * This class provides high level apis to read temperature, air humidity, atmospheric pressure.
+ *
+ * The sensor runs in forced mode: each readAll() triggers one conversion, waits for
+ * it and fetches temperature, pressure and humidity with a single 8-byte burst read.
+ * Between measurements the sensor sleeps.
+ *
+ * Every transfer runs under a high-priority I2cBus lease; the bus is not held
+ * while the conversion is in progress.
  */
 #define SEA_LEVEL_PRESSURE_HPA (1023.25f) //!< Default sea level pressure in hPa
 #define BME280_I2C_ADDRESS (0x76u)        //!< Default I2C address for BME280
+#define BME280_MEASURING_POLL_RETRIES 5   //!< Status polls (1 ms apart) after the datasheet conversion time
 
 namespace PlantMonitor {
 namespace Drivers {
 
+/*!
+ * \struct Bme280Settings
+ * \brief Forced-mode acquisition settings
+ *
+ * The defaults follow the Bosch "weather monitoring" recommendation (x1 on every
+ * channel, IIR filter off), which is plenty for a 2 s plant monitor.
+ */
+struct Bme280Settings {
+    Adafruit_BME280::sensor_sampling temperatureOversampling = Adafruit_BME280::SAMPLING_X1; //!< Temperature oversampling
+    Adafruit_BME280::sensor_sampling pressureOversampling = Adafruit_BME280::SAMPLING_X1;    //!< Pressure oversampling (NONE skips it)
+    Adafruit_BME280::sensor_sampling humidityOversampling = Adafruit_BME280::SAMPLING_X1;    //!< Humidity oversampling
+    Adafruit_BME280::sensor_filter filter = Adafruit_BME280::FILTER_OFF;                     //!< IIR filter coefficient
+};
+
 /*!
  * \class Bme280Hal
  * \brief Read the air temperature, air humidity, atmospheric pressure and altidute, using bme280 sensor.
@@ -22,8 +46,9 @@ class Bme280Hal {
   public:
     /*!
     * \brief Constructor
+    * \param settings Oversampling and filter configuration
     */
-    explicit Bme280Hal();
+    explicit Bme280Hal(const Bme280Settings &settings = Bme280Settings());
 
     /*!
      * \brief Destructor
@@ -35,9 +60,17 @@ class Bme280Hal {
      */
     bool begin();
 
+    /*!
+     * \brief Take one forced-mode measurement of every channel
+     * \param[out] out Temperature (°C), humidity (%) and pressure (hPa)
+     * \return false if the sensor did not answer or the conversion timed out
+     */
+    bool readAll(Bme280Reading &out);
+
     /*!
      * \brief Take the bme280 air temperature measurement
      * \return Temperature in Celsius scale
+     * \note Triggers a full measurement; use readAll() when several channels are needed.
      */
     float readTemperature();
 
@@ -60,7 +93,23 @@ class Bme280Hal {
     float readHumidity();
 
   private:
-    Adafruit_BME280 bme; //!< BME280 sensor instance
+    /*!
+     * \brief Read consecutive registers (takes its own bus lease)
+     * \return true if all bytes were received
+     */
+    bool readRegisters(uint8_t reg, uint8_t *buffer, size_t length);
+
+    /*!
+     * \brief Write one register (takes its own bus lease)
+     * \return true on ACK
+     */
+    bool writeRegister(uint8_t reg, uint8_t value);
+
+    Adafruit_BME280 bme;         //!< BME280 sensor instance (reset, ID check, sampling setup)
+    Bme280Settings m_settings;   //!< Acquisition settings
+    Bme280Calibration m_calib;   //!< Trimming parameters read at begin()
+    uint8_t m_ctrlMeas;          //!< ctrl_meas value that starts a forced conversion
+    uint32_t m_conversionUs;     //!< Worst-case conversion time for m_settings
 };
 
 } // namespace Drivers
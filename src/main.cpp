@@ -4,7 +4,10 @@
 #include "tasks/sensor/sensor-task.h"
 #include "tasks/iot/iot-task.h"
 #include "tasks/display/display-task.h"
+#include "tasks/plant/plant-task.h"
 #include "utils/configuration/config.h"
+#include "drivers/i2c/i2c-bus.h"
+#include "utils/timer/timer-service.h"
 
 /*!
  * \file main.cpp
@@ -27,6 +30,14 @@ void setup() {
     Serial.println("  ESP32 IoT Monitoring System");
     Serial.println("=====================================");
 
+    // Shared by the display (core 0) and the BME280 (core 1): start it before either task
+    Drivers::I2cBus::begin(Config::I2C_FREQUENCY);
+
+    // Every task arms timers: create the service lock and tick timer before any of them runs
+    if (!Utils::TimerService::begin()) {
+        Serial.println("[MAIN] ERROR: Timer service unavailable");
+    }
+
     Tasks::startDisplayTask(
         Config::Tasks::DISPLAY_STACK_SIZE,
         Config::Tasks::DISPLAY_PRIORITY,
@@ -42,6 +53,11 @@ void setup() {
         Config::Tasks::SENSOR_PRIORITY,
         Config::Tasks::SENSOR_CORE);
 
+    Tasks::startPlantTask(
+        Config::Tasks::PLANT_STACK_SIZE,
+        Config::Tasks::PLANT_PRIORITY,
+        Config::Tasks::PLANT_CORE);
+
     Serial.println("[INIT] System ready\n");
 }
 
@@ -2,12 +2,14 @@
 
 #include "drivers/display/display-hal.h"
 #include "../sensor/sensor-task.h"
-#include "../plant/plant-state-machine.h"
+#include "../plant/plant-task.h"
 #include "drivers/sensors/button-sensor/button-sensor-hal.h"
 #include "utils/bitmap/bluetooth-icon.h"
 #include "utils/bitmap/plant-happy-icon.h"
 #include "utils/bitmap/plant-angry-icon.h"
 #include "utils/bitmap/plant-dying-icon.h"
+#include "utils/state-machine/state-machine.h"
+#include "utils/timer/timer-service.h"
 
 #include <freertos/FreeRTOS.h>
 #include <freertos/queue.h>
@@ -21,24 +23,30 @@ namespace Tasks {
 /*! \defgroup DisplayTiming Display Timing Configuration
  *  @{
  */
-#define UI_UPDATE_INTERVAL_MS 100   /*!< UI refresh interval in milliseconds */
+#define UI_IDLE_REFRESH_MS 1000     /*!< Periodic refresh tick (page timeout, config checks) */
+#define UI_BUTTON_POLL_MS 20        /*!< Wake-up period while a press is being tracked */
 #define UI_PAGE_TIMEOUT_MS 10000    /*!< Page timeout before returning to idle */
 #define FACTORY_RESET_HOLD_MS 10000 /*!< Button hold duration for factory reset (ms) */
 #define FACTORY_RESET_SHOW_MS 2500  /*!< Hold time before showing reset progress UI (ms) */
 /*! @} */
 
-static DisplayHAL *display_task_driver = nullptr;
-static UiState display_task_current_state = UiState::UI_STATE_BOOT;
+/*! \defgroup DisplayNotify Display Task Notification Bits
+ *  @{
+ */
+#define DISPLAY_NOTIFY_SENSOR_DATA (1u << 0) /*!< New sensor sample committed */
+#define DISPLAY_NOTIFY_BUTTON (1u << 1)      /*!< Button edge queued by the ISR */
+#define DISPLAY_NOTIFY_REFRESH (1u << 2)     /*!< Periodic refresh from TimerService */
+#define DISPLAY_NOTIFY_PLANT_STATE (1u << 3) /*!< Plant health state changed */
+/*! @} */
 
-static uint32_t display_task_last_ui_update = 0;
-static uint32_t display_task_last_interaction = 0;
+static DisplayHAL *display_task_driver = nullptr;
+static TaskHandle_t display_task_handle = nullptr;
+static Utils::TimerId display_task_refresh_timer = TIMER_WHEEL_INVALID_ID;
 
 static QueueHandle_t display_task_ui_event_queue = nullptr;
 
 PlantMonitor::Drivers::ButtonHal *display_task_button = nullptr;
 
-static bool display_task_plant_state_initialized = false;
-
 static bool display_task_button_held = false;        /*!< True while tracking a long press */
 static uint32_t display_task_button_press_start = 0; /*!< Timestamp of the first press edge */
 
@@ -51,6 +59,9 @@ static void IRAM_ATTR prv_on_boot_button_pressed() {
         uint8_t evt = 1;
         BaseType_t xHigherPriorityTaskWoken = pdFALSE;
         xQueueSendFromISR(display_task_ui_event_queue, &evt, &xHigherPriorityTaskWoken);
+        if (display_task_handle != nullptr) {
+            xTaskNotifyFromISR(display_task_handle, DISPLAY_NOTIFY_BUTTON, eSetBits, &xHigherPriorityTaskWoken);
+        }
         if (xHigherPriorityTaskWoken) {
             portYIELD_FROM_ISR();
         }
@@ -65,8 +76,8 @@ static void IRAM_ATTR prv_on_boot_button_pressed() {
  *  @{
  */
 #define HEADER_Y 8   // Header vertical position
-#define VALUE_Y 64   // Main value vertical position (centered)
-#define UNIT_Y 90    // Unit text vertical position
+#define VALUE_PAGE 8 // Main value top page (y = 64)
+#define UNIT_PAGE 11 // Unit text top page (y = 88)
 #define ICON_SIZE 32 // Icon/symbol size
 #define ICON_X 64    // Icon horizontal center position
 /*! @} */
@@ -79,7 +90,7 @@ static void prv_draw_header(const char *text) {
     display_task_driver->setTextSize(1);
     int16_t x = (128 - strlen(text) * 6) / 2; // Center text (6px per char)
     display_task_driver->setCursor(x, HEADER_Y);
-    display_task_driver->printf("%s", text);
+    display_task_driver->print(text);
 
     // Subtle divider line
     display_task_driver->drawLine(16, 24, 112, 24, COLOR_WHITE);
@@ -88,41 +99,25 @@ static void prv_draw_header(const char *text) {
 /*!
  * \brief Draw large centered value with unit
  * \param value Numeric value to display
- * \param unit Unit string (e.g., "°C", "%", "")
+ * \param unit Unit string (e.g., "C", "%", "")
  * \param decimals Number of decimal places
+ * \note Uses the pre-scaled glyphs: no printf and no per-pixel GFX plotting.
  */
 static void prv_draw_centered_value(float value, const char *unit, uint8_t decimals = 1) {
+    using ValueFont = Utils::GlyphFont<3>;
+    using UnitFont = Utils::GlyphFont<2>;
     char buffer[16];
 
-    // Format value
-    snprintf(buffer, sizeof(buffer), "%.*f", decimals, value);
-
     // Draw large value (centered)
-    display_task_driver->setTextSize(3);
-    int16_t valueWidth = strlen(buffer) * 18;
-    int16_t valueX = (128 - valueWidth) / 2;
-    display_task_driver->setCursor(valueX, VALUE_Y);
-    display_task_driver->printf("%s", buffer);
+    Utils::formatFixed(value, decimals, buffer, sizeof(buffer));
+    display_task_driver->drawGlyphText<3>((128 - ValueFont::textWidth(buffer)) / 2, VALUE_PAGE, buffer);
 
     if (unit && (unit[0] == 'C' || unit[0] == 'F')) {
-        // Calculate width of "°C" (circle + letter)
-        int16_t unitTotalWidth = 6 + 12; // circle(6px space) + C(12px)
-        int16_t unitStartX = (128 - unitTotalWidth) / 2;
-
-        int16_t degX = unitStartX + 3;
-        int16_t degY = UNIT_Y + 4;
-        display_task_driver->drawCircle(degX, degY, 3, COLOR_WHITE);
-
-        display_task_driver->setTextSize(2);
-        display_task_driver->setCursor(unitStartX + 8, UNIT_Y);
-        display_task_driver->printf("%c", unit[0]);
+        const char degrees[] = { GLYPH_FONT_DEGREE, unit[0], '\0' };
+        display_task_driver->drawGlyphText<2>((128 - UnitFont::textWidth(degrees)) / 2, UNIT_PAGE, degrees);
     } else if (unit && strlen(unit) > 0) {
         // Normal unit
-        display_task_driver->setTextSize(2);
-        int16_t unitWidth = strlen(unit) * 12;
-        int16_t unitX = (128 - unitWidth) / 2;
-        display_task_driver->setCursor(unitX, UNIT_Y);
-        display_task_driver->printf("%s", unit);
+        display_task_driver->drawGlyphText<2>((128 - UnitFont::textWidth(unit)) / 2, UNIT_PAGE, unit);
     }
 }
 
@@ -296,13 +291,13 @@ static void prv_draw_factory_reset_progress(uint8_t progress) {
     display_task_driver->setTextSize(1);
     int16_t x = (128 - strlen(title) * 6) / 2;
     display_task_driver->setCursor(x, 20);
-    display_task_driver->printf("%s", title);
+    display_task_driver->print(title);
 
     // Subtitle
     const char *subtitle = "Hold button...";
     x = (128 - strlen(subtitle) * 6) / 2;
     display_task_driver->setCursor(x, 36);
-    display_task_driver->printf("%s", subtitle);
+    display_task_driver->print(subtitle);
 
     // Progress bar outline
     const int16_t barX = 14;
@@ -323,14 +318,14 @@ static void prv_draw_factory_reset_progress(uint8_t progress) {
     display_task_driver->setTextSize(2);
     int16_t pctW = strlen(pctBuf) * 12;
     display_task_driver->setCursor((128 - pctW) / 2, 84);
-    display_task_driver->printf("%s", pctBuf);
+    display_task_driver->print(pctBuf);
 
     // Warning
     const char *warn = "Release to cancel";
     display_task_driver->setTextSize(1);
     x = (128 - strlen(warn) * 6) / 2;
     display_task_driver->setCursor(x, 110);
-    display_task_driver->printf("%s", warn);
+    display_task_driver->print(warn);
 
     display_task_driver->update();
 }
@@ -347,7 +342,7 @@ static void prv_factory_reset() {
     display_task_driver->setTextSize(1);
     int16_t x = (128 - strlen(msg) * 6) / 2;
     display_task_driver->setCursor(x, 56);
-    display_task_driver->printf("%s", msg);
+    display_task_driver->print(msg);
     display_task_driver->update();
 
     // Clear stored configuration from NVS
@@ -361,26 +356,64 @@ static void prv_factory_reset() {
     ESP.restart();
 }
 
+// ============================================================================
+// UI FSM
+// ============================================================================
+
 /*!
- * \brief Get the next UI state in the FSM sequence
- * \param state Current UI state
- * \return Next UI state
+ * \brief UI FSM events
  */
-static UiState prv_next_state(UiState state) {
-    switch (state) {
-        case UiState::UI_STATE_FACE_IDLE:
-            return UiState::UI_STATE_PAGE_TEMPERATURE;
-        case UiState::UI_STATE_PAGE_TEMPERATURE:
-            return UiState::UI_STATE_PAGE_HUMIDITY;
-        case UiState::UI_STATE_PAGE_HUMIDITY:
-            return UiState::UI_STATE_PAGE_MOISTURE;
-        case UiState::UI_STATE_PAGE_MOISTURE:
-            return UiState::UI_STATE_FACE_IDLE;
-        default:
-            return UiState::UI_STATE_FACE_IDLE;
-    }
+enum class UiEvent : uint8_t {
+    UI_EVENT_BUTTON,      /*!< Short press released */
+    UI_EVENT_PAGE_TIMEOUT /*!< No interaction for UI_PAGE_TIMEOUT_MS */
+};
+
+/*!
+ * \brief Data seen by the UI FSM guards
+ */
+struct UiFsmContext {
+    bool configured; /*!< Device has a stored configuration */
+};
+
+static bool prv_guard_configured(UiFsmContext &ctx) {
+    return ctx.configured;
 }
 
+/*!
+ * \brief UI FSM definition: the button cycles the pages, a timeout returns to the face
+ */
+struct UiFsm {
+    using State = UiState;
+    using Event = UiEvent;
+    using Context = UiFsmContext;
+    static constexpr size_t kStateCount = 6;
+    static constexpr size_t kEventCount = 2;
+    static constexpr Utils::HsmState<State, Context> states[kStateCount] = {
+        { UiState::UI_STATE_BOOT, UiState::UI_STATE_BOOT, "BOOT", nullptr, nullptr },
+        { UiState::UI_STATE_PAIRING, UiState::UI_STATE_PAIRING, "PAIRING", nullptr, nullptr },
+        { UiState::UI_STATE_FACE_IDLE, UiState::UI_STATE_FACE_IDLE, "FACE", nullptr, nullptr },
+        { UiState::UI_STATE_PAGE_TEMPERATURE, UiState::UI_STATE_PAGE_TEMPERATURE, "TEMPERATURE", nullptr, nullptr },
+        { UiState::UI_STATE_PAGE_HUMIDITY, UiState::UI_STATE_PAGE_HUMIDITY, "HUMIDITY", nullptr, nullptr },
+        { UiState::UI_STATE_PAGE_MOISTURE, UiState::UI_STATE_PAGE_MOISTURE, "MOISTURE", nullptr, nullptr },
+    };
+    static constexpr const char *events[kEventCount] = { "BUTTON", "PAGE_TIMEOUT" };
+    static constexpr Utils::HsmTransition<State, Event, Context> transitions[] = {
+        { UiState::UI_STATE_BOOT, UiEvent::UI_EVENT_BUTTON, UiState::UI_STATE_FACE_IDLE, nullptr, nullptr },
+        { UiState::UI_STATE_FACE_IDLE, UiEvent::UI_EVENT_BUTTON, UiState::UI_STATE_PAGE_TEMPERATURE, nullptr, nullptr },
+        { UiState::UI_STATE_PAGE_TEMPERATURE, UiEvent::UI_EVENT_BUTTON, UiState::UI_STATE_PAGE_HUMIDITY, nullptr, nullptr },
+        { UiState::UI_STATE_PAGE_HUMIDITY, UiEvent::UI_EVENT_BUTTON, UiState::UI_STATE_PAGE_MOISTURE, nullptr, nullptr },
+        { UiState::UI_STATE_PAGE_MOISTURE, UiEvent::UI_EVENT_BUTTON, UiState::UI_STATE_FACE_IDLE, nullptr, nullptr },
+        { UiState::UI_STATE_BOOT, UiEvent::UI_EVENT_PAGE_TIMEOUT, UiState::UI_STATE_FACE_IDLE, &prv_guard_configured, nullptr },
+        { UiState::UI_STATE_PAIRING, UiEvent::UI_EVENT_PAGE_TIMEOUT, UiState::UI_STATE_FACE_IDLE, &prv_guard_configured, nullptr },
+        { UiState::UI_STATE_PAGE_TEMPERATURE, UiEvent::UI_EVENT_PAGE_TIMEOUT, UiState::UI_STATE_FACE_IDLE, &prv_guard_configured, nullptr },
+        { UiState::UI_STATE_PAGE_HUMIDITY, UiEvent::UI_EVENT_PAGE_TIMEOUT, UiState::UI_STATE_FACE_IDLE, &prv_guard_configured, nullptr },
+        { UiState::UI_STATE_PAGE_MOISTURE, UiEvent::UI_EVENT_PAGE_TIMEOUT, UiState::UI_STATE_FACE_IDLE, &prv_guard_configured, nullptr },
+    };
+};
+
+static UiFsmContext display_task_ui_context = { false };
+static Utils::StateMachine<UiFsm> display_task_ui(display_task_ui_context);
+
 /*!
  * \brief Main display task function
  * \param pvParameters Task parameters (unused)
@@ -394,34 +427,30 @@ static void prv_display_task(void *) {
 
     display_task_driver->setTextSize(1);
     display_task_driver->setTextColor(COLOR_WHITE);
-    display_task_last_interaction = millis();
 
     display_task_ui_event_queue = xQueueCreate(5, sizeof(uint8_t));
+    display_task_handle = xTaskGetCurrentTaskHandle();
+    subscribeSensorData(display_task_handle, DISPLAY_NOTIFY_SENSOR_DATA);
+    subscribePlantState(display_task_handle, DISPLAY_NOTIFY_PLANT_STATE);
+    display_task_refresh_timer = Utils::TimerService::startNotify(display_task_handle, DISPLAY_NOTIFY_REFRESH,
+                                                                  UI_IDLE_REFRESH_MS, UI_IDLE_REFRESH_MS);
 
     display_task_button = new PlantMonitor::Drivers::ButtonHal(SWITCH_PIN, BUTTON_INPUT_PULLUP, prv_on_boot_button_pressed);
 
     // Set initial state based on configuration
-    if (!ConfigHandler::isConfigured()) {
-        display_task_current_state = UiState::UI_STATE_PAIRING;
-    }
+    display_task_ui_context.configured = ConfigHandler::isConfigured();
+    display_task_ui.start(display_task_ui_context.configured ? UiState::UI_STATE_BOOT : UiState::UI_STATE_PAIRING,
+                          millis());
 
     uint8_t evt;
-    SensorData data;
+    SensorData data = {};
+    uint32_t dataSequence = 0;
+    uint32_t notified = 0;
+    UiState drawnState = UiState::UI_STATE_BOOT;
 
     while (true) {
         uint32_t now = millis();
-
-        // Initialize plant state machine once device is configured
-        if (ConfigHandler::isConfigured() && !display_task_plant_state_initialized) {
-            initPlantStateMachine(); // Uses default timeout from plant-config.h
-            display_task_plant_state_initialized = true;
-            Serial.println("[DISPLAY] Plant state machine initialized");
-        }
-
-        // Update plant state machine only if initialized
-        if (display_task_plant_state_initialized) {
-            updatePlantState();
-        }
+        display_task_ui_context.configured = ConfigHandler::isConfigured();
 
         // ----------------------------------------------------------------
         // Button handling: short press (page cycle) + long press (reset)
@@ -431,7 +460,7 @@ static void prv_display_task(void *) {
             if (display_task_button->debouncing() && !display_task_button_held) {
                 // FALLING edge detected: start tracking the long press
                 // (only allow factory reset when the device is already configured)
-                if (display_task_current_state != UiState::UI_STATE_PAIRING) {
+                if (display_task_ui.state() != UiState::UI_STATE_PAIRING) {
                     display_task_button_held = true;
                     display_task_button_press_start = now;
                 } else {
@@ -457,30 +486,33 @@ static void prv_display_task(void *) {
             } else if (!stillPressed) {
                 // Button released: treat as short press (page cycle)
                 display_task_button_held = false;
-                display_task_current_state = prv_next_state(display_task_current_state);
-                display_task_last_interaction = now;
+                display_task_ui.dispatch(UiEvent::UI_EVENT_BUTTON, now);
             }
         }
 
         // ----------------------------------------------------------------
         // Page timeout: return to idle face after inactivity
+        // (every press changes page, so time in state is time since the last press)
         // ----------------------------------------------------------------
 
-        if (!display_task_button_held &&
-            display_task_current_state != UiState::UI_STATE_FACE_IDLE &&
-            now - display_task_last_interaction > UI_PAGE_TIMEOUT_MS && ConfigHandler::isConfigured()) {
-            display_task_current_state = UiState::UI_STATE_FACE_IDLE;
+        if (!display_task_button_held && display_task_ui.timeInCurrent(now) > UI_PAGE_TIMEOUT_MS) {
+            display_task_ui.dispatch(UiEvent::UI_EVENT_PAGE_TIMEOUT, now);
         }
 
         // ----------------------------------------------------------------
         // UI rendering (skipped while showing reset progress)
         // ----------------------------------------------------------------
 
-        if (!display_task_button_held && now - display_task_last_ui_update >= UI_UPDATE_INTERVAL_MS) {
-            display_task_last_ui_update = now;
-            getLatestSensorData(data);
+        UiState uiState = display_task_ui.state();
+        bool redraw = notified != 0 || uiState != drawnState;
+
+        if (!display_task_button_held && redraw) {
+            drawnState = uiState;
+            if (getSensorDataSequence() != dataSequence) {
+                getLatestSensorData(data, dataSequence);
+            }
 
-            switch (display_task_current_state) {
+            switch (uiState) {
                 case UiState::UI_STATE_PAIRING:
                     prv_draw_bluetooth_icon();
                     break;
@@ -514,7 +546,16 @@ static void prv_display_task(void *) {
             }
         }
 
-        vTaskDelay(pdMS_TO_TICKS(20));
+        // Block until new data, a plant state change, a button edge or the refresh tick; poll only while a press is tracked
+        TickType_t wait = portMAX_DELAY;
+        if (display_task_button_held) {
+            wait = pdMS_TO_TICKS(UI_BUTTON_POLL_MS);
+        } else if (display_task_refresh_timer == TIMER_WHEEL_INVALID_ID) {
+            wait = pdMS_TO_TICKS(UI_IDLE_REFRESH_MS); // No timer service: fall back to a timed wait
+        }
+        if (xTaskNotifyWait(0, UINT32_MAX, &notified, wait) != pdTRUE) {
+            notified = 0;
+        }
     }
 }
 
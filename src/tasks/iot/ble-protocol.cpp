@@ -63,7 +63,7 @@ void BleProtocolHandler::sendInfo(int deviceId) {
     AppConfig cfg;
     if (ConfigHandler::load(cfg)) {
         doc["wifi_ssid"] = cfg.ssid.c_str();
-        if (!cfg.params.empty()) {
+        if (hasConfigParam(cfg, ParamIndex::PlantTypeId)) {
             doc["plant_type"] = static_cast<int>(getConfigParam(cfg, ParamIndex::PlantTypeId));
         }
     }
@@ -129,11 +129,25 @@ bool BleProtocolHandler::parseConfigFromJson(JsonDocument &doc, AppConfig &cfg)
     cfg.ssid = doc["ssid"].as<const char *>();
     cfg.password = doc["pass"].as<const char *>();
     cfg.params.clear();
-
-    if (doc["params"].is<JsonArray>()) {
+    cfg.paramMask = 0;
+
+    if (doc["params"].is<JsonObject>()) {
+        // Keyed: store only what was sent
+        for (JsonPair kv : doc["params"].as<JsonObject>()) {
+            size_t index = 0;
+            while (index < PARAM_COUNT && strcmp(kv.key().c_str(), PARAM_KEYS[index]) != 0) {
+                index++;
+            }
+            if (index == PARAM_COUNT || !kv.value().is<float>()) {
+                return false;
+            }
+            ConfigHandler::setParam(cfg, index, kv.value().as<float>());
+        }
+    } else if (doc["params"].is<JsonArray>()) {
         JsonArray params = doc["params"].as<JsonArray>();
         for (JsonVariant v : params) {
-            cfg.params.push_back(v.as<float>());
+            // as<float>() reads null as 0, which would override a threshold with 0
+            cfg.params.push_back(v.isNull() ? NAN : v.as<float>());
         }
     }
 
@@ -148,7 +162,7 @@ BleProtocolHandler::CommandResult BleProtocolHandler::handleCommand(
     const char *data, int currentDeviceId) {
 
     CommandResult result;
-    result.nextState = IoTState::BleConfiguring;
+    result.event = IoTEvent::None;
     result.hasConfig = false;
     result.pendingCmd = "";
 
@@ -190,7 +204,7 @@ BleProtocolHandler::CommandResult BleProtocolHandler::handleCommand(
             sendStatus("saving_config");
             sendStatus("connecting_wifi", 0);
 
-            result.nextState = IoTState::BleTestingWifi;
+            result.event = IoTEvent::WifiTestRequested;
             result.hasConfig = true;
             result.config = cfg;
             result.pendingCmd = "config";
@@ -206,7 +220,7 @@ BleProtocolHandler::CommandResult BleProtocolHandler::handleCommand(
         if (doc["ssid"].is<const char *>() && doc["pass"].is<const char *>()) {
             sendAck("test_wifi");
 
-            result.nextState = IoTState::BleTestingWifi;
+            result.event = IoTEvent::WifiTestRequested;
             result.hasConfig = false;
             result.config.ssid = doc["ssid"].as<const char *>();
             result.config.password = doc["pass"].as<const char *>();
@@ -224,7 +238,7 @@ BleProtocolHandler::CommandResult BleProtocolHandler::handleCommand(
         sendAck("reset");
         ConfigHandler::clear();
         sendResult("reset", true);
-        result.nextState = IoTState::BleAdvertising;
+        result.event = IoTEvent::ConfigReset;
         return result;
     }
 
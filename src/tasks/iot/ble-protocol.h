@@ -31,7 +31,7 @@ namespace Tasks {
  * - ping: Returns device info (fw_version, hw_version, configured)
  * - get_info: Returns detailed device configuration
  * - wifi_scan: Scans and returns available WiFi networks
- * - config: Saves WiFi and plant configuration
+ * - config: Saves WiFi and plant configuration (see parseConfigFromJson())
  * - test_wifi: Tests WiFi credentials without saving
  * - reset: Clears all stored configuration
  */
@@ -41,10 +41,10 @@ class BleProtocolHandler {
      * \brief Result of command processing
      */
     struct CommandResult {
-        IoTState nextState; //!< Next FSM state to transition to
-        bool hasConfig;     //!< True if config was parsed
-        AppConfig config;   //!< Parsed configuration (if hasConfig)
-        String pendingCmd;  //!< Command name for pending operations
+        IoTEvent event;    //!< FSM event raised by the command (None to stay)
+        bool hasConfig;    //!< True if config was parsed
+        AppConfig config;  //!< Parsed configuration (if hasConfig)
+        String pendingCmd; //!< Command name for pending operations
     };
 
     /*!
@@ -122,9 +122,21 @@ class BleProtocolHandler {
 
     /*!
      * \brief Parse configuration from JSON document
+     *
+     * "params" is either an object keyed by PARAM_KEYS, stored sparse (only
+     * the keys sent, e.g. a plant type and a device id, with every threshold
+     * taken from the plant profile):
+     * \code
+     * {"cmd":"config","ssid":"Net","pass":"pw","params":{"plant_type":3,"device_id":7,"temp_min":12}}
+     * \endcode
+     * or the legacy array in ParamIndex order, where null skips an entry:
+     * \code
+     * {"cmd":"config","ssid":"Net","pass":"pw","params":[3,null,null,null,null,null,null,null,7]}
+     * \endcode
+     *
      * \param doc JSON document containing config
      * \param cfg Output configuration structure
-     * \return true if parsing succeeded
+     * \return true if parsing succeeded (false on an unknown or non-numeric key)
      */
     static bool parseConfigFromJson(JsonDocument &doc, AppConfig &cfg);
 
@@ -14,6 +14,7 @@
 #include <Arduino.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/queue.h>
+#include <cmath>
 #include "../sensor/sensor-task.h"
 #include "utils/configuration/config.h"
 #include "../plant/plant-config.h"
@@ -69,7 +70,12 @@ constexpr const char *IOT_HW_VERSION = "ESP32"; //!< Hardware version
 
 /*!
  * \enum ParamIndex
- * \brief Indices for configuration parameters array
+ * \brief Logical indices of the configuration parameters
+ *
+ * Legacy configurations store params densely in this order. Keyed ones (BLE
+ * "params" object, see PARAM_KEYS) are sparse: only the parameters sent are
+ * stored, with AppConfig::paramMask recording which. Either way, read them
+ * with getConfigParam() / hasConfigParam().
  */
 enum class ParamIndex : uint8_t {
     PlantTypeId = 0,   //!< Plant type identifier
@@ -79,10 +85,27 @@ enum class ParamIndex : uint8_t {
     HumidityMax = 4,   //!< Maximum humidity threshold
     MoistureMin = 5,   //!< Minimum soil moisture threshold
     MoistureMax = 6,   //!< Maximum soil moisture threshold
-    LightHoursMin = 7, //!< Minimum light hours required
+    LightHoursMin = 7, //!< Minimum light hours required (see LIGHT_HOURS_TO_INTEGRAL)
     DeviceId = 8,      //!< Device identifier
 };
 
+constexpr size_t PARAM_COUNT = 9; //!< Number of ParamIndex values
+
+/*!
+ * \brief BLE keys of the parameters, indexed by ParamIndex
+ */
+constexpr const char *PARAM_KEYS[PARAM_COUNT] = {
+    "plant_type",      // PlantTypeId
+    "temp_min",        // TempMin
+    "temp_max",        // TempMax
+    "humidity_min",    // HumidityMin
+    "humidity_max",    // HumidityMax
+    "moisture_min",    // MoistureMin
+    "moisture_max",    // MoistureMax
+    "light_hours_min", // LightHoursMin
+    "device_id",       // DeviceId
+};
+
 // ============================================================================
 // FSM STATE
 // ============================================================================
@@ -101,6 +124,26 @@ enum class IoTState {
     Error           //!< Error state - recovery pending
 };
 
+/*!
+ * \enum IoTEvent
+ * \brief Events reported by the IoT state handlers (see the transition table in iot-task.cpp)
+ */
+enum class IoTEvent {
+    None,              //!< Nothing happened - stay in the current state
+    NotConfigured,     //!< No stored configuration at boot
+    Configured,        //!< Stored configuration found at boot
+    BleConnected,      //!< BLE client connected
+    BleDisconnected,   //!< BLE client disconnected
+    WifiTestRequested, //!< config or test_wifi command accepted
+    ConfigReset,       //!< reset command cleared the configuration
+    WifiTestDone,      //!< WiFi test finished without new configuration to apply
+    ConfigCommitted,   //!< WiFi test passed and the configuration was saved
+    ConfigLost,        //!< Stored configuration unreadable, back to provisioning
+    WifiConnected,     //!< Station connected to the access point
+    LinkLost,          //!< WiFi or MQTT link lost
+    Recovered          //!< Error recovery finished
+};
+
 // ============================================================================
 // BLE MESSAGE
 // ============================================================================
@@ -130,14 +173,13 @@ struct BleMessage {
  * Contains all state information needed across FSM iterations.
  */
 struct IoTContext {
-    IoTState currentState;       //!< Current FSM state
     int deviceId;                //!< Device identifier from config
-    uint32_t lastMqttPublish;    //!< Timestamp of last MQTT publish
     uint32_t wifiConnectStart;   //!< Timestamp when WiFi connection started
     uint32_t mqttInitRetries;    //!< MQTT initialization retry counter
     uint32_t configLoadFailures; //!< Config load failure counter
     QueueHandle_t bleQueue;      //!< Queue for BLE messages
     bool firstMqttPublish;       //!< True if first MQTT publish after connection
+    bool publishDue;             //!< Publish timer fired while the FSM was sleeping
     bool ntpConfigured;          //!< True if NTP has been configured
 
     // Pending configuration during WiFi test
@@ -156,44 +198,29 @@ struct IoTContext {
 // ============================================================================
 
 /*!
- * \brief Converts an IoTState enum value to its string representation
- * \param state The state to convert
- * \return String representation of the state
+ * \brief Checks whether a configuration parameter was set
+ * \param cfg The application configuration
+ * \param index The parameter index
+ * \return true if present and not NaN (NaN marks a skipped dense entry)
  */
-inline const char *iotStateToString(IoTState state) {
-    switch (state) {
-        case IoTState::Boot:
-            return "BOOT";
-        case IoTState::BleAdvertising:
-            return "BLE_ADV";
-        case IoTState::BleConfiguring:
-            return "BLE_CFG";
-        case IoTState::BleTestingWifi:
-            return "BLE_TEST_WIFI";
-        case IoTState::WifiConnecting:
-            return "WIFI_CONN";
-        case IoTState::MqttOperating:
-            return "MQTT_OP";
-        case IoTState::Error:
-            return "ERROR";
-        default:
-            return "UNKNOWN";
-    }
+inline bool hasConfigParam(const AppConfig &cfg, ParamIndex index) {
+    float value = 0.0f;
+    return ConfigHandler::findParam(cfg, static_cast<size_t>(index), value) && !std::isnan(value);
 }
 
 /*!
  * \brief Gets a configuration parameter with a default fallback value
  * \param cfg The application configuration
  * \param index The parameter index
- * \param defaultVal Default value if index out of bounds
+ * \param defaultVal Default value if the parameter was not set
  * \return The parameter value or default
  */
 inline float getConfigParam(const AppConfig &cfg, ParamIndex index, float defaultVal = 0.0f) {
-    size_t idx = static_cast<size_t>(index);
-    if (idx < cfg.params.size()) {
-        return cfg.params[idx];
+    float value = defaultVal;
+    if (!ConfigHandler::findParam(cfg, static_cast<size_t>(index), value) || std::isnan(value)) {
+        return defaultVal;
     }
-    return defaultVal;
+    return value;
 }
 
 /*!
@@ -15,7 +15,10 @@
 #include "drivers/bluetooth/bluetooth-hal.h"
 #include "drivers/wifi/wifi-hal.h"
 #include "iot/hivemq-ca.h"
+#include "tasks/plant/plant-state-machine.h"
 #include "utils/configuration/private-data.h"
+#include "utils/state-machine/state-machine.h"
+#include "utils/timer/periodic-timer.h"
 
 using namespace PlantMonitor::Drivers;
 
@@ -31,11 +34,12 @@ namespace Tasks {
  * @{
  */
 
-static IoTContext s_ctx;                            //!< FSM context
-static BleUartHal *s_ble = nullptr;                 //!< BLE UART controller
-static BleProtocolHandler *s_bleProtocol = nullptr; //!< BLE protocol handler
-static WiFiHal *s_wifi = nullptr;                   //!< WiFi manager
-static MqttTelemetryPublisher *s_mqtt = nullptr;    //!< MQTT telemetry publisher
+static IoTContext s_ctx;                                   //!< FSM context
+static BleUartHal *s_ble = nullptr;                        //!< BLE UART controller
+static BleProtocolHandler *s_bleProtocol = nullptr;        //!< BLE protocol handler
+static WiFiHal *s_wifi = nullptr;                          //!< WiFi manager
+static MqttTelemetryPublisher *s_mqtt = nullptr;           //!< MQTT telemetry publisher
+static Utils::PeriodicSendTimer *s_publishTimer = nullptr; //!< MQTT publish interval
 
 /*! @} */
 
@@ -65,14 +69,14 @@ static void prv_on_ble_data(const BleUartHal::Bytes &data) {
 /*!
  * \brief Handle BOOT state
  */
-static IoTState prv_handle_boot() {
+static IoTEvent prv_handle_boot() {
     Serial.println("[FSM] Checking configuration...");
 
     if (!ConfigHandler::isConfigured()) {
         Serial.println("[FSM] Not configured, starting BLE advertising");
         if (s_ble)
             s_ble->startAdvertising_();
-        return IoTState::BleAdvertising;
+        return IoTEvent::NotConfigured;
     }
 
     AppConfig cfg;
@@ -82,28 +86,28 @@ static IoTState prv_handle_boot() {
     }
 
     Serial.println("[FSM] Already configured, connecting to WiFi");
-    return IoTState::WifiConnecting;
+    return IoTEvent::Configured;
 }
 
 /*!
  * \brief Handle BLE_ADVERTISING state
  */
-static IoTState prv_handle_ble_advertising() {
+static IoTEvent prv_handle_ble_advertising() {
     if (s_ble->isConnected()) {
         Serial.println("[BLE] Client connected");
-        return IoTState::BleConfiguring;
+        return IoTEvent::BleConnected;
     }
-    return IoTState::BleAdvertising;
+    return IoTEvent::None;
 }
 
 /*!
  * \brief Handle BLE_CONFIGURING state
  */
-static IoTState prv_handle_ble_configuring() {
+static IoTEvent prv_handle_ble_configuring() {
     if (!s_ble->isConnected()) {
         Serial.println("[BLE] Client disconnected");
         s_ble->startAdvertising_();
-        return IoTState::BleAdvertising;
+        return IoTEvent::BleDisconnected;
     }
 
     BleMessage msg;
@@ -122,16 +126,16 @@ static IoTState prv_handle_ble_configuring() {
         }
         s_ctx.pendingCmd = result.pendingCmd;
 
-        return result.nextState;
+        return result.event;
     }
 
-    return IoTState::BleConfiguring;
+    return IoTEvent::None;
 }
 
 /*!
  * \brief Handle BLE_TESTING_WIFI state
  */
-static IoTState prv_handle_ble_testing_wifi() {
+static IoTEvent prv_handle_ble_testing_wifi() {
     // Initialize test
     if (s_ctx.testWifi == nullptr) {
         s_ctx.wifiTestStart = millis();
@@ -185,13 +189,13 @@ static IoTState prv_handle_ble_testing_wifi() {
             s_ble = nullptr;
 
             s_ctx.hasPendingConfig = false;
-            return IoTState::WifiConnecting;
+            return IoTEvent::ConfigCommitted;
         }
 
         // Just a test - return to configuring
         vTaskDelay(pdMS_TO_TICKS(500));
         WiFi.disconnect();
-        return IoTState::BleConfiguring;
+        return IoTEvent::WifiTestDone;
     }
 
     // Check timeout
@@ -209,16 +213,16 @@ static IoTState prv_handle_ble_testing_wifi() {
             s_ctx.hasPendingConfig = false;
         }
 
-        return IoTState::BleConfiguring;
+        return IoTEvent::WifiTestDone;
     }
 
-    return IoTState::BleTestingWifi;
+    return IoTEvent::None;
 }
 
 /*!
  * \brief Handle WIFI_CONNECTING state
  */
-static IoTState prv_handle_wifi_connecting() {
+static IoTEvent prv_handle_wifi_connecting() {
     AppConfig cfg;
 
     if (!ConfigHandler::load(cfg)) {
@@ -240,11 +244,11 @@ static IoTState prv_handle_wifi_connecting() {
                 s_bleProtocol = new BleProtocolHandler(s_ble);
             }
             s_ble->startAdvertising_();
-            return IoTState::BleAdvertising;
+            return IoTEvent::ConfigLost;
         }
 
         vTaskDelay(pdMS_TO_TICKS(IOT_RECONNECT_DELAY_MS));
-        return IoTState::WifiConnecting;
+        return IoTEvent::None;
     }
 
     s_ctx.configLoadFailures = 0;
@@ -273,19 +277,19 @@ static IoTState prv_handle_wifi_connecting() {
         }
 
         s_ctx.wifiConnectStart = 0;
-        return IoTState::MqttOperating;
+        return IoTEvent::WifiConnected;
     }
 
     s_wifi->begin();
     vTaskDelay(pdMS_TO_TICKS(5000));
 
-    return IoTState::WifiConnecting;
+    return IoTEvent::None;
 }
 
 /*!
  * \brief Handle MQTT_OPERATING state
  */
-static IoTState prv_handle_mqtt_operating() {
+static IoTEvent prv_handle_mqtt_operating() {
     // Check WiFi connection
     if (s_wifi && !s_wifi->isConnected()) {
         Serial.println("[WIFI] Connection lost");
@@ -300,7 +304,7 @@ static IoTState prv_handle_mqtt_operating() {
         // Reset NTP flag so it will be reconfigured on reconnect
         s_ctx.ntpConfigured = false;
 
-        return IoTState::WifiConnecting;
+        return IoTEvent::LinkLost;
     }
 
     // Initialize MQTT if needed
@@ -322,14 +326,14 @@ static IoTState prv_handle_mqtt_operating() {
                 delete s_mqtt;
                 s_mqtt = nullptr;
 
-                return IoTState::WifiConnecting;
+                return IoTEvent::LinkLost;
             }
 
             Serial.printf("[MQTT] Init failed, retry %lu/%lu\n",
                           s_ctx.mqttInitRetries,
                           IOT_MAX_MQTT_INIT_RETRIES);
             vTaskDelay(pdMS_TO_TICKS(IOT_RECONNECT_DELAY_MS));
-            return IoTState::MqttOperating;
+            return IoTEvent::None;
         }
 
         s_ctx.mqttInitRetries = 0;
@@ -340,33 +344,109 @@ static IoTState prv_handle_mqtt_operating() {
     s_mqtt->poll();
 
     // Publish telemetry: immediately after connection, then periodically
-    uint32_t now = millis();
-    bool shouldPublish = s_ctx.firstMqttPublish ||
-                         (now - s_ctx.lastMqttPublish >= IOT_MQTT_PUB_INTERVAL_MS);
+    bool shouldPublish = s_ctx.firstMqttPublish || s_ctx.publishDue || (s_publishTimer && s_publishTimer->take());
 
     if (shouldPublish) {
-        s_ctx.lastMqttPublish = now;
+        s_ctx.publishDue = false;
+        if (s_ctx.firstMqttPublish && s_publishTimer) {
+            s_publishTimer->begin(IOT_MQTT_PUB_INTERVAL_MS); // Count the interval from this publish
+        }
         s_ctx.firstMqttPublish = false;
 
         SensorData data;
         if (getLatestSensorData(data)) {
-            s_mqtt->publishTelemetry(s_ctx.deviceId, data);
+            // Everything sampled since the previous publish, not just the latest reading
+            SensorStatistics stats;
+            bool haveStats = drainSensorStatistics(stats);
+            s_mqtt->publishTelemetry(s_ctx.deviceId, data, haveStats ? &stats : nullptr, getDailyLightIntegral());
             Serial.println("[MQTT] Telemetry published");
         } else {
             Serial.println("[MQTT] Sensor data unavailable");
         }
     }
 
-    return IoTState::MqttOperating;
+    return IoTEvent::None;
 }
 
 /*!
  * \brief Handle ERROR state
  */
-static IoTState prv_handle_error() {
+static IoTEvent prv_handle_error() {
     Serial.println("[FSM] Error state - attempting recovery");
     vTaskDelay(pdMS_TO_TICKS(5000));
-    return IoTState::Boot;
+    return IoTEvent::Recovered;
+}
+
+// ============================================================================
+// FSM DEFINITION
+// ============================================================================
+
+/*!
+ * \brief IoT FSM definition: handlers report events, the table picks the next state
+ */
+struct IoTFsm {
+    using State = IoTState;
+    using Event = IoTEvent;
+    using Context = IoTContext;
+    static constexpr size_t kStateCount = 7;
+    static constexpr size_t kEventCount = 13;
+    static constexpr Utils::HsmState<State, Context> states[kStateCount] = {
+        { IoTState::Boot, IoTState::Boot, "BOOT", nullptr, nullptr },
+        { IoTState::BleAdvertising, IoTState::BleAdvertising, "BLE_ADV", nullptr, nullptr },
+        { IoTState::BleConfiguring, IoTState::BleConfiguring, "BLE_CFG", nullptr, nullptr },
+        { IoTState::BleTestingWifi, IoTState::BleTestingWifi, "BLE_TEST_WIFI", nullptr, nullptr },
+        { IoTState::WifiConnecting, IoTState::WifiConnecting, "WIFI_CONN", nullptr, nullptr },
+        { IoTState::MqttOperating, IoTState::MqttOperating, "MQTT_OP", nullptr, nullptr },
+        { IoTState::Error, IoTState::Error, "ERROR", nullptr, nullptr },
+    };
+    static constexpr const char *events[kEventCount] = {
+        "none", "not_configured", "configured", "ble_connected", "ble_disconnected",
+        "wifi_test_requested", "config_reset", "wifi_test_done", "config_committed",
+        "config_lost", "wifi_connected", "link_lost", "recovered"
+    };
+    static constexpr Utils::HsmTransition<State, Event, Context> transitions[] = {
+        { IoTState::Boot, IoTEvent::NotConfigured, IoTState::BleAdvertising, nullptr, nullptr },
+        { IoTState::Boot, IoTEvent::Configured, IoTState::WifiConnecting, nullptr, nullptr },
+        { IoTState::BleAdvertising, IoTEvent::BleConnected, IoTState::BleConfiguring, nullptr, nullptr },
+        { IoTState::BleConfiguring, IoTEvent::BleDisconnected, IoTState::BleAdvertising, nullptr, nullptr },
+        { IoTState::BleConfiguring, IoTEvent::WifiTestRequested, IoTState::BleTestingWifi, nullptr, nullptr },
+        { IoTState::BleConfiguring, IoTEvent::ConfigReset, IoTState::BleAdvertising, nullptr, nullptr },
+        { IoTState::BleTestingWifi, IoTEvent::WifiTestDone, IoTState::BleConfiguring, nullptr, nullptr },
+        { IoTState::BleTestingWifi, IoTEvent::ConfigCommitted, IoTState::WifiConnecting, nullptr, nullptr },
+        { IoTState::WifiConnecting, IoTEvent::ConfigLost, IoTState::BleAdvertising, nullptr, nullptr },
+        { IoTState::WifiConnecting, IoTEvent::WifiConnected, IoTState::MqttOperating, nullptr, nullptr },
+        { IoTState::MqttOperating, IoTEvent::LinkLost, IoTState::WifiConnecting, nullptr, nullptr },
+        { IoTState::Error, IoTEvent::Recovered, IoTState::Boot, nullptr, nullptr },
+    };
+};
+
+using IoTMachine = Utils::StateMachine<IoTFsm>;
+
+/*!
+ * \brief Per-state handlers, indexed by IoTState
+ */
+static IoTEvent (*const s_stateHandlers[])() = {
+    prv_handle_boot,
+    prv_handle_ble_advertising,
+    prv_handle_ble_configuring,
+    prv_handle_ble_testing_wifi,
+    prv_handle_wifi_connecting,
+    prv_handle_mqtt_operating,
+    prv_handle_error,
+};
+static_assert(sizeof(s_stateHandlers) / sizeof(s_stateHandlers[0]) == IoTFsm::kStateCount,
+              "One handler per IoT state");
+
+static IoTMachine s_machine(s_ctx); //!< IoT FSM
+
+/*!
+ * \brief Log every IoT FSM transition
+ */
+static void prv_trace_transition(const IoTMachine::Trace &entry) {
+    Serial.printf("[FSM] %s -> %s (%s)\n",
+                  IoTMachine::stateName(entry.from),
+                  IoTMachine::stateName(entry.to),
+                  IoTMachine::eventName(entry.event));
 }
 
 // ============================================================================
@@ -382,7 +462,6 @@ static void prv_iot_task(void *) {
 
     // Initialize context
     memset(&s_ctx, 0, sizeof(s_ctx));
-    s_ctx.currentState = IoTState::Boot;
     s_ctx.deviceId = 1;
     s_ctx.testWifi = nullptr;
     s_ctx.lastProgressSent = -1;
@@ -397,6 +476,8 @@ static void prv_iot_task(void *) {
         return;
     }
 
+    s_publishTimer = new Utils::PeriodicSendTimer();
+
     // Initialize BLE
     s_ble = new BleUartHal();
     s_ble->begin("PlantMonitor");
@@ -406,43 +487,23 @@ static void prv_iot_task(void *) {
     Serial.println("[FSM] IoT Task started");
     Serial.printf("[FSM] Firmware: %s\n", IOT_FW_VERSION);
 
+    s_machine.setTraceHook(prv_trace_transition);
+    s_machine.start(IoTState::Boot, millis());
+
     // FSM main loop
     while (true) {
-        IoTState current = s_ctx.currentState;
-        IoTState next = current;
-
-        switch (current) {
-            case IoTState::Boot:
-                next = prv_handle_boot();
-                break;
-            case IoTState::BleAdvertising:
-                next = prv_handle_ble_advertising();
-                break;
-            case IoTState::BleConfiguring:
-                next = prv_handle_ble_configuring();
-                break;
-            case IoTState::BleTestingWifi:
-                next = prv_handle_ble_testing_wifi();
-                break;
-            case IoTState::WifiConnecting:
-                next = prv_handle_wifi_connecting();
-                break;
-            case IoTState::MqttOperating:
-                next = prv_handle_mqtt_operating();
-                break;
-            case IoTState::Error:
-                next = prv_handle_error();
-                break;
+        IoTEvent event = s_stateHandlers[static_cast<size_t>(s_machine.state())]();
+        if (event != IoTEvent::None) {
+            s_machine.dispatch(event, millis());
         }
+        IoTState next = s_machine.state();
 
-        if (current != next) {
-            Serial.printf("[FSM] %s -> %s\n",
-                          iotStateToString(current),
-                          iotStateToString(next));
+        // While operating, sleep on the publish timer: same tick, but a due publish wakes the loop at once
+        if (next == IoTState::MqttOperating && s_publishTimer && s_publishTimer->isRunning()) {
+            s_ctx.publishDue = s_publishTimer->waitFor(IOT_FSM_TICK_MS) || s_ctx.publishDue;
+        } else {
+            vTaskDelay(pdMS_TO_TICKS(IOT_FSM_TICK_MS));
         }
-        s_ctx.currentState = next;
-
-        vTaskDelay(pdMS_TO_TICKS(IOT_FSM_TICK_MS));
     }
 }
 
@@ -6,9 +6,12 @@
 #include "mqtt-telemetry.h"
 #include "iot/mqtt-service.h"
 #include <esp_task_wdt.h>
+#include <cstdarg>
 
 using namespace PlantMonitor::IoT;
 
+#define MQTT_TELEMETRY_JSON_SIZE 896 //!< Payload buffer: readings, light integral and four channel summaries
+
 namespace PlantMonitor {
 namespace Tasks {
 
@@ -90,13 +93,13 @@ void MqttTelemetryPublisher::disconnect() {
 // TELEMETRY PUBLISHING
 // ============================================================================
 
-bool MqttTelemetryPublisher::publishTelemetry(int deviceId, const SensorData &data) {
+bool MqttTelemetryPublisher::publishTelemetry(int deviceId, const SensorData &data, const SensorStatistics *stats, float lightIntegral) {
     if (!isConnected()) {
         return false;
     }
 
     String topic = generateDeviceTopic(deviceId);
-    String payload = createTelemetryJson("ok", data, deviceId);
+    String payload = createTelemetryJson("ok", data, deviceId, stats, lightIntegral);
 
     bool success = m_mqttService->publish(topic.c_str(), payload.c_str(), false);
     if (success) {
@@ -116,18 +119,75 @@ String MqttTelemetryPublisher::generateDeviceTopic(int deviceId) {
     return String(topic);
 }
 
+/*!
+ * \brief Append formatted text to a JSON buffer
+ * \param[in,out] pos Write position, left unchanged if the text does not fit
+ */
+static void prv_append(char *buf, size_t size, size_t &pos, const char *fmt, ...) {
+    if (pos >= size) {
+        return;
+    }
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(buf + pos, size - pos, fmt, args);
+    va_end(args);
+    if (n > 0 && static_cast<size_t>(n) < size - pos) {
+        pos += static_cast<size_t>(n);
+    } else {
+        buf[pos] = '\0'; // Drop the partial member
+    }
+}
+
+/*!
+ * \brief Append one channel summary as a JSON member
+ */
+static void prv_append_summary(char *buf, size_t size, size_t &pos, const char *name, const Utils::StatsSummary &s, bool last) {
+    if (s.count == 0) {
+        // NAN is not valid JSON: an empty channel only reports its count
+        prv_append(buf, size, pos, "\"%s\":{\"n\":0}%s", name, last ? "" : ",");
+        return;
+    }
+    prv_append(buf, size, pos,
+               "\"%s\":{\"n\":%lu,\"mean\":%.2f,\"sd\":%.2f,\"min\":%.2f,\"max\":%.2f,"
+               "\"p10\":%.2f,\"p50\":%.2f,\"p90\":%.2f}%s",
+               name, static_cast<unsigned long>(s.count), s.mean, s.stddev, s.min, s.max,
+               s.p10, s.p50, s.p90, last ? "" : ",");
+}
+
 String MqttTelemetryPublisher::createTelemetryJson(
-    const char *status, const SensorData &data, int deviceId) {
-
-    char json[256];
-    snprintf(json, sizeof(json), "{\"status\":\"%s\",\"temperature\":%.2f,\"humidity\":%.2f,"
-                                 "\"moisture\":%.2f,\"light\":%s,\"device_id\":%d}",
-             status,
-             data.temperature,
-             data.humidity,
-             data.moisture,
-             data.lightDetected ? "true" : "false",
-             deviceId);
+    const char *status, const SensorData &data, int deviceId, const SensorStatistics *stats, float lightIntegral) {
+
+    char json[MQTT_TELEMETRY_JSON_SIZE];
+    size_t pos = 0;
+    json[0] = '\0';
+
+    prv_append(json, sizeof(json), pos, "{\"status\":\"%s\",\"temperature\":%.2f,\"humidity\":%.2f,"
+                                        "\"moisture\":%.2f,\"moisture_trend\":%.2f,\"light\":%s,"
+                                        "\"light_level\":%.1f,\"device_id\":%d",
+               status,
+               data.temperature,
+               data.humidity,
+               data.moisture,
+               data.moistureTrend,
+               data.lightDetected ? "true" : "false",
+               data.lightLevel,
+               deviceId);
+
+    if (!isnan(lightIntegral)) {
+        prv_append(json, sizeof(json), pos, ",\"light_integral_h\":%.2f", lightIntegral);
+    }
+
+    if (stats) {
+        prv_append(json, sizeof(json), pos, ",\"stats\":{\"interval_s\":%lu,",
+                   static_cast<unsigned long>(stats->intervalMs / 1000));
+        prv_append_summary(json, sizeof(json), pos, "temperature", stats->temperature, false);
+        prv_append_summary(json, sizeof(json), pos, "humidity", stats->humidity, false);
+        prv_append_summary(json, sizeof(json), pos, "moisture", stats->moisture, false);
+        prv_append_summary(json, sizeof(json), pos, "light", stats->light, true);
+        prv_append(json, sizeof(json), pos, "}");
+    }
+
+    prv_append(json, sizeof(json), pos, "}");
     return String(json);
 }
 
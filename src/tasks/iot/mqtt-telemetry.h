@@ -73,9 +73,14 @@ class MqttTelemetryPublisher {
      * \brief Publish telemetry data
      * \param deviceId Device identifier for topic
      * \param data Sensor readings to publish
+     * \param stats Statistics of the readings since the previous publish (optional)
+     * \param lightIntegral Today's light integral in full-scale hours (omitted if NAN)
      * \return true if publish succeeded
      */
-    bool publishTelemetry(int deviceId, const SensorData &data);
+    bool publishTelemetry(int deviceId,
+                          const SensorData &data,
+                          const SensorStatistics *stats = nullptr,
+                          float lightIntegral = NAN);
 
     /*!
      * \brief Generate MQTT topic for a device
@@ -89,11 +94,15 @@ class MqttTelemetryPublisher {
      * \param status Status string
      * \param data Sensor readings
      * \param deviceId Device identifier
+     * \param stats Interval statistics added under "stats" (optional)
+     * \param lightIntegral Today's light integral in full-scale hours (omitted if NAN)
      * \return JSON string payload
      */
     static String createTelemetryJson(const char *status,
                                       const SensorData &data,
-                                      int deviceId);
+                                      int deviceId,
+                                      const SensorStatistics *stats = nullptr,
+                                      float lightIntegral = NAN);
 
   private:
     const char *m_broker;
@@ -0,0 +1,201 @@
+#include "light-journal.h"
+
+namespace PlantMonitor {
+namespace Tasks {
+
+static_assert(sizeof(LightDayRecord) == 12, "LightDayRecord layout is stored in flash");
+static_assert(LIGHT_JOURNAL_DAYS <= 100, "Slot keys use two digits");
+
+static constexpr const char *LIGHT_JOURNAL_PROGRESS_KEY = "today";
+
+LightJournal::LightJournal()
+    : m_lastSequence(0), m_count(0) {}
+
+void LightJournal::slotKey(size_t slot, char *key) {
+    key[0] = 'd';
+    key[1] = static_cast<char>('0' + slot / 10);
+    key[2] = static_cast<char>('0' + slot % 10);
+    key[3] = '\0';
+}
+
+bool LightJournal::readRecord(Preferences &nvs, uint32_t sequence, LightDayRecord &out) {
+    char key[4];
+    slotKey((sequence - 1) % LIGHT_JOURNAL_DAYS, key);
+    if (nvs.getBytes(key, &out, sizeof(out)) != sizeof(out)) {
+        return false;
+    }
+    // A slot holding an older lap means the requested record was never written
+    return out.sequence == sequence;
+}
+
+bool LightJournal::load() {
+    m_lastSequence = 0;
+    m_count = 0;
+
+    Preferences nvs;
+    if (!nvs.begin(LIGHT_JOURNAL_NAMESPACE, true)) {
+        return false; // Namespace doesn't exist yet (first boot)
+    }
+
+    for (size_t slot = 0; slot < LIGHT_JOURNAL_DAYS; slot++) {
+        char key[4];
+        slotKey(slot, key);
+        LightDayRecord record;
+        if (nvs.getBytes(key, &record, sizeof(record)) != sizeof(record) || record.sequence == 0) {
+            continue;
+        }
+        m_count++;
+        if (record.sequence > m_lastSequence) {
+            m_lastSequence = record.sequence;
+        }
+    }
+    nvs.end();
+
+    return m_count > 0;
+}
+
+bool LightJournal::append(const LightDayRecord &record) {
+    LightDayRecord stored = record;
+    stored.sequence = m_lastSequence + 1;
+    if (stored.sequence == 0) {
+        stored.sequence = 1; // Never reached in practice (one record per day)
+    }
+
+    Preferences nvs;
+    if (!nvs.begin(LIGHT_JOURNAL_NAMESPACE, false)) {
+        return false;
+    }
+
+    // The whole day goes out in one write; the previous lap's record in this slot is replaced
+    char key[4];
+    slotKey((stored.sequence - 1) % LIGHT_JOURNAL_DAYS, key);
+    bool written = nvs.putBytes(key, &stored, sizeof(stored)) == sizeof(stored);
+    nvs.end();
+
+    if (written) {
+        m_lastSequence = stored.sequence;
+        if (m_count < LIGHT_JOURNAL_DAYS) {
+            m_count++;
+        }
+    }
+    return written;
+}
+
+bool LightJournal::at(size_t age, LightDayRecord &out) const {
+    if (age >= m_count) {
+        return false;
+    }
+
+    Preferences nvs;
+    if (!nvs.begin(LIGHT_JOURNAL_NAMESPACE, true)) {
+        return false;
+    }
+    bool found = readRecord(nvs, m_lastSequence - age, out);
+    nvs.end();
+    return found;
+}
+
+bool LightJournal::summarize(size_t days, LightJournalSummary &out) const {
+    out = {};
+    if (days > m_count) {
+        days = m_count;
+    }
+    if (days == 0) {
+        return false;
+    }
+
+    Preferences nvs;
+    if (!nvs.begin(LIGHT_JOURNAL_NAMESPACE, true)) {
+        return false;
+    }
+
+    uint32_t totalMinutes = 0;
+    out.minMinutes = UINT16_MAX;
+    for (size_t age = 0; age < days; age++) {
+        LightDayRecord record;
+        if (!readRecord(nvs, m_lastSequence - age, record)) {
+            break;
+        }
+        out.days++;
+        totalMinutes += record.lightMinutes;
+        if (record.lightMinutes < out.minMinutes) {
+            out.minMinutes = record.lightMinutes;
+        }
+        if (record.lightMinutes > out.maxMinutes) {
+            out.maxMinutes = record.lightMinutes;
+        }
+        if (record.peakPercent > out.peakPercent) {
+            out.peakPercent = record.peakPercent;
+        }
+    }
+    nvs.end();
+
+    if (out.days == 0) {
+        out.minMinutes = 0;
+        return false;
+    }
+    out.meanMinutes = static_cast<float>(totalMinutes) / out.days;
+    return true;
+}
+
+uint8_t LightJournal::trailingDaysBelow(uint16_t minMinutes) const {
+    if (m_count == 0) {
+        return 0;
+    }
+
+    Preferences nvs;
+    if (!nvs.begin(LIGHT_JOURNAL_NAMESPACE, true)) {
+        return 0;
+    }
+
+    uint8_t days = 0;
+    for (size_t age = 0; age < m_count; age++) {
+        LightDayRecord record;
+        if (!readRecord(nvs, m_lastSequence - age, record) || record.lightMinutes >= minMinutes) {
+            break;
+        }
+        days++;
+    }
+    nvs.end();
+    return days;
+}
+
+bool LightJournal::saveProgress(const LightDayRecord &record) {
+    Preferences nvs;
+    if (!nvs.begin(LIGHT_JOURNAL_NAMESPACE, false)) {
+        return false;
+    }
+    LightDayRecord stored = record;
+    stored.sequence = 0;
+    bool written = nvs.putBytes(LIGHT_JOURNAL_PROGRESS_KEY, &stored, sizeof(stored)) == sizeof(stored);
+    nvs.end();
+    return written;
+}
+
+bool LightJournal::loadProgress(LightDayRecord &out) const {
+    Preferences nvs;
+    if (!nvs.begin(LIGHT_JOURNAL_NAMESPACE, true)) {
+        return false;
+    }
+    bool found = nvs.getBytes(LIGHT_JOURNAL_PROGRESS_KEY, &out, sizeof(out)) == sizeof(out);
+    nvs.end();
+    return found;
+}
+
+void LightJournal::clear() {
+    Preferences nvs;
+    if (nvs.begin(LIGHT_JOURNAL_NAMESPACE, false)) {
+        for (size_t slot = 0; slot < LIGHT_JOURNAL_DAYS; slot++) {
+            char key[4];
+            slotKey(slot, key);
+            nvs.remove(key);
+        }
+        nvs.remove(LIGHT_JOURNAL_PROGRESS_KEY);
+        nvs.end();
+    }
+    m_lastSequence = 0;
+    m_count = 0;
+}
+
+} // namespace Tasks
+} // namespace PlantMonitor
@@ -0,0 +1,150 @@
+#pragma once
+#include <Arduino.h>
+#include <Preferences.h>
+
+/*!
+ * \file light-journal.h
+ * \brief Append-only journal of daily light records in NVS.
+ *
+ * Each finished day is stored as one small record under its own key
+ * ("d00".."d29" in the plant_light namespace), written in a single NVS
+ * operation. Slots are used round-robin, so every key is rewritten only once
+ * per LIGHT_JOURNAL_DAYS days and the writes are spread evenly on top of
+ * NVS's own page rotation. A sequence number in every record identifies the
+ * newest one after a reboot.
+ *
+ * Only the head position is kept in RAM: records are read back from flash on
+ * demand, one day at a time or as a weekly / monthly summary.
+ *
+ * The day still in progress is checkpointed separately under "today", so a
+ * reboot resumes its light integral instead of starting from zero.
+ *
+ * Typical usage:
+ * \code
+ * LightJournal journal;
+ * journal.load();
+ * journal.append(record);            // At each day rollover
+ * LightJournalSummary week;
+ * journal.summarize(7, week);
+ * \endcode
+ */
+
+#define LIGHT_JOURNAL_DAYS 30                  //!< Days kept (one NVS key each)
+#define LIGHT_JOURNAL_NAMESPACE "plant_light" //!< NVS namespace shared with light tracking
+
+namespace PlantMonitor {
+namespace Tasks {
+
+/*!
+ * \struct LightDayRecord
+ * \brief Light received during one calendar day
+ */
+struct LightDayRecord {
+    uint32_t sequence;     //!< Append counter (assigned by append(), 0 = empty slot)
+    uint16_t day;          //!< Local calendar day (days since 1970-01-01)
+    uint16_t lightMinutes; //!< Daily light integral (minutes at full-scale intensity)
+    uint8_t peakPercent;   //!< Highest light level of the day (% of full scale)
+    uint8_t reserved[3];   //!< Keeps the record at 12 bytes
+};
+
+/*!
+ * \struct LightJournalSummary
+ * \brief Statistics over the most recent days of the journal
+ */
+struct LightJournalSummary {
+    uint16_t days;        //!< Records covered (may be fewer than requested)
+    float meanMinutes;    //!< Average light per day (minutes)
+    uint16_t minMinutes;  //!< Darkest day (minutes)
+    uint16_t maxMinutes;  //!< Brightest day (minutes)
+    uint8_t peakPercent;  //!< Highest light level over the period (%)
+};
+
+/*!
+ * \class LightJournal
+ * \brief Ring of LIGHT_JOURNAL_DAYS daily records persisted one key per day
+ */
+class LightJournal {
+  public:
+    LightJournal();
+
+    /*!
+     * \brief Find the newest record in NVS
+     * \return true if at least one record was found
+     */
+    bool load();
+
+    /*!
+     * \brief Append a finished day
+     * \param record Day to store (sequence is assigned here)
+     * \return true if the record was written
+     */
+    bool append(const LightDayRecord &record);
+
+    /*!
+     * \brief Get the number of stored days (at most LIGHT_JOURNAL_DAYS)
+     */
+    size_t size() const {
+        return m_count;
+    }
+
+    /*!
+     * \brief Read one day back
+     * \param age 0 for the newest record, 1 for the one before, ...
+     * \param[out] out Record read
+     * \return true if the record exists
+     */
+    bool at(size_t age, LightDayRecord &out) const;
+
+    /*!
+     * \brief Summarize the most recent days
+     * \param days Number of days to cover (e.g. 7 or 30)
+     * \param[out] out Summary
+     * \return true if at least one record was found
+     */
+    bool summarize(size_t days, LightJournalSummary &out) const;
+
+    /*!
+     * \brief Count the most recent consecutive days below a minimum
+     * \param minMinutes Minimum light per day (minutes)
+     * \return Number of consecutive days, newest first, with less light than minMinutes
+     */
+    uint8_t trailingDaysBelow(uint16_t minMinutes) const;
+
+    /*!
+     * \brief Checkpoint the day in progress (sequence is ignored)
+     * \param record Partial day, overwritten by every checkpoint
+     * \return true if the checkpoint was written
+     */
+    bool saveProgress(const LightDayRecord &record);
+
+    /*!
+     * \brief Read the last checkpoint back
+     * \param[out] out Partial day
+     * \return true if a checkpoint exists
+     * \note The checkpoint may describe a day that was journaled since; compare
+     *       its day with the newest record.
+     */
+    bool loadProgress(LightDayRecord &out) const;
+
+    /*!
+     * \brief Erase every record and the checkpoint
+     */
+    void clear();
+
+  private:
+    /*!
+     * \brief Read the record with a given sequence (namespace already open)
+     */
+    static bool readRecord(Preferences &nvs, uint32_t sequence, LightDayRecord &out);
+
+    /*!
+     * \brief Build the NVS key of a slot ("d00".."d29")
+     */
+    static void slotKey(size_t slot, char *key);
+
+    uint32_t m_lastSequence; //!< Sequence of the newest record (0 if empty)
+    size_t m_count;          //!< Stored records
+};
+
+} // namespace Tasks
+} // namespace PlantMonitor
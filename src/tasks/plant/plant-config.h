@@ -38,10 +38,25 @@ constexpr uint32_t STATE_DEBOUNCE_MINUTES = 1;
  * Testing: 10 minutes (for quick validation)
  * Production: 720 minutes (12 hours)
  *
+ * The native test_plant_replay harness runs the FSM with the production
+ * value under a virtual clock, so it can be validated without waiting.
+ *
  * Default: 10 minutes (testing)
  */
 constexpr uint32_t DYING_TIMEOUT_MINUTES = 5; // Change to 720 for production
 
+/*!
+ * \brief Plant health re-evaluation period when no sample arrives (seconds)
+ *
+ * The plant task evaluates health on every new sensor sample. This deadline
+ * only matters when samples stop: it keeps the dying timer and the daily
+ * light rollover going with the last known reading.
+ *
+ * Default: 30 seconds
+ * Range: 5-300 seconds
+ */
+constexpr uint32_t PLANT_EVAL_INTERVAL_SECONDS = 30;
+
 // ============================================================================
 // TELEMETRY CONFIGURATION
 // ============================================================================
@@ -84,11 +99,27 @@ constexpr uint8_t LIGHT_ANGRY_DAYS = 1;
  */
 constexpr uint8_t LIGHT_DYING_DAYS = 2;
 
+/*!
+ * \brief Full-scale light hours credited per configured light hour
+ *
+ * ParamIndex::LightHoursMin keeps its original meaning: hours of light per
+ * day. The daily light integral counts hours at full-scale intensity, and a
+ * normally lit indoor hour averages about half of the sensor's full scale, so
+ * the configured value is scaled by this factor. The built-in profile
+ * defaults use the same factor.
+ *
+ * Default: 0.5
+ * Range: 0.2-1.0 (1.0 = only full-scale light counts)
+ */
+constexpr float LIGHT_HOURS_TO_INTEGRAL = 0.5f;
+
 /*!
  * \brief Light detection threshold (percentage)
  *
  * Minimum light percentage (0-100%) to consider light as "detected".
  * This percentage is calculated from ADC readings (0-4095 range).
+ * It only drives the SensorData::lightDetected flag; the daily light integral
+ * uses the light level itself.
  *
  * Typical values:
  * - 20-30%: Detects dim ambient light (room with curtains closed)
@@ -100,6 +131,30 @@ constexpr uint8_t LIGHT_DYING_DAYS = 2;
  */
 constexpr uint8_t LIGHT_DETECTION_THRESHOLD_PERCENT = 40;
 
+/*!
+ * \brief Longest gap between light readings bridged by the integral (minutes)
+ *
+ * The daily light integral interpolates linearly between consecutive light
+ * readings. Across a longer gap (sensor task stalled, device rebooted) the
+ * light level is unknown and the gap adds nothing.
+ *
+ * Default: 10 minutes
+ * Range: 1-60 minutes
+ */
+constexpr uint32_t LIGHT_INTEGRAL_MAX_GAP_MINUTES = 10;
+
+/*!
+ * \brief Period of the partial-day light integral checkpoint (minutes)
+ *
+ * Today's integral is written to NVS at this period so a reboot only loses
+ * the light received since the last checkpoint. Each checkpoint is one NVS
+ * write to the same key.
+ *
+ * Default: 30 minutes
+ * Range: 5-240 minutes
+ */
+constexpr uint32_t LIGHT_CHECKPOINT_INTERVAL_MINUTES = 30;
+
 /*!
  * \brief Light tracking debug print interval (minutes)
  *
@@ -118,9 +173,18 @@ constexpr uint32_t LIGHT_DEBUG_INTERVAL_MINUTES = 3;
 /*! \brief Debounce time in milliseconds */
 constexpr uint32_t STATE_DEBOUNCE_MS = STATE_DEBOUNCE_MINUTES * 60 * 1000;
 
+/*! \brief Plant health re-evaluation period in milliseconds */
+constexpr uint32_t PLANT_EVAL_INTERVAL_MS = PLANT_EVAL_INTERVAL_SECONDS * 1000;
+
 /*! \brief MQTT telemetry interval in milliseconds */
 constexpr uint32_t MQTT_TELEMETRY_INTERVAL_MS = MQTT_TELEMETRY_INTERVAL_MINUTES * 60 * 1000;
 
+/*! \brief Light integral gap limit in milliseconds */
+constexpr uint32_t LIGHT_INTEGRAL_MAX_GAP_MS = LIGHT_INTEGRAL_MAX_GAP_MINUTES * 60 * 1000;
+
+/*! \brief Light integral checkpoint period in milliseconds */
+constexpr uint32_t LIGHT_CHECKPOINT_INTERVAL_MS = LIGHT_CHECKPOINT_INTERVAL_MINUTES * 60 * 1000;
+
 /*! \brief Light debug interval in milliseconds */
 constexpr uint32_t LIGHT_DEBUG_INTERVAL_MS = LIGHT_DEBUG_INTERVAL_MINUTES * 60 * 1000;
 
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "plant-config.h"
+#include "plant-state-machine.h"
+
+/*!
+ * \file plant-profiles.h
+ * \brief Built-in plant profiles selected by ParamIndex::PlantTypeId
+ *
+ * The table is constexpr, so it lives in flash and a lookup is a bounds check
+ * plus an array index. The configuration only carries the plant type; any
+ * threshold it also carries (ParamIndex::TempMin..LightHoursMin) overrides
+ * the profile value.
+ */
+
+namespace PlantMonitor {
+namespace Tasks {
+
+/*!
+ * \enum PlantTypeId
+ * \brief Plant types known to the firmware (value of ParamIndex::PlantTypeId)
+ */
+enum class PlantTypeId : uint8_t {
+    Generic = 0,   //!< Average house plant (former hard-coded defaults)
+    Succulent = 1, //!< Succulents and cacti
+    Tropical = 2,  //!< Tropical foliage (monstera, pothos, ...)
+    Herb = 3,      //!< Kitchen herbs (basil, parsley, mint, ...)
+    Fern = 4,      //!< Ferns
+    Orchid = 5,    //!< Epiphytic orchids
+    Count
+};
+
+/*!
+ * \struct PlantProfile
+ * \brief Thresholds of one plant type
+ */
+struct PlantProfile {
+    PlantTypeId id;             //!< Plant type (equal to the table index)
+    const char *name;           //!< Display name
+    PlantThresholds thresholds; //!< Default thresholds for this type
+};
+
+/*!
+ * \brief Profile table, indexed by PlantTypeId
+ *
+ * Thresholds: {tempMin, tempMax, humidityMin, humidityMax, moistureMin,
+ * moistureMax, lightMin, lightMax}. lightMin is the daily light integral in
+ * hours at full-scale intensity, written as light hours per day scaled by
+ * LIGHT_HOURS_TO_INTEGRAL like a configured ParamIndex::LightHoursMin.
+ */
+constexpr PlantProfile PLANT_PROFILES[] = {
+    { PlantTypeId::Generic, "Generic", { 15.0f, 30.0f, 30.0f, 80.0f, 20.0f, 80.0f, 8.0f * LIGHT_HOURS_TO_INTEGRAL, 24.0f } },
+    { PlantTypeId::Succulent, "Succulent", { 10.0f, 35.0f, 10.0f, 50.0f, 5.0f, 35.0f, 10.0f * LIGHT_HOURS_TO_INTEGRAL, 24.0f } },
+    { PlantTypeId::Tropical, "Tropical", { 18.0f, 30.0f, 50.0f, 90.0f, 40.0f, 80.0f, 6.0f * LIGHT_HOURS_TO_INTEGRAL, 24.0f } },
+    { PlantTypeId::Herb, "Herb", { 15.0f, 30.0f, 40.0f, 70.0f, 30.0f, 70.0f, 10.0f * LIGHT_HOURS_TO_INTEGRAL, 24.0f } },
+    { PlantTypeId::Fern, "Fern", { 16.0f, 27.0f, 50.0f, 90.0f, 50.0f, 85.0f, 4.0f * LIGHT_HOURS_TO_INTEGRAL, 24.0f } },
+    { PlantTypeId::Orchid, "Orchid", { 18.0f, 29.0f, 40.0f, 80.0f, 30.0f, 60.0f, 6.0f * LIGHT_HOURS_TO_INTEGRAL, 24.0f } },
+};
+
+/*! \brief Number of built-in profiles */
+constexpr size_t PLANT_PROFILE_COUNT = sizeof(PLANT_PROFILES) / sizeof(PLANT_PROFILES[0]);
+
+static_assert(PLANT_PROFILE_COUNT == static_cast<size_t>(PlantTypeId::Count),
+              "Every PlantTypeId needs a profile");
+
+namespace detail {
+constexpr bool plantProfilesIndexed(size_t i = 0) {
+    return i == PLANT_PROFILE_COUNT ||
+           (static_cast<size_t>(PLANT_PROFILES[i].id) == i && plantProfilesIndexed(i + 1));
+}
+} // namespace detail
+
+static_assert(detail::plantProfilesIndexed(), "PLANT_PROFILES must be ordered by PlantTypeId");
+
+/*!
+ * \brief Look up the profile of a plant type
+ * \param typeId Plant type from ParamIndex::PlantTypeId
+ * \return Profile, or nullptr if the type is unknown
+ */
+constexpr const PlantProfile *findPlantProfile(uint32_t typeId) {
+    return typeId < PLANT_PROFILE_COUNT ? &PLANT_PROFILES[typeId] : nullptr;
+}
+
+} // namespace Tasks
+} // namespace PlantMonitor
@@ -1,10 +1,13 @@
 #include "plant-state-machine.h"
 #include "plant-config.h"
+#include "plant-profiles.h"
+#include "light-journal.h"
 #include "tasks/iot/iot-task-types.h"
+#include "utils/state-machine/state-machine.h"
 #include "utils/timer/periodic-timer.h"
-#include <Preferences.h>
+#include <atomic>
+#include <math.h>
 #include <time.h>
-#include <WiFi.h>
 
 namespace PlantMonitor {
 namespace Tasks {
@@ -13,77 +16,145 @@ namespace Tasks {
 // STATIC STATE
 // ============================================================================
 
-static PlantState s_currentState = PlantState::PLANT_HAPPY;
 static PlantThresholds s_thresholds;
 static bool s_thresholdsLoaded = false;
 static Utils::PeriodicSendTimer *s_dyingTimer = nullptr;
 static bool s_timerStarted = false;
+static Utils::PeriodicSendTimer *s_lightDebugTimer = nullptr;
 
 // Debounce tracking
 static bool s_lastAllOk = true;
 static uint32_t s_lastConditionChangeTime = 0;
 
+/*!
+ * \brief Health FSM states (Unwell groups the states that keep the dying timer running)
+ */
+enum class PlantFsmState : uint8_t {
+    Happy,
+    Unwell,
+    Angry,
+    Dying
+};
+
+/*!
+ * \brief Health FSM events, raised once per update from the combined condition
+ */
+enum class PlantFsmEvent : uint8_t {
+    InRange,
+    OutOfRange
+};
+
+/*!
+ * \brief Data seen by the health FSM guards
+ */
+struct PlantFsmContext {
+    uint32_t timeInCondition; //!< Time since the combined condition last changed (ms)
+};
+
+static PlantFsmContext s_fsmContext = { 0 };
+
+// Written by the plant task only, read by any task
+static std::atomic<PlantState> s_publishedState(PlantState::PLANT_HAPPY);
+
 // Light tracking
 struct LightTracking {
-    float accumulatedHours;         // Hours accumulated today
-    int lastDayOfYear;              // Day of year (0-365)
+    float integralHours;            // Daily light integral so far (hours at full-scale intensity)
+    int32_t currentDay;             // Day being accumulated (days since 1970-01-01, -1 = unknown)
     uint8_t daysWithoutEnoughLight; // Consecutive days without enough light
-    uint32_t lastUpdateMs;          // Last update timestamp (millis)
-    uint32_t lastDebugPrintMs;      // Last debug print timestamp
+    uint8_t peakPercent;            // Highest light level today (%)
+    float lastLevel;                // Previous light reading (%)
+    uint32_t lastSampleMs;          // Timestamp of the previous light reading (millis, 0 = none)
+    uint32_t lastCheckpointMs;      // Last partial-day checkpoint (millis)
     bool initialized;
 };
 
-static LightTracking s_lightTracking = { 0.0f, -1, 0, 0, 0, false };
-static Preferences s_nvs;
+static LightTracking s_lightTracking = { 0.0f, -1, 0, 0, 0.0f, 0, 0, false };
+static LightJournal s_lightJournal;
+
+// Written by the plant task only, read by the IoT task for telemetry
+static std::atomic<float> s_publishedLightIntegral(0.0f);
 
 // ============================================================================
 // HELPER FUNCTIONS
 // ============================================================================
 
 /*!
- * \brief Check if internet/WiFi is available
+ * \brief Get the day number of a local date
+ * \return Days since 1970-01-01 (proleptic Gregorian calendar)
  */
-static bool prv_is_internet_available() {
-    return WiFi.status() == WL_CONNECTED;
+static int32_t prv_day_number(const struct tm &date) {
+    int32_t year = date.tm_year + 1900 - (date.tm_mon < 2 ? 1 : 0);
+    int32_t era = (year >= 0 ? year : year - 399) / 400;
+    int32_t yearOfEra = year - era * 400;
+    int32_t monthFromMarch = (date.tm_mon + 10) % 12;
+    int32_t dayOfYear = (153 * monthFromMarch + 2) / 5 + date.tm_mday - 1;
+    int32_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
 }
 
 /*!
- * \brief Load light tracking data from NVS
+ * \brief Restore light tracking from the journal
+ *
+ * Accumulation resumes from today's checkpoint when it is newer than the last
+ * journaled day, otherwise on the day after the newest record. If the device
+ * was off longer, the next rollover records that day with what it got.
  */
 static void prv_load_light_tracking_from_nvs() {
-    if (!s_nvs.begin("plant_light", true)) { // Read-only
-        // Namespace doesn't exist yet (first boot) - use defaults
-        Serial.println("[PLANT] NVS namespace not found, using defaults");
-        s_lightTracking.accumulatedHours = 0.0f;
-        s_lightTracking.lastDayOfYear = -1;
-        s_lightTracking.daysWithoutEnoughLight = 0;
+    s_lightTracking.integralHours = 0.0f;
+    s_lightTracking.peakPercent = 0;
+    s_lightTracking.currentDay = -1;
+    s_lightTracking.daysWithoutEnoughLight = 0;
+
+    LightDayRecord latest;
+    bool haveJournal = s_lightJournal.load() && s_lightJournal.at(0, latest);
+    if (haveJournal) {
+        s_lightTracking.currentDay = latest.day + 1;
+        s_lightTracking.daysWithoutEnoughLight =
+            s_lightJournal.trailingDaysBelow(static_cast<uint16_t>(s_thresholds.lightMin * 60.0f));
+    }
+
+    LightDayRecord progress;
+    if (s_lightJournal.loadProgress(progress) && (!haveJournal || progress.day > latest.day)) {
+        s_lightTracking.currentDay = progress.day;
+        s_lightTracking.integralHours = progress.lightMinutes / 60.0f;
+        s_lightTracking.peakPercent = progress.peakPercent;
+    }
+    s_publishedLightIntegral.store(s_lightTracking.integralHours, std::memory_order_relaxed);
+
+    if (!haveJournal) {
+        // Nothing journaled yet (first boot) - use defaults
+        Serial.println("[PLANT] Light journal empty, using defaults");
         return;
     }
 
-    s_lightTracking.accumulatedHours = s_nvs.getFloat("accum_hours", 0.0f);
-    s_lightTracking.lastDayOfYear = s_nvs.getInt("last_day", -1);
-    s_lightTracking.daysWithoutEnoughLight = s_nvs.getUChar("days_no_light", 0);
-    s_nvs.end();
+    Serial.printf("[PLANT] Loaded light journal: %u days, %d days without light, %.2fh today\n",
+                  static_cast<unsigned>(s_lightJournal.size()),
+                  s_lightTracking.daysWithoutEnoughLight,
+                  s_lightTracking.integralHours);
+}
 
-    Serial.printf("[PLANT] Loaded light tracking: %.1fh accumulated, %d days without light\n",
-                  s_lightTracking.accumulatedHours,
-                  s_lightTracking.daysWithoutEnoughLight);
+/*!
+ * \brief Build the record of the day being accumulated
+ */
+static LightDayRecord prv_light_day_record() {
+    float minutes = s_lightTracking.integralHours * 60.0f;
+
+    LightDayRecord record = {};
+    record.day = static_cast<uint16_t>(s_lightTracking.currentDay);
+    record.lightMinutes = static_cast<uint16_t>(minutes < 1440.0f ? minutes + 0.5f : 1440.0f);
+    record.peakPercent = s_lightTracking.peakPercent;
+    return record;
 }
 
 /*!
- * \brief Save light tracking data to NVS
+ * \brief Journal the day that just ended (one NVS write)
  */
 static void prv_save_light_tracking_to_nvs() {
-    if (!s_nvs.begin("plant_light", false)) { // Read-write
-        Serial.println("[PLANT] ERROR: Failed to open NVS for writing");
+    if (!s_lightJournal.append(prv_light_day_record())) {
+        Serial.println("[PLANT] ERROR: Failed to write light journal");
         return;
     }
 
-    s_nvs.putFloat("accum_hours", s_lightTracking.accumulatedHours);
-    s_nvs.putInt("last_day", s_lightTracking.lastDayOfYear);
-    s_nvs.putUChar("days_no_light", s_lightTracking.daysWithoutEnoughLight);
-    s_nvs.end();
-
     Serial.println("[PLANT] Saved light tracking to NVS");
 }
 
@@ -104,18 +175,14 @@ static bool prv_is_light_ok() {
 }
 
 /*!
- * \brief Update light hours tracking
+ * \brief Update the daily light integral
+ * \param data Latest sensor sample
  */
-static void prv_update_light_tracking() {
-    if (!prv_is_internet_available()) {
-        return; // Skip if no internet (can't sync time)
-    }
-
+static void prv_update_light_tracking(const SensorData &data) {
     // Initialize tracking if needed
     if (!s_lightTracking.initialized) {
         prv_load_light_tracking_from_nvs();
-        s_lightTracking.lastUpdateMs = millis();
-        s_lightTracking.lastDebugPrintMs = 0; // Force first print
+        s_lightTracking.lastCheckpointMs = millis();
         s_lightTracking.initialized = true;
     }
 
@@ -123,79 +190,104 @@ static void prv_update_light_tracking() {
     time_t now;
     time(&now);
     if (now < 946684800) { // Check if time is valid (> 2000-01-01)
-        return;            // Time not synced yet
+        return;            // Time not synced yet (no NTP since boot)
     }
 
     struct tm timeinfo;
     localtime_r(&now, &timeinfo);
-    int currentDay = timeinfo.tm_yday;
+    int32_t currentDay = prv_day_number(timeinfo);
 
     // Check if day changed (midnight passed)
-    if (s_lightTracking.lastDayOfYear != -1 && currentDay != s_lightTracking.lastDayOfYear) {
-        // New day - check yesterday's accumulated hours
-        if (s_lightTracking.accumulatedHours < s_thresholds.lightMin) {
+    if (s_lightTracking.currentDay != -1 && currentDay != s_lightTracking.currentDay) {
+        // New day - check yesterday's light integral
+        if (s_lightTracking.integralHours < s_thresholds.lightMin) {
             s_lightTracking.daysWithoutEnoughLight++;
             Serial.printf("[PLANT] Day ended with %.1fh light (need %.1fh) - %d days without enough light\n",
-                          s_lightTracking.accumulatedHours,
+                          s_lightTracking.integralHours,
                           s_thresholds.lightMin,
                           s_lightTracking.daysWithoutEnoughLight);
         } else {
             s_lightTracking.daysWithoutEnoughLight = 0;
-            Serial.printf("[PLANT] Day ended with %.1fh light - Reset counter\n", s_lightTracking.accumulatedHours);
+            Serial.printf("[PLANT] Day ended with %.1fh light - Reset counter\n", s_lightTracking.integralHours);
         }
 
-        // Reset for new day
-        s_lightTracking.accumulatedHours = 0.0f;
-        s_lightTracking.lastDayOfYear = currentDay;
+        // Journal the finished day, then reset for the new one
         prv_save_light_tracking_to_nvs();
-    } else if (s_lightTracking.lastDayOfYear == -1) {
+        s_lightTracking.integralHours = 0.0f;
+        s_lightTracking.peakPercent = 0;
+        s_lightTracking.currentDay = currentDay;
+    } else if (s_lightTracking.currentDay == -1) {
         // First run
-        s_lightTracking.lastDayOfYear = currentDay;
+        s_lightTracking.currentDay = currentDay;
     }
 
-    // Accumulate light hours
-    SensorData data;
-    if (getLatestSensorData(data)) {
-        // Check if plant is getting light
-        if (data.lightDetected) {
-            uint32_t nowMs = millis();
-            uint32_t deltaMs = nowMs - s_lightTracking.lastUpdateMs;
-            float deltaHours = deltaMs / 3600000.0f;
-            s_lightTracking.accumulatedHours += deltaHours;
+    // Integrate each new light reading once (re-evaluations reuse the last sample)
+    if (data.lightTimestampMs != 0 && data.lightTimestampMs != s_lightTracking.lastSampleMs) {
+        float level = data.lightLevel < 0.0f ? 0.0f : (data.lightLevel > 100.0f ? 100.0f : data.lightLevel);
+        uint32_t deltaMs = data.lightTimestampMs - s_lightTracking.lastSampleMs;
+
+        // Trapezoid between the previous reading and this one, in full-scale hours
+        if (s_lightTracking.lastSampleMs != 0 && deltaMs <= LIGHT_INTEGRAL_MAX_GAP_MS) {
+            float meanFraction = (s_lightTracking.lastLevel + level) * (0.5f / 100.0f);
+            s_lightTracking.integralHours += meanFraction * (deltaMs / 3600000.0f);
         }
-        s_lightTracking.lastUpdateMs = millis();
-
-        // Periodic debug print (configured interval)
-        uint32_t nowMs = millis();
-        if (s_lightTracking.lastDebugPrintMs == 0 ||
-            (nowMs - s_lightTracking.lastDebugPrintMs >= LIGHT_DEBUG_INTERVAL_MS)) {
-            s_lightTracking.lastDebugPrintMs = nowMs;
-
-            // Get current time for display
-            time_t now_time;
-            time(&now_time);
-
-            // Only print if time is valid
-            if (now_time >= 946684800) {
-                struct tm timeinfo;
-                localtime_r(&now_time, &timeinfo);
-
-                Serial.println("========================================");
-                Serial.printf("[PLANT LIGHT] Debug Info @ %02d:%02d:%02d\n",
-                              timeinfo.tm_hour,
-                              timeinfo.tm_min,
-                              timeinfo.tm_sec);
-                Serial.printf("  Accumulated today: %.2f hours (need %.1f h/day)\n",
-                              s_lightTracking.accumulatedHours,
-                              s_thresholds.lightMin);
-                Serial.printf("  Days without enough light: %d\n",
-                              s_lightTracking.daysWithoutEnoughLight);
-                Serial.printf("  Currently light detected: %s\n",
-                              data.lightDetected ? "YES" : "NO");
-                Serial.printf("  Light status: %s\n",
-                              prv_is_light_ok() ? "OK" : "BAD");
-                Serial.println("========================================");
+        s_lightTracking.lastLevel = level;
+        s_lightTracking.lastSampleMs = data.lightTimestampMs;
+
+        if (level > s_lightTracking.peakPercent) {
+            s_lightTracking.peakPercent = static_cast<uint8_t>(level);
+        }
+    }
+    s_publishedLightIntegral.store(s_lightTracking.integralHours, std::memory_order_relaxed);
+
+    // Checkpoint the partial day so a reboot resumes it
+    uint32_t nowMs = millis();
+    if (nowMs - s_lightTracking.lastCheckpointMs >= LIGHT_CHECKPOINT_INTERVAL_MS) {
+        s_lightTracking.lastCheckpointMs = nowMs;
+        s_lightJournal.saveProgress(prv_light_day_record());
+    }
+
+    // Periodic debug print (configured interval); the first one is immediate
+    bool printNow = false;
+    if (s_lightDebugTimer && !s_lightDebugTimer->isRunning()) {
+        printNow = s_lightDebugTimer->begin(LIGHT_DEBUG_INTERVAL_MS);
+    } else if (s_lightDebugTimer) {
+        printNow = s_lightDebugTimer->take();
+    }
+    if (printNow) {
+        // Get current time for display
+        time_t now_time;
+        time(&now_time);
+
+        // Only print if time is valid
+        if (now_time >= 946684800) {
+            struct tm timeinfo;
+            localtime_r(&now_time, &timeinfo);
+
+            Serial.println("========================================");
+            Serial.printf("[PLANT LIGHT] Debug Info @ %02d:%02d:%02d\n",
+                          timeinfo.tm_hour,
+                          timeinfo.tm_min,
+                          timeinfo.tm_sec);
+            Serial.printf("  Light integral today: %.2f h at full scale (need %.1f h/day)\n",
+                          s_lightTracking.integralHours,
+                          s_thresholds.lightMin);
+            Serial.printf("  Days without enough light: %d\n",
+                          s_lightTracking.daysWithoutEnoughLight);
+            LightJournalSummary week;
+            if (s_lightJournal.summarize(7, week)) {
+                Serial.printf("  Last %u days: %.1f h/day (min %.1f h, max %.1f h, peak %u%%)\n",
+                              week.days,
+                              week.meanMinutes / 60.0f,
+                              week.minMinutes / 60.0f,
+                              week.maxMinutes / 60.0f,
+                              week.peakPercent);
             }
+            Serial.printf("  Current light level: %.0f%%\n",
+                          data.lightLevel);
+            Serial.printf("  Light status: %s\n",
+                          prv_is_light_ok() ? "OK" : "BAD");
+            Serial.println("========================================");
         }
     }
 }
@@ -224,6 +316,93 @@ static void prv_stop_dying_timer() {
     }
 }
 
+// ============================================================================
+// HEALTH FSM
+// ============================================================================
+
+static void prv_enter_unwell(PlantFsmContext &) {
+    prv_start_dying_timer();
+}
+
+static void prv_exit_unwell(PlantFsmContext &) {
+    prv_stop_dying_timer();
+}
+
+/*!
+ * \brief The condition has held for the debounce period
+ */
+static bool prv_guard_debounced(PlantFsmContext &ctx) {
+    return ctx.timeInCondition >= STATE_DEBOUNCE_MS;
+}
+
+/*!
+ * \brief The dying timer expired or the plant went without light for too long
+ * \note Consumes the dying timer expiry
+ */
+static bool prv_guard_dying(PlantFsmContext &) {
+    bool shouldGoDying = false;
+
+    if (s_dyingTimer && s_dyingTimer->take()) {
+        shouldGoDying = true;
+        Serial.println("[PLANT] Dying condition: 12h timer expired");
+    }
+
+    if (s_lightTracking.initialized && s_lightTracking.daysWithoutEnoughLight >= LIGHT_DYING_DAYS) {
+        shouldGoDying = true;
+        Serial.printf("[PLANT] Dying condition: %d days without light\n", s_lightTracking.daysWithoutEnoughLight);
+    }
+
+    return shouldGoDying;
+}
+
+/*!
+ * \brief Health FSM definition
+ */
+struct PlantFsm {
+    using State = PlantFsmState;
+    using Event = PlantFsmEvent;
+    using Context = PlantFsmContext;
+    static constexpr size_t kStateCount = 4;
+    static constexpr size_t kEventCount = 2;
+    static constexpr Utils::HsmState<State, Context> states[kStateCount] = {
+        { State::Happy, State::Happy, "HAPPY", nullptr, nullptr },
+        { State::Unwell, State::Unwell, "UNWELL", &prv_enter_unwell, &prv_exit_unwell },
+        { State::Angry, State::Unwell, "ANGRY", nullptr, nullptr },
+        { State::Dying, State::Unwell, "DYING", nullptr, nullptr },
+    };
+    static constexpr const char *events[kEventCount] = { "in range", "out of range" };
+    static constexpr Utils::HsmTransition<State, Event, Context> transitions[] = {
+        { State::Happy, Event::OutOfRange, State::Angry, &prv_guard_debounced, nullptr },
+        { State::Angry, Event::OutOfRange, State::Dying, &prv_guard_dying, nullptr },
+        { State::Unwell, Event::InRange, State::Happy, &prv_guard_debounced, nullptr },
+    };
+};
+
+using PlantMachine = Utils::StateMachine<PlantFsm>;
+
+static PlantMachine s_machine(s_fsmContext);
+
+/*!
+ * \brief Map a health FSM leaf state to the public PlantState
+ */
+static PlantState prv_plant_state(PlantFsmState state) {
+    switch (state) {
+        case PlantFsmState::Angry:
+            return PlantState::PLANT_ANGRY;
+        case PlantFsmState::Dying:
+            return PlantState::PLANT_DYING;
+        default:
+            return PlantState::PLANT_HAPPY;
+    }
+}
+
+static void prv_trace_transition(const PlantMachine::Trace &entry) {
+    Serial.printf("[PLANT] State: %s -> %s (%s)\n",
+                  PlantMachine::stateName(entry.from),
+                  PlantMachine::stateName(entry.to),
+                  PlantMachine::eventName(entry.event));
+}
+
 // ============================================================================
 // PUBLIC API
 // ============================================================================
@@ -251,13 +430,19 @@ void initPlantStateMachine(uint32_t timeoutMinutes) {
         return;
     }
 
-    s_currentState = PlantState::PLANT_HAPPY;
+    if (!s_lightDebugTimer) {
+        s_lightDebugTimer = new Utils::PeriodicSendTimer();
+    }
+
     s_timerStarted = false;
+    s_machine.setTraceHook(prv_trace_transition);
+    s_machine.start(PlantFsmState::Happy, millis());
+    s_publishedState.store(PlantState::PLANT_HAPPY, std::memory_order_release);
 
     Serial.println("[PLANT] State machine initialized");
 }
 
-void updatePlantState() {
+bool updatePlantState(const SensorData &data) {
     // Load thresholds if not already loaded
     if (!s_thresholdsLoaded) {
         AppConfig cfg;
@@ -278,18 +463,12 @@ void updatePlantState() {
 
         // If still not loaded, return (wait for configuration)
         if (!s_thresholdsLoaded) {
-            return;
+            return false;
         }
     }
 
-    // Get current sensor data
-    SensorData data;
-    if (!getLatestSensorData(data)) {
-        return; // No sensor data available
-    }
-
-    // Update light tracking (if internet available)
-    prv_update_light_tracking();
+    // Update light tracking (once the clock is synced)
+    prv_update_light_tracking(data);
 
     // Check if basic sensors are in range
     bool sensorsInRange = areSensorsInRange(data, s_thresholds);
@@ -312,85 +491,63 @@ void updatePlantState() {
                       s_lightTracking.daysWithoutEnoughLight);
     }
 
-    // Calculate time in current condition
-    uint32_t timeInCondition = now - s_lastConditionChangeTime;
-
-    // State machine logic with debounce
-    PlantState nextState = s_currentState;
+    // Debounce and dying conditions are guards of the health FSM
+    s_fsmContext.timeInCondition = now - s_lastConditionChangeTime;
+    s_machine.dispatch(allOk ? PlantFsmEvent::InRange : PlantFsmEvent::OutOfRange, now);
 
-    switch (s_currentState) {
-        case PlantState::PLANT_HAPPY:
-            if (!allOk && timeInCondition >= STATE_DEBOUNCE_MS) {
-                // Out of range for 5 minutes -> ANGRY
-                nextState = PlantState::PLANT_ANGRY;
-                prv_start_dying_timer();
-                Serial.println("[PLANT] State: HAPPY -> ANGRY (5 min out of range)");
-            }
-            break;
-
-        case PlantState::PLANT_ANGRY:
-            if (allOk && timeInCondition >= STATE_DEBOUNCE_MS) {
-                // Back in range for 5 minutes -> HAPPY
-                nextState = PlantState::PLANT_HAPPY;
-                prv_stop_dying_timer();
-                Serial.println("[PLANT] State: ANGRY -> HAPPY (5 min in range)");
-            } else if (!allOk) {
-                // Still out of range - check conditions for DYING
-                bool shouldGoDying = false;
-
-                // Check if 12h timer expired
-                if (s_dyingTimer && s_dyingTimer->take()) {
-                    shouldGoDying = true;
-                    Serial.println("[PLANT] Dying condition: 12h timer expired");
-                }
-
-                // Check if 2+ days without enough light
-                if (s_lightTracking.initialized && s_lightTracking.daysWithoutEnoughLight >= LIGHT_DYING_DAYS) {
-                    shouldGoDying = true;
-                    Serial.printf("[PLANT] Dying condition: %d days without light\n", s_lightTracking.daysWithoutEnoughLight);
-                }
-
-                if (shouldGoDying) {
-                    nextState = PlantState::PLANT_DYING;
-                    Serial.println("[PLANT] State: ANGRY -> DYING");
-                }
-            }
-            break;
-
-        case PlantState::PLANT_DYING:
-            if (allOk && timeInCondition >= STATE_DEBOUNCE_MS) {
-                // Back in range for 5 minutes -> HAPPY
-                nextState = PlantState::PLANT_HAPPY;
-                prv_stop_dying_timer();
-                Serial.println("[PLANT] State: DYING -> HAPPY (5 min in range)");
-            }
-            break;
+    PlantState state = prv_plant_state(s_machine.state());
+    if (state == s_publishedState.load(std::memory_order_relaxed)) {
+        return false;
     }
-
-    s_currentState = nextState;
+    s_publishedState.store(state, std::memory_order_release);
+    return true;
 }
 
 PlantState getCurrentPlantState() {
-    return s_currentState;
+    return s_publishedState.load(std::memory_order_acquire);
 }
 
-bool loadThresholdsFromConfig(const AppConfig &cfg, PlantThresholds &thresholds) {
-    if (cfg.params.size() < 8) {
-        Serial.printf("[PLANT] ERROR: Insufficient parameters in config (need 8, got %d)\n", cfg.params.size());
-        return false;
+float getDailyLightIntegral() {
+    return s_publishedLightIntegral.load(std::memory_order_relaxed);
+}
+
+/*!
+ * \brief Apply one configured threshold over the profile value
+ * \param scale Conversion from the configured unit to the threshold unit
+ * \note Parameters not sent (absent key, short dense array, null / NaN entry)
+ *       keep the profile value
+ */
+static void prv_override_threshold(const AppConfig &cfg, ParamIndex index, float &threshold, float scale = 1.0f) {
+    if (hasConfigParam(cfg, index)) {
+        threshold = getConfigParam(cfg, index) * scale;
     }
+}
 
-    // Extract thresholds using ParamIndex enum
-    // params[1]=TempMin, params[2]=TempMax, params[3]=HumidityMin, params[4]=HumidityMax,
-    // params[5]=MoistureMin, params[6]=MoistureMax, params[7]=LightHoursMin
-    thresholds.tempMin = getConfigParam(cfg, ParamIndex::TempMin, 15.0f);
-    thresholds.tempMax = getConfigParam(cfg, ParamIndex::TempMax, 30.0f);
-    thresholds.humidityMin = getConfigParam(cfg, ParamIndex::HumidityMin, 30.0f);
-    thresholds.humidityMax = getConfigParam(cfg, ParamIndex::HumidityMax, 80.0f);
-    thresholds.moistureMin = getConfigParam(cfg, ParamIndex::MoistureMin, 20.0f);
-    thresholds.moistureMax = getConfigParam(cfg, ParamIndex::MoistureMax, 80.0f);
-    thresholds.lightMin = getConfigParam(cfg, ParamIndex::LightHoursMin, 8.0f); // Minimum hours of light per day
-    thresholds.lightMax = 24.0f;                                                // No max light parameter in config, use 24 hours
+bool loadThresholdsFromConfig(const AppConfig &cfg, PlantThresholds &thresholds) {
+    // The plant type selects the built-in profile (Generic when none was sent)
+    float typeParam = getConfigParam(cfg, ParamIndex::PlantTypeId, 0.0f);
+    const PlantProfile *profile = nullptr;
+    if (typeParam >= 0.0f) {
+        profile = findPlantProfile(static_cast<uint32_t>(typeParam + 0.5f));
+    }
+    if (!profile) {
+        // A plant id from a newer backend must not leave the machine without thresholds
+        Serial.printf("[PLANT] WARNING: Unknown plant type %.0f, using Generic\n", typeParam);
+        profile = findPlantProfile(static_cast<uint32_t>(PlantTypeId::Generic));
+    }
+    thresholds = profile->thresholds;
+    Serial.printf("[PLANT] Plant profile: %s\n", profile->name);
+
+    // Optional overrides: TempMin, TempMax, HumidityMin, HumidityMax,
+    // MoistureMin, MoistureMax, LightHoursMin
+    prv_override_threshold(cfg, ParamIndex::TempMin, thresholds.tempMin);
+    prv_override_threshold(cfg, ParamIndex::TempMax, thresholds.tempMax);
+    prv_override_threshold(cfg, ParamIndex::HumidityMin, thresholds.humidityMin);
+    prv_override_threshold(cfg, ParamIndex::HumidityMax, thresholds.humidityMax);
+    prv_override_threshold(cfg, ParamIndex::MoistureMin, thresholds.moistureMin);
+    prv_override_threshold(cfg, ParamIndex::MoistureMax, thresholds.moistureMax);
+    // Light is configured in hours per day, compared as a full-scale integral
+    prv_override_threshold(cfg, ParamIndex::LightHoursMin, thresholds.lightMin, LIGHT_HOURS_TO_INTEGRAL);
 
     return true;
 }
@@ -28,8 +28,8 @@ struct PlantThresholds {
     float humidityMax; //!< Maximum air humidity threshold (%)
     float moistureMin; //!< Minimum soil moisture threshold (%)
     float moistureMax; //!< Maximum soil moisture threshold (%)
-    float lightMin;    //!< Minimum light hours required
-    float lightMax;    //!< Maximum light hours allowed
+    float lightMin;    //!< Minimum daily light integral (hours at full-scale intensity)
+    float lightMax;    //!< Maximum daily light integral (hours at full-scale intensity)
 };
 
 /*!
@@ -41,22 +41,39 @@ struct PlantThresholds {
 void initPlantStateMachine(uint32_t timeoutMinutes = 0);
 
 /*!
- * \brief Update the plant state machine
- * \note Must be called periodically (non-blocking)
+ * \brief Evaluate plant health against a sensor sample
+ * \param data Latest sensor sample
+ * \return true if the published PlantState changed
+ * \note Called by the plant task on each new sample or evaluation deadline (non-blocking)
  */
-void updatePlantState();
+bool updatePlantState(const SensorData &data);
 
 /*!
  * \brief Get the current plant state
  * \return Current PlantState
+ * \note Safe to call from any task
  */
 PlantState getCurrentPlantState();
 
+/*!
+ * \brief Get today's daily light integral
+ * \return Light received since local midnight, in hours at full-scale intensity
+ *         (trapezoidal integral of SensorData::lightLevel)
+ * \note Safe to call from any task
+ */
+float getDailyLightIntegral();
+
 /*!
  * \brief Load thresholds from configuration
+ *
+ * Starts from the built-in profile selected by ParamIndex::PlantTypeId (see
+ * plant-profiles.h) and applies the thresholds present in the configuration
+ * as overrides (see hasConfigParam()). An unknown plant type falls back to the
+ * Generic profile (with a warning).
+ *
  * \param cfg Application configuration
- * \param[out] thresholds Parsed thresholds
- * \return true if thresholds loaded successfully
+ * \param[out] thresholds Resolved thresholds
+ * \return true once thresholds are resolved
  */
 bool loadThresholdsFromConfig(const AppConfig &cfg, PlantThresholds &thresholds);
 
@@ -0,0 +1,116 @@
+#include "plant-task.h"
+#include "plant-config.h"
+#include "tasks/sensor/sensor-task.h"
+#include "utils/configuration/config.h"
+#include "utils/subscriber-table/subscriber-table.h"
+#include "utils/timer/timer-service.h"
+
+namespace PlantMonitor {
+namespace Tasks {
+
+/*! \defgroup PlantNotify Plant Task Notification Bits
+ *  @{
+ */
+#define PLANT_NOTIFY_SENSOR_DATA (1u << 0) /*!< New sensor sample committed */
+#define PLANT_NOTIFY_DEADLINE (1u << 1)    /*!< Evaluation deadline from TimerService */
+/*! @} */
+
+/*!
+ * \struct PlantSubscriber
+ * \brief One task notified on plant state changes
+ */
+struct PlantSubscriber {
+    TaskHandle_t task;   //!< Task to notify
+    uint32_t notifyBits; //!< Bits set in the task's notification value
+};
+
+static Utils::SubscriberTable<PlantSubscriber, PLANT_MAX_SUBSCRIBERS> plant_task_subscribers;
+
+/*!
+ * \brief Notify every subscriber of a state change
+ */
+static void prv_notify_subscribers() {
+    plant_task_subscribers.forEach(
+        [](const PlantSubscriber &sub) { xTaskNotify(sub.task, sub.notifyBits, eSetBits); });
+}
+
+static void prv_plant_task(void *) {
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    subscribeSensorData(self, PLANT_NOTIFY_SENSOR_DATA);
+    Utils::TimerId deadline = Utils::TimerService::startNotify(self, PLANT_NOTIFY_DEADLINE,
+                                                              PLANT_EVAL_INTERVAL_MS, PLANT_EVAL_INTERVAL_MS);
+
+    bool initialized = false;
+    bool haveData = false;
+    bool evaluatedSinceDeadline = false;
+    SensorData data = {};
+    uint32_t sequence = 0;
+
+    while (true) {
+        uint32_t notified = 0;
+        TickType_t wait = portMAX_DELAY;
+        if (deadline == TIMER_WHEEL_INVALID_ID) {
+            wait = pdMS_TO_TICKS(PLANT_EVAL_INTERVAL_MS); // No timer service: fall back to a timed wait
+        }
+        if (xTaskNotifyWait(0, UINT32_MAX, &notified, wait) != pdTRUE) {
+            notified = PLANT_NOTIFY_DEADLINE;
+        }
+
+        // The state machine starts once the device is configured
+        if (!initialized) {
+            if (!ConfigHandler::isConfigured()) {
+                continue;
+            }
+            initPlantStateMachine(); // Uses default timeout from plant-config.h
+            initialized = true;
+        }
+
+        bool evaluate = false;
+        if ((notified & PLANT_NOTIFY_SENSOR_DATA) && getSensorDataSequence() != sequence) {
+            haveData = getLatestSensorData(data, sequence);
+            evaluate = haveData;
+        }
+
+        // The deadline only matters when samples stopped arriving
+        if (notified & PLANT_NOTIFY_DEADLINE) {
+            evaluate = evaluate || (haveData && !evaluatedSinceDeadline);
+            evaluatedSinceDeadline = false;
+        }
+
+        if (evaluate) {
+            evaluatedSinceDeadline = true;
+            if (updatePlantState(data)) {
+                prv_notify_subscribers();
+            }
+        }
+    }
+}
+
+void startPlantTask(uint32_t stackSize, UBaseType_t priority, BaseType_t core) {
+    xTaskCreatePinnedToCore(
+        prv_plant_task,
+        "PlantTask",
+        stackSize,
+        nullptr,
+        priority,
+        nullptr,
+        core);
+}
+
+bool subscribePlantState(TaskHandle_t task, uint32_t notifyBits) {
+    if (!task || notifyBits == 0) {
+        return false;
+    }
+    if (plant_task_subscribers.add({task, notifyBits})) {
+        return true;
+    }
+    Serial.println("[PLANT TASK] Subscriber table full");
+    return false;
+}
+
+void unsubscribePlantState(TaskHandle_t task) {
+    plant_task_subscribers.remove([task](const PlantSubscriber &sub) { return sub.task == task; });
+}
+
+} // namespace Tasks
+} // namespace PlantMonitor
@@ -0,0 +1,48 @@
+#pragma once
+#include <Arduino.h>
+#include "app-config.h"
+#include "plant-state-machine.h"
+
+/*!
+ * \file plant-task.h
+ * \brief Task evaluating plant health
+ *
+ * The task sleeps until the sensor task commits a new sample (or, when samples
+ * stop, until the PLANT_EVAL_INTERVAL_MS deadline) and only then runs the plant
+ * state machine, away from the display core. Tasks interested in the result
+ * subscribe to state changes instead of polling getCurrentPlantState().
+ */
+
+#define PLANT_MAX_SUBSCRIBERS 2 //!< Maximum number of plant state subscribers
+
+namespace PlantMonitor {
+namespace Tasks {
+
+/*!
+ * \brief Start the plant task
+ * \param stackSize Stack size for the task
+ * \param priority Task priority
+ * \param core Core to pin the task to
+ */
+void startPlantTask(
+    uint32_t stackSize = Config::Tasks::PLANT_STACK_SIZE,
+    UBaseType_t priority = Config::Tasks::PLANT_PRIORITY,
+    BaseType_t core = Config::Tasks::PLANT_CORE);
+
+/*!
+ * \brief Get a task notification whenever the plant state changes
+ * \param task Task to notify
+ * \param notifyBits Bits set in the task's notification value (eSetBits)
+ * \return true if subscribed, false if the subscriber table is full
+ * \note The task then reads the new state with getCurrentPlantState().
+ */
+bool subscribePlantState(TaskHandle_t task, uint32_t notifyBits);
+
+/*!
+ * \brief Remove a subscription
+ * \param task Task passed to subscribePlantState()
+ */
+void unsubscribePlantState(TaskHandle_t task);
+
+} // namespace Tasks
+} // namespace PlantMonitor
@@ -0,0 +1,134 @@
+#pragma once
+#include <Arduino.h>
+#include "esp_timer.h"
+#include "sensor-task.h"
+#include "utils/history-ring/history-ring.h"
+
+/*!
+ * \file sensor-history.h
+ * \brief Compact in-RAM sensor history (24 h of one-minute records)
+ *
+ * The sensor task folds every raw sample into a one-minute aggregate and
+ * appends it to a fixed-size ring of packed fixed-point records. At 12 bytes
+ * per record, a full day costs about 17 KB of static RAM and no heap.
+ *
+ * \note Storing every 2 s sample for 24 h (43200 records) would need well
+ *       over 100 KB even at 4 bytes per record, which the ESP32 cannot spare
+ *       next to BLE and TLS; hence the one-minute aggregation.
+ */
+
+namespace PlantMonitor {
+namespace Tasks {
+
+constexpr uint32_t SENSOR_HISTORY_INTERVAL_S = 60;  //!< Seconds folded into one record
+constexpr size_t SENSOR_HISTORY_CAPACITY = 24 * 60; //!< Records held (24 h)
+
+/*!
+ * \struct SensorHistoryRecord
+ * \brief Packed fixed-point aggregate of the samples taken in one interval
+ */
+struct SensorHistoryRecord {
+    uint32_t timestamp;  //!< End of the interval (historyNowS())
+    int16_t temperature; //!< Mean temperature (centi-°C)
+    uint16_t humidity;   //!< Mean air humidity (centi-%)
+    uint8_t moisture;    //!< Mean soil moisture (%)
+    uint8_t light;       //!< Share of samples with light detected (%)
+    uint16_t samples;    //!< Number of raw samples aggregated
+};
+
+static_assert(sizeof(SensorHistoryRecord) == 12, "SensorHistoryRecord must stay packed");
+
+/*!
+ * \brief History ring type shared by the sensor task and its readers
+ */
+using SensorHistory = Utils::HistoryRing<SensorHistoryRecord, SENSOR_HISTORY_CAPACITY>;
+
+/*!
+ * \brief Current history timestamp: seconds since boot
+ *
+ * Taken from the 64-bit esp_timer clock rather than millis(), which wraps
+ * after 49.7 days and would break the ascending order range() searches on.
+ * In 32-bit seconds this only wraps after 136 years.
+ */
+inline uint32_t historyNowS() {
+    return static_cast<uint32_t>(esp_timer_get_time() / 1000000LL);
+}
+
+/*!
+ * \brief Temperature of a record in °C
+ */
+inline float historyTemperature(const SensorHistoryRecord &r) {
+    return r.temperature / 100.0f;
+}
+
+/*!
+ * \brief Air humidity of a record in %
+ */
+inline float historyHumidity(const SensorHistoryRecord &r) {
+    return r.humidity / 100.0f;
+}
+
+/*!
+ * \class SensorHistoryAggregator
+ * \brief Accumulates raw samples and emits one packed record per interval
+ */
+class SensorHistoryAggregator {
+  public:
+    /*!
+     * \brief Add a raw sample to the current interval
+     * \param data Sensor reading
+     */
+    void add(const SensorData &data) {
+        m_temperature += data.temperature;
+        m_humidity += data.humidity;
+        m_moisture += data.moisture;
+        m_light += data.lightDetected ? 1u : 0u;
+        m_samples++;
+    }
+
+    /*!
+     * \brief Get the number of samples in the current interval
+     */
+    uint16_t samples() const {
+        return m_samples;
+    }
+
+    /*!
+     * \brief Close the current interval
+     * \param timestamp Record timestamp (historyNowS())
+     * \param[out] out Packed record
+     * \return true if at least one sample was aggregated
+     */
+    bool flush(uint32_t timestamp, SensorHistoryRecord &out) {
+        if (m_samples == 0) {
+            return false;
+        }
+
+        const float n = static_cast<float>(m_samples);
+        out.timestamp = timestamp;
+        out.temperature = static_cast<int16_t>(constrain(lroundf(m_temperature / n * 100.0f), -32768L, 32767L));
+        out.humidity = static_cast<uint16_t>(constrain(lroundf(m_humidity / n * 100.0f), 0L, 10000L));
+        out.moisture = static_cast<uint8_t>(constrain(lroundf(m_moisture / n), 0L, 100L));
+        out.light = static_cast<uint8_t>((m_light * 100u + m_samples / 2u) / m_samples);
+        out.samples = m_samples;
+
+        *this = SensorHistoryAggregator();
+        return true;
+    }
+
+  private:
+    float m_temperature = 0.0f; //!< Sum of temperatures
+    float m_humidity = 0.0f;    //!< Sum of humidities
+    float m_moisture = 0.0f;    //!< Sum of moisture levels
+    uint32_t m_light = 0;       //!< Samples with light detected
+    uint16_t m_samples = 0;     //!< Samples in the interval
+};
+
+/*!
+ * \brief Get the sensor history ring (read-only, safe from any task)
+ * \return Reference to the shared history
+ */
+const SensorHistory &getSensorHistory();
+
+} // namespace Tasks
+} // namespace PlantMonitor
@@ -1,9 +1,19 @@
 #include "sensor-task.h"
+#include "sensor-history.h"
 
 #include "drivers/sensors/temperature-sensor/bme280-hal.h"
 #include "drivers/sensors/moisture-sensor/moisture-sensor-hal.h"
 #include "drivers/sensors/light-sensor/light-sensor.h"
+#include "drivers/sensors/adc-engine/adc-engine.h"
+#include "drivers/sensors/adc-engine/adc-continuous-backend.h"
 #include "tasks/plant/plant-config.h"
+#include "utils/seqlock/seqlock.h"
+#include "utils/deadline-scheduler/deadline-scheduler.h"
+#include "utils/derivative-filter/timed-derivative-filter.h"
+#include "utils/filter-pipeline/filter-pipeline.h"
+#include "utils/subscriber-table/subscriber-table.h"
+
+#include <freertos/semphr.h>
 
 using namespace PlantMonitor::Drivers;
 
@@ -14,8 +24,95 @@ static Bme280Hal *sensor_task_environmental_sensor = nullptr;
 static MoistureSensorHAL *sensor_task_moisture_sensor = nullptr;
 static LightSensor *sensor_task_light_sensor = nullptr;
 
-static SensorData sensor_task_latest_data;
-static SemaphoreHandle_t sensor_task_data_mutex = nullptr;
+static ContinuousAdcBackend sensor_task_adc_backend;
+static AdcEngine sensor_task_adc_engine(sensor_task_adc_backend);
+static bool sensor_task_adc_engine_running = false;
+
+static Utils::SeqLock<SensorData> sensor_task_latest_data;
+static SensorHistory sensor_task_history;
+static SensorHistoryAggregator sensor_task_history_aggregator;
+static uint32_t sensor_task_history_interval_start = 0;
+
+/*! \brief Spin attempts before a reader backs off for one tick */
+#define SENSOR_SNAPSHOT_SPIN_RETRIES 8
+
+// Per-source sampling schedule. Phases stagger the sources so I2C and ADC
+// work never lands in the same wake-up.
+#define SENSOR_ENVIRONMENT_PERIOD_MS 2000 //!< BME280 temperature / humidity
+#define SENSOR_ENVIRONMENT_PHASE_MS 0
+#define SENSOR_MOISTURE_PERIOD_MS 10000   //!< Soil moisture changes over minutes
+#define SENSOR_MOISTURE_PHASE_MS 500
+#define SENSOR_LIGHT_PERIOD_MS 1000       //!< Light reacts to shading / lamps quickly
+#define SENSOR_LIGHT_PHASE_MS 250
+
+/*! \brief analogRead() fallback: reads per measurement, reduced with a Hampel filter */
+#define SENSOR_ANALOG_BURST_SAMPLES 9
+
+// Soil probe calibration in 12-bit counts, shared by the engine and fallback paths
+#define SENSOR_MOISTURE_DRY_VALUE 3724 //!< Reading with the probe in dry air
+#define SENSOR_MOISTURE_WET_VALUE 0    //!< Reading with the probe in water
+
+/*! \brief Moisture samples in the trend fit (30 x 10 s = last 5 minutes) */
+#define SENSOR_MOISTURE_TREND_WINDOW 30
+
+/*!
+ * \enum SensorSource
+ * \brief Independently scheduled sensor sources (bit index in the due mask)
+ */
+enum SensorSource : uint8_t {
+    SENSOR_SOURCE_ENVIRONMENT = 0,
+    SENSOR_SOURCE_MOISTURE,
+    SENSOR_SOURCE_LIGHT,
+    SENSOR_SOURCE_COUNT
+};
+
+/*! \brief Mask with one bit set per sensor source */
+#define SENSOR_SOURCE_ALL ((1u << SENSOR_SOURCE_COUNT) - 1)
+
+static Utils::DeadlineScheduler<SENSOR_SOURCE_COUNT> sensor_task_scheduler;
+static Utils::TimedDerivativeFilter<SENSOR_MOISTURE_TREND_WINDOW> sensor_task_moisture_trend;
+
+// Per-channel filter chains. Medians reject single-sample glitches (I2C
+// hiccups, ADC spikes); clamps keep values inside the sensor's physical range.
+using TemperatureFilter = Utils::Pipeline<Utils::Median<3>, Utils::Clamp<-40, 85>>;
+using HumidityFilter = Utils::Pipeline<Utils::Median<3>, Utils::Clamp<0, 100>>;
+using MoistureFilter = Utils::Pipeline<Utils::Median<3>, Utils::Ema<1, 2>, Utils::Clamp<0, 100>>;
+using LightFilter = Utils::Pipeline<Utils::Median<3>, Utils::Clamp<0, 100>>;
+
+static TemperatureFilter sensor_task_temperature_filter;
+static HumidityFilter sensor_task_humidity_filter;
+static MoistureFilter sensor_task_moisture_filter;
+static LightFilter sensor_task_light_filter;
+
+/*!
+ * \struct SensorChannelStats
+ * \brief Streaming statistics of each channel for the current drain interval
+ */
+struct SensorChannelStats {
+    Utils::StreamingStats temperature;
+    Utils::StreamingStats humidity;
+    Utils::StreamingStats moisture;
+    Utils::StreamingStats light;
+};
+
+/*! \brief Maximum wait for the statistics lock before a reading is left out */
+#define SENSOR_STATS_LOCK_TIMEOUT_MS 10
+
+static SemaphoreHandle_t sensor_task_stats_mutex = nullptr;
+static SensorChannelStats sensor_task_stats;
+static uint32_t sensor_task_stats_start_ms = 0;
+
+/*!
+ * \struct SensorSubscriber
+ * \brief One notification target (task or callback)
+ */
+struct SensorSubscriber {
+    TaskHandle_t task;            //!< Task to notify (nullptr for callbacks)
+    uint32_t notifyBits;          //!< Bits set in the task's notification value
+    SensorDataCallback callback;  //!< Callback (nullptr for tasks)
+};
+
+static Utils::SubscriberTable<SensorSubscriber, SENSOR_MAX_SUBSCRIBERS> sensor_task_subscribers;
 
 static bool prv_init_sensors() {
     sensor_task_environmental_sensor = new Bme280Hal();
@@ -24,42 +121,203 @@ static bool prv_init_sensors() {
         return false;
     }
 
-    sensor_task_moisture_sensor = new MoistureSensorHAL();
+    // Analog channels are sampled in the background by the ADC engine; the HALs
+    // then read its latest block average instead of polling analogRead().
+    sensor_task_adc_engine.addChannel(Config::SOIL_MOISTURE_PIN);
+    sensor_task_adc_engine.addChannel(Config::LIGHT_SENSOR_PIN);
+    sensor_task_adc_engine_running = sensor_task_adc_engine.start();
+
+    if (sensor_task_adc_engine_running) {
+        // 16-bit block values: the oversampling gain reaches the percentages
+        sensor_task_moisture_sensor = new MoistureSensorHAL(SENSOR_MOISTURE_DRY_VALUE,
+                                                            SENSOR_MOISTURE_WET_VALUE,
+                                                            sensor_task_adc_engine.fineReader(),
+                                                            1,
+                                                            Utils::SampleReduction::Mean,
+                                                            ADC_ENGINE_FINE_BITS);
+        sensor_task_light_sensor = new LightSensor(Config::LIGHT_SENSOR_PIN, sensor_task_adc_engine.fineReader());
+    } else {
+        Serial.println("[WARN] ADC engine unavailable, falling back to analogRead()");
+        sensor_task_moisture_sensor = new MoistureSensorHAL(SENSOR_MOISTURE_DRY_VALUE,
+                                                            SENSOR_MOISTURE_WET_VALUE,
+                                                            nullptr,
+                                                            SENSOR_ANALOG_BURST_SAMPLES,
+                                                            Utils::SampleReduction::Hampel);
+        sensor_task_light_sensor = new LightSensor();
+    }
+
     if (!sensor_task_moisture_sensor->begin()) {
         Serial.println("[ERROR] Moisture sensor initialization failed");
         return false;
     }
-
-    sensor_task_light_sensor = new LightSensor();
     sensor_task_light_sensor->begin();
 
     Serial.println("[INIT] Sensors initialized");
     return true;
 }
 
-static bool prv_read_all_sensors(SensorData &data) {
-    if (!sensor_task_environmental_sensor || !sensor_task_moisture_sensor) {
+/*!
+ * \brief Read temperature and humidity from the BME280
+ * \param[out] data Sample to update
+ * \return true if the readings are valid
+ */
+static bool prv_read_environment(SensorData &data) {
+    if (!sensor_task_environmental_sensor) {
+        return false;
+    }
+
+    // One forced conversion, one burst read: temperature and humidity come from the same sample
+    Bme280Reading reading;
+    if (!sensor_task_environmental_sensor->readAll(reading) ||
+        isnan(reading.temperature) || isnan(reading.humidity)) {
+        Serial.println("[SENSORS] Invalid readings");
+        return false;
+    }
+
+    data.temperature = sensor_task_temperature_filter.apply(reading.temperature);
+    data.humidity = sensor_task_humidity_filter.apply(reading.humidity);
+    return true;
+}
+
+/*!
+ * \brief Check that analog readings are available
+ * \return false while the ADC engine has not completed its first block
+ */
+static bool prv_analog_ready() {
+    return !sensor_task_adc_engine_running || sensor_task_adc_engine.isReady();
+}
+
+/*!
+ * \brief Read the soil moisture level
+ * \param[out] data Sample to update
+ * \return true if the reading is valid
+ */
+static bool prv_read_moisture(SensorData &data) {
+    if (!sensor_task_moisture_sensor || !prv_analog_ready()) {
         return false;
     }
 
-    data.temperature = sensor_task_environmental_sensor->readTemperature();
-    data.humidity = sensor_task_environmental_sensor->readHumidity();
-    data.moisture = sensor_task_moisture_sensor->readMoistureLevel();
+    data.moisture = sensor_task_moisture_filter.apply(sensor_task_moisture_sensor->readMoisturePercent());
+    // Timestamped so a late or skipped wake-up does not skew the rate
+    data.moistureTrend = sensor_task_moisture_trend.apply(millis(), data.moisture) * 3600.0f;
+    return true;
+}
+
+/*!
+ * \brief Read the light sensor and apply the detection threshold
+ * \param[out] data Sample to update
+ * \return true if the reading is valid
+ */
+static bool prv_read_light(SensorData &data) {
+    if (!sensor_task_light_sensor || !prv_analog_ready()) {
+        return false;
+    }
 
-    // Read light sensor with averaging (10 samples to avoid spurious readings)
-    int lightRawAvg = sensor_task_light_sensor->readRawAverage(10);
-    float lightPercentage = (lightRawAvg * 100.0f) / 4095.0f;
+    // Block averages are already smoothed; analogRead() needs its own burst.
+    // Hampel drops spurious reads instead of averaging them in.
+    int lightRawAvg = sensor_task_adc_engine_running
+                          ? sensor_task_light_sensor->readRaw()
+                          : sensor_task_light_sensor->readRawFiltered(SENSOR_ANALOG_BURST_SAMPLES, Utils::SampleReduction::Hampel);
+    float lightFullScale = sensor_task_adc_engine_running ? static_cast<float>((1ul << ADC_ENGINE_FINE_BITS) - 1)
+                                                          : static_cast<float>((1ul << ADC_ENGINE_RAW_BITS) - 1);
+    float lightPercentage = sensor_task_light_filter.apply((lightRawAvg * 100.0f) / lightFullScale);
+    data.lightLevel = lightPercentage;
+    data.lightTimestampMs = millis();
 
     // Use configured percentage threshold from plant-config.h
-    using namespace PlantMonitor::Tasks;
     data.lightDetected = (lightPercentage >= LIGHT_DETECTION_THRESHOLD_PERCENT);
+    return true;
+}
 
-    if (isnan(data.temperature) || isnan(data.humidity)) {
-        Serial.println("[SENSORS] Invalid readings");
-        return false;
+/*!
+ * \brief Service the due sources
+ * \param due Bit mask of SensorSource values whose deadline was reached
+ * \param[in,out] data Working sample, updated field by field
+ * \return Bit mask of sources that produced a valid reading
+ */
+static uint32_t prv_read_due_sensors(uint32_t due, SensorData &data) {
+    uint32_t updated = 0;
+
+    if ((due & (1u << SENSOR_SOURCE_ENVIRONMENT)) && prv_read_environment(data)) {
+        updated |= 1u << SENSOR_SOURCE_ENVIRONMENT;
+    }
+    if ((due & (1u << SENSOR_SOURCE_MOISTURE)) && prv_read_moisture(data)) {
+        updated |= 1u << SENSOR_SOURCE_MOISTURE;
+    }
+    if ((due & (1u << SENSOR_SOURCE_LIGHT)) && prv_read_light(data)) {
+        updated |= 1u << SENSOR_SOURCE_LIGHT;
     }
 
-    return true;
+    return updated;
+}
+
+/*!
+ * \brief Fold fresh readings into the per-channel statistics
+ * \param updated Bit mask of sources that produced a valid reading
+ * \param data Working sample holding the readings
+ */
+static void prv_record_statistics(uint32_t updated, const SensorData &data) {
+    if (updated == 0 || !sensor_task_stats_mutex ||
+        xSemaphoreTake(sensor_task_stats_mutex, pdMS_TO_TICKS(SENSOR_STATS_LOCK_TIMEOUT_MS)) != pdTRUE) {
+        return;
+    }
+
+    if (updated & (1u << SENSOR_SOURCE_ENVIRONMENT)) {
+        sensor_task_stats.temperature.add(data.temperature);
+        sensor_task_stats.humidity.add(data.humidity);
+    }
+    if (updated & (1u << SENSOR_SOURCE_MOISTURE)) {
+        sensor_task_stats.moisture.add(data.moisture);
+    }
+    if (updated & (1u << SENSOR_SOURCE_LIGHT)) {
+        sensor_task_stats.light.add(data.lightLevel);
+    }
+
+    xSemaphoreGive(sensor_task_stats_mutex);
+}
+
+/*!
+ * \brief Fold a sample into the history, closing the interval when it elapses
+ * \param data Sample just committed
+ */
+static void prv_record_history(const SensorData &data) {
+    sensor_task_history_aggregator.add(data);
+
+    uint32_t nowS = historyNowS();
+    if (nowS - sensor_task_history_interval_start >= SENSOR_HISTORY_INTERVAL_S) {
+        SensorHistoryRecord record;
+        if (sensor_task_history_aggregator.flush(nowS, record)) {
+            sensor_task_history.push(record);
+        }
+        sensor_task_history_interval_start = nowS;
+    }
+}
+
+/*!
+ * \brief Claim a free subscriber slot and publish it
+ * \return true if a slot was available
+ */
+static bool prv_add_subscriber(TaskHandle_t task, uint32_t notifyBits, SensorDataCallback callback) {
+    if (sensor_task_subscribers.add({task, notifyBits, callback})) {
+        return true;
+    }
+    Serial.println("[SENSOR TASK] Subscriber table full");
+    return false;
+}
+
+/*!
+ * \brief Notify every active subscriber of a new commit
+ * \param data Sample just committed
+ * \param sequence Its sequence number
+ */
+static void prv_notify_subscribers(const SensorData &data, uint32_t sequence) {
+    sensor_task_subscribers.forEach([&](const SensorSubscriber &sub) {
+        if (sub.task) {
+            xTaskNotify(sub.task, sub.notifyBits, eSetBits);
+        } else if (sub.callback) {
+            sub.callback(data, sequence);
+        }
+    });
 }
 
 static void prv_sensor_task(void *pvParameters) {
@@ -68,22 +326,41 @@ static void prv_sensor_task(void *pvParameters) {
         vTaskDelete(nullptr);
     }
 
-    SensorData tempData;
+    sensor_task_scheduler.addSource(pdMS_TO_TICKS(SENSOR_ENVIRONMENT_PERIOD_MS), pdMS_TO_TICKS(SENSOR_ENVIRONMENT_PHASE_MS));
+    sensor_task_scheduler.addSource(pdMS_TO_TICKS(SENSOR_MOISTURE_PERIOD_MS), pdMS_TO_TICKS(SENSOR_MOISTURE_PHASE_MS));
+    sensor_task_scheduler.addSource(pdMS_TO_TICKS(SENSOR_LIGHT_PERIOD_MS), pdMS_TO_TICKS(SENSOR_LIGHT_PHASE_MS));
+    sensor_task_scheduler.start(xTaskGetTickCount());
+
+    SensorData tempData = {};
+    uint32_t validSources = 0;
+    sensor_task_history_interval_start = historyNowS();
+    sensor_task_stats_start_ms = millis();
 
     while (true) {
-        if (prv_read_all_sensors(tempData)) {
-            if (xSemaphoreTake(sensor_task_data_mutex, portMAX_DELAY)) {
-                sensor_task_latest_data = tempData;
-                xSemaphoreGive(sensor_task_data_mutex);
-            }
+        uint32_t due = sensor_task_scheduler.collectDue(xTaskGetTickCount());
+        uint32_t updated = prv_read_due_sensors(due, tempData);
+        validSources |= updated;
+        prv_record_statistics(updated, tempData);
+
+        // Publish once every source has contributed, then on each fresh reading
+        if (updated != 0 && validSources == SENSOR_SOURCE_ALL) {
+            sensor_task_latest_data.write(tempData);
+            prv_record_history(tempData);
+            prv_notify_subscribers(tempData, sensor_task_latest_data.sequence());
         }
 
-        vTaskDelay(pdMS_TO_TICKS(2000));
+        // Sleep exactly until the next deadline: read time does not shift the schedule
+        TickType_t wait = sensor_task_scheduler.timeUntilNext(xTaskGetTickCount());
+        if (wait > 0) {
+            vTaskDelay(wait);
+        }
     }
 }
 
 void startSensorTask(uint32_t stackSize, UBaseType_t priority, BaseType_t core) {
-    sensor_task_data_mutex = xSemaphoreCreateMutex();
+    if (!sensor_task_stats_mutex) {
+        sensor_task_stats_mutex = xSemaphoreCreateMutex();
+    }
 
     xTaskCreatePinnedToCore(
         prv_sensor_task,
@@ -96,16 +373,88 @@ void startSensorTask(uint32_t stackSize, UBaseType_t priority, BaseType_t core)
 }
 
 bool getLatestSensorData(SensorData &out) {
-    if (!sensor_task_data_mutex)
+    uint32_t sequence;
+    return getLatestSensorData(out, sequence);
+}
+
+bool getLatestSensorData(SensorData &out, uint32_t &sequence) {
+    SensorData copy;
+    uint32_t attempts = 0;
+
+    // A retry only happens if the copy overlapped a commit. Back off for a tick
+    // after a few spins so a reader can never starve a preempted writer.
+    while (!sensor_task_latest_data.tryRead(copy, sequence)) {
+        if (++attempts >= SENSOR_SNAPSHOT_SPIN_RETRIES) {
+            vTaskDelay(1);
+            attempts = 0;
+        }
+    }
+
+    if (sequence == 0) {
+        return false; // Nothing committed yet
+    }
+
+    out = copy;
+    return true;
+}
+
+uint32_t getSensorDataSequence() {
+    return sensor_task_latest_data.sequence();
+}
+
+bool subscribeSensorData(TaskHandle_t task, uint32_t notifyBits) {
+    if (!task || notifyBits == 0) {
         return false;
+    }
+    return prv_add_subscriber(task, notifyBits, nullptr);
+}
 
-    if (xSemaphoreTake(sensor_task_data_mutex, pdMS_TO_TICKS(50))) {
-        out = sensor_task_latest_data;
-        xSemaphoreGive(sensor_task_data_mutex);
-        return true;
+bool subscribeSensorData(SensorDataCallback callback) {
+    if (!callback) {
+        return false;
     }
+    return prv_add_subscriber(nullptr, 0, callback);
+}
 
-    return false;
+void unsubscribeSensorData(TaskHandle_t task) {
+    if (!task) {
+        return;
+    }
+    sensor_task_subscribers.remove([task](const SensorSubscriber &sub) { return sub.task == task; });
+}
+
+void unsubscribeSensorData(SensorDataCallback callback) {
+    if (!callback) {
+        return;
+    }
+    sensor_task_subscribers.remove([callback](const SensorSubscriber &sub) { return sub.callback == callback; });
+}
+
+bool drainSensorStatistics(SensorStatistics &out) {
+    if (!sensor_task_stats_mutex || xSemaphoreTake(sensor_task_stats_mutex, portMAX_DELAY) != pdTRUE) {
+        return false;
+    }
+
+    uint32_t now = millis();
+    out.intervalMs = now - sensor_task_stats_start_ms;
+    out.temperature = sensor_task_stats.temperature.summary();
+    out.humidity = sensor_task_stats.humidity.summary();
+    out.moisture = sensor_task_stats.moisture.summary();
+    out.light = sensor_task_stats.light.summary();
+
+    sensor_task_stats.temperature.reset();
+    sensor_task_stats.humidity.reset();
+    sensor_task_stats.moisture.reset();
+    sensor_task_stats.light.reset();
+    sensor_task_stats_start_ms = now;
+
+    xSemaphoreGive(sensor_task_stats_mutex);
+
+    return out.temperature.count + out.humidity.count + out.moisture.count + out.light.count > 0;
+}
+
+const SensorHistory &getSensorHistory() {
+    return sensor_task_history;
 }
 
 } // namespace Tasks
@@ -1,6 +1,7 @@
 #pragma once
 #include <Arduino.h>
 #include "app-config.h"
+#include "utils/streaming-stats/streaming-stats.h"
 
 /*!
  * \file sensor-task.h
@@ -9,9 +10,20 @@
  * This task is responsible for periodically reading data from the connected sensors (temperature, humidity, soil moisture, light),
  * processing the data (e.g., applying filters), and making it available to other tasks such as the display and MQTT communication tasks.
  * 
- * The task runs in its own FreeRTOS thread and uses a thread-safe mechanism to share the latest sensor data with other tasks.
+ * Each source (BME280, soil moisture, light) is sampled on its own period and phase by a
+ * deadline scheduler, so slow channels cost less bus traffic and the schedule does not drift
+ * with read time.
+ *
+ * The task runs in its own FreeRTOS thread and publishes the latest sensor data through a sequence lock,
+ * so readers on either core never block and never observe a half-written sample.
+ *
+ * Every valid reading is also folded into per-channel streaming statistics (count, mean, standard
+ * deviation, min/max, percentiles), which a periodic consumer such as the MQTT publisher drains once
+ * per report interval.
  */
 
+#define SENSOR_MAX_SUBSCRIBERS 4 //!< Maximum number of concurrent sensor data subscribers
+
 namespace PlantMonitor {
 namespace Tasks {
 
@@ -24,8 +36,31 @@ struct SensorData {
     float humidity;
     float moisture;
     bool lightDetected;
+    float moistureTrend; //!< Soil moisture rate of change per hour (least-squares over the recent window)
+    float lightLevel;          //!< Light level (% of full scale)
+    uint32_t lightTimestampMs; //!< millis() when lightLevel was read (0 = no reading yet)
+};
+
+/*!
+ * \struct SensorStatistics
+ * \brief Per-channel statistics of every reading since the last drain
+ */
+struct SensorStatistics {
+    uint32_t intervalMs;             //!< Time covered by the statistics
+    Utils::StatsSummary temperature; //!< Air temperature (°C)
+    Utils::StatsSummary humidity;    //!< Air humidity (%)
+    Utils::StatsSummary moisture;    //!< Soil moisture (%)
+    Utils::StatsSummary light;       //!< Light level (% of full scale)
 };
 
+/*!
+ * \brief Callback invoked for every committed sample
+ * \param data Sample just committed
+ * \param sequence Sequence number of the sample
+ * \note Runs in the sensor task context: keep it short and never block.
+ */
+using SensorDataCallback = void (*)(const SensorData &data, uint32_t sequence);
+
 /*!
  * \brief Start the sensor task
  * \param stackSize Stack size for the task (default: 4096 bytes)
@@ -40,9 +75,65 @@ void startSensorTask(
 /*!
  * \brief Get the latest sensor data in a thread-safe manner
  * \param out Reference to SensorData structure to populate
- * \return true if data was successfully retrieved, false otherwise
+ * \return true if data was successfully retrieved, false if no sample was committed yet
+ * \note Lock-free: the call never waits on the sensor task.
  */
 bool getLatestSensorData(SensorData &out);
 
+/*!
+ * \brief Get the latest sensor data together with its sequence number
+ * \param out Reference to SensorData structure to populate
+ * \param[out] sequence Number of samples committed so far (the copy belongs to this one)
+ * \return true if data was successfully retrieved, false if no sample was committed yet
+ */
+bool getLatestSensorData(SensorData &out, uint32_t &sequence);
+
+/*!
+ * \brief Get the number of samples committed so far
+ * \return Sequence number of the latest sample (0 before the first one)
+ * \note Cheap enough to poll: readers can compare it against the last value they
+ *       processed and skip work when nothing changed.
+ */
+uint32_t getSensorDataSequence();
+
+/*!
+ * \brief Take the statistics accumulated since the previous call and start a new interval
+ * \param[out] out Per-channel summaries
+ * \return true if at least one reading was accumulated
+ * \note Meant for a single periodic consumer: each reading is reported by exactly one drain.
+ */
+bool drainSensorStatistics(SensorStatistics &out);
+
+/*!
+ * \brief Get a task notification whenever a new sample is committed
+ * \param task Task to notify
+ * \param notifyBits Bits set in the task's notification value (eSetBits), so the
+ *        subscriber can multiplex sensor updates with its own events
+ * \return true if subscribed, false if the subscriber table is full
+ * \note The task typically blocks in xTaskNotifyWait() and then calls
+ *       getLatestSensorData(); several commits may coalesce into one wake-up.
+ */
+bool subscribeSensorData(TaskHandle_t task, uint32_t notifyBits);
+
+/*!
+ * \brief Get a callback whenever a new sample is committed
+ * \param callback Function called from the sensor task after each commit
+ * \return true if subscribed, false if the subscriber table is full
+ */
+bool subscribeSensorData(SensorDataCallback callback);
+
+/*!
+ * \brief Remove a task subscription
+ * \param task Task passed to subscribeSensorData()
+ * \note A notification already in flight may still be delivered once.
+ */
+void unsubscribeSensorData(TaskHandle_t task);
+
+/*!
+ * \brief Remove a callback subscription
+ * \param callback Callback passed to subscribeSensorData()
+ */
+void unsubscribeSensorData(SensorDataCallback callback);
+
 } // namespace Tasks
 } // namespace PlantMonitor
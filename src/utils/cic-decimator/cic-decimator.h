@@ -0,0 +1,176 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/*!
+ * \file cic-decimator.h
+ * \brief Integer CIC (cascaded integrator-comb) decimator for oversampled ADC streams
+ *
+ * Every input sample runs through Order integrators; every R-th sample the
+ * integrator output runs through Order combs and one output is produced.
+ * Order 1 is plain accumulate-and-dump (the block sum); higher orders give
+ * a sharper anti-alias response for the same decimation.
+ *
+ * Averaging R samples of white noise lowers it by sqrt(R), i.e. half a bit
+ * per doubling of R: 256x oversampling turns a noisy 12-bit ADC into about
+ * 16 effective bits. value() rescales the output to the requested width.
+ *
+ * Arithmetic is modular (unsigned wrap-around), which is exact for CIC
+ * filters as long as the final output fits Acc: InBits + Order * log2(R)
+ * bits. Per input sample the cost is Order additions.
+ *
+ * Typical usage:
+ * \code
+ * CicDecimator<2> cic(64);           // Order 2, 64x decimation
+ * if (cic.push(adcRead())) {
+ *     uint16_t fine = cic.value(12, 16); // 12-bit input, 16-bit output
+ * }
+ * \endcode
+ */
+
+namespace PlantMonitor {
+namespace Utils {
+
+/*!
+ * \class CicDecimator
+ * \brief CIC decimator of order Order with run-time decimation factor
+ * \tparam Order Number of integrator / comb stages (1 = accumulate-and-dump)
+ * \tparam Acc Unsigned accumulator type (uint64_t for wide or high-order filters)
+ */
+template <unsigned Order, typename Acc = uint32_t>
+class CicDecimator {
+    static_assert(Order >= 1 && Order <= 4, "CicDecimator supports order 1 to 4");
+    static_assert(Acc(0) < Acc(-1), "CicDecimator accumulator must be unsigned");
+
+  public:
+    /*!
+     * \brief Constructor
+     * \param decimation Input samples per output (R, at least 1)
+     */
+    explicit CicDecimator(uint32_t decimation = 1) {
+        configure(decimation);
+    }
+
+    /*!
+     * \brief Change the decimation factor and reset the state
+     * \param decimation Input samples per output (R, at least 1)
+     */
+    void configure(uint32_t decimation) {
+        m_decimation = decimation > 0 ? decimation : 1;
+        m_gain = 1;
+        for (unsigned i = 0; i < Order; ++i) {
+            m_gain *= m_decimation;
+        }
+        reset();
+    }
+
+    /*!
+     * \brief Feed one input sample
+     * \param sample Raw (non-negative) sample
+     * \return true when a new output is available
+     */
+    bool push(uint32_t sample) {
+        Acc x = static_cast<Acc>(sample);
+        for (unsigned i = 0; i < Order; ++i) {
+            m_integrators[i] += x;
+            x = m_integrators[i];
+        }
+
+        if (++m_phase < m_decimation) {
+            return false;
+        }
+        m_phase = 0;
+
+        for (unsigned i = 0; i < Order; ++i) {
+            Acc delayed = m_combs[i];
+            m_combs[i] = x;
+            x -= delayed;
+        }
+        m_output = x;
+        m_outputs++;
+        return true;
+    }
+
+    /*!
+     * \brief Get the last output at full gain (sum scaled by R^Order)
+     */
+    Acc raw() const {
+        return m_output;
+    }
+
+    /*!
+     * \brief Get the last output normalized to a given resolution
+     * \param inBits Resolution of the input samples
+     * \param outBits Resolution of the result (more than inBits adds fractional bits)
+     * \return Mean input shifted by (outBits - inBits), rounded and capped at 2^outBits - 1
+     * \note Uses one 64-bit division per output, never per input sample.
+     */
+    uint32_t value(unsigned inBits, unsigned outBits) const {
+        uint64_t num = static_cast<uint64_t>(m_output);
+        uint64_t den = m_gain;
+        if (outBits >= inBits) {
+            num <<= (outBits - inBits);
+        } else {
+            den <<= (inBits - outBits);
+        }
+        uint64_t result = (num + den / 2) / den;
+        uint64_t fullScale = (1ull << outBits) - 1;
+        return static_cast<uint32_t>(result < fullScale ? result : fullScale);
+    }
+
+    /*!
+     * \brief Get the decimation factor
+     */
+    uint32_t decimation() const {
+        return m_decimation;
+    }
+
+    /*!
+     * \brief Get the number of outputs produced since the last reset
+     */
+    uint32_t outputs() const {
+        return m_outputs;
+    }
+
+    /*!
+     * \brief Get the number of input samples in the current (incomplete) output
+     */
+    uint32_t pending() const {
+        return m_phase;
+    }
+
+    /*!
+     * \brief Get the number of outputs to discard after a reset
+     *
+     * Combs of order N need N outputs to fill their delay lines; the first
+     * Order - 1 outputs of an order > 1 filter are a transient.
+     */
+    static constexpr unsigned settlingOutputs() {
+        return Order - 1;
+    }
+
+    /*!
+     * \brief Clear the filter state (keeps the decimation factor)
+     */
+    void reset() {
+        for (unsigned i = 0; i < Order; ++i) {
+            m_integrators[i] = 0;
+            m_combs[i] = 0;
+        }
+        m_phase = 0;
+        m_output = 0;
+        m_outputs = 0;
+    }
+
+  private:
+    Acc m_integrators[Order]; //!< Integrator stages (run at the input rate)
+    Acc m_combs[Order];       //!< Comb delay lines (run at the output rate)
+    Acc m_output;             //!< Last output at full gain
+    uint64_t m_gain;          //!< R^Order
+    uint32_t m_decimation;    //!< R
+    uint32_t m_phase;         //!< Inputs since the last output
+    uint32_t m_outputs;       //!< Outputs since the last reset
+};
+
+} // namespace Utils
+} // namespace PlantMonitor
@@ -1,5 +1,12 @@
 #include "config.h"
 #include <Preferences.h>
+#include <cmath>
+#include <cstring>
+
+/// \brief Number of params a presence mask announces.
+static std::size_t prv_mask_count(uint32_t mask) {
+    return static_cast<std::size_t>(__builtin_popcount(mask));
+}
 
 bool ConfigHandler::load(AppConfig &out) {
     Preferences prefs;
@@ -23,12 +30,14 @@ bool ConfigHandler::load(AppConfig &out) {
 
     // Params count
     const uint32_t count = prefs.getUInt(kKeyParCount, 0);
+    const uint32_t mask = prefs.getUInt(kKeyParMask, 0);
 
     // Validate count before allocating
-    if (count > kMaxParams) {
+    if (count > kMaxParams || (mask != 0 && prv_mask_count(mask) != count)) {
         prefs.end();
         return false;
     }
+    out.paramMask = mask;
 
     out.params.clear();
     out.params.resize(count);
@@ -64,12 +73,17 @@ bool ConfigHandler::save(const AppConfig &cfg) {
     // Save params count + blob
     const uint32_t count = static_cast<uint32_t>(cfg.params.size());
 
-    if (count > kMaxParams) {
+    if (count > kMaxParams || (cfg.paramMask != 0 && prv_mask_count(cfg.paramMask) != count)) {
         prefs.end();
         return false;
     }
 
     prefs.putUInt(kKeyParCount, count);
+    if (cfg.paramMask != 0) {
+        prefs.putUInt(kKeyParMask, cfg.paramMask);
+    } else {
+        prefs.remove(kKeyParMask);
+    }
 
     const std::size_t bytes = static_cast<std::size_t>(count) * sizeof(float);
 
@@ -181,6 +195,11 @@ static bool prv_parse_quoted_string(const char *&p, std::string &out) {
 
 static bool prv_parse_float(const char *&p, float &out) {
     prv_skip_spaces(p);
+    if (std::strncmp(p, "null", 4) == 0) {
+        out = NAN; // Not set
+        p += 4;
+        return true;
+    }
     char *endPtr = nullptr;
     out = std::strtof(p, &endPtr);
     if (endPtr == p)
@@ -262,4 +281,49 @@ bool ConfigHandler::parseAppCfg(const std::string &msg, AppConfig &cfg) {
     }
 
     return foundSsid && foundPass;
-}
\ No newline at end of file
+}
+
+bool ConfigHandler::findParam(const AppConfig &cfg, std::size_t index, float &value) {
+    if (cfg.paramMask == 0) {
+        if (index >= cfg.params.size()) {
+            return false;
+        }
+        value = cfg.params[index];
+        return true;
+    }
+
+    if (index >= kMaxParams || (cfg.paramMask & (1u << index)) == 0) {
+        return false;
+    }
+    // Present values are packed in index order: count the ones below
+    const std::size_t slot = prv_mask_count(cfg.paramMask & ((1u << index) - 1u));
+    if (slot >= cfg.params.size()) {
+        return false;
+    }
+    value = cfg.params[slot];
+    return true;
+}
+
+bool ConfigHandler::setParam(AppConfig &cfg, std::size_t index, float value) {
+    if (index >= kMaxParams) {
+        return false;
+    }
+
+    if (cfg.paramMask == 0 && !cfg.params.empty()) {
+        // Dense: pad the gap with "not set"
+        if (index >= cfg.params.size()) {
+            cfg.params.resize(index + 1, NAN);
+        }
+        cfg.params[index] = value;
+        return true;
+    }
+
+    const std::size_t slot = prv_mask_count(cfg.paramMask & ((1u << index) - 1u));
+    if (cfg.paramMask & (1u << index)) {
+        cfg.params[slot] = value;
+    } else {
+        cfg.params.insert(cfg.params.begin() + static_cast<std::ptrdiff_t>(slot), value);
+        cfg.paramMask |= 1u << index;
+    }
+    return true;
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <cctype>  // std::isspace (used by parser implementation)
@@ -18,6 +19,8 @@
  * - Data is stored under ConfigHandler::kNamespace.
  * - A boolean validity marker ("ok") is used to determine whether the configuration
  *   is complete and safe to use.
+ * - Params are stored dense (one float per index) or sparse (only the present
+ *   values, plus a presence mask), see AppConfig::paramMask.
  */
 
 /// \brief Application configuration payload.
@@ -35,6 +38,15 @@ struct AppConfig {
    * The meaning/order of these values is application-specific.
    */
     std::vector<float> params;
+
+    /*!
+   * \brief Presence mask of sparse params (0 = dense).
+   *
+   * When non-zero, bit i set means parameter i is present and params holds
+   * only the present values, in ascending index order. Use
+   * ConfigHandler::findParam() / setParam() rather than indexing params.
+   */
+    uint32_t paramMask = 0;
 };
 
 /*!
@@ -135,6 +147,7 @@ class ConfigHandler {
      * - The first element must be a quoted SSID string.
      * - The second element must be a quoted password string.
      * - Remaining elements are optional floats, separated by commas, until ']'.
+ *   A null element is stored as NaN (parameter not set).
      *
      * Examples:
      * \code
@@ -148,6 +161,24 @@ class ConfigHandler {
      */
     static bool parseAppCfg(const std::string &msg, AppConfig &cfg);
 
+    /*!
+     * \brief Look up parameter @p index in a dense or sparse configuration.
+     * \param cfg Configuration.
+     * \param index Logical parameter index (< kMaxParams).
+     * \param[out] value Parameter value (may be NaN in a dense config: "not set").
+     * \return true if the parameter is present.
+     */
+    static bool findParam(const AppConfig &cfg, std::size_t index, float &value);
+
+    /*!
+     * \brief Set parameter @p index, keeping the configuration sparse unless it is dense already.
+     * \param cfg Configuration (an empty one becomes sparse).
+     * \param index Logical parameter index (< kMaxParams).
+     * \param value Parameter value.
+     * \return false if @p index is out of range.
+     */
+    static bool setParam(AppConfig &cfg, std::size_t index, float value);
+
   private:
     /// \brief NVS key used as "configuration valid" marker.
     static constexpr const char *kKeyOk = "ok";
@@ -161,6 +192,9 @@ class ConfigHandler {
     /// \brief NVS key for the stored number of float parameters.
     static constexpr const char *kKeyParCount = "p_cnt";
 
+    /// \brief NVS key for the presence mask of sparse params (absent = dense).
+    static constexpr const char *kKeyParMask = "p_mask";
+
     /*!
      * \brief NVS key for the raw parameters blob.
      *
@@ -0,0 +1,169 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/*!
+ * \file deadline-scheduler.h
+ * \brief Fixed-size periodic deadline scheduler for polling loops.
+ *
+ * Each source has its own period and phase. Deadlines advance by whole
+ * periods from the start time rather than from the moment the work finished,
+ * so the schedule never drifts by the time spent servicing a source. A source
+ * that falls behind skips the periods it missed (they are counted as overruns)
+ * and keeps its original phase.
+ *
+ * Times are plain tick counts; comparisons are wrap-safe as long as no wait
+ * exceeds half the counter range.
+ *
+ * Typical usage:
+ * \code
+ * DeadlineScheduler<2> scheduler;
+ * int fast = scheduler.addSource(pdMS_TO_TICKS(1000));
+ * int slow = scheduler.addSource(pdMS_TO_TICKS(10000), pdMS_TO_TICKS(500));
+ * scheduler.start(xTaskGetTickCount());
+ *
+ * while (true) {
+ *     uint32_t due = scheduler.collectDue(xTaskGetTickCount());
+ *     if (due & (1u << fast)) { ... }
+ *     if (due & (1u << slow)) { ... }
+ *     vTaskDelay(scheduler.timeUntilNext(xTaskGetTickCount()));
+ * }
+ * \endcode
+ */
+
+namespace PlantMonitor {
+namespace Utils {
+
+/*!
+ * \class DeadlineScheduler
+ * \brief Tracks the next deadline of up to N periodic sources
+ * \tparam N Maximum number of sources (at most 32, one bit each in the due mask)
+ */
+template <size_t N>
+class DeadlineScheduler {
+    static_assert(N > 0 && N <= 32, "DeadlineScheduler supports 1 to 32 sources");
+
+  public:
+    DeadlineScheduler() : m_count(0) {}
+
+    /*!
+     * \brief Register a periodic source (before start())
+     * \param period Ticks between two deadlines (must be non-zero)
+     * \param phase Offset of the first deadline from the start time
+     * \return Source id (bit index in the due mask), or -1 if full or invalid
+     */
+    int addSource(uint32_t period, uint32_t phase = 0) {
+        if (m_count >= N || period == 0) {
+            return -1;
+        }
+        Source &src = m_sources[m_count];
+        src.period = period;
+        src.phase = phase;
+        src.deadline = phase;
+        src.overruns = 0;
+        return static_cast<int>(m_count++);
+    }
+
+    /*!
+     * \brief Anchor every source's first deadline at \p now + phase
+     * \param now Current tick count
+     */
+    void start(uint32_t now) {
+        for (size_t i = 0; i < m_count; ++i) {
+            m_sources[i].deadline = now + m_sources[i].phase;
+            m_sources[i].overruns = 0;
+        }
+    }
+
+    /*!
+     * \brief Collect the sources whose deadline has been reached
+     *
+     * Each returned source has its deadline advanced past \p now by whole
+     * periods.
+     *
+     * \param now Current tick count
+     * \return Bit mask of due sources (bit i = source id i)
+     */
+    uint32_t collectDue(uint32_t now) {
+        uint32_t due = 0;
+        for (size_t i = 0; i < m_count; ++i) {
+            Source &src = m_sources[i];
+            if (!reached(now, src.deadline)) {
+                continue;
+            }
+            due |= 1u << i;
+
+            uint32_t late = now - src.deadline;
+            uint32_t skipped = late / src.period;
+            src.overruns += skipped;
+            src.deadline += (skipped + 1) * src.period;
+        }
+        return due;
+    }
+
+    /*!
+     * \brief Get the earliest pending deadline
+     * \return Tick count of the next deadline (0 if no source is registered)
+     */
+    uint32_t nextDeadline() const {
+        if (m_count == 0) {
+            return 0;
+        }
+        uint32_t next = m_sources[0].deadline;
+        for (size_t i = 1; i < m_count; ++i) {
+            if (static_cast<int32_t>(m_sources[i].deadline - next) < 0) {
+                next = m_sources[i].deadline;
+            }
+        }
+        return next;
+    }
+
+    /*!
+     * \brief Get the number of ticks to sleep until the next deadline
+     * \param now Current tick count
+     * \return Ticks until the next deadline (0 if one is already due)
+     */
+    uint32_t timeUntilNext(uint32_t now) const {
+        if (m_count == 0) {
+            return 0;
+        }
+        uint32_t next = nextDeadline();
+        return reached(now, next) ? 0 : next - now;
+    }
+
+    /*!
+     * \brief Get the number of periods a source skipped because it was serviced late
+     * \param id Source id
+     */
+    uint32_t overruns(int id) const {
+        return (id >= 0 && static_cast<size_t>(id) < m_count) ? m_sources[id].overruns : 0;
+    }
+
+    /*!
+     * \brief Get the number of registered sources
+     */
+    size_t size() const { return m_count; }
+
+  private:
+    /*!
+     * \struct Source
+     * \brief Schedule state of one periodic source
+     */
+    struct Source {
+        uint32_t period;   //!< Ticks between deadlines
+        uint32_t phase;    //!< Offset of the first deadline
+        uint32_t deadline; //!< Next deadline (absolute ticks)
+        uint32_t overruns; //!< Periods skipped so far
+    };
+
+    /// \brief Wrap-safe "now >= deadline".
+    static bool reached(uint32_t now, uint32_t deadline) {
+        return static_cast<int32_t>(now - deadline) >= 0;
+    }
+
+    Source m_sources[N]; //!< Registered sources
+    size_t m_count;      //!< Number of registered sources
+};
+
+} // namespace Utils
+} // namespace PlantMonitor
@@ -0,0 +1,166 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/*!
+ * \file timed-derivative-filter.h
+ * \brief Timestamp-aware derivative filter (least-squares slope over a window)
+ *
+ * Unlike DerivativeFilter, which assumes a fixed sample period, this filter
+ * takes (timestamp, value) pairs and returns a true rate per second, so jitter
+ * and dropped samples do not distort the result. The rate is the least-squares
+ * slope of the last N samples, which averages out measurement noise; with
+ * N = 2 it reduces to the plain two-point difference.
+ *
+ * The window is stored inline: no heap allocation.
+ *
+ * Typical usage:
+ * \code
+ * TimedDerivativeFilter<12> trend;
+ * float perSecond = trend.apply(millis(), moisture);
+ * float perHour = perSecond * 3600.0f;
+ * \endcode
+ */
+
+namespace PlantMonitor {
+namespace Utils {
+
+/*!
+ * \class TimedDerivativeFilter
+ * \brief Least-squares rate of change over the last N timestamped samples
+ * \tparam N Window size in samples (at least 2)
+ */
+template <size_t N>
+class TimedDerivativeFilter {
+    static_assert(N >= 2, "TimedDerivativeFilter needs at least two samples");
+
+  public:
+    TimedDerivativeFilter() : m_index(0), m_count(0), m_rate(0.0f) {}
+
+    /*!
+     * \brief Add a sample and compute the rate of change
+     * \param timestampMs Sample time in milliseconds (wrap-safe, must not go backwards)
+     * \param value Sample value
+     * \return Rate of change in value units per second (0 until two distinct timestamps)
+     * \note A sample with the same timestamp as the previous one replaces it;
+     *       an older sample is ignored and the previous rate is returned.
+     */
+    float apply(uint32_t timestampMs, float value) {
+        if (m_count > 0) {
+            const Sample &last = m_samples[newest()];
+            int32_t step = static_cast<int32_t>(timestampMs - last.timestampMs);
+            if (step < 0) {
+                return m_rate;
+            }
+            if (step == 0) {
+                m_samples[newest()].value = value;
+                m_rate = computeRate();
+                return m_rate;
+            }
+        }
+
+        m_samples[m_index] = { timestampMs, value };
+        m_index = (m_index + 1) % N;
+        if (m_count < N) {
+            m_count++;
+        }
+
+        m_rate = computeRate();
+        return m_rate;
+    }
+
+    /*!
+     * \brief Get the last computed rate
+     * \return Rate of change in value units per second
+     */
+    float getRate() const {
+        return m_rate;
+    }
+
+    /*!
+     * \brief Get the number of samples in the window
+     */
+    size_t getCount() const {
+        return m_count;
+    }
+
+    /*!
+     * \brief Get the time covered by the window
+     * \return Milliseconds between the oldest and newest sample
+     */
+    uint32_t getSpanMs() const {
+        if (m_count < 2) {
+            return 0;
+        }
+        return m_samples[newest()].timestampMs - m_samples[oldest()].timestampMs;
+    }
+
+    /*!
+     * \brief Reset the filter state
+     */
+    void reset() {
+        m_index = 0;
+        m_count = 0;
+        m_rate = 0.0f;
+    }
+
+  private:
+    /*!
+     * \struct Sample
+     * \brief One timestamped value
+     */
+    struct Sample {
+        uint32_t timestampMs; //!< Sample time
+        float value;          //!< Sample value
+    };
+
+    size_t newest() const {
+        return (m_index + N - 1) % N;
+    }
+
+    size_t oldest() const {
+        return (m_count < N) ? 0 : m_index;
+    }
+
+    /*!
+     * \brief Least-squares slope of the window
+     *
+     * Times are taken relative to the newest sample (in seconds) and both axes
+     * are centered, which keeps the float sums well conditioned even with
+     * large millis() values.
+     */
+    float computeRate() const {
+        if (m_count < 2) {
+            return 0.0f;
+        }
+
+        const uint32_t ref = m_samples[newest()].timestampMs;
+        float meanT = 0.0f;
+        float meanV = 0.0f;
+        for (size_t i = 0; i < m_count; ++i) {
+            const Sample &s = m_samples[i];
+            meanT += -static_cast<float>(ref - s.timestampMs) * 0.001f;
+            meanV += s.value;
+        }
+        meanT /= static_cast<float>(m_count);
+        meanV /= static_cast<float>(m_count);
+
+        float stv = 0.0f;
+        float stt = 0.0f;
+        for (size_t i = 0; i < m_count; ++i) {
+            const Sample &s = m_samples[i];
+            float dt = -static_cast<float>(ref - s.timestampMs) * 0.001f - meanT;
+            stv += dt * (s.value - meanV);
+            stt += dt * dt;
+        }
+        return (stt > 0.0f) ? stv / stt : 0.0f;
+    }
+
+    Sample m_samples[N]; //!< Window storage (circular)
+    size_t m_index;      //!< Next write position
+    size_t m_count;      //!< Samples in the window
+    float m_rate;        //!< Last computed rate (units per second)
+};
+
+} // namespace Utils
+} // namespace PlantMonitor
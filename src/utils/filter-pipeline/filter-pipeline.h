@@ -0,0 +1,246 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include "utils/median-filter/median-filter.h"
+#include "utils/moving-average/moving-average.h"
+
+/*!
+ * \file filter-pipeline.h
+ * \brief Compile-time chain of sample filters for sensor channels
+ *
+ * A Pipeline runs each sample through its stages in order. The chain is a
+ * std::tuple resolved at compile time: no virtual dispatch, no heap, and the
+ * compiler can inline the whole chain into the caller.
+ *
+ * A stage is any default-constructible type with:
+ * - float apply(float sample)
+ * - void reset()
+ *
+ * Stage parameters are template arguments. Floating point values cannot be
+ * template arguments in C++17, so ratios are given as Num/Den and bounds as
+ * integers.
+ *
+ * Typical usage:
+ * \code
+ * Pipeline<Median<5>, Ema<1, 4>, Clamp<0, 100>> moisture;
+ * float filtered = moisture.apply(raw);
+ *
+ * float block[64];
+ * moisture.apply(block, 64); // In place, one pass over the buffer
+ * \endcode
+ */
+
+namespace PlantMonitor {
+namespace Utils {
+
+/*!
+ * \class Median
+ * \brief Running median of the last N samples (rejects isolated spikes)
+ * \tparam N Window size (odd, so the median is a sample value)
+ */
+template <size_t N>
+class Median {
+    static_assert(N > 0 && (N % 2) == 1, "Median window must be odd");
+    static_assert(N <= MEDIAN_MAX_WINDOW, "Median window too large for the sorting networks");
+
+  public:
+    Median() : m_window(), m_index(0), m_count(0) {}
+
+    float apply(float sample) {
+        m_window[m_index] = sample;
+        m_index = (m_index + 1) % N;
+        if (m_count < N) {
+            m_count++;
+        }
+
+        // Sort a copy with the sorting network: the window keeps arrival order
+        float sorted[N];
+        for (size_t i = 0; i < m_count; ++i) {
+            sorted[i] = m_window[i];
+        }
+        if (m_count == N) {
+            return medianOf<float, N>(sorted);
+        }
+        // Until the window fills, the samples sit at the front of m_window
+        sortSmall(sorted, m_count);
+        return sorted[m_count / 2];
+    }
+
+    void reset() {
+        m_index = 0;
+        m_count = 0;
+    }
+
+  private:
+    float m_window[N]; //!< Last N samples (circular)
+    size_t m_index;    //!< Next write position
+    size_t m_count;    //!< Samples in the window
+};
+
+/*!
+ * \class Ema
+ * \brief Exponential moving average with smoothing factor Num/Den
+ * \tparam Num Numerator of the smoothing factor
+ * \tparam Den Denominator of the smoothing factor (1 = pass-through)
+ * \note The first sample seeds the average, so there is no ramp from zero.
+ */
+template <uint32_t Num, uint32_t Den>
+class Ema {
+    static_assert(Den > 0 && Num > 0 && Num <= Den, "Ema factor must be in (0, 1]");
+
+  public:
+    Ema() : m_value(0.0f), m_primed(false) {}
+
+    float apply(float sample) {
+        if (!m_primed) {
+            m_value = sample;
+            m_primed = true;
+        } else {
+            m_value += kAlpha * (sample - m_value);
+        }
+        return m_value;
+    }
+
+    void reset() {
+        m_primed = false;
+    }
+
+  private:
+    static constexpr float kAlpha = static_cast<float>(Num) / static_cast<float>(Den);
+
+    float m_value; //!< Current average
+    bool m_primed; //!< First sample seen
+};
+
+/*!
+ * \class Average
+ * \brief Moving average over the last N samples
+ * \tparam N Window size
+ */
+template <size_t N>
+class Average {
+  public:
+    float apply(float sample) {
+        m_average.addSample(sample);
+        return m_average.getAverage();
+    }
+
+    void reset() {
+        m_average.clear();
+    }
+
+  private:
+    StaticMovingAverage<float, N> m_average; //!< Running-sum window
+};
+
+/*!
+ * \class Clamp
+ * \brief Limit samples to [Lo, Hi]
+ * \tparam Lo Lower bound
+ * \tparam Hi Upper bound
+ */
+template <int32_t Lo, int32_t Hi>
+class Clamp {
+    static_assert(Lo <= Hi, "Clamp bounds are reversed");
+
+  public:
+    float apply(float sample) {
+        if (sample < static_cast<float>(Lo)) {
+            return static_cast<float>(Lo);
+        }
+        if (sample > static_cast<float>(Hi)) {
+            return static_cast<float>(Hi);
+        }
+        return sample;
+    }
+
+    void reset() {}
+};
+
+/*!
+ * \class Pipeline
+ * \brief Chain of filter stages applied left to right
+ * \tparam Stages Stage types (an empty pipeline passes samples through)
+ */
+template <typename... Stages>
+class Pipeline {
+  public:
+    Pipeline() = default;
+
+    Pipeline(const Pipeline &) = delete;
+    Pipeline &operator=(const Pipeline &) = delete;
+
+    /*!
+     * \brief Filter one sample through every stage
+     * \param sample Input sample
+     * \return Output of the last stage
+     */
+    float apply(float sample) {
+        return applyStages(sample, std::index_sequence_for<Stages...>{});
+    }
+
+    /*!
+     * \brief Filter a buffer in place
+     * \param samples Samples in time order, replaced by the filtered values
+     * \param count Number of samples
+     */
+    void apply(float *samples, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            samples[i] = apply(samples[i]);
+        }
+    }
+
+    /*!
+     * \brief Filter a buffer into another one
+     * \param in Samples in time order
+     * \param out Filtered samples (may alias \p in)
+     * \param count Number of samples
+     */
+    void apply(const float *in, float *out, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = apply(in[i]);
+        }
+    }
+
+    /*!
+     * \brief Reset every stage
+     */
+    void reset() {
+        resetStages(std::index_sequence_for<Stages...>{});
+    }
+
+    /*!
+     * \brief Access a stage by position
+     * \tparam I Stage index
+     */
+    template <size_t I>
+    typename std::tuple_element<I, std::tuple<Stages...>>::type &stage() {
+        return std::get<I>(m_stages);
+    }
+
+    /*!
+     * \brief Number of stages
+     */
+    static constexpr size_t size() {
+        return sizeof...(Stages);
+    }
+
+  private:
+    template <size_t... I>
+    float applyStages(float sample, std::index_sequence<I...>) {
+        ((sample = std::get<I>(m_stages).apply(sample)), ...);
+        return sample;
+    }
+
+    template <size_t... I>
+    void resetStages(std::index_sequence<I...>) {
+        (std::get<I>(m_stages).reset(), ...);
+    }
+
+    std::tuple<Stages...> m_stages; //!< Stage state, in application order
+};
+
+} // namespace Utils
+} // namespace PlantMonitor
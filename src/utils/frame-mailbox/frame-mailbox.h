@@ -0,0 +1,108 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+/*!
+ * \file frame-mailbox.h
+ * \brief Lock-free hand-off of whole framebuffers from a renderer to a flusher.
+ *
+ * Three buffers circulate: the renderer draws into its back buffer, the
+ * flusher streams its front buffer, and the mailbox parks the newest finished
+ * frame between them. Both sides only ever exchange pointers, so handing a
+ * frame over is O(1) and neither side waits for the other:
+ *
+ * - publish() swaps the finished back buffer into the mailbox and returns the
+ *   buffer to draw the next frame in. A frame the flusher had not picked up
+ *   yet is superseded (only the newest frame matters on a display).
+ * - take() swaps the flusher's finished front buffer into the mailbox and
+ *   returns the newest frame, or nullptr if nothing was published since the
+ *   last take().
+ *
+ * The "new frame" flag is kept in the low bit of the parked pointer, so the
+ * pointer and the flag always change together.
+ *
+ * Typical usage:
+ * \code
+ * FrameMailbox mailbox(spare);
+ *
+ * // Renderer task
+ * back = mailbox.publish(back);      // back now points at a free buffer
+ *
+ * // Flusher task
+ * if (uint8_t *frame = mailbox.take(front)) {
+ *     front = frame;
+ *     send(front);
+ * }
+ * \endcode
+ *
+ * \note One publishing task and one taking task. Buffers must be at least
+ *       2-byte aligned (any heap or static uint8_t array of a frame is).
+ */
+
+namespace PlantMonitor {
+namespace Utils {
+
+/*!
+ * \class FrameMailbox
+ * \brief Single-slot, latest-wins exchange of buffer pointers
+ */
+class FrameMailbox {
+  public:
+    /*!
+     * \brief Constructor
+     * \param spare Buffer parked in the mailbox (neither drawn into nor sent)
+     */
+    explicit FrameMailbox(uint8_t *spare = nullptr)
+        : m_slot(reinterpret_cast<uintptr_t>(spare)) {}
+
+    /*!
+     * \brief Park a spare buffer (before either side starts)
+     * \param spare Buffer parked in the mailbox
+     */
+    void reset(uint8_t *spare) {
+        m_slot.store(reinterpret_cast<uintptr_t>(spare), std::memory_order_release);
+    }
+
+    /*!
+     * \brief Hand a finished frame to the flusher (renderer side)
+     * \param frame Finished frame
+     * \param[out] superseded Set to true if an unsent frame was replaced
+     * \return Buffer to draw the next frame in
+     */
+    uint8_t *publish(uint8_t *frame, bool *superseded = nullptr) {
+        uintptr_t previous = m_slot.exchange(reinterpret_cast<uintptr_t>(frame) | kFresh, std::memory_order_acq_rel);
+        if (superseded != nullptr) {
+            *superseded = (previous & kFresh) != 0;
+        }
+        return reinterpret_cast<uint8_t *>(previous & ~kFresh);
+    }
+
+    /*!
+     * \brief Take the newest frame (flusher side)
+     * \param done Buffer the flusher has finished with (kept if nothing is new)
+     * \return Newest frame, or nullptr if nothing was published since the last take()
+     */
+    uint8_t *take(uint8_t *done) {
+        if ((m_slot.load(std::memory_order_acquire) & kFresh) == 0) {
+            return nullptr;
+        }
+        // Only this side clears the flag, so the exchanged-out slot is still fresh
+        uintptr_t latest = m_slot.exchange(reinterpret_cast<uintptr_t>(done), std::memory_order_acq_rel);
+        return reinterpret_cast<uint8_t *>(latest & ~kFresh);
+    }
+
+    /*!
+     * \brief Check whether a frame waits to be taken
+     */
+    bool pending() const {
+        return (m_slot.load(std::memory_order_acquire) & kFresh) != 0;
+    }
+
+  private:
+    static constexpr uintptr_t kFresh = 1; //!< Low pointer bit: frame not taken yet
+
+    std::atomic<uintptr_t> m_slot; //!< Parked buffer | kFresh
+};
+
+} // namespace Utils
+} // namespace PlantMonitor
@@ -0,0 +1,233 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+/*!
+ * \file glyph-font.h
+ * \brief Pre-scaled digit and unit glyphs blitted straight into a page-addressed framebuffer.
+ *
+ * Adafruit GFX draws a text size N character by plotting an N x N block for
+ * every pixel of its 5x7 font. For the few characters of a reading (digits,
+ * sign, decimal point, units) the scaled bitmaps are generated at compile time
+ * from the same 5x7 font data, stored as framebuffer-ready columns (one byte
+ * per 8-pixel page, LSB on top) and copied into the frame a whole column at a
+ * time. The output is pixel-identical to GFX text at the same size.
+ *
+ * Text is positioned on page boundaries (y multiple of 8), which is what
+ * makes every column a byte copy; x is free. Characters without a glyph
+ * advance like a space.
+ *
+ * Typical usage:
+ * \code
+ * char text[12];
+ * formatFixed(23.45f, 1, text, sizeof(text));            // "23.5", no printf
+ * int16_t x = (128 - GlyphFont<3>::textWidth(text)) / 2;
+ * GlyphFont<3>::draw(frame, 128, 16, x, 8, text);         // y = 64
+ * \endcode
+ */
+
+#define GLYPH_FONT_DEGREE '\xF8' //!< Degree sign (code page 437 position, as in the GFX font)
+
+namespace PlantMonitor {
+namespace Utils {
+
+namespace detail {
+
+/*!
+ * \brief 5x7 source glyphs, columns left to right, LSB on top (Adafruit glcdfont)
+ */
+constexpr uint8_t kGlyphSource[][5] = {
+    { 0x3E, 0x51, 0x49, 0x45, 0x3E }, // 0
+    { 0x00, 0x42, 0x7F, 0x40, 0x00 }, // 1
+    { 0x72, 0x49, 0x49, 0x49, 0x46 }, // 2
+    { 0x21, 0x41, 0x49, 0x4D, 0x33 }, // 3
+    { 0x18, 0x14, 0x12, 0x7F, 0x10 }, // 4
+    { 0x27, 0x45, 0x45, 0x45, 0x39 }, // 5
+    { 0x3C, 0x4A, 0x49, 0x49, 0x31 }, // 6
+    { 0x41, 0x21, 0x11, 0x09, 0x07 }, // 7
+    { 0x36, 0x49, 0x49, 0x49, 0x36 }, // 8
+    { 0x46, 0x49, 0x49, 0x29, 0x1E }, // 9
+    { 0x00, 0x60, 0x60, 0x00, 0x00 }, // .
+    { 0x08, 0x08, 0x08, 0x08, 0x08 }, // -
+    { 0x23, 0x13, 0x08, 0x64, 0x62 }, // %
+    { 0x3E, 0x41, 0x41, 0x41, 0x22 }, // C
+    { 0x7F, 0x09, 0x09, 0x09, 0x01 }, // F
+    { 0x00, 0x06, 0x09, 0x09, 0x06 }, // degree
+};
+
+constexpr size_t kGlyphCount = sizeof(kGlyphSource) / sizeof(kGlyphSource[0]);
+constexpr int kNoGlyph = -1;
+
+/*!
+ * \brief Map a character to its row in kGlyphSource
+ */
+constexpr int glyphIndex(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    switch (c) {
+        case '.':
+            return 10;
+        case '-':
+            return 11;
+        case '%':
+            return 12;
+        case 'C':
+            return 13;
+        case 'F':
+            return 14;
+        case GLYPH_FONT_DEGREE:
+            return 15;
+        default:
+            return kNoGlyph;
+    }
+}
+
+/*!
+ * \brief Glyph columns scaled by Scale, split into Scale page bytes each
+ */
+template <uint8_t Scale>
+struct ScaledGlyphs {
+    uint8_t columns[kGlyphCount][5 * Scale][Scale]; //!< [glyph][column][page]
+};
+
+/*!
+ * \brief Build the scaled bitmaps (evaluated by the compiler)
+ */
+template <uint8_t Scale>
+constexpr ScaledGlyphs<Scale> scaleGlyphs() {
+    ScaledGlyphs<Scale> out{};
+    for (size_t g = 0; g < kGlyphCount; ++g) {
+        for (size_t c = 0; c < 5; ++c) {
+            // Every source row becomes Scale rows of the 8 * Scale pixel cell
+            uint32_t tall = 0;
+            for (size_t row = 0; row < 8; ++row) {
+                if (kGlyphSource[g][c] & (1u << row)) {
+                    tall |= ((1u << Scale) - 1u) << (row * Scale);
+                }
+            }
+            for (size_t dx = 0; dx < Scale; ++dx) {
+                for (size_t page = 0; page < Scale; ++page) {
+                    out.columns[g][c * Scale + dx][page] = static_cast<uint8_t>(tall >> (page * 8));
+                }
+            }
+        }
+    }
+    return out;
+}
+
+} // namespace detail
+
+/*!
+ * \class GlyphFont
+ * \brief Digits, '.', '-', '%', 'C', 'F' and the degree sign at text size Scale
+ * \tparam Scale GFX text size (cell of 6 * Scale x 8 * Scale pixels, Scale pages tall)
+ */
+template <uint8_t Scale>
+class GlyphFont {
+    static_assert(Scale >= 1 && Scale <= 4, "Scaled columns are built in 32 bits");
+
+  public:
+    static constexpr uint8_t kWidth = 5 * Scale;   //!< Inked columns per glyph
+    static constexpr uint8_t kAdvance = 6 * Scale; //!< Cell width (same as GFX)
+    static constexpr uint8_t kPages = Scale;       //!< Cell height in 8-pixel pages
+
+    /*!
+     * \brief Get the width GFX would report for a string (cells, including the last gap)
+     */
+    static int16_t textWidth(const char *text) {
+        int16_t width = 0;
+        for (; *text != '\0'; ++text) {
+            width += kAdvance;
+        }
+        return width;
+    }
+
+    /*!
+     * \brief Draw a string, OR-ing the glyphs into the frame (transparent background)
+     * \param frame Page-major framebuffer (frameWidth bytes per page)
+     * \param frameWidth Columns per page
+     * \param framePages Pages in the framebuffer
+     * \param x Left edge (may be negative; clipped)
+     * \param page Top page (y / 8)
+     * \param text Null-terminated string
+     */
+    static void draw(uint8_t *frame, int16_t frameWidth, uint8_t framePages, int16_t x, uint8_t page, const char *text) {
+        for (; *text != '\0'; ++text, x += kAdvance) {
+            int index = detail::glyphIndex(*text);
+            if (index == detail::kNoGlyph || x >= frameWidth || x + kWidth <= 0) {
+                continue;
+            }
+            const auto &columns = kGlyphs.columns[index];
+            int16_t first = x < 0 ? -x : 0;
+            int16_t last = x + kWidth > frameWidth ? frameWidth - x : kWidth;
+            for (uint8_t p = 0; p < kPages && page + p < framePages; ++p) {
+                uint8_t *row = frame + static_cast<size_t>(page + p) * frameWidth;
+                for (int16_t c = first; c < last; ++c) {
+                    row[x + c] |= columns[c][p];
+                }
+            }
+        }
+    }
+
+  private:
+    static constexpr detail::ScaledGlyphs<Scale> kGlyphs = detail::scaleGlyphs<Scale>(); //!< Flash-resident bitmaps
+};
+
+/*!
+ * \brief Format a value with a fixed number of decimals, without printf
+ * \param value Value to format
+ * \param decimals Digits after the point (0-4)
+ * \param[out] out Destination
+ * \param size Destination size (at least 3)
+ * \return Length written; "--" if the value is not finite or does not fit
+ * \note Halves round away from zero, and values rounding to zero lose their
+ *       sign ("0.0" rather than printf's "-0.0").
+ */
+inline size_t formatFixed(float value, uint8_t decimals, char *out, size_t size) {
+    static constexpr uint32_t kPow10[] = { 1, 10, 100, 1000, 10000 };
+    if (decimals > 4) {
+        decimals = 4;
+    }
+
+    float scaled = std::fabs(value) * static_cast<float>(kPow10[decimals]) + 0.5f;
+    if (!std::isfinite(value) || scaled >= 4.0e9f) {
+        out[0] = '-';
+        out[1] = '-';
+        out[2] = '\0';
+        return 2;
+    }
+
+    uint32_t n = static_cast<uint32_t>(scaled);
+    char digits[16];
+    size_t count = 0;
+    do {
+        digits[count++] = static_cast<char>('0' + n % 10);
+        n /= 10;
+        if (count == decimals) {
+            digits[count++] = '.';
+        }
+    } while (n != 0 || count <= decimals);
+    if (digits[count - 1] == '.') {
+        digits[count++] = '0'; // 0.5 -> "0.5", not ".5"
+    }
+    bool negative = value < 0.0f && static_cast<uint32_t>(scaled) != 0;
+
+    size_t length = count + (negative ? 1 : 0);
+    if (length + 1 > size) {
+        return formatFixed(NAN, 0, out, size);
+    }
+    size_t pos = 0;
+    if (negative) {
+        out[pos++] = '-';
+    }
+    while (count > 0) {
+        out[pos++] = digits[--count];
+    }
+    out[pos] = '\0';
+    return pos;
+}
+
+} // namespace Utils
+} // namespace PlantMonitor
@@ -0,0 +1,248 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/*!
+ * \file history-ring.h
+ * \brief Fixed-size, allocation-free time-series ring buffer.
+ *
+ * Records are appended by a single writer and can be read concurrently by any
+ * number of readers without locks. When the ring is full the oldest record is
+ * overwritten; a reader that was copying that record detects it and skips it.
+ *
+ * Records must be trivially copyable and expose a monotonic
+ * \c uint32_t \c timestamp member, which is used for range queries.
+ *
+ * Typical usage:
+ * \code
+ * static HistoryRing<Record, 1440> history;
+ *
+ * history.push(record);                       // Writer task
+ *
+ * auto cursor = history.range(fromTs, toTs);  // Any reader task
+ * Record r;
+ * while (cursor.next(r)) {
+ *     // r.timestamp in [fromTs, toTs]
+ * }
+ * \endcode
+ */
+
+namespace PlantMonitor {
+namespace Utils {
+
+/*!
+ * \class HistoryRing
+ * \brief Single-writer / multi-reader ring of timestamped records
+ * \tparam T Record type (trivially copyable, with a uint32_t timestamp member)
+ * \tparam N Capacity in records
+ */
+template <typename T, size_t N>
+class HistoryRing {
+    static_assert(std::is_trivially_copyable<T>::value, "HistoryRing records must be trivially copyable");
+    static_assert(N > 0, "HistoryRing capacity must be non-zero");
+
+  public:
+    /*!
+     * \class Cursor
+     * \brief Forward iterator over a range of records (oldest first)
+     *
+     * A cursor holds no lock. If the writer overtakes it, the overwritten
+     * records are skipped and iteration resumes from the oldest valid one.
+     */
+    class Cursor {
+      public:
+        /*!
+         * \brief Fetch the next record in the range
+         * \param[out] out Destination record
+         * \return true if a record was produced, false at the end of the range
+         */
+        bool next(T &out) {
+            while (m_index < m_ring->written()) {
+                if (m_ring->at(m_index, out)) {
+                    if (out.timestamp > m_to) {
+                        m_index = UINT32_MAX; // Past the end of the range
+                        return false;
+                    }
+                    m_index++;
+                    return true;
+                }
+                // Overwritten while we were behind: jump to the oldest survivor
+                uint32_t oldest = m_ring->oldestIndex();
+                m_index = (oldest > m_index) ? oldest : m_index + 1;
+            }
+            return false;
+        }
+
+      private:
+        friend class HistoryRing;
+
+        Cursor(const HistoryRing *ring, uint32_t index, uint32_t to)
+            : m_ring(ring), m_index(index), m_to(to) {
+        }
+
+        const HistoryRing *m_ring; //!< Ring being iterated
+        uint32_t m_index;          //!< Absolute index of the next record
+        uint32_t m_to;             //!< Inclusive upper timestamp bound
+    };
+
+    /*!
+     * \brief Constructor (empty ring)
+     */
+    HistoryRing()
+        : m_started(0), m_written(0) {
+        for (auto &slot : m_slots) {
+            for (auto &word : slot) {
+                word.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /*!
+     * \brief Append a record, overwriting the oldest one when full (single writer only)
+     * \param record Record to append (timestamps must not decrease)
+     */
+    void push(const T &record) {
+        uint32_t words[kWords] = {};
+        std::memcpy(words, &record, sizeof(T));
+
+        const uint32_t index = m_written.load(std::memory_order_relaxed);
+        m_started.store(index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        auto &slot = m_slots[index % N];
+        for (size_t i = 0; i < kWords; ++i) {
+            slot[i].store(words[i], std::memory_order_relaxed);
+        }
+
+        m_written.store(index + 1, std::memory_order_release);
+    }
+
+    /*!
+     * \brief Read a record by absolute index
+     * \param index Absolute record index (0 = first record ever pushed)
+     * \param[out] out Destination record, only valid on success
+     * \return true if the record exists and was not overwritten during the copy
+     */
+    bool at(uint32_t index, T &out) const {
+        if (index >= m_written.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        uint32_t words[kWords];
+        const auto &slot = m_slots[index % N];
+        for (size_t i = 0; i < kWords; ++i) {
+            words[i] = slot[i].load(std::memory_order_relaxed);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_started.load(std::memory_order_relaxed) > index + N) {
+            return false; // Slot was reused while copying
+        }
+
+        std::memcpy(&out, words, sizeof(T));
+        return true;
+    }
+
+    /*!
+     * \brief Get the most recent record
+     * \param[out] out Destination record
+     * \return true if the ring is not empty
+     */
+    bool latest(T &out) const {
+        const uint32_t count = written();
+        return count > 0 && at(count - 1, out);
+    }
+
+    /*!
+     * \brief Get the number of records currently held
+     * \return Record count (at most N)
+     */
+    size_t size() const {
+        const uint32_t count = written();
+        return count < N ? count : N;
+    }
+
+    /*!
+     * \brief Get the ring capacity
+     * \return Maximum number of records held
+     */
+    static constexpr size_t capacity() {
+        return N;
+    }
+
+    /*!
+     * \brief Get the total number of records ever pushed
+     * \return Write count
+     */
+    uint32_t written() const {
+        return m_written.load(std::memory_order_acquire);
+    }
+
+    /*!
+     * \brief Get the absolute index of the oldest record still held
+     * \return Oldest valid index (equal to written() when empty)
+     */
+    uint32_t oldestIndex() const {
+        const uint32_t started = m_started.load(std::memory_order_acquire);
+        return started > N ? started - N : 0;
+    }
+
+    /*!
+     * \brief Iterate over every record currently held
+     * \return Cursor positioned on the oldest record
+     */
+    Cursor all() const {
+        return Cursor(this, oldestIndex(), UINT32_MAX);
+    }
+
+    /*!
+     * \brief Iterate over the records with a timestamp in [from, to]
+     * \param from Inclusive lower timestamp bound
+     * \param to Inclusive upper timestamp bound
+     * \return Cursor positioned on the first matching record
+     *
+     * The first record is located by binary search, O(log N).
+     */
+    Cursor range(uint32_t from, uint32_t to) const {
+        return Cursor(this, lowerBound(from), to);
+    }
+
+  private:
+    /*!
+     * \brief Find the absolute index of the first record with timestamp >= ts
+     * \param ts Timestamp to search for
+     * \return Absolute index (written() if none)
+     */
+    uint32_t lowerBound(uint32_t ts) const {
+        uint32_t lo = oldestIndex();
+        uint32_t hi = written();
+        T record;
+
+        while (lo < hi) {
+            const uint32_t mid = lo + (hi - lo) / 2;
+            if (!at(mid, record)) {
+                // Overwritten during the search: everything below is gone too
+                lo = mid + 1;
+                continue;
+            }
+            if (record.timestamp < ts) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return lo;
+    }
+
+    static constexpr size_t kWords = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+    std::atomic<uint32_t> m_started;             //!< Number of pushes begun
+    std::atomic<uint32_t> m_written;             //!< Number of pushes completed
+    std::atomic<uint32_t> m_slots[N][kWords];    //!< Record storage
+};
+
+} // namespace Utils
+} // namespace PlantMonitor
@@ -0,0 +1,160 @@
+#pragma once
+#include <cstdint>
+
+/*!
+ * \file fixed-point.h
+ * \brief Q15 / Q31 fixed-point helpers and constexpr math for filter design
+ *
+ * Q15 is a signed 16-bit fraction in [-1, 1), Q31 its 32-bit counterpart.
+ * Conversions round to nearest and saturate.
+ *
+ * The constexpr sin/cos/exp below exist so filter coefficients can be
+ * computed at compile time (std:: math is not constexpr in C++17). They are
+ * accurate to double precision for the arguments filter design needs
+ * (|x| <= a few pi).
+ */
+
+namespace PlantMonitor {
+namespace Utils {
+
+using q15_t = int16_t; //!< Q1.15 fraction
+using q31_t = int32_t; //!< Q1.31 fraction
+
+namespace FixedPoint {
+
+constexpr double kPi = 3.14159265358979323846;
+
+/*!
+ * \brief Saturate a wide value to the Q15 range
+ */
+constexpr q15_t saturate16(int64_t v) {
+    return static_cast<q15_t>(v > INT16_MAX ? INT16_MAX : (v < INT16_MIN ? INT16_MIN : v));
+}
+
+/*!
+ * \brief Saturate a wide value to the Q31 range
+ */
+constexpr q31_t saturate32(int64_t v) {
+    return static_cast<q31_t>(v > INT32_MAX ? INT32_MAX : (v < INT32_MIN ? INT32_MIN : v));
+}
+
+/*!
+ * \brief Round to nearest (half away from zero) and saturate to int64
+ */
+constexpr int64_t roundToInt64(double v) {
+    if (v >= 9.2e18) {
+        return INT64_MAX;
+    }
+    if (v <= -9.2e18) {
+        return INT64_MIN;
+    }
+    return static_cast<int64_t>(v >= 0.0 ? v + 0.5 : v - 0.5);
+}
+
+/*!
+ * \brief Convert a value to a fixed-point integer with \p fracBits fractional bits
+ */
+constexpr int64_t toFixed(double v, int fracBits) {
+    return roundToInt64(v * static_cast<double>(int64_t(1) << fracBits));
+}
+
+/*!
+ * \brief Convert a fraction to Q15 (saturating)
+ */
+constexpr q15_t toQ15(double v) {
+    return saturate16(toFixed(v, 15));
+}
+
+/*!
+ * \brief Convert a fraction to Q31 (saturating)
+ */
+constexpr q31_t toQ31(double v) {
+    return saturate32(toFixed(v, 31));
+}
+
+/*!
+ * \brief Convert Q15 to float
+ */
+constexpr float fromQ15(q15_t v) {
+    return static_cast<float>(v) / 32768.0f;
+}
+
+/*!
+ * \brief Convert Q31 to float
+ */
+constexpr float fromQ31(q31_t v) {
+    return static_cast<float>(static_cast<double>(v) / 2147483648.0);
+}
+
+/*!
+ * \brief Arithmetic shift right with round to nearest
+ */
+constexpr int64_t roundingShift(int64_t v, int shift) {
+    return (v + (int64_t(1) << (shift - 1))) >> shift;
+}
+
+/*!
+ * \brief Reduce an angle to [-pi, pi]
+ */
+constexpr double wrapAngle(double x) {
+    while (x > kPi) {
+        x -= 2.0 * kPi;
+    }
+    while (x < -kPi) {
+        x += 2.0 * kPi;
+    }
+    return x;
+}
+
+/*!
+ * \brief constexpr sine (Taylor series after range reduction)
+ */
+constexpr double sin(double x) {
+    x = wrapAngle(x);
+    double term = x;
+    double sum = x;
+    for (int n = 1; n < 14; ++n) {
+        term *= -x * x / ((2.0 * n) * (2.0 * n + 1.0));
+        sum += term;
+    }
+    return sum;
+}
+
+/*!
+ * \brief constexpr cosine (Taylor series after range reduction)
+ */
+constexpr double cos(double x) {
+    x = wrapAngle(x);
+    double term = 1.0;
+    double sum = 1.0;
+    for (int n = 1; n < 14; ++n) {
+        term *= -x * x / ((2.0 * n - 1.0) * (2.0 * n));
+        sum += term;
+    }
+    return sum;
+}
+
+/*!
+ * \brief constexpr e^x (Taylor series on x / 2^k, then squared k times)
+ */
+constexpr double exp(double x) {
+    int halvings = 0;
+    while (x > 0.5 || x < -0.5) {
+        x *= 0.5;
+        halvings++;
+    }
+    double term = 1.0;
+    double sum = 1.0;
+    for (int n = 1; n < 20; ++n) {
+        term *= x / n;
+        sum += term;
+    }
+    while (halvings-- > 0) {
+        sum *= sum;
+    }
+    return sum;
+}
+
+} // namespace FixedPoint
+} // namespace Utils
+} // namespace PlantMonitor
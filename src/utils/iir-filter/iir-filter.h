@@ -0,0 +1,288 @@
+#pragma once
+#include <cstdint>
+#include "fixed-point.h"
+
+/*!
+ * \file iir-filter.h
+ * \brief Single-pole EMA and biquad (low-pass / notch) IIR filters
+ *
+ * Every filter comes in three flavours sharing one constexpr design step:
+ * - float reference (EmaFloat, BiquadFloat)
+ * - Q31 (EmaQ31, BiquadQ31): 32-bit samples, 64-bit accumulation
+ * - Q15 (EmaQ15, BiquadQ15): 16-bit samples in and out, Q31 state inside so
+ *   small steps are not lost to rounding (no dead band, low feedback noise)
+ *
+ * Biquads use Direct Form I with coefficients in Q2.30 (range [-2, 2)),
+ * following the RBJ audio-EQ cookbook. Design functions are constexpr, so a
+ * filter declared with static storage has its coefficients folded in at
+ * compile time:
+ * \code
+ * constexpr BiquadCoefficients kSoilLowPass = biquadLowPass(0.5, 20.0);
+ * static BiquadQ15 soilFilter(kSoilLowPass);
+ *
+ * q15_t y = soilFilter.apply(x);
+ * \endcode
+ */
+
+#define IIR_BUTTERWORTH_Q 0.70710678118654752 //!< Q of a maximally flat (Butterworth) 2nd-order section
+#define IIR_DEFAULT_NOTCH_Q 5.0               //!< Default notch quality factor (bandwidth = f0 / Q)
+
+namespace PlantMonitor {
+namespace Utils {
+
+/*!
+ * \struct BiquadCoefficients
+ * \brief Normalized biquad coefficients (a0 = 1)
+ *
+ * y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] - a1 y[n-1] - a2 y[n-2]
+ */
+struct BiquadCoefficients {
+    double b0;
+    double b1;
+    double b2;
+    double a1;
+    double a2;
+};
+
+/*!
+ * \struct BiquadQ30Coefficients
+ * \brief Biquad coefficients in Q2.30
+ */
+struct BiquadQ30Coefficients {
+    int32_t b0;
+    int32_t b1;
+    int32_t b2;
+    int32_t a1;
+    int32_t a2;
+};
+
+/*!
+ * \brief Smoothing factor of a single-pole low-pass
+ * \param cutoffHz -3 dB frequency
+ * \param sampleRateHz Sample rate
+ * \return alpha for y += alpha * (x - y)
+ */
+constexpr double emaAlpha(double cutoffHz, double sampleRateHz) {
+    return 1.0 - FixedPoint::exp(-2.0 * FixedPoint::kPi * cutoffHz / sampleRateHz);
+}
+
+/*!
+ * \brief Design a second-order low-pass
+ * \param cutoffHz Cutoff frequency (below sampleRateHz / 2)
+ * \param sampleRateHz Sample rate
+ * \param q Quality factor (IIR_BUTTERWORTH_Q for a flat passband)
+ */
+constexpr BiquadCoefficients biquadLowPass(double cutoffHz, double sampleRateHz, double q = IIR_BUTTERWORTH_Q) {
+    const double w0 = 2.0 * FixedPoint::kPi * cutoffHz / sampleRateHz;
+    const double cw = FixedPoint::cos(w0);
+    const double alpha = FixedPoint::sin(w0) / (2.0 * q);
+    const double a0 = 1.0 + alpha;
+    return { (1.0 - cw) / 2.0 / a0, (1.0 - cw) / a0, (1.0 - cw) / 2.0 / a0, -2.0 * cw / a0, (1.0 - alpha) / a0 };
+}
+
+/*!
+ * \brief Design a notch (band-stop)
+ * \param centerHz Rejected frequency (below sampleRateHz / 2)
+ * \param sampleRateHz Sample rate
+ * \param q Quality factor (bandwidth = centerHz / q)
+ */
+constexpr BiquadCoefficients biquadNotch(double centerHz, double sampleRateHz, double q = IIR_DEFAULT_NOTCH_Q) {
+    const double w0 = 2.0 * FixedPoint::kPi * centerHz / sampleRateHz;
+    const double cw = FixedPoint::cos(w0);
+    const double alpha = FixedPoint::sin(w0) / (2.0 * q);
+    const double a0 = 1.0 + alpha;
+    return { 1.0 / a0, -2.0 * cw / a0, 1.0 / a0, -2.0 * cw / a0, (1.0 - alpha) / a0 };
+}
+
+/*!
+ * \brief Convert coefficients to Q2.30 (saturating at [-2, 2))
+ */
+constexpr BiquadQ30Coefficients toQ30(const BiquadCoefficients &c) {
+    return { FixedPoint::saturate32(FixedPoint::toFixed(c.b0, 30)),
+             FixedPoint::saturate32(FixedPoint::toFixed(c.b1, 30)),
+             FixedPoint::saturate32(FixedPoint::toFixed(c.b2, 30)),
+             FixedPoint::saturate32(FixedPoint::toFixed(c.a1, 30)),
+             FixedPoint::saturate32(FixedPoint::toFixed(c.a2, 30)) };
+}
+
+/*!
+ * \class EmaFloat
+ * \brief Float reference single-pole low-pass (first sample seeds the state)
+ */
+class EmaFloat {
+  public:
+    /*!
+     * \brief Constructor
+     * \param alpha Smoothing factor in (0, 1] (see emaAlpha())
+     */
+    constexpr explicit EmaFloat(double alpha) : m_alpha(static_cast<float>(alpha)), m_state(0.0f), m_primed(false) {}
+
+    float apply(float x) {
+        if (!m_primed) {
+            m_state = x;
+            m_primed = true;
+        } else {
+            m_state += m_alpha * (x - m_state);
+        }
+        return m_state;
+    }
+
+    void reset() {
+        m_primed = false;
+    }
+
+  private:
+    float m_alpha; //!< Smoothing factor
+    float m_state; //!< Current output
+    bool m_primed; //!< First sample seen
+};
+
+/*!
+ * \class EmaQ31
+ * \brief Q31 single-pole low-pass (first sample seeds the state)
+ */
+class EmaQ31 {
+  public:
+    /*!
+     * \brief Constructor
+     * \param alpha Smoothing factor in (0, 1] (see emaAlpha())
+     */
+    constexpr explicit EmaQ31(double alpha) : m_alpha(FixedPoint::toQ31(alpha)), m_state(0), m_primed(false) {}
+
+    q31_t apply(q31_t x) {
+        if (!m_primed) {
+            m_state = x;
+            m_primed = true;
+        } else {
+            int64_t delta = static_cast<int64_t>(x) - m_state; // Up to 33 bits
+            m_state = FixedPoint::saturate32(m_state + FixedPoint::roundingShift(delta * m_alpha, 31));
+        }
+        return m_state;
+    }
+
+    void reset() {
+        m_primed = false;
+    }
+
+  private:
+    q31_t m_alpha; //!< Smoothing factor (Q31)
+    q31_t m_state; //!< Current output
+    bool m_primed; //!< First sample seen
+};
+
+/*!
+ * \class EmaQ15
+ * \brief Q15 single-pole low-pass with Q31 internal state
+ */
+class EmaQ15 {
+  public:
+    /*!
+     * \brief Constructor
+     * \param alpha Smoothing factor in (0, 1] (see emaAlpha())
+     */
+    constexpr explicit EmaQ15(double alpha) : m_core(alpha) {}
+
+    q15_t apply(q15_t x) {
+        q31_t y = m_core.apply(static_cast<q31_t>(x) * 65536);
+        return FixedPoint::saturate16(FixedPoint::roundingShift(y, 16));
+    }
+
+    void reset() {
+        m_core.reset();
+    }
+
+  private:
+    EmaQ31 m_core; //!< Full-precision state
+};
+
+/*!
+ * \class BiquadFloat
+ * \brief Float reference biquad (Direct Form I)
+ */
+class BiquadFloat {
+  public:
+    constexpr explicit BiquadFloat(const BiquadCoefficients &c)
+        : m_b0(static_cast<float>(c.b0)), m_b1(static_cast<float>(c.b1)), m_b2(static_cast<float>(c.b2)),
+          m_a1(static_cast<float>(c.a1)), m_a2(static_cast<float>(c.a2)),
+          m_x1(0.0f), m_x2(0.0f), m_y1(0.0f), m_y2(0.0f) {}
+
+    float apply(float x) {
+        float y = m_b0 * x + m_b1 * m_x1 + m_b2 * m_x2 - m_a1 * m_y1 - m_a2 * m_y2;
+        m_x2 = m_x1;
+        m_x1 = x;
+        m_y2 = m_y1;
+        m_y1 = y;
+        return y;
+    }
+
+    void reset() {
+        m_x1 = m_x2 = m_y1 = m_y2 = 0.0f;
+    }
+
+  private:
+    float m_b0, m_b1, m_b2, m_a1, m_a2; //!< Coefficients
+    float m_x1, m_x2, m_y1, m_y2;       //!< Delay line
+};
+
+/*!
+ * \class BiquadQ31
+ * \brief Q31 biquad (Direct Form I, Q2.30 coefficients, 64-bit accumulator)
+ *
+ * Each Q61 product is pre-shifted to Q59 so the sum of the five terms
+ * cannot overflow the accumulator.
+ */
+class BiquadQ31 {
+  public:
+    constexpr explicit BiquadQ31(const BiquadCoefficients &c) : m_c(toQ30(c)), m_x1(0), m_x2(0), m_y1(0), m_y2(0) {}
+
+    q31_t apply(q31_t x) {
+        int64_t acc = (static_cast<int64_t>(m_c.b0) * x) >> 2;
+        acc += (static_cast<int64_t>(m_c.b1) * m_x1) >> 2;
+        acc += (static_cast<int64_t>(m_c.b2) * m_x2) >> 2;
+        acc -= (static_cast<int64_t>(m_c.a1) * m_y1) >> 2;
+        acc -= (static_cast<int64_t>(m_c.a2) * m_y2) >> 2;
+        q31_t y = FixedPoint::saturate32(FixedPoint::roundingShift(acc, 28));
+
+        m_x2 = m_x1;
+        m_x1 = x;
+        m_y2 = m_y1;
+        m_y1 = y;
+        return y;
+    }
+
+    void reset() {
+        m_x1 = m_x2 = m_y1 = m_y2 = 0;
+    }
+
+  private:
+    BiquadQ30Coefficients m_c;    //!< Coefficients
+    q31_t m_x1, m_x2, m_y1, m_y2; //!< Delay line
+};
+
+/*!
+ * \class BiquadQ15
+ * \brief Q15 biquad with Q31 internal state
+ *
+ * Keeping the feedback path at 32 bits matters for low cutoffs, where the
+ * poles sit close to the unit circle and 16-bit state would add large
+ * quantization noise and limit cycles.
+ */
+class BiquadQ15 {
+  public:
+    constexpr explicit BiquadQ15(const BiquadCoefficients &c) : m_core(c) {}
+
+    q15_t apply(q15_t x) {
+        q31_t y = m_core.apply(static_cast<q31_t>(x) * 65536);
+        return FixedPoint::saturate16(FixedPoint::roundingShift(y, 16));
+    }
+
+    void reset() {
+        m_core.reset();
+    }
+
+  private:
+    BiquadQ31 m_core; //!< Full-precision core
+};
+
+} // namespace Utils
+} // namespace PlantMonitor
@@ -0,0 +1,288 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+/*!
+ * \file median-filter.h
+ * \brief Sorting-network median and Hampel outlier rejection for small windows
+ *
+ * Averaging a burst of ADC reads smears a single spike over the whole
+ * result. A median ignores it, and a Hampel filter goes one step further:
+ * samples further than k scaled MADs (median absolute deviation) from the
+ * median are dropped and the rest averaged, which keeps the noise reduction
+ * of the mean without its sensitivity to outliers.
+ *
+ * Sorting uses Batcher odd-even merge networks (3 to 15 samples need at most
+ * 59 compare-exchanges). Every compare-exchange is a min/max pair, so the
+ * data path has no branches and no allocation; the index logic is resolved
+ * at compile time once the loops are unrolled.
+ *
+ * Typical usage:
+ * \code
+ * uint16_t burst[9];
+ * for (auto &v : burst) v = analogRead(pin);
+ * uint16_t m = medianOf(burst, 9);                // Sorts burst in place
+ * float clean = hampelMean(burst, 9);             // Mean of the inliers
+ * \endcode
+ */
+
+#define MEDIAN_MAX_WINDOW 15          //!< Largest window handled by the runtime-sized helpers
+#define HAMPEL_DEFAULT_THRESHOLD 3.0f //!< Outlier limit in scaled MADs
+#define HAMPEL_MAD_SCALE 1.4826f      //!< MAD to standard deviation factor for Gaussian noise
+
+namespace PlantMonitor {
+namespace Utils {
+
+/*!
+ * \enum SampleReduction
+ * \brief How a burst of raw reads is reduced to one value
+ */
+enum class SampleReduction : uint8_t {
+    Mean = 0, //!< Arithmetic mean (lowest noise, spikes leak into the result)
+    Median,   //!< Middle value (spikes ignored)
+    Hampel    //!< Mean of the samples within HAMPEL_DEFAULT_THRESHOLD MADs of the median
+};
+
+/*!
+ * \brief Branchless compare-exchange: a <= b afterwards
+ */
+template <typename T>
+inline void compareExchange(T &a, T &b) {
+    T lo = (b < a) ? b : a;
+    T hi = (b < a) ? a : b;
+    a = lo;
+    b = hi;
+}
+
+/*!
+ * \brief Sort N values in place with a Batcher odd-even merge network
+ * \tparam N Number of values (any size; meant for small windows)
+ */
+template <typename T, size_t N>
+inline void sortingNetwork(T *v) {
+    for (size_t p = 1; p < N; p <<= 1) {
+        for (size_t k = p; k >= 1; k >>= 1) {
+            for (size_t j = k % p; j + k < N; j += 2 * k) {
+                for (size_t i = 0; i < k && i + j + k < N; ++i) {
+                    if ((i + j) / (2 * p) == (i + j + k) / (2 * p)) {
+                        compareExchange(v[i + j], v[i + j + k]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+/*!
+ * \brief Sort a runtime-sized window in place
+ * \param v Values
+ * \param count Number of values (at most MEDIAN_MAX_WINDOW)
+ * \return false if count is out of range (v untouched)
+ */
+template <typename T>
+inline bool sortSmall(T *v, size_t count) {
+    switch (count) {
+    case 0:
+    case 1: return count == 1;
+    case 2: sortingNetwork<T, 2>(v); return true;
+    case 3: sortingNetwork<T, 3>(v); return true;
+    case 4: sortingNetwork<T, 4>(v); return true;
+    case 5: sortingNetwork<T, 5>(v); return true;
+    case 6: sortingNetwork<T, 6>(v); return true;
+    case 7: sortingNetwork<T, 7>(v); return true;
+    case 8: sortingNetwork<T, 8>(v); return true;
+    case 9: sortingNetwork<T, 9>(v); return true;
+    case 10: sortingNetwork<T, 10>(v); return true;
+    case 11: sortingNetwork<T, 11>(v); return true;
+    case 12: sortingNetwork<T, 12>(v); return true;
+    case 13: sortingNetwork<T, 13>(v); return true;
+    case 14: sortingNetwork<T, 14>(v); return true;
+    case 15: sortingNetwork<T, 15>(v); return true;
+    default: return false;
+    }
+}
+
+/*!
+ * \brief Middle value of a sorted window (mean of the two middles for even sizes)
+ */
+template <typename T>
+inline T sortedMedian(const T *sorted, size_t count) {
+    if (count % 2 == 1) {
+        return sorted[count / 2];
+    }
+    return static_cast<T>((sorted[count / 2 - 1] + sorted[count / 2]) / 2);
+}
+
+/*!
+ * \brief Median of a fixed-size window
+ * \param v Values, sorted in place
+ */
+template <typename T, size_t N>
+inline T medianOf(T *v) {
+    static_assert(N > 0, "Median of an empty window");
+    sortingNetwork<T, N>(v);
+    return sortedMedian(v, N);
+}
+
+/*!
+ * \brief Median of a runtime-sized window
+ * \param v Values, sorted in place
+ * \param count Number of values (1 to MEDIAN_MAX_WINDOW)
+ * \return Median (0 if count is out of range)
+ */
+template <typename T>
+inline T medianOf(T *v, size_t count) {
+    if (!sortSmall(v, count)) {
+        return T(0);
+    }
+    return sortedMedian(v, count);
+}
+
+/*!
+ * \brief Mean of the samples within \p threshold scaled MADs of the median
+ * \param v Values, sorted in place
+ * \param count Number of values (1 to MEDIAN_MAX_WINDOW)
+ * \param threshold Outlier limit in scaled MADs
+ * \return Robust mean (0 if count is out of range)
+ * \note When more than half the samples are identical the MAD is 0 and only
+ *       the samples equal to the median are kept.
+ */
+template <typename T>
+inline float hampelMean(T *v, size_t count, float threshold = HAMPEL_DEFAULT_THRESHOLD) {
+    if (!sortSmall(v, count)) {
+        return 0.0f;
+    }
+    const float med = static_cast<float>(sortedMedian(v, count));
+
+    float dev[MEDIAN_MAX_WINDOW];
+    for (size_t i = 0; i < count; ++i) {
+        dev[i] = std::fabs(static_cast<float>(v[i]) - med);
+    }
+    sortSmall(dev, count);
+    const float limit = threshold * HAMPEL_MAD_SCALE * sortedMedian(dev, count);
+
+    // Inlier mask as arithmetic: no data-dependent branch
+    float sum = 0.0f;
+    float kept = 0.0f;
+    for (size_t i = 0; i < count; ++i) {
+        float x = static_cast<float>(v[i]);
+        float inlier = static_cast<float>(std::fabs(x - med) <= limit);
+        sum += inlier * x;
+        kept += inlier;
+    }
+    return sum / kept; // The sample closest to the median is always kept, so kept >= 1
+}
+
+/*!
+ * \brief Reduce a burst of reads to one value
+ * \param v Values (reordered for Median / Hampel)
+ * \param count Number of values (capped to MEDIAN_MAX_WINDOW for Median / Hampel)
+ * \param mode Reduction to apply
+ */
+template <typename T>
+inline float reduceSamples(T *v, size_t count, SampleReduction mode) {
+    if (count == 0) {
+        return 0.0f;
+    }
+    if (mode != SampleReduction::Mean && count > MEDIAN_MAX_WINDOW) {
+        count = MEDIAN_MAX_WINDOW;
+    }
+
+    switch (mode) {
+    case SampleReduction::Median:
+        return static_cast<float>(medianOf(v, count));
+    case SampleReduction::Hampel:
+        return hampelMean(v, count);
+    case SampleReduction::Mean:
+    default: {
+        float sum = 0.0f;
+        for (size_t i = 0; i < count; ++i) {
+            sum += static_cast<float>(v[i]);
+        }
+        return sum / static_cast<float>(count);
+    }
+    }
+}
+
+/*!
+ * \class HampelFilter
+ * \brief Streaming Hampel filter: replaces outliers with the window median
+ * \tparam N Window size (3 to MEDIAN_MAX_WINDOW)
+ *
+ * Causal variant: the newest sample is tested against the median and MAD of
+ * the last N samples. Usable as a Pipeline stage. On a perfectly flat signal
+ * the MAD is 0, so a genuine step is held back until it fills half the window.
+ */
+template <size_t N>
+class HampelFilter {
+    static_assert(N >= 3 && N <= MEDIAN_MAX_WINDOW, "HampelFilter window must be 3 to MEDIAN_MAX_WINDOW");
+
+  public:
+    /*!
+     * \brief Constructor
+     * \param threshold Outlier limit in scaled MADs
+     */
+    explicit HampelFilter(float threshold = HAMPEL_DEFAULT_THRESHOLD)
+        : m_window(), m_threshold(threshold), m_index(0), m_count(0), m_outliers(0) {}
+
+    /*!
+     * \brief Filter one sample
+     * \return The sample, or the window median if it is an outlier
+     */
+    float apply(float sample) {
+        m_window[m_index] = sample;
+        m_index = (m_index + 1) % N;
+        if (m_count < N) {
+            m_count++;
+        }
+        if (m_count < 3) {
+            return sample; // Not enough history to judge
+        }
+
+        float sorted[N];
+        float dev[N];
+        for (size_t i = 0; i < m_count; ++i) {
+            sorted[i] = m_window[i];
+        }
+        sortSmall(sorted, m_count);
+        float med = sortedMedian(sorted, m_count);
+        for (size_t i = 0; i < m_count; ++i) {
+            dev[i] = std::fabs(sorted[i] - med);
+        }
+        sortSmall(dev, m_count);
+        float limit = m_threshold * HAMPEL_MAD_SCALE * sortedMedian(dev, m_count);
+
+        if (std::fabs(sample - med) > limit) {
+            m_outliers++;
+            return med;
+        }
+        return sample;
+    }
+
+    /*!
+     * \brief Get the number of samples replaced since the last reset
+     */
+    uint32_t outliers() const {
+        return m_outliers;
+    }
+
+    /*!
+     * \brief Reset the filter state
+     */
+    void reset() {
+        m_index = 0;
+        m_count = 0;
+        m_outliers = 0;
+    }
+
+  private:
+    float m_window[N];   //!< Last N samples (circular)
+    float m_threshold;   //!< Outlier limit in scaled MADs
+    size_t m_index;      //!< Next write position
+    size_t m_count;      //!< Samples in the window
+    uint32_t m_outliers; //!< Samples replaced so far
+};
+
+} // namespace Utils
+} // namespace PlantMonitor
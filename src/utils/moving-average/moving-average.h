@@ -1,26 +1,235 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
 #include <vector>
-#include <numeric>
 
 /*!
  * \file moving_average.h
  * \brief Simple moving average filter utility
+ *
+ * All variants keep a running sum, so adding a sample and reading the average
+ * are both O(1):
+ * - StaticMovingAverage<T, N, Acc>: compile-time window, storage inline (no heap).
+ *   Integer T accumulates in an integer type, so raw ADC counts never touch floats.
+ * - MovingAverage: window size chosen at run time (storage allocated once in the
+ *   constructor), built on the same MovingAverageWindow core.
+ *
+ * Typical usage:
+ * \code
+ * StaticMovingAverage<uint16_t, 16> adc;      // uint32_t accumulator
+ * adc.addSample(analogRead(pin));
+ * uint16_t counts = adc.getAverage();         // Rounded to nearest
+ * \endcode
  */
 
 namespace PlantMonitor {
 namespace Utils {
+
+/*!
+ * \struct MovingAverageAccumulator
+ * \brief Default running-sum type for a sample type
+ *
+ * Floating point samples accumulate in their own type; integers narrower than
+ * 32 bits accumulate in a 32-bit integer of the same signedness (enough for
+ * 65536 samples of 16 bits), wider integers in int64_t.
+ */
+template <typename T>
+struct MovingAverageAccumulator {
+    using type = typename std::conditional<
+        std::is_floating_point<T>::value,
+        T,
+        typename std::conditional<(sizeof(T) < 4),
+                                  typename std::conditional<std::is_signed<T>::value, int32_t, uint32_t>::type,
+                                  int64_t>::type>::type;
+};
+
+/*!
+ * \class MovingAverageWindow
+ * \brief Running-sum moving average over caller-provided storage
+ * \tparam T Sample type
+ * \tparam Acc Running-sum type
+ *
+ * Floating point sums are recomputed from the window every time the write
+ * index wraps, so rounding error cannot build up (amortized O(1)).
+ */
+template <typename T, typename Acc = typename MovingAverageAccumulator<T>::type>
+class MovingAverageWindow {
+  public:
+    /*!
+     * \brief Constructor
+     * \param buffer Sample storage (must outlive the window)
+     * \param capacity Number of samples in \p buffer (must be non-zero)
+     */
+    MovingAverageWindow(T *buffer, size_t capacity)
+        : m_buffer(buffer), m_capacity(capacity), m_index(0), m_count(0), m_sum(0) {
+    }
+
+    /*!
+     * \brief Add a new sample, replacing the oldest one when the window is full
+     * \param sample New sample value
+     */
+    void addSample(T sample) {
+        if (m_count == m_capacity) {
+            m_sum -= static_cast<Acc>(m_buffer[m_index]);
+        } else {
+            m_count++;
+        }
+        m_buffer[m_index] = sample;
+        m_sum += static_cast<Acc>(sample);
+
+        if (++m_index == m_capacity) {
+            m_index = 0;
+            if (std::is_floating_point<Acc>::value) {
+                resync();
+            }
+        }
+    }
+
+    /*!
+     * \brief Get the current average value
+     * \return Average of the samples (integers rounded to nearest), 0 when empty
+     */
+    T getAverage() const {
+        if (m_count == 0) {
+            return T(0);
+        }
+        return divide(m_sum, static_cast<Acc>(m_count));
+    }
+
+    /*!
+     * \brief Get the running sum of the samples in the window
+     */
+    Acc getSum() const {
+        return m_sum;
+    }
+
+    /*!
+     * \brief Get the number of samples currently in the window
+     */
+    size_t getCount() const {
+        return m_count;
+    }
+
+    /*!
+     * \brief Get the window capacity
+     */
+    size_t getCapacity() const {
+        return m_capacity;
+    }
+
+    /*!
+     * \brief Clear all stored samples
+     */
+    void clear() {
+        m_index = 0;
+        m_count = 0;
+        m_sum = 0;
+    }
+
+  private:
+    /// \brief Recompute the sum from the stored samples.
+    void resync() {
+        Acc sum = 0;
+        for (size_t i = 0; i < m_count; ++i) {
+            sum += static_cast<Acc>(m_buffer[i]);
+        }
+        m_sum = sum;
+    }
+
+    /// \brief Floating point division.
+    template <typename A = Acc>
+    static typename std::enable_if<std::is_floating_point<A>::value, T>::type divide(A sum, A count) {
+        return static_cast<T>(sum / count);
+    }
+
+    /// \brief Integer division rounded half away from zero.
+    template <typename A = Acc>
+    static typename std::enable_if<!std::is_floating_point<A>::value, T>::type divide(A sum, A count) {
+        return static_cast<T>((sum >= 0) ? (sum + count / 2) / count : (sum - count / 2) / count);
+    }
+
+    T *m_buffer;       //!< Sample storage
+    size_t m_capacity; //!< Window size
+    size_t m_index;    //!< Next write position
+    size_t m_count;    //!< Number of samples added (up to m_capacity)
+    Acc m_sum;         //!< Running sum of the stored samples
+};
+
+/*!
+ * \class StaticMovingAverage
+ * \brief Moving average with a compile-time window and inline storage
+ * \tparam T Sample type
+ * \tparam N Window size
+ * \tparam Acc Running-sum type (pick a wide enough integer for N samples of T)
+ */
+template <typename T, size_t N, typename Acc = typename MovingAverageAccumulator<T>::type>
+class StaticMovingAverage {
+    static_assert(N > 0, "StaticMovingAverage window must be non-zero");
+
+  public:
+    StaticMovingAverage() : m_samples(), m_window(m_samples, N) {}
+
+    StaticMovingAverage(const StaticMovingAverage &) = delete;
+    StaticMovingAverage &operator=(const StaticMovingAverage &) = delete;
+
+    /*!
+     * \brief Add a new sample to the filter
+     * \param sample New sample value
+     */
+    void addSample(T sample) {
+        m_window.addSample(sample);
+    }
+
+    /*!
+     * \brief Get the current average value
+     * \return Average of the samples (integers rounded to nearest), 0 when empty
+     */
+    T getAverage() const {
+        return m_window.getAverage();
+    }
+
+    /*!
+     * \brief Get the running sum of the samples in the window
+     */
+    Acc getSum() const {
+        return m_window.getSum();
+    }
+
+    /*!
+     * \brief Get the number of samples currently in the window
+     */
+    size_t getCount() const {
+        return m_window.getCount();
+    }
+
+    /*!
+     * \brief Clear all stored samples
+     */
+    void clear() {
+        m_window.clear();
+    }
+
+  private:
+    T m_samples[N];                       //!< Sample storage
+    MovingAverageWindow<T, Acc> m_window; //!< Running-sum core over m_samples
+};
+
 /*!
  * \class MovingAverage
  * \brief Implements a simple moving average filter
  */
 class MovingAverage {
   public:
-    /*! 
+    /*!
      * \brief Constructor
      * \param size Number of samples to average
      */
     explicit MovingAverage(size_t size);
 
+    MovingAverage(const MovingAverage &) = delete;
+    MovingAverage &operator=(const MovingAverage &) = delete;
+
     /*!
      * \brief Add a new sample to the filter
      * \param sample New sample value
@@ -39,10 +248,8 @@ class MovingAverage {
     void clear();
 
   private:
-    size_t m_size;                //!< Number of samples to average
-    std::vector<float> m_samples; //!< Stored samples
-    size_t m_index;               //!< Current index for circular buffer
-    size_t m_count;               //!< Number of samples added
+    std::vector<float> m_samples;              //!< Stored samples (allocated once)
+    MovingAverageWindow<float, float> m_window; //!< Running-sum core over m_samples
 };
 } // namespace Utils
 } // namespace PlantMonitor
@@ -0,0 +1,134 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/*!
+ * \file seqlock.h
+ * \brief Single-writer / multi-reader sequence lock for small trivially copyable snapshots.
+ *
+ * The writer never blocks and readers never take a lock: a reader copies the
+ * payload and validates the copy against a sequence counter, retrying only if
+ * it overlapped a write. Suitable for sharing a small struct (e.g. SensorData)
+ * between tasks running on different cores.
+ *
+ * Typical usage:
+ * \code
+ * SeqLock<SensorData> snapshot;
+ *
+ * // Writer task
+ * snapshot.write(data);
+ *
+ * // Reader task
+ * SensorData copy;
+ * uint32_t seq;
+ * if (snapshot.tryRead(copy, seq)) {
+ *     // copy is consistent, seq counts the completed writes
+ * }
+ * \endcode
+ *
+ * \note Only one task may call write(). The payload is stored as an array of
+ *       32-bit atomics, so concurrent copies are free of data races.
+ */
+
+namespace PlantMonitor {
+namespace Utils {
+
+/*!
+ * \class SeqLock
+ * \brief Sequence lock protecting a trivially copyable value.
+ * \tparam T Payload type (must be trivially copyable)
+ */
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock payload must be trivially copyable");
+
+  public:
+    /*!
+     * \brief Constructor (payload zero-filled, sequence 0)
+     */
+    SeqLock()
+        : m_sequence(0) {
+        for (auto &word : m_words) {
+            word.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /*!
+     * \brief Publish a new value (single writer only)
+     * \param value Value to publish
+     */
+    void write(const T &value) {
+        uint32_t words[kWords] = {};
+        std::memcpy(words, &value, sizeof(T));
+
+        const uint32_t seq = m_sequence.load(std::memory_order_relaxed);
+        m_sequence.store(seq + 1, std::memory_order_relaxed); // Odd: write in progress
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (size_t i = 0; i < kWords; ++i) {
+            m_words[i].store(words[i], std::memory_order_relaxed);
+        }
+
+        m_sequence.store(seq + 2, std::memory_order_release); // Even: stable
+    }
+
+    /*!
+     * \brief Attempt a single consistent read (never blocks)
+     * \param[out] out Destination, only written on success
+     * \param[out] sequence Number of completed writes the copy belongs to
+     * \return true if the copy is consistent, false if it overlapped a write
+     */
+    bool tryRead(T &out, uint32_t &sequence) const {
+        const uint32_t before = m_sequence.load(std::memory_order_acquire);
+        if (before & 1u) {
+            return false;
+        }
+
+        uint32_t words[kWords];
+        for (size_t i = 0; i < kWords; ++i) {
+            words[i] = m_words[i].load(std::memory_order_relaxed);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_sequence.load(std::memory_order_relaxed) != before) {
+            return false;
+        }
+
+        std::memcpy(&out, words, sizeof(T));
+        sequence = before >> 1;
+        return true;
+    }
+
+    /*!
+     * \brief Read a consistent copy, spinning until no write overlaps it
+     * \param[out] out Destination
+     * \return Number of completed writes the copy belongs to
+     * \warning Do not call from a task that can preempt the writer on the same core.
+     */
+    uint32_t read(T &out) const {
+        uint32_t sequence = 0;
+        while (!tryRead(out, sequence)) {
+        }
+        return sequence;
+    }
+
+    /*!
+     * \brief Get the number of completed writes
+     * \return Write count (0 if nothing was published yet)
+     */
+    uint32_t sequence() const {
+        return m_sequence.load(std::memory_order_acquire) >> 1;
+    }
+
+  private:
+    static constexpr size_t kWords = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+    std::atomic<uint32_t> m_sequence;        //!< Twice the write count, odd while writing
+    std::atomic<uint32_t> m_words[kWords];   //!< Payload storage
+};
+
+} // namespace Utils
+} // namespace PlantMonitor
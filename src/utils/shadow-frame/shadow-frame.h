@@ -0,0 +1,147 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/*!
+ * \file shadow-frame.h
+ * \brief Copy of the last frame sent to a page-addressed display, diffed by column block.
+ *
+ * Page-addressed controllers (SH1107, SSD1306) store one byte per column per
+ * 8-pixel page. The shadow keeps what the panel RAM holds; each flush compares
+ * the new frame against it, block by block, and only the runs of changed
+ * blocks go on the bus. A run is committed to the shadow once its transfer
+ * succeeded, so a failed flush is retried on the next one.
+ *
+ * Typical usage:
+ * \code
+ * ShadowFrame<128, 16, 16> shadow;      // 128 columns, 16 pages, 16-column blocks
+ *
+ * if (shadow.differs(frame)) {
+ *     for (uint8_t page = 0; page < 16; ++page) {
+ *         FrameSpan spans[decltype(shadow)::kMaxSpans];
+ *         size_t n = shadow.dirtySpans(frame, page, spans);
+ *         for (size_t i = 0; i < n; ++i) {
+ *             if (send(spans[i])) {
+ *                 shadow.commit(frame, spans[i]);
+ *             }
+ *         }
+ *     }
+ * }
+ * \endcode
+ */
+
+namespace PlantMonitor {
+namespace Utils {
+
+/*!
+ * \struct FrameSpan
+ * \brief Run of changed columns within one page
+ */
+struct FrameSpan {
+    uint8_t page;   //!< Page index (0 = top)
+    uint8_t column; //!< First column
+    uint8_t length; //!< Number of columns
+};
+
+/*!
+ * \class ShadowFrame
+ * \brief Last transmitted frame and per-page validity
+ * \tparam Width Columns per page (bytes per page in the framebuffer)
+ * \tparam Pages Number of 8-pixel pages
+ * \tparam Block Diff granularity in columns (a changed pixel resends its whole block)
+ */
+template <size_t Width, size_t Pages, size_t Block>
+class ShadowFrame {
+    static_assert(Width % Block == 0, "Block must divide the page width");
+    static_assert(Width < 256 && Pages < 256, "Spans use 8-bit coordinates");
+
+  public:
+    static constexpr size_t kBlocks = Width / Block;        //!< Blocks per page
+    static constexpr size_t kMaxSpans = (kBlocks + 1) / 2; //!< Worst case: every other block changed
+
+    /*!
+     * \brief Constructor (every page invalid: the first flush sends everything)
+     */
+    ShadowFrame() {
+        std::memset(m_shadow, 0, sizeof(m_shadow));
+        invalidate();
+    }
+
+    /*!
+     * \brief Forget what the panel holds (after a reset or a failed init)
+     */
+    void invalidate() {
+        std::memset(m_valid, 0, sizeof(m_valid));
+    }
+
+    /*!
+     * \brief Check whether anything must be sent
+     * \param frame Framebuffer (Pages x Width bytes, page-major)
+     * \return true if at least one page is invalid or differs
+     */
+    bool differs(const uint8_t *frame) const {
+        for (size_t page = 0; page < Pages; ++page) {
+            if (!m_valid[page]) {
+                return true;
+            }
+        }
+        return std::memcmp(frame, m_shadow, sizeof(m_shadow)) != 0;
+    }
+
+    /*!
+     * \brief List the runs of changed blocks in one page
+     * \param frame Framebuffer (Pages x Width bytes, page-major)
+     * \param page Page index
+     * \param[out] out At least kMaxSpans entries
+     * \return Number of spans written (an invalid page is one full-width span)
+     */
+    size_t dirtySpans(const uint8_t *frame, uint8_t page, FrameSpan *out) const {
+        const uint8_t *next = frame + static_cast<size_t>(page) * Width;
+        const uint8_t *last = m_shadow + static_cast<size_t>(page) * Width;
+
+        if (!m_valid[page]) {
+            out[0] = { page, 0, static_cast<uint8_t>(Width) };
+            return 1;
+        }
+
+        size_t count = 0;
+        size_t runStart = 0;
+        bool inRun = false;
+        for (size_t block = 0; block < kBlocks; ++block) {
+            size_t column = block * Block;
+            bool dirty = std::memcmp(next + column, last + column, Block) != 0;
+            if (dirty && !inRun) {
+                runStart = column;
+                inRun = true;
+            } else if (!dirty && inRun) {
+                out[count++] = { page, static_cast<uint8_t>(runStart), static_cast<uint8_t>(column - runStart) };
+                inRun = false;
+            }
+        }
+        if (inRun) {
+            out[count++] = { page, static_cast<uint8_t>(runStart), static_cast<uint8_t>(Width - runStart) };
+        }
+        return count;
+    }
+
+    /*!
+     * \brief Record a span as transmitted
+     * \param frame Framebuffer the span was sent from
+     * \param span Span returned by dirtySpans()
+     */
+    void commit(const uint8_t *frame, const FrameSpan &span) {
+        size_t offset = static_cast<size_t>(span.page) * Width + span.column;
+        std::memcpy(m_shadow + offset, frame + offset, span.length);
+        if (span.column == 0 && span.length == Width) {
+            m_valid[span.page] = true;
+        }
+    }
+
+  private:
+    uint8_t m_shadow[Width * Pages]; //!< What the panel RAM holds
+    bool m_valid[Pages];             //!< Page content known (else resent in full)
+};
+
+} // namespace Utils
+} // namespace PlantMonitor
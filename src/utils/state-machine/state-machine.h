@@ -0,0 +1,485 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/*!
+ * \file state-machine.h
+ * \brief Table-driven hierarchical state machine declared at compile time.
+ *
+ * A machine is described by a definition struct holding three constexpr
+ * tables: the states (with their parent and entry/exit actions), the event
+ * names, and the transitions (with an optional guard and action). The
+ * StateMachine template indexes the transition table by [state][event] at
+ * compile time, so dispatch() never searches the table and never allocates.
+ * An event that the current state does not handle bubbles up to its parent.
+ *
+ * Every transition is recorded in a small trace ring (and optionally passed
+ * to a trace hook), and the time spent in each state is accumulated.
+ *
+ * Typical usage:
+ * \code
+ * enum class Door : uint8_t { Closed, Open };
+ * enum class DoorEvent : uint8_t { Push, Pull };
+ *
+ * struct DoorFsm {
+ *     using State = Door;
+ *     using Event = DoorEvent;
+ *     using Context = DoorContext;
+ *     static constexpr size_t kStateCount = 2;
+ *     static constexpr size_t kEventCount = 2;
+ *     static constexpr HsmState<State, Context> states[kStateCount] = {
+ *         {Door::Closed, Door::Closed, "CLOSED", nullptr, nullptr},
+ *         {Door::Open, Door::Open, "OPEN", nullptr, nullptr},
+ *     };
+ *     static constexpr const char *events[kEventCount] = {"PUSH", "PULL"};
+ *     static constexpr HsmTransition<State, Event, Context> transitions[] = {
+ *         {Door::Closed, DoorEvent::Push, Door::Open, &isUnlocked, nullptr},
+ *         {Door::Open, DoorEvent::Pull, Door::Closed, nullptr, nullptr},
+ *     };
+ * };
+ *
+ * StateMachine<DoorFsm> door(ctx);
+ * door.start(Door::Closed, millis());
+ * door.dispatch(DoorEvent::Push, millis());
+ * \endcode
+ *
+ * \note States and events must be enums numbered 0..N-1, and states[i] must
+ *       describe state i. Transition targets must be leaf states.
+ */
+
+#define HSM_TRACE_DEPTH 8 //!< Transitions kept in the trace ring
+
+namespace PlantMonitor {
+namespace Utils {
+
+/*!
+ * \brief State table entry
+ * \tparam State State enum
+ * \tparam Context Data passed to every action and guard
+ */
+template <typename State, typename Context>
+struct HsmState {
+    State id;                   //!< State described by this entry (must equal its index)
+    State parent;               //!< Enclosing state (the state itself for a top-level state)
+    const char *name;           //!< Name used by traces
+    void (*onEntry)(Context &); //!< Run when the state is entered (may be null)
+    void (*onExit)(Context &);  //!< Run when the state is left (may be null)
+};
+
+/*!
+ * \brief Transition table entry
+ *
+ * When several entries share a state and an event, the first one whose guard
+ * passes is taken. A transition whose target is the current state is internal:
+ * its action runs, but no exit or entry action does and nothing is traced.
+ */
+template <typename State, typename Event, typename Context>
+struct HsmTransition {
+    State from;                 //!< Source state (a parent state covers all its children)
+    Event event;                //!< Triggering event
+    State to;                   //!< Target leaf state
+    bool (*guard)(Context &);   //!< Condition checked before the transition (may be null)
+    void (*action)(Context &);  //!< Run between the exit and entry actions (may be null)
+};
+
+/*!
+ * \brief Recorded transition
+ */
+template <typename State, typename Event>
+struct HsmTraceEntry {
+    State from;      //!< Leaf state before the transition
+    State to;        //!< Leaf state after the transition
+    Event event;     //!< Event that caused it
+    uint32_t timeMs; //!< Time passed to dispatch()
+};
+
+namespace detail {
+
+/*!
+ * \brief Compile-time lookup tables of a machine definition
+ */
+template <typename Def>
+struct HsmIndex {
+    static constexpr size_t kStates = Def::kStateCount;
+    static constexpr size_t kEvents = Def::kEventCount;
+    static constexpr size_t kTransitions = sizeof(Def::transitions) / sizeof(Def::transitions[0]);
+
+    int16_t first[kStates * kEvents]; //!< First transition per [state][event] (-1 = none)
+    int16_t next[kTransitions];       //!< Next transition with the same state and event
+    uint8_t depth[kStates];           //!< Number of ancestors of each state
+    uint8_t maxDepth;                 //!< Deepest state
+    bool statesOrdered;               //!< states[i].id == i for every entry
+    bool acyclic;                     //!< Parent chains all end at a top-level state
+    bool leafTargets;                 //!< No transition targets a parent state
+};
+
+template <typename Def>
+constexpr HsmIndex<Def> hsmBuildIndex() {
+    using Index = HsmIndex<Def>;
+    Index index{};
+
+    index.statesOrdered = true;
+    index.acyclic = true;
+    index.leafTargets = true;
+
+    for (size_t i = 0; i < Index::kStates * Index::kEvents; i++) {
+        index.first[i] = -1;
+    }
+
+    // Walk backwards so each chain keeps the table order
+    for (size_t t = Index::kTransitions; t-- > 0;) {
+        const auto &tr = Def::transitions[t];
+        size_t slot = static_cast<size_t>(tr.from) * Index::kEvents + static_cast<size_t>(tr.event);
+        index.next[t] = index.first[slot];
+        index.first[slot] = static_cast<int16_t>(t);
+    }
+
+    for (size_t s = 0; s < Index::kStates; s++) {
+        if (static_cast<size_t>(Def::states[s].id) != s) {
+            index.statesOrdered = false;
+        }
+
+        size_t depth = 0;
+        size_t p = s;
+        while (static_cast<size_t>(Def::states[p].parent) != p && depth <= Index::kStates) {
+            p = static_cast<size_t>(Def::states[p].parent);
+            depth++;
+        }
+        if (depth > Index::kStates) {
+            index.acyclic = false;
+            depth = 0;
+        }
+        index.depth[s] = static_cast<uint8_t>(depth);
+        if (depth > index.maxDepth) {
+            index.maxDepth = static_cast<uint8_t>(depth);
+        }
+    }
+
+    for (size_t t = 0; t < Index::kTransitions; t++) {
+        for (size_t s = 0; s < Index::kStates; s++) {
+            if (s != static_cast<size_t>(Def::transitions[t].to) &&
+                Def::states[s].parent == Def::transitions[t].to) {
+                index.leafTargets = false;
+            }
+        }
+    }
+
+    return index;
+}
+
+} // namespace detail
+
+/*!
+ * \class StateMachine
+ * \brief Hierarchical state machine running a compile-time definition
+ * \tparam Def Definition struct (see the file description)
+ *
+ * Not thread-safe: one task owns the machine and dispatches its events.
+ */
+template <typename Def>
+class StateMachine {
+  public:
+    using State = typename Def::State;
+    using Event = typename Def::Event;
+    using Context = typename Def::Context;
+    using Trace = HsmTraceEntry<State, Event>;
+
+    /*!
+     * \brief Called after every traced transition
+     */
+    using TraceHook = void (*)(const Trace &entry);
+
+  private:
+    using Index = detail::HsmIndex<Def>;
+
+    static constexpr size_t kStates = Index::kStates;
+    static constexpr size_t kEvents = Index::kEvents;
+    static constexpr Index kIndex = detail::hsmBuildIndex<Def>();
+    static constexpr size_t kMaxPath = kIndex.maxDepth + 1;
+
+    static_assert(Index::kTransitions > 0 && Index::kTransitions < 0x7FFF, "Transition table size out of range");
+    static_assert(kIndex.statesOrdered, "states[i] must describe state i");
+    static_assert(kIndex.acyclic, "State parents must form a tree");
+    static_assert(kIndex.leafTargets, "Transition targets must be leaf states");
+
+  public:
+    /*!
+     * \brief Constructor
+     * \param context Data passed to every action and guard (not owned)
+     */
+    explicit StateMachine(Context &context)
+        : m_context(context), m_current(State()), m_started(false), m_traceHook(nullptr) {
+        reset();
+    }
+
+    /*!
+     * \brief Enter the initial state, running entry actions from the top down
+     * \param initial Initial leaf state
+     * \param nowMs Current time (ms)
+     *
+     * Clears the counters and the trace. Calling it again restarts the machine
+     * without running any exit action.
+     */
+    void start(State initial, uint32_t nowMs) {
+        reset();
+        m_current = initial;
+        m_started = true;
+        enterFrom(initial, initial, false, nowMs);
+    }
+
+    /*!
+     * \brief Deliver an event
+     * \param event Event to handle
+     * \param nowMs Current time (ms)
+     * \return true if a transition (internal or external) was taken
+     */
+    bool dispatch(Event event, uint32_t nowMs) {
+        if (!m_started) {
+            return false;
+        }
+
+        size_t e = static_cast<size_t>(event);
+        for (size_t s = index(m_current);; s = index(Def::states[s].parent)) {
+            for (int16_t t = kIndex.first[s * kEvents + e]; t >= 0; t = kIndex.next[t]) {
+                const auto &tr = Def::transitions[t];
+                if (tr.guard && !tr.guard(m_context)) {
+                    continue;
+                }
+                take(tr, nowMs);
+                return true;
+            }
+            if (isTopLevel(s)) {
+                return false;
+            }
+        }
+    }
+
+    /*!
+     * \brief Get the current leaf state
+     */
+    State state() const {
+        return m_current;
+    }
+
+    /*!
+     * \brief Check whether a state is the current state or one of its ancestors
+     */
+    bool isIn(State state) const {
+        if (!m_started) {
+            return false;
+        }
+        for (size_t s = index(m_current);; s = index(Def::states[s].parent)) {
+            if (s == index(state)) {
+                return true;
+            }
+            if (isTopLevel(s)) {
+                return false;
+            }
+        }
+    }
+
+    /*!
+     * \brief Get the time spent in the current leaf state (ms)
+     */
+    uint32_t timeInCurrent(uint32_t nowMs) const {
+        return m_started ? nowMs - m_enteredMs[index(m_current)] : 0;
+    }
+
+    /*!
+     * \brief Get the total time spent in a state since start() (ms, wraps after ~49 days)
+     * \param state State to query (a parent state counts while any child is active)
+     * \param nowMs Current time (ms)
+     */
+    uint32_t timeInState(State state, uint32_t nowMs) const {
+        size_t s = index(state);
+        uint32_t total = m_totalMs[s];
+        if (isIn(state)) {
+            total += nowMs - m_enteredMs[s];
+        }
+        return total;
+    }
+
+    /*!
+     * \brief Get how many times a state has been entered since start()
+     */
+    uint32_t entryCount(State state) const {
+        return m_entries[index(state)];
+    }
+
+    /*!
+     * \brief Get the number of traced transitions since start()
+     */
+    uint32_t transitionCount() const {
+        return m_transitions;
+    }
+
+    /*!
+     * \brief Get the number of entries held by the trace ring
+     */
+    size_t traceSize() const {
+        return m_transitions < HSM_TRACE_DEPTH ? m_transitions : HSM_TRACE_DEPTH;
+    }
+
+    /*!
+     * \brief Get a recorded transition
+     * \param i Position in the ring (0 = oldest kept, traceSize() - 1 = latest)
+     */
+    const Trace &traceAt(size_t i) const {
+        size_t oldest = (m_transitions - traceSize()) % HSM_TRACE_DEPTH;
+        return m_trace[(oldest + i) % HSM_TRACE_DEPTH];
+    }
+
+    /*!
+     * \brief Install a function called after every traced transition (nullptr to remove)
+     */
+    void setTraceHook(TraceHook hook) {
+        m_traceHook = hook;
+    }
+
+    /*!
+     * \brief Get the context passed to actions and guards
+     */
+    Context &context() {
+        return m_context;
+    }
+
+    /*!
+     * \brief Get the name of a state
+     */
+    static const char *stateName(State state) {
+        return Def::states[index(state)].name;
+    }
+
+    /*!
+     * \brief Get the name of an event
+     */
+    static const char *eventName(Event event) {
+        return Def::events[static_cast<size_t>(event)];
+    }
+
+  private:
+    static constexpr size_t index(State state) {
+        return static_cast<size_t>(state);
+    }
+
+    static constexpr bool isTopLevel(size_t s) {
+        return index(Def::states[s].parent) == s;
+    }
+
+    void reset() {
+        for (size_t s = 0; s < kStates; s++) {
+            m_enteredMs[s] = 0;
+            m_totalMs[s] = 0;
+            m_entries[s] = 0;
+        }
+        m_transitions = 0;
+    }
+
+    /*!
+     * \brief Run entry actions from just below an ancestor down to a leaf
+     * \param target Leaf being entered
+     * \param lca Common ancestor that stays active (ignored if !hasLca)
+     * \param hasLca False to enter from the top level
+     * \param nowMs Current time (ms)
+     */
+    void enterFrom(State target, State lca, bool hasLca, uint32_t nowMs) {
+        size_t path[kMaxPath];
+        size_t depth = 0;
+        for (size_t s = index(target);; s = index(Def::states[s].parent)) {
+            if (hasLca && s == index(lca)) {
+                break;
+            }
+            path[depth++] = s;
+            if (isTopLevel(s)) {
+                break;
+            }
+        }
+
+        while (depth > 0) {
+            size_t s = path[--depth];
+            m_enteredMs[s] = nowMs;
+            m_entries[s]++;
+            if (Def::states[s].onEntry) {
+                Def::states[s].onEntry(m_context);
+            }
+        }
+    }
+
+    /*!
+     * \brief Perform a transition: exit up to the common ancestor, act, enter down to the target
+     */
+    void take(const HsmTransition<State, Event, Context> &tr, uint32_t nowMs) {
+        State source = m_current;
+
+        if (tr.to == source) {
+            if (tr.action) {
+                tr.action(m_context);
+            }
+            return;
+        }
+
+        // Lowest common ancestor of source and target (if any)
+        size_t a = index(source);
+        size_t b = index(tr.to);
+        while (kIndex.depth[a] > kIndex.depth[b]) {
+            a = index(Def::states[a].parent);
+        }
+        while (kIndex.depth[b] > kIndex.depth[a]) {
+            b = index(Def::states[b].parent);
+        }
+        bool hasLca = true;
+        while (a != b) {
+            if (isTopLevel(a)) {
+                hasLca = false;
+                break;
+            }
+            a = index(Def::states[a].parent);
+            b = index(Def::states[b].parent);
+        }
+        State lca = static_cast<State>(a);
+
+        for (size_t s = index(source);; s = index(Def::states[s].parent)) {
+            if (hasLca && s == a) {
+                break;
+            }
+            m_totalMs[s] += nowMs - m_enteredMs[s];
+            if (Def::states[s].onExit) {
+                Def::states[s].onExit(m_context);
+            }
+            if (isTopLevel(s)) {
+                break;
+            }
+        }
+
+        if (tr.action) {
+            tr.action(m_context);
+        }
+
+        m_current = tr.to;
+        enterFrom(tr.to, lca, hasLca, nowMs);
+
+        Trace &entry = m_trace[m_transitions % HSM_TRACE_DEPTH];
+        entry.from = source;
+        entry.to = tr.to;
+        entry.event = tr.event;
+        entry.timeMs = nowMs;
+        m_transitions++;
+
+        if (m_traceHook) {
+            m_traceHook(entry);
+        }
+    }
+
+    Context &m_context;                //!< Data passed to actions and guards
+    State m_current;                   //!< Current leaf state
+    bool m_started;                    //!< start() has been called
+    TraceHook m_traceHook;             //!< Optional transition observer
+    uint32_t m_enteredMs[kStates];     //!< Entry time of each active state
+    uint32_t m_totalMs[kStates];       //!< Time accumulated by past visits
+    uint32_t m_entries[kStates];       //!< Entry counters
+    uint32_t m_transitions;            //!< Traced transitions since start()
+    Trace m_trace[HSM_TRACE_DEPTH];    //!< Latest transitions
+};
+
+} // namespace Utils
+} // namespace PlantMonitor
@@ -0,0 +1,179 @@
+#include "streaming-stats.h"
+#include <cmath>
+
+namespace PlantMonitor {
+namespace Utils {
+
+// ============================================================================
+// P2Quantile
+// ============================================================================
+
+P2Quantile::P2Quantile(float p) : m_p(p) {
+    reset();
+}
+
+void P2Quantile::reset() {
+    m_count = 0;
+    for (int i = 0; i < 5; ++i) {
+        m_q[i] = 0.0f;
+        m_n[i] = i + 1;
+    }
+    m_np[0] = 1.0f;
+    m_np[1] = 1.0f + 2.0f * m_p;
+    m_np[2] = 1.0f + 4.0f * m_p;
+    m_np[3] = 3.0f + 2.0f * m_p;
+    m_np[4] = 5.0f;
+    m_dn[0] = 0.0f;
+    m_dn[1] = m_p / 2.0f;
+    m_dn[2] = m_p;
+    m_dn[3] = (1.0f + m_p) / 2.0f;
+    m_dn[4] = 1.0f;
+}
+
+void P2Quantile::add(float x) {
+    // Warm-up: keep the first five samples sorted in the marker heights
+    if (m_count < 5) {
+        int i = static_cast<int>(m_count);
+        while (i > 0 && m_q[i - 1] > x) {
+            m_q[i] = m_q[i - 1];
+            i--;
+        }
+        m_q[i] = x;
+        m_count++;
+        return;
+    }
+    m_count++;
+
+    // Find the cell holding x, extending the extremes if needed
+    int k;
+    if (x < m_q[0]) {
+        m_q[0] = x;
+        k = 0;
+    } else if (x >= m_q[4]) {
+        m_q[4] = x;
+        k = 3;
+    } else {
+        k = 0;
+        while (k < 3 && x >= m_q[k + 1]) {
+            k++;
+        }
+    }
+
+    for (int i = k + 1; i < 5; ++i) {
+        m_n[i]++;
+    }
+    for (int i = 0; i < 5; ++i) {
+        m_np[i] += m_dn[i];
+    }
+
+    // Move the middle markers towards their desired positions
+    for (int i = 1; i < 4; ++i) {
+        float d = m_np[i] - static_cast<float>(m_n[i]);
+        if ((d >= 1.0f && m_n[i + 1] - m_n[i] > 1) || (d <= -1.0f && m_n[i - 1] - m_n[i] < -1)) {
+            int step = (d > 0.0f) ? 1 : -1;
+            float q = parabolic(i, step);
+            if (!(m_q[i - 1] < q && q < m_q[i + 1])) {
+                q = linear(i, step);
+            }
+            m_q[i] = q;
+            m_n[i] += step;
+        }
+    }
+}
+
+float P2Quantile::parabolic(int i, int d) const {
+    float n = static_cast<float>(m_n[i]);
+    float nPrev = static_cast<float>(m_n[i - 1]);
+    float nNext = static_cast<float>(m_n[i + 1]);
+    return m_q[i] + d / (nNext - nPrev) *
+                        ((n - nPrev + d) * (m_q[i + 1] - m_q[i]) / (nNext - n) +
+                         (nNext - n - d) * (m_q[i] - m_q[i - 1]) / (n - nPrev));
+}
+
+float P2Quantile::linear(int i, int d) const {
+    return m_q[i] + d * (m_q[i + d] - m_q[i]) / static_cast<float>(m_n[i + d] - m_n[i]);
+}
+
+float P2Quantile::get() const {
+    if (m_count == 0) {
+        return NAN;
+    }
+    if (m_count >= 5) {
+        return m_q[2];
+    }
+    // Exact quantile of the sorted warm-up samples (linear interpolation)
+    float pos = m_p * static_cast<float>(m_count - 1);
+    int lo = static_cast<int>(pos);
+    float frac = pos - static_cast<float>(lo);
+    if (lo + 1 >= static_cast<int>(m_count)) {
+        return m_q[lo];
+    }
+    return m_q[lo] + frac * (m_q[lo + 1] - m_q[lo]);
+}
+
+// ============================================================================
+// StreamingStats
+// ============================================================================
+
+StreamingStats::StreamingStats()
+    : m_low(STATS_QUANTILE_LOW), m_mid(STATS_QUANTILE_MID), m_high(STATS_QUANTILE_HIGH) {
+    reset();
+}
+
+void StreamingStats::reset() {
+    m_count = 0;
+    m_mean = 0.0f;
+    m_m2 = 0.0f;
+    m_min = NAN;
+    m_max = NAN;
+    m_low.reset();
+    m_mid.reset();
+    m_high.reset();
+}
+
+void StreamingStats::add(float x) {
+    if (std::isnan(x)) {
+        return;
+    }
+
+    m_count++;
+    float delta = x - m_mean;
+    m_mean += delta / static_cast<float>(m_count);
+    m_m2 += delta * (x - m_mean);
+
+    if (m_count == 1) {
+        m_min = x;
+        m_max = x;
+    } else {
+        m_min = (x < m_min) ? x : m_min;
+        m_max = (x > m_max) ? x : m_max;
+    }
+
+    m_low.add(x);
+    m_mid.add(x);
+    m_high.add(x);
+}
+
+float StreamingStats::mean() const {
+    return (m_count > 0) ? m_mean : NAN;
+}
+
+float StreamingStats::variance() const {
+    return (m_count > 1) ? m_m2 / static_cast<float>(m_count - 1) : 0.0f;
+}
+
+StatsSummary StreamingStats::summary() const {
+    StatsSummary s;
+    s.count = m_count;
+    s.mean = mean();
+    s.stddev = (m_count > 0) ? std::sqrt(variance()) : NAN;
+    s.min = m_min;
+    s.max = m_max;
+    s.p10 = m_low.get();
+    s.p50 = m_mid.get();
+    s.p90 = m_high.get();
+    return s;
+}
+
+} // namespace Utils
+} // namespace PlantMonitor
@@ -0,0 +1,150 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/*!
+ * \file streaming-stats.h
+ * \brief O(1)-memory running statistics for a sample stream
+ *
+ * StreamingStats keeps count, mean and variance (Welford's update, stable
+ * for long runs), min/max and three P² quantile estimates (10th, 50th and
+ * 90th percentile) without storing the samples. Memory is fixed (under
+ * 300 bytes per channel) whatever the number of samples.
+ *
+ * Typical usage:
+ * \code
+ * StreamingStats stats;
+ * stats.add(reading);              // On every sample
+ * StatsSummary s = stats.summary(); // At report time
+ * stats.reset();
+ * \endcode
+ */
+
+#define STATS_QUANTILE_LOW 0.10f  //!< Lower quantile reported in StatsSummary::p10
+#define STATS_QUANTILE_MID 0.50f  //!< Median reported in StatsSummary::p50
+#define STATS_QUANTILE_HIGH 0.90f //!< Upper quantile reported in StatsSummary::p90
+
+namespace PlantMonitor {
+namespace Utils {
+
+/*!
+ * \class P2Quantile
+ * \brief P² (Jain & Chlamtac) streaming quantile estimator
+ *
+ * Tracks five markers whose heights are adjusted with piecewise-parabolic
+ * interpolation as samples arrive. Until five samples are seen, the result
+ * is the exact quantile of the samples so far.
+ */
+class P2Quantile {
+  public:
+    /*!
+     * \brief Constructor
+     * \param p Quantile to estimate, in (0, 1)
+     */
+    explicit P2Quantile(float p = 0.5f);
+
+    /*!
+     * \brief Add a sample
+     */
+    void add(float x);
+
+    /*!
+     * \brief Get the current estimate
+     * \return Quantile estimate (NAN when empty)
+     */
+    float get() const;
+
+    /*!
+     * \brief Get the number of samples added
+     */
+    uint32_t count() const {
+        return m_count;
+    }
+
+    /*!
+     * \brief Forget every sample (keeps the quantile)
+     */
+    void reset();
+
+  private:
+    float parabolic(int i, int d) const;
+    float linear(int i, int d) const;
+
+    float m_p;          //!< Target quantile
+    float m_q[5];       //!< Marker heights
+    int32_t m_n[5];     //!< Actual marker positions
+    float m_np[5];      //!< Desired marker positions
+    float m_dn[5];      //!< Desired position increments per sample
+    uint32_t m_count;   //!< Samples added
+};
+
+/*!
+ * \struct StatsSummary
+ * \brief Snapshot of a StreamingStats accumulator
+ *
+ * All statistics are NAN when count is 0; stddev is 0 with a single sample.
+ */
+struct StatsSummary {
+    uint32_t count; //!< Samples accumulated
+    float mean;     //!< Arithmetic mean
+    float stddev;   //!< Sample standard deviation
+    float min;      //!< Smallest sample
+    float max;      //!< Largest sample
+    float p10;      //!< 10th percentile estimate
+    float p50;      //!< Median estimate
+    float p90;      //!< 90th percentile estimate
+};
+
+/*!
+ * \class StreamingStats
+ * \brief Count, mean, variance, min/max and quantiles of a stream
+ */
+class StreamingStats {
+  public:
+    StreamingStats();
+
+    /*!
+     * \brief Add a sample (NAN samples are ignored)
+     */
+    void add(float x);
+
+    /*!
+     * \brief Get the number of samples accumulated
+     */
+    uint32_t count() const {
+        return m_count;
+    }
+
+    /*!
+     * \brief Get the mean (NAN when empty)
+     */
+    float mean() const;
+
+    /*!
+     * \brief Get the sample variance (n - 1 denominator; 0 with fewer than two samples)
+     */
+    float variance() const;
+
+    /*!
+     * \brief Get a snapshot of every statistic
+     */
+    StatsSummary summary() const;
+
+    /*!
+     * \brief Forget every sample
+     */
+    void reset();
+
+  private:
+    uint32_t m_count;   //!< Samples accumulated
+    float m_mean;       //!< Running mean
+    float m_m2;         //!< Sum of squared deviations from the mean
+    float m_min;        //!< Smallest sample
+    float m_max;        //!< Largest sample
+    P2Quantile m_low;   //!< STATS_QUANTILE_LOW estimator
+    P2Quantile m_mid;   //!< STATS_QUANTILE_MID estimator
+    P2Quantile m_high;  //!< STATS_QUANTILE_HIGH estimator
+};
+
+} // namespace Utils
+} // namespace PlantMonitor
@@ -0,0 +1,143 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/*!
+ * \file subscriber-table.h
+ * \brief Fixed-size, lock-free table of notification subscribers.
+ *
+ * Slots are claimed with a compare-and-swap and published with a release
+ * store, so the publishing task walks the table without taking a lock while
+ * other tasks subscribe and unsubscribe.
+ *
+ * Typical usage:
+ * \code
+ * struct Subscriber {
+ *     TaskHandle_t task;
+ *     uint32_t notifyBits;
+ * };
+ * SubscriberTable<Subscriber, 4> subscribers;
+ *
+ * subscribers.add({task, bits});
+ * subscribers.forEach([](const Subscriber &sub) { xTaskNotify(sub.task, sub.notifyBits, eSetBits); });
+ * subscribers.remove([task](const Subscriber &sub) { return sub.task == task; });
+ * \endcode
+ *
+ * \note An entry is only written while its slot is claimed. A slot removed
+ *       while the publisher is visiting it may be reused by a concurrent add();
+ *       callers unsubscribe before tearing down whatever the entry points to.
+ */
+
+namespace PlantMonitor {
+namespace Utils {
+
+/*!
+ * \class SubscriberTable
+ * \brief Subscriber slots shared between one publisher and any number of subscribers.
+ * \tparam T Entry type (copied into the slot)
+ * \tparam N Number of slots
+ */
+template <typename T, size_t N>
+class SubscriberTable {
+    static_assert(N > 0, "SubscriberTable needs at least one slot");
+
+  public:
+    /*!
+     * \brief Constructor (all slots free)
+     */
+    SubscriberTable() {
+        for (Slot &slot : m_slots) {
+            slot.state.store(SLOT_FREE, std::memory_order_relaxed);
+        }
+    }
+
+    /*!
+     * \brief Claim a free slot and publish an entry in it
+     * \param entry Entry to copy into the slot
+     * \return true if a slot was available
+     */
+    bool add(const T &entry) {
+        for (Slot &slot : m_slots) {
+            uint8_t expected = SLOT_FREE;
+            if (!slot.state.compare_exchange_strong(expected, SLOT_CLAIMED, std::memory_order_acquire)) {
+                continue;
+            }
+            slot.entry = entry;
+            slot.state.store(SLOT_ACTIVE, std::memory_order_release);
+            return true;
+        }
+        return false;
+    }
+
+    /*!
+     * \brief Free every active slot whose entry matches
+     * \param match Predicate called with each active entry
+     * \return Number of slots freed
+     */
+    template <typename Predicate>
+    size_t remove(Predicate match) {
+        size_t removed = 0;
+        for (Slot &slot : m_slots) {
+            if (slot.state.load(std::memory_order_acquire) == SLOT_ACTIVE && match(slot.entry)) {
+                slot.state.store(SLOT_FREE, std::memory_order_release);
+                ++removed;
+            }
+        }
+        return removed;
+    }
+
+    /*!
+     * \brief Visit every active entry
+     * \param fn Function called with each active entry
+     */
+    template <typename Function>
+    void forEach(Function fn) const {
+        for (const Slot &slot : m_slots) {
+            if (slot.state.load(std::memory_order_acquire) == SLOT_ACTIVE) {
+                fn(slot.entry);
+            }
+        }
+    }
+
+    /*!
+     * \brief Get the number of active entries
+     * \return Active slot count
+     */
+    size_t size() const {
+        size_t count = 0;
+        for (const Slot &slot : m_slots) {
+            if (slot.state.load(std::memory_order_acquire) == SLOT_ACTIVE) {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    /*!
+     * \brief Get the number of slots
+     * \return N
+     */
+    static constexpr size_t capacity() { return N; }
+
+  private:
+    /*!
+     * \enum SlotState
+     * \brief Life cycle of a slot
+     */
+    enum SlotState : uint8_t {
+        SLOT_FREE = 0, //!< Available
+        SLOT_CLAIMED,  //!< Being filled by add()
+        SLOT_ACTIVE    //!< Visited by forEach()
+    };
+
+    struct Slot {
+        std::atomic<uint8_t> state; //!< SlotState
+        T entry;                    //!< Subscriber data, valid while ACTIVE
+    };
+
+    Slot m_slots[N];
+};
+
+} // namespace Utils
+} // namespace PlantMonitor
@@ -4,49 +4,21 @@ namespace PlantMonitor {
 namespace Utils {
 
 PeriodicSendTimer::PeriodicSendTimer()
-    : m_timer(nullptr), m_period_ms(0), m_running(false), m_due(false), m_count(0), m_mutex(nullptr) {
-
-    m_mutex = xSemaphoreCreateBinary();
-    if (m_mutex) {
-        xSemaphoreGive(m_mutex); // Make the semaphore available
-    }
-}
+    : m_timer(TIMER_WHEEL_INVALID_ID), m_period_ms(0), m_running(false), m_due(false), m_count(0), m_waiter(nullptr) {}
 
 PeriodicSendTimer::~PeriodicSendTimer() {
     end();
-
-    if (m_mutex) {
-        vSemaphoreDelete(m_mutex);
-        m_mutex = nullptr;
-    }
 }
 
 bool PeriodicSendTimer::begin(uint32_t period_ms, bool start_now) {
     end();
 
     m_period_ms = period_ms;
-    m_due = false;
-    m_count = 0;
+    m_due.store(false, std::memory_order_relaxed);
+    m_count.store(0, std::memory_order_relaxed);
     m_running = false;
 
-    // Recreate semaphore if it was destroyed
-    if (!m_mutex) {
-        m_mutex = xSemaphoreCreateBinary();
-        if (m_mutex) {
-            xSemaphoreGive(m_mutex);
-        } else {
-            return false;
-        }
-    }
-
-    esp_timer_create_args_t args = {};
-    args.callback = &PeriodicSendTimer::timerThunk;
-    args.arg = this;
-    args.dispatch_method = ESP_TIMER_TASK;
-    args.name = "PeriodicSendTimer";
-
-    if (esp_timer_create(&args, &m_timer) != ESP_OK || m_timer == nullptr) {
-        m_timer = nullptr;
+    if (!TimerService::ready()) {
         return false;
     }
 
@@ -57,13 +29,13 @@ bool PeriodicSendTimer::begin(uint32_t period_ms, bool start_now) {
 }
 
 bool PeriodicSendTimer::start() {
-    if (!m_timer || m_period_ms == 0)
+    if (m_period_ms == 0)
         return false;
     if (m_running)
         return true;
 
-    const uint64_t us = (uint64_t)m_period_ms * 1000ULL;
-    if (esp_timer_start_periodic(m_timer, us) != ESP_OK) {
+    m_timer = TimerService::startCallback(&PeriodicSendTimer::timerThunk, this, 0, m_period_ms, m_period_ms);
+    if (m_timer == TIMER_WHEEL_INVALID_ID) {
         return false;
     }
 
@@ -72,20 +44,16 @@ bool PeriodicSendTimer::start() {
 }
 
 void PeriodicSendTimer::stop() {
-    if (!m_timer)
-        return;
     if (m_running) {
-        esp_timer_stop(m_timer);
+        TimerService::cancel(m_timer);
+        m_timer = TIMER_WHEEL_INVALID_ID;
         m_running = false;
     }
 }
 
 void PeriodicSendTimer::end() {
     stop();
-    if (m_timer) {
-        esp_timer_delete(m_timer);
-        m_timer = nullptr;
-    }
+    m_period_ms = 0;
 }
 
 bool PeriodicSendTimer::isRunning() const {
@@ -93,48 +61,54 @@ bool PeriodicSendTimer::isRunning() const {
 }
 
 bool PeriodicSendTimer::take() {
-    if (!m_mutex)
-        return false;
-
-    bool ret = false;
-
-    if (xSemaphoreTake(m_mutex, pdMS_TO_TICKS(10)) == pdTRUE) {
-        if (m_due) {
-            m_due = false;
-            ret = true;
-        }
-        xSemaphoreGive(m_mutex);
-    }
-
-    return ret;
+    // Read and clear in one step: a fire landing in between is never lost
+    return m_due.exchange(false, std::memory_order_acq_rel);
 }
 
 bool PeriodicSendTimer::peek() const {
-    if (!m_mutex)
-        return false;
+    return m_due.load(std::memory_order_acquire);
+}
 
-    bool ret = false;
+void PeriodicSendTimer::clear() {
+    m_due.store(false, std::memory_order_release);
+}
 
-    if (xSemaphoreTake(m_mutex, pdMS_TO_TICKS(10)) == pdTRUE) {
-        ret = m_due;
-        xSemaphoreGive(m_mutex);
+bool PeriodicSendTimer::waitFor(uint32_t timeout_ms) {
+    if (take()) {
+        return true;
     }
 
-    return ret;
-}
-
-void PeriodicSendTimer::clear() {
-    if (!m_mutex)
-        return;
+    // Publish the waiter, then check again: a fire between the first take()
+    // and the store would otherwise go unnoticed until the next period
+    m_waiter.store(xTaskGetCurrentTaskHandle(), std::memory_order_release);
+
+    const bool forever = (timeout_ms == PERIODIC_TIMER_WAIT_FOREVER);
+    const TickType_t timeout = forever ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+    const TickType_t start = xTaskGetTickCount();
+    bool fired = take();
+
+    while (!fired) {
+        TickType_t wait = portMAX_DELAY;
+        if (!forever) {
+            TickType_t elapsed = xTaskGetTickCount() - start;
+            if (elapsed >= timeout) {
+                break;
+            }
+            wait = timeout - elapsed;
+        }
 
-    if (xSemaphoreTake(m_mutex, pdMS_TO_TICKS(10)) == pdTRUE) {
-        m_due = false;
-        xSemaphoreGive(m_mutex);
+        // Only our bit is cleared; other notification bits stay for the task's own loop
+        uint32_t bits = 0;
+        xTaskNotifyWait(0, PERIODIC_TIMER_NOTIFY_BIT, &bits, wait);
+        fired = take();
     }
+
+    m_waiter.store(nullptr, std::memory_order_release);
+    return fired;
 }
 
 bool PeriodicSendTimer::setPeriodMs(uint32_t period_ms) {
-    if (!m_timer || period_ms == 0)
+    if (m_period_ms == 0 || period_ms == 0)
         return false;
 
     const bool wasRunning = m_running;
@@ -152,36 +126,24 @@ uint32_t PeriodicSendTimer::periodMs() const {
     return m_period_ms;
 }
 
-uint64_t PeriodicSendTimer::fireCount() const {
-    if (!m_mutex)
-        return 0;
-
-    uint64_t c = 0;
-
-    if (xSemaphoreTake(m_mutex, pdMS_TO_TICKS(10)) == pdTRUE) {
-        c = m_count;
-        xSemaphoreGive(m_mutex);
-    }
-
-    return c;
+uint32_t PeriodicSendTimer::fireCount() const {
+    return m_count.load(std::memory_order_relaxed);
 }
 
-void PeriodicSendTimer::timerThunk(void *arg) {
+void PeriodicSendTimer::timerThunk(void *arg, uint32_t) {
     auto *self = static_cast<PeriodicSendTimer *>(arg);
     if (self)
         self->onTimer();
 }
 
 void PeriodicSendTimer::onTimer() {
-    if (!m_mutex)
-        return;
-
-    // ESP_TIMER_TASK dispatch: this runs in a dedicated FreeRTOS task,
-    // not in ISR context, so normal xSemaphoreTake is safe.
-    if (xSemaphoreTake(m_mutex, 0) == pdTRUE) {
-        m_due = true;
-        m_count++;
-        xSemaphoreGive(m_mutex);
+    // Never blocks and never drops a fire, whatever the consumer is doing
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_due.store(true, std::memory_order_release);
+
+    TaskHandle_t waiter = m_waiter.load(std::memory_order_acquire);
+    if (waiter) {
+        xTaskNotify(waiter, PERIODIC_TIMER_NOTIFY_BIT, eSetBits);
     }
 }
 
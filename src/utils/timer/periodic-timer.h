@@ -1,16 +1,18 @@
 #pragma once
 #include <Arduino.h>
-#include "esp_timer.h"
+#include <atomic>
 #include "freertos/FreeRTOS.h"
-#include "freertos/semphr.h"
+#include "timer-service.h"
 
 /*!
  * \file periodic-timer.h
- * \brief Thread-safe periodic timer built on top of ESP32 esp_timer.
+ * \brief Thread-safe periodic timer built on top of the shared TimerService.
  *
  * This module provides a reusable periodic timer that signals readiness
- * through a mutex-protected flag, suitable for cooperative polling from
- * FreeRTOS tasks.
+ * through a lock-free flag, suitable for cooperative polling from FreeRTOS
+ * tasks, or for blocking on a task notification with waitFor(). Each
+ * instance is a handle on one TimerService wheel slot, so any number of them
+ * share a single esp_timer.
  *
  * Typical usage:
  * \code
@@ -23,12 +25,22 @@
  *     }
  *     vTaskDelay(pdMS_TO_TICKS(20));
  * }
+ *
+ * while (true) {
+ *     if (timer.waitFor(PERIODIC_TIMER_WAIT_FOREVER)) { // Sleeps until the fire
+ *         // Time to act
+ *     }
+ * }
  * \endcode
  *
- * \note The timer callback runs in the ESP_TIMER_TASK context (not ISR),
- *       so standard FreeRTOS synchronization primitives are safe to use.
+ * \note The timer callback runs in the ESP_TIMER_TASK context (not ISR).
+ *       It only touches atomics, so a fire is never dropped or delayed by
+ *       a consumer. Periods are rounded up to TIMER_SERVICE_TICK_MS.
  */
 
+#define PERIODIC_TIMER_NOTIFY_BIT (1u << 31)    //!< Notification bit used by waitFor()
+#define PERIODIC_TIMER_WAIT_FOREVER 0xFFFFFFFFu //!< waitFor() timeout that never expires
+
 namespace PlantMonitor {
 namespace Utils {
 
@@ -36,39 +48,36 @@ namespace Utils {
  * \class PeriodicSendTimer
  * \brief Periodic timer with thread-safe signalling.
  *
- * Internally uses \c esp_timer_start_periodic and a binary semaphore to
- * protect the \c m_due flag, which is set by the timer callback and
- * consumed by application code via take().
+ * Internally arms a periodic TimerService callback that sets the atomic
+ * \c m_due flag, which is consumed by application code via take() or waitFor().
  */
 class PeriodicSendTimer {
   public:
     /*!
      * \brief Construct a timer (not yet started).
-     *
-     * Creates the internal binary semaphore.
      */
     PeriodicSendTimer();
 
     /*!
      * \brief Destroy the timer, releasing all resources.
      *
-     * Calls end() and deletes the semaphore.
+     * Calls end(), which releases the TimerService slot.
      */
     ~PeriodicSendTimer();
 
     /*!
-     * \brief Create and optionally start the underlying esp_timer.
+     * \brief Configure and optionally start the timer.
      * \param period_ms Timer period in milliseconds.
-     * \param start_now If true, the timer starts immediately after creation.
+     * \param start_now If true, the timer starts immediately after configuration.
      * \return true on success, false if resource allocation failed.
      *
-     * Calling begin() on an already-running timer will stop and recreate it.
+     * Calling begin() on an already-running timer will stop and restart it.
      */
     bool begin(uint32_t period_ms, bool start_now = true);
 
     /*!
      * \brief Start the timer with the previously configured period.
-     * \return true on success, false if the timer was not created or the period is zero.
+     * \return true on success, false if the timer was not configured or the wheel is full.
      */
     bool start();
 
@@ -80,7 +89,7 @@ class PeriodicSendTimer {
     void stop();
 
     /*!
-     * \brief Stop and destroy the underlying esp_timer.
+     * \brief Stop the timer and forget its period.
      *
      * After this call, begin() must be called again before the timer can be used.
      */
@@ -97,10 +106,22 @@ class PeriodicSendTimer {
      * \return true if the timer had fired since the last take(), false otherwise.
      *
      * This is the primary polling method: it atomically reads and clears
-     * the internal \c m_due flag under mutex protection.
+     * the internal \c m_due flag (single exchange, never blocks).
      */
     bool take();
 
+    /*!
+     * \brief Block until the timer fires, then consume the signal.
+     * \param timeout_ms Longest wait (PERIODIC_TIMER_WAIT_FOREVER for no limit).
+     * \return true if the timer fired (or had already fired), false on timeout.
+     *
+     * The caller sleeps on PERIODIC_TIMER_NOTIFY_BIT of its task notification
+     * value instead of polling. Only one task may wait on a timer at a time,
+     * and the task must not use that bit for anything else. Other bits are
+     * left in the notification value.
+     */
+    bool waitFor(uint32_t timeout_ms);
+
     /*!
      * \brief Peek at the pending signal without consuming it.
      * \return true if the timer has fired and the signal has not been consumed.
@@ -129,26 +150,25 @@ class PeriodicSendTimer {
 
     /*!
      * \brief Get the total number of times the timer has fired.
-     * \return Fire count (mutex-protected read).
+     * \return Fire count (lock-free read, wraps at 2^32).
      */
-    uint64_t fireCount() const;
+    uint32_t fireCount() const;
 
   private:
-    /// \brief Static trampoline forwarding the esp_timer callback to onTimer().
-    static void timerThunk(void *arg);
+    /// \brief Static trampoline forwarding the TimerService callback to onTimer().
+    static void timerThunk(void *arg, uint32_t);
 
     /// \brief Timer callback executed in ESP_TIMER_TASK context.
     void onTimer();
 
   private:
-    esp_timer_handle_t m_timer; //!< Underlying esp_timer handle.
-    uint32_t m_period_ms;       //!< Configured period (ms).
-    bool m_running;             //!< True while the timer is active.
-
-    bool m_due;       //!< Set by onTimer(), cleared by take().
-    uint64_t m_count; //!< Cumulative fire count.
+    TimerId m_timer;      //!< TimerService handle while running.
+    uint32_t m_period_ms; //!< Configured period (ms).
+    bool m_running;       //!< True while the timer is active.
 
-    SemaphoreHandle_t m_mutex; //!< Binary semaphore protecting m_due and m_count.
+    std::atomic<bool> m_due;            //!< Set by onTimer(), cleared by take().
+    std::atomic<uint32_t> m_count;      //!< Cumulative fire count (32-bit: native atomics on the ESP32).
+    std::atomic<TaskHandle_t> m_waiter; //!< Task blocked in waitFor(), if any.
 };
 
 } // namespace Utils
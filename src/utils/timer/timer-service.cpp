@@ -0,0 +1,170 @@
+#include "timer-service.h"
+#include "esp_timer.h"
+#include "freertos/semphr.h"
+#include <atomic>
+
+namespace PlantMonitor {
+namespace Utils {
+
+static TimerWheel timer_service_wheel;
+static SemaphoreHandle_t timer_service_lock = nullptr;
+static esp_timer_handle_t timer_service_tick_timer = nullptr;
+static std::atomic<bool> timer_service_ready(false); //!< Lock and tick timer created by begin()
+
+static constexpr int64_t TIMER_SERVICE_TICK_US = 1000LL * TIMER_SERVICE_TICK_MS;
+
+/*!
+ * \brief Current time in wheel ticks (wraps after ~497 days, which the wheel tolerates)
+ */
+static uint32_t prv_now_ticks() {
+    return static_cast<uint32_t>(esp_timer_get_time() / TIMER_SERVICE_TICK_US);
+}
+
+/*!
+ * \brief Expiry callback of startNotify() timers
+ */
+static void prv_notify_task(void *context, uint32_t bits) {
+    xTaskNotify(static_cast<TaskHandle_t>(context), bits, eSetBits);
+}
+
+/*!
+ * \brief Re-arm the one-shot tick timer for the wheel's next expiry (lock held)
+ *
+ * The CPU only wakes when a timer is due, and not at all while the wheel is
+ * empty. The wheel's clock may lag behind (it is only advanced on demand),
+ * so the deadline is taken as an absolute tick and measured from now.
+ */
+static void prv_arm_tick_timer() {
+    esp_timer_stop(timer_service_tick_timer); // Fails harmlessly when not armed
+
+    uint32_t ticks = 0;
+    if (!timer_service_wheel.nextExpiry(ticks)) {
+        return;
+    }
+    int64_t nowUs = esp_timer_get_time();
+    uint32_t deadline = timer_service_wheel.now() + ticks;
+    int32_t ticksAhead = static_cast<int32_t>(deadline - static_cast<uint32_t>(nowUs / TIMER_SERVICE_TICK_US));
+    int64_t delayUs = ticksAhead * TIMER_SERVICE_TICK_US - nowUs % TIMER_SERVICE_TICK_US;
+    esp_timer_start_once(timer_service_tick_timer, delayUs > 0 ? static_cast<uint64_t>(delayUs) : 0);
+}
+
+/*!
+ * \brief Tick timer callback (ESP_TIMER_TASK context)
+ */
+static void prv_on_tick(void *) {
+    TimerService::poll();
+}
+
+bool TimerService::begin() {
+    if (ready()) {
+        return true;
+    }
+
+    if (!timer_service_lock) {
+        timer_service_lock = xSemaphoreCreateMutex();
+        if (!timer_service_lock) {
+            return false;
+        }
+    }
+
+    esp_timer_create_args_t args = {};
+    args.callback = &prv_on_tick;
+    args.arg = nullptr;
+    args.dispatch_method = ESP_TIMER_TASK;
+    args.name = "TimerService";
+
+    if (esp_timer_create(&args, &timer_service_tick_timer) != ESP_OK || timer_service_tick_timer == nullptr) {
+        timer_service_tick_timer = nullptr;
+        return false;
+    }
+
+    // The wheel is empty, so this only aligns its clock
+    timer_service_wheel.advanceTo(prv_now_ticks());
+    timer_service_ready.store(true, std::memory_order_release);
+    return true;
+}
+
+bool TimerService::ready() {
+    return timer_service_ready.load(std::memory_order_acquire);
+}
+
+TimerId TimerService::startCallback(TimerWheel::Callback callback, void *context, uint32_t value,
+                                    uint32_t delayMs, uint32_t periodMs) {
+    if (!ready() || xSemaphoreTake(timer_service_lock, portMAX_DELAY) != pdTRUE) {
+        return TIMER_WHEEL_INVALID_ID;
+    }
+
+    // Catch up first: the tick timer may have been idle, and the delay counts from now
+    timer_service_wheel.advanceTo(prv_now_ticks());
+    TimerId id = timer_service_wheel.schedule(msToTicks(delayMs), msToTicks(periodMs), callback, context, value);
+    if (id != TIMER_WHEEL_INVALID_ID) {
+        prv_arm_tick_timer();
+    }
+
+    xSemaphoreGive(timer_service_lock);
+    return id;
+}
+
+TimerId TimerService::startNotify(TaskHandle_t task, uint32_t bits, uint32_t delayMs, uint32_t periodMs) {
+    if (!task || bits == 0) {
+        return TIMER_WHEEL_INVALID_ID;
+    }
+    return startCallback(&prv_notify_task, task, bits, delayMs, periodMs);
+}
+
+bool TimerService::cancel(TimerId id) {
+    if (!timer_service_lock || xSemaphoreTake(timer_service_lock, portMAX_DELAY) != pdTRUE) {
+        return false;
+    }
+    bool cancelled = timer_service_wheel.cancel(id);
+    if (cancelled) {
+        prv_arm_tick_timer();
+    }
+    xSemaphoreGive(timer_service_lock);
+    return cancelled;
+}
+
+bool TimerService::isActive(TimerId id) {
+    if (!timer_service_lock || xSemaphoreTake(timer_service_lock, portMAX_DELAY) != pdTRUE) {
+        return false;
+    }
+    bool active = timer_service_wheel.isActive(id);
+    xSemaphoreGive(timer_service_lock);
+    return active;
+}
+
+uint32_t TimerService::remainingMs(TimerId id) {
+    if (!timer_service_lock || xSemaphoreTake(timer_service_lock, portMAX_DELAY) != pdTRUE) {
+        return 0;
+    }
+    uint32_t ticks = timer_service_wheel.remaining(id);
+    xSemaphoreGive(timer_service_lock);
+    return ticks * TIMER_SERVICE_TICK_MS;
+}
+
+size_t TimerService::poll() {
+    if (!timer_service_lock) {
+        return 0;
+    }
+
+    TimerWheel::Expiry expired[TIMER_SERVICE_POLL_BATCH];
+    size_t fired = 0;
+    bool caughtUp = false;
+    while (!caughtUp && xSemaphoreTake(timer_service_lock, portMAX_DELAY) == pdTRUE) {
+        uint32_t now = prv_now_ticks();
+        size_t count = timer_service_wheel.collect(now, expired, TIMER_SERVICE_POLL_BATCH);
+        caughtUp = timer_service_wheel.now() == now;
+        prv_arm_tick_timer();
+        xSemaphoreGive(timer_service_lock);
+
+        // Outside the lock, so a callback may start or cancel timers
+        for (size_t i = 0; i < count; ++i) {
+            expired[i].callback(expired[i].context, expired[i].value);
+        }
+        fired += count;
+    }
+    return fired;
+}
+
+} // namespace Utils
+} // namespace PlantMonitor
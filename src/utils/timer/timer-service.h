@@ -0,0 +1,113 @@
+#pragma once
+#include <Arduino.h>
+#include "freertos/FreeRTOS.h"
+#include "timer-wheel.h"
+
+/*!
+ * \file timer-service.h
+ * \brief Application timer service: every software timer on one esp_timer.
+ *
+ * A single one-shot esp_timer is armed for the TimerWheel's next expiry and
+ * re-armed whenever a timer is started, cancelled or fires; with the wheel
+ * empty nothing is armed. The CPU only wakes when a timer is due, which
+ * leaves the idle time free for light sleep. Expiries are delivered either
+ * as task notification bits (eSetBits) or as a plain callback.
+ *
+ * Typical usage:
+ * \code
+ * TimerService::begin();                 // Once, in setup()
+ * TimerService::startNotify(xTaskGetCurrentTaskHandle(), MY_REFRESH_BIT, 1000, 1000);
+ *
+ * uint32_t bits = 0;
+ * xTaskNotifyWait(0, UINT32_MAX, &bits, portMAX_DELAY);
+ * if (bits & MY_REFRESH_BIT) { ... }
+ * \endcode
+ *
+ * \note Callbacks run in the ESP_TIMER_TASK context after the service lock
+ *       is released, so they may start or cancel timers, but must be short.
+ *       Callbacks due in the same poll are collected first: one of them
+ *       cancelling another does not stop that one from running this time.
+ */
+
+#define TIMER_SERVICE_TICK_MS 10                             //!< Wheel resolution (timers are rounded up to whole ticks)
+#define TIMER_SERVICE_POLL_BATCH (2 * TIMER_WHEEL_MAX_TIMERS) //!< Expiries collected per lock hold in poll()
+
+namespace PlantMonitor {
+namespace Utils {
+
+/*!
+ * \class TimerService
+ * \brief Static front end of the shared timer wheel
+ */
+class TimerService {
+  public:
+    /*!
+     * \brief Create the lock and the tick timer
+     * \return true once the service is usable
+     * \note Call once from setup() before any task starts: creation is not
+     *       guarded against concurrent callers. Later calls only return ready().
+     */
+    static bool begin();
+
+    /*!
+     * \brief Check whether begin() succeeded (timers can be armed)
+     */
+    static bool ready();
+
+    /*!
+     * \brief Arm a timer that sets notification bits on a task
+     * \param task Task to notify
+     * \param bits Bits OR-ed into the task's notification value on expiry
+     * \param delayMs Time to the first expiry
+     * \param periodMs Re-arm interval (0 = one-shot)
+     * \return Timer handle, or TIMER_WHEEL_INVALID_ID on failure
+     */
+    static TimerId startNotify(TaskHandle_t task, uint32_t bits, uint32_t delayMs, uint32_t periodMs = 0);
+
+    /*!
+     * \brief Arm a timer that calls a function
+     * \param callback Function called on expiry (ESP_TIMER_TASK context)
+     * \param context Passed to the callback
+     * \param value Passed to the callback
+     * \param delayMs Time to the first expiry
+     * \param periodMs Re-arm interval (0 = one-shot)
+     * \return Timer handle, or TIMER_WHEEL_INVALID_ID on failure
+     */
+    static TimerId startCallback(TimerWheel::Callback callback, void *context, uint32_t value,
+                                 uint32_t delayMs, uint32_t periodMs = 0);
+
+    /*!
+     * \brief Disarm a timer
+     * \return true if the timer was armed
+     */
+    static bool cancel(TimerId id);
+
+    /*!
+     * \brief Check whether a timer is armed
+     */
+    static bool isActive(TimerId id);
+
+    /*!
+     * \brief Get the time left before a timer's next expiry (0 if inactive)
+     */
+    static uint32_t remainingMs(TimerId id);
+
+    /*!
+     * \brief Bring the wheel up to the current time, firing due timers
+     * \return Number of expiries delivered
+     *
+     * Called by the tick timer; host tests call it after moving the mock clock.
+     * Callbacks run without the service lock held.
+     */
+    static size_t poll();
+
+    /*!
+     * \brief Convert a duration to wheel ticks (rounded up)
+     */
+    static constexpr uint32_t msToTicks(uint32_t ms) {
+        return (ms + TIMER_SERVICE_TICK_MS - 1) / TIMER_SERVICE_TICK_MS;
+    }
+};
+
+} // namespace Utils
+} // namespace PlantMonitor
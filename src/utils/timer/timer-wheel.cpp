@@ -0,0 +1,243 @@
+#include "timer-wheel.h"
+
+namespace PlantMonitor {
+namespace Utils {
+
+static_assert(TIMER_WHEEL_MAX_TIMERS > 0 && TIMER_WHEEL_MAX_TIMERS < 256, "Timer index must fit the low byte of a TimerId");
+static_assert(TIMER_WHEEL_SLOT_BITS * TIMER_WHEEL_LEVELS <= 31, "Timer wheel range must fit 31 bits");
+
+TimerWheel::TimerWheel() : m_free(kNone), m_now(0), m_active(0) {
+    for (size_t i = 0; i < TIMER_WHEEL_MAX_TIMERS; ++i) {
+        m_nodes[i].generation = 0;
+        m_nodes[i].active = false;
+    }
+    clear();
+}
+
+void TimerWheel::clear() {
+    for (size_t i = 0; i < TIMER_WHEEL_LEVELS * kSlots; ++i) {
+        m_slots[i] = kNone;
+    }
+    // Rebuild the free list; bumping the generation invalidates every handle
+    m_free = kNone;
+    for (int16_t i = TIMER_WHEEL_MAX_TIMERS - 1; i >= 0; --i) {
+        Node &n = m_nodes[i];
+        if (n.active) {
+            n.generation++;
+        }
+        n.active = false;
+        n.next = m_free;
+        m_free = i;
+    }
+    m_active = 0;
+}
+
+TimerId TimerWheel::schedule(uint32_t delayTicks, uint32_t periodTicks, Callback callback, void *context, uint32_t value) {
+    if (m_free == kNone || callback == nullptr) {
+        return TIMER_WHEEL_INVALID_ID;
+    }
+
+    int16_t index = m_free;
+    Node &n = m_nodes[index];
+    m_free = n.next;
+
+    if (delayTicks == 0) {
+        delayTicks = 1; // The current tick has already been processed
+    }
+    n.expires = m_now + (delayTicks < maxDelay() ? delayTicks : maxDelay());
+    n.period = periodTicks < maxDelay() ? periodTicks : maxDelay();
+    n.callback = callback;
+    n.context = context;
+    n.value = value;
+    n.active = true;
+    insert(index);
+    m_active++;
+
+    return (n.generation << 8) | static_cast<uint32_t>(index + 1);
+}
+
+bool TimerWheel::cancel(TimerId id) {
+    int16_t index = indexOf(id);
+    if (index == kNone) {
+        return false;
+    }
+    unlink(index);
+    release(index);
+    return true;
+}
+
+bool TimerWheel::isActive(TimerId id) const {
+    return indexOf(id) != kNone;
+}
+
+uint32_t TimerWheel::remaining(TimerId id) const {
+    int16_t index = indexOf(id);
+    return (index == kNone) ? 0 : m_nodes[index].expires - m_now;
+}
+
+size_t TimerWheel::advance(uint32_t ticks) {
+    if (m_active == 0) {
+        m_now += ticks; // Nothing to fire or cascade
+        return 0;
+    }
+
+    size_t fired = 0;
+    while (ticks-- > 0) {
+        fired += tick();
+    }
+    return fired;
+}
+
+size_t TimerWheel::advanceTo(uint32_t nowTicks) {
+    uint32_t delta = nowTicks - m_now;
+    if (delta > 0x7FFFFFFFu) {
+        return 0; // In the past
+    }
+    return advance(delta);
+}
+
+size_t TimerWheel::collect(uint32_t nowTicks, Expiry *out, size_t max) {
+    uint32_t delta = nowTicks - m_now;
+    if (delta > 0x7FFFFFFFu) {
+        return 0; // In the past
+    }
+
+    size_t count = 0;
+    while (delta > 0 && max - count >= TIMER_WHEEL_MAX_TIMERS) {
+        if (m_active == 0) {
+            m_now += delta; // Nothing left to fire or cascade
+            break;
+        }
+        count += tick(out + count);
+        delta--;
+    }
+    return count;
+}
+
+bool TimerWheel::nextExpiry(uint32_t &ticks) const {
+    if (m_active == 0) {
+        return false;
+    }
+    // The pool is small: a scan is cheaper than keeping the wheels ordered
+    uint32_t earliest = maxDelay();
+    for (size_t i = 0; i < TIMER_WHEEL_MAX_TIMERS; ++i) {
+        const Node &n = m_nodes[i];
+        if (n.active && n.expires - m_now < earliest) {
+            earliest = n.expires - m_now;
+        }
+    }
+    ticks = earliest;
+    return true;
+}
+
+int16_t TimerWheel::indexOf(TimerId id) const {
+    uint32_t slot = id & 0xFFu;
+    if (slot == 0 || slot > TIMER_WHEEL_MAX_TIMERS) {
+        return kNone;
+    }
+    int16_t index = static_cast<int16_t>(slot - 1);
+    const Node &n = m_nodes[index];
+    if (!n.active || ((n.generation << 8) | slot) != id) {
+        return kNone;
+    }
+    return index;
+}
+
+void TimerWheel::insert(int16_t index) {
+    Node &n = m_nodes[index];
+    uint32_t delta = n.expires - m_now;
+
+    // Lowest level whose span covers the delay; the slot comes from the
+    // matching bits of the absolute expiry so cascades land on time
+    unsigned level = 0;
+    while (level < TIMER_WHEEL_LEVELS - 1 && delta >= (1ul << (TIMER_WHEEL_SLOT_BITS * (level + 1)))) {
+        level++;
+    }
+    uint32_t slot = (n.expires >> (TIMER_WHEEL_SLOT_BITS * level)) & kSlotMask;
+
+    n.bucket = static_cast<uint16_t>(level * kSlots + slot);
+    n.prev = kNone;
+    n.next = m_slots[n.bucket];
+    if (n.next != kNone) {
+        m_nodes[n.next].prev = index;
+    }
+    m_slots[n.bucket] = index;
+}
+
+void TimerWheel::unlink(int16_t index) {
+    Node &n = m_nodes[index];
+    if (n.prev != kNone) {
+        m_nodes[n.prev].next = n.next;
+    } else {
+        m_slots[n.bucket] = n.next;
+    }
+    if (n.next != kNone) {
+        m_nodes[n.next].prev = n.prev;
+    }
+    n.prev = kNone;
+    n.next = kNone;
+}
+
+void TimerWheel::release(int16_t index) {
+    Node &n = m_nodes[index];
+    n.active = false;
+    n.generation++;
+    n.next = m_free;
+    m_free = index;
+    m_active--;
+}
+
+void TimerWheel::cascade(unsigned level) {
+    uint32_t slot = (m_now >> (TIMER_WHEEL_SLOT_BITS * level)) & kSlotMask;
+    int16_t index = m_slots[level * kSlots + slot];
+    m_slots[level * kSlots + slot] = kNone;
+
+    while (index != kNone) {
+        int16_t next = m_nodes[index].next;
+        insert(index); // Always lands on a lower level
+        index = next;
+    }
+}
+
+size_t TimerWheel::tick(Expiry *out) {
+    m_now++;
+
+    // Each time a wheel wraps, pull the next slot of the wheel above down
+    for (unsigned level = 1; level < TIMER_WHEEL_LEVELS; ++level) {
+        if ((m_now & ((1ul << (TIMER_WHEEL_SLOT_BITS * level)) - 1)) != 0) {
+            break;
+        }
+        cascade(level);
+    }
+
+    size_t fired = 0;
+    uint16_t bucket = static_cast<uint16_t>(m_now & kSlotMask);
+    int16_t index;
+    // Re-read the head every time: a callback may cancel other timers in this slot
+    while ((index = m_slots[bucket]) != kNone) {
+        Node &n = m_nodes[index];
+        unlink(index);
+
+        Callback callback = n.callback;
+        void *context = n.context;
+        uint32_t value = n.value;
+
+        if (n.period > 0) {
+            n.expires = m_now + n.period;
+            insert(index);
+        } else {
+            release(index);
+        }
+
+        if (out != nullptr) {
+            out[fired] = { callback, context, value };
+        } else {
+            callback(context, value);
+        }
+        fired++;
+    }
+    return fired;
+}
+
+} // namespace Utils
+} // namespace PlantMonitor
@@ -0,0 +1,188 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/*!
+ * \file timer-wheel.h
+ * \brief Hierarchical timer wheel multiplexing many software timers on one tick.
+ *
+ * Timers live in a fixed pool and are linked into the slots of
+ * TIMER_WHEEL_LEVELS wheels of 2^TIMER_WHEEL_SLOT_BITS slots each. Level 0
+ * holds timers due within the next 64 ticks, level 1 within 64^2 ticks, and
+ * so on. When the lower wheel wraps, the matching slot of the level above is
+ * cascaded down. Insert and cancel are O(1) (doubly linked slot lists); a
+ * tick costs O(1) plus the timers it fires or cascades.
+ *
+ * The wheel is platform-free: time only moves when advance() / advanceTo()
+ * / collect() is called, so host tests can drive it tick by tick.
+ * TimerService runs it on the target from a single one-shot esp_timer armed
+ * for nextExpiry().
+ *
+ * Typical usage:
+ * \code
+ * TimerWheel wheel;
+ * TimerId id = wheel.schedule(100, 100, onTick, &ctx, 0); // Every 100 ticks
+ * wheel.advance(250);                                     // Fires twice
+ * wheel.cancel(id);
+ * \endcode
+ */
+
+#define TIMER_WHEEL_MAX_TIMERS 16 //!< Timer pool size
+#define TIMER_WHEEL_LEVELS 4      //!< Number of cascaded wheels
+#define TIMER_WHEEL_SLOT_BITS 6   //!< log2 of the slots per wheel
+#define TIMER_WHEEL_INVALID_ID 0u //!< Never returned for a scheduled timer
+
+namespace PlantMonitor {
+namespace Utils {
+
+/*!
+ * \brief Timer handle (pool index plus a generation, so stale handles are rejected)
+ */
+using TimerId = uint32_t;
+
+/*!
+ * \class TimerWheel
+ * \brief Fixed-capacity hierarchical timer wheel
+ *
+ * Not thread-safe on its own; TimerService serializes access.
+ */
+class TimerWheel {
+  public:
+    /*!
+     * \brief Expiry callback
+     * \param context Pointer given to schedule()
+     * \param value Value given to schedule()
+     */
+    using Callback = void (*)(void *context, uint32_t value);
+
+    /*!
+     * \struct Expiry
+     * \brief A due callback returned by collect() instead of being invoked
+     */
+    struct Expiry {
+        Callback callback; //!< Expiry callback
+        void *context;     //!< Callback context
+        uint32_t value;    //!< Callback value
+    };
+
+    TimerWheel();
+
+    /*!
+     * \brief Arm a timer
+     * \param delayTicks Ticks until the first expiry (0 is treated as 1, capped at maxDelay())
+     * \param periodTicks Re-arm interval after each expiry (0 = one-shot)
+     * \param callback Function called on expiry (must not be null)
+     * \param context Passed to the callback
+     * \param value Passed to the callback
+     * \return Timer handle, or TIMER_WHEEL_INVALID_ID if the pool is full
+     */
+    TimerId schedule(uint32_t delayTicks, uint32_t periodTicks, Callback callback, void *context, uint32_t value);
+
+    /*!
+     * \brief Disarm a timer
+     * \return true if the timer was active
+     */
+    bool cancel(TimerId id);
+
+    /*!
+     * \brief Check whether a handle refers to an armed timer
+     */
+    bool isActive(TimerId id) const;
+
+    /*!
+     * \brief Get the ticks left before a timer's next expiry (0 if inactive)
+     */
+    uint32_t remaining(TimerId id) const;
+
+    /*!
+     * \brief Move time forward, firing every timer that comes due
+     * \param ticks Number of ticks to process
+     * \return Number of callbacks invoked
+     */
+    size_t advance(uint32_t ticks);
+
+    /*!
+     * \brief Move time forward to an absolute tick count
+     * \param nowTicks Current tick count (wrap-safe; earlier values are ignored)
+     * \return Number of callbacks invoked
+     */
+    size_t advanceTo(uint32_t nowTicks);
+
+    /*!
+     * \brief Move time forward like advanceTo(), returning the due callbacks instead of invoking them
+     * \param nowTicks Current tick count (wrap-safe; earlier values are ignored)
+     * \param[out] out Due callbacks, in firing order
+     * \param max Capacity of \p out (at least TIMER_WHEEL_MAX_TIMERS, the most one tick can fire)
+     * \return Number of entries written
+     * \note Stops early when another tick might not fit in \p out: call again
+     *       until now() reaches \p nowTicks.
+     */
+    size_t collect(uint32_t nowTicks, Expiry *out, size_t max);
+
+    /*!
+     * \brief Get the ticks from now() to the earliest expiry
+     * \param[out] ticks Ticks until the next timer fires (at least 1)
+     * \return false if no timer is armed
+     */
+    bool nextExpiry(uint32_t &ticks) const;
+
+    /*!
+     * \brief Get the current tick count of the wheel
+     */
+    uint32_t now() const {
+        return m_now;
+    }
+
+    /*!
+     * \brief Get the number of armed timers
+     */
+    size_t activeCount() const {
+        return m_active;
+    }
+
+    /*!
+     * \brief Get the longest delay the wheel can represent
+     */
+    static constexpr uint32_t maxDelay() {
+        return (1ul << (TIMER_WHEEL_SLOT_BITS * TIMER_WHEEL_LEVELS)) - 1;
+    }
+
+    /*!
+     * \brief Disarm every timer (keeps the current time)
+     */
+    void clear();
+
+  private:
+    static constexpr uint32_t kSlots = 1u << TIMER_WHEEL_SLOT_BITS;
+    static constexpr uint32_t kSlotMask = kSlots - 1;
+    static constexpr int16_t kNone = -1;
+
+    struct Node {
+        uint32_t expires;    //!< Absolute expiry tick
+        uint32_t period;     //!< Re-arm interval (0 = one-shot)
+        Callback callback;   //!< Expiry callback
+        void *context;       //!< Callback context
+        uint32_t value;      //!< Callback value
+        uint32_t generation; //!< Bumped on release to invalidate old handles
+        int16_t prev;        //!< Previous node in the slot list
+        int16_t next;        //!< Next node in the slot (or free) list
+        uint16_t bucket;     //!< Slot index (level * kSlots + slot) while armed
+        bool active;         //!< Linked into a slot
+    };
+
+    int16_t indexOf(TimerId id) const;
+    void insert(int16_t index);
+    void unlink(int16_t index);
+    void release(int16_t index);
+    void cascade(unsigned level);
+    size_t tick(Expiry *out = nullptr);
+
+    Node m_nodes[TIMER_WHEEL_MAX_TIMERS];         //!< Timer pool
+    int16_t m_slots[TIMER_WHEEL_LEVELS * kSlots]; //!< Slot list heads
+    int16_t m_free;                               //!< Free list head
+    uint32_t m_now;                               //!< Last processed tick
+    size_t m_active;                              //!< Armed timers
+};
+
+} // namespace Utils
+} // namespace PlantMonitor
@@ -9,6 +9,7 @@
 #include <cstdarg>
 #include <cstring>
 #include <cstdlib>
+#include <cmath>
 #include <algorithm>
 #include <string>
 #include <functional>
@@ -30,6 +31,7 @@ using byte = uint8_t;
 // ============ Controllable mock state ============
 inline int mockAnalogValue = 0;
 inline uint32_t mockMillisValue = 0;
+inline uint32_t mockMicrosValue = 0;
 inline int mockDigitalValue = LOW;
 
 // ============ GPIO stubs ============
@@ -41,6 +43,8 @@ inline int analogRead(uint8_t) { return mockAnalogValue; }
 // ============ Timing ============
 inline void delay(unsigned long) {}
 inline uint32_t millis() { return mockMillisValue; }
+inline uint32_t micros() { return mockMicrosValue; }
+inline void delayMicroseconds(unsigned int) {}
 inline void yield() {}
 
 // ============ Math helpers (Arduino built-ins) ============
@@ -4,6 +4,7 @@
  * \brief Mock I2C Wire library for native unit testing.
  */
 
+#include <cstddef>
 #include <cstdint>
 
 class TwoWire {
@@ -11,6 +12,13 @@ class TwoWire {
     void begin() {}
     void begin(int, int) {}
     void setClock(uint32_t) {}
+    void beginTransmission(uint8_t) {}
+    size_t write(uint8_t) { return 1; }
+    size_t write(const uint8_t *, size_t length) { return length; }
+    uint8_t endTransmission(bool = true) { return 0; }
+    uint8_t requestFrom(uint8_t, uint8_t length) { return length; }
+    int read() { return 0; }
+    int available() { return 0; }
 };
 
 inline TwoWire Wire;
@@ -27,6 +27,20 @@ inline esp_err_t esp_timer_create(const esp_timer_create_args_t *, esp_timer_han
     return ESP_OK;
 }
 
+// Monotonic clock in microseconds; tests move it by hand
+inline int64_t mockEspTimerMicros = 0;
+inline int64_t esp_timer_get_time() { return mockEspTimerMicros; }
+
+// Timeout of the last esp_timer_start_once() still armed (-1 = stopped)
+inline int64_t mockEspTimerArmedUs = -1;
+
+inline esp_err_t esp_timer_start_once(esp_timer_handle_t, uint64_t timeoutUs) {
+    mockEspTimerArmedUs = static_cast<int64_t>(timeoutUs);
+    return ESP_OK;
+}
 inline esp_err_t esp_timer_start_periodic(esp_timer_handle_t, uint64_t) { return ESP_OK; }
-inline esp_err_t esp_timer_stop(esp_timer_handle_t) { return ESP_OK; }
+inline esp_err_t esp_timer_stop(esp_timer_handle_t) {
+    mockEspTimerArmedUs = -1;
+    return ESP_OK;
+}
 inline esp_err_t esp_timer_delete(esp_timer_handle_t) { return ESP_OK; }
@@ -9,13 +9,67 @@
 using UBaseType_t = unsigned int;
 using BaseType_t = int;
 using TickType_t = uint32_t;
+using TaskHandle_t = void *;
+using TaskFunction_t = void (*)(void *);
 
 #ifndef pdMS_TO_TICKS
 #define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
 #endif
 
+#ifndef portMAX_DELAY
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFFu)
+#endif
+
 #define pdTRUE 1
 #define pdFALSE 0
 #define pdPASS pdTRUE
 
+inline TickType_t mockTickCount = 0;
+
 inline void vTaskDelay(TickType_t) {}
+inline TickType_t xTaskGetTickCount() { return mockTickCount; }
+
+enum eNotifyAction { eNoAction, eSetBits, eIncrement, eSetValueWithOverwrite, eSetValueWithoutOverwrite };
+
+// Last notification sent; eSetBits accumulates like the real notification value
+inline TaskHandle_t mockNotifiedTask = nullptr;
+inline uint32_t mockNotifiedValue = 0;
+
+inline BaseType_t xTaskNotify(TaskHandle_t task, uint32_t value, eNotifyAction action) {
+    mockNotifiedTask = task;
+    mockNotifiedValue = (action == eSetBits) ? (mockNotifiedValue | value) : value;
+    return pdPASS;
+}
+
+// The "current task" of native tests
+inline TaskHandle_t mockCurrentTask = reinterpret_cast<TaskHandle_t>(0x7A5C);
+inline TaskHandle_t xTaskGetCurrentTaskHandle() { return mockCurrentTask; }
+
+// Called on every xTaskNotifyWait() with the requested timeout, so tests can
+// make things happen "while the task sleeps" (e.g. move the clock and fire timers)
+inline void (*mockNotifyWaitHook)(TickType_t) = nullptr;
+
+inline BaseType_t xTaskNotifyWait(uint32_t clearOnEntry, uint32_t clearOnExit, uint32_t *value, TickType_t timeout) {
+    mockNotifiedValue &= ~clearOnEntry;
+    if (mockNotifyWaitHook) {
+        mockNotifyWaitHook(timeout);
+    }
+    if (mockNotifiedTask == mockCurrentTask && mockNotifiedValue != 0) {
+        if (value) {
+            *value = mockNotifiedValue;
+        }
+        mockNotifiedValue &= ~clearOnExit;
+        return pdTRUE;
+    }
+    mockTickCount += timeout; // Nothing arrived: the whole timeout elapsed
+    return pdFALSE;
+}
+
+// Tasks are never started natively; tests drive the task body directly.
+// Set to pdFALSE to simulate task creation failing (e.g. out of heap)
+inline BaseType_t mockTaskCreateResult = pdPASS;
+
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t, const char *, uint32_t, void *,
+                                          UBaseType_t, TaskHandle_t *, BaseType_t) {
+    return mockTaskCreateResult;
+}
@@ -10,6 +10,15 @@ using SemaphoreHandle_t = void *;
 
 inline SemaphoreHandle_t xSemaphoreCreateBinary() { return reinterpret_cast<void *>(1); }
 inline SemaphoreHandle_t xSemaphoreCreateMutex() { return reinterpret_cast<void *>(1); }
-inline BaseType_t xSemaphoreTake(SemaphoreHandle_t, TickType_t) { return pdTRUE; }
-inline BaseType_t xSemaphoreGive(SemaphoreHandle_t) { return pdTRUE; }
+// Takes not yet given back, so tests can check what runs outside a lock
+inline int mockSemaphoresHeld = 0;
+
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t, TickType_t) {
+    mockSemaphoresHeld++;
+    return pdTRUE;
+}
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t) {
+    mockSemaphoresHeld--;
+    return pdTRUE;
+}
 inline void vSemaphoreDelete(SemaphoreHandle_t) {}
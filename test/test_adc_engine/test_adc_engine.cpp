@@ -0,0 +1,225 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "drivers/sensors/adc-engine/adc-engine.h"
+#include "drivers/sensors/adc-engine/adc-engine.cpp"
+#include "drivers/sensors/moisture-sensor/moisture-sensor-hal.h"
+#include "drivers/sensors/moisture-sensor/moisture-sensor-hal.cpp"
+
+using namespace PlantMonitor::Drivers;
+
+static constexpr uint8_t PIN_A = 34;
+static constexpr uint8_t PIN_B = 35;
+
+// Synthetic stream: pin A alternates 1000/3000, pin B ramps 0,1,2,...
+static uint32_t rampCounter = 0;
+
+static int syntheticReader(uint8_t pin) {
+    static bool high = false;
+    if (pin == PIN_A) {
+        high = !high;
+        return high ? 3000 : 1000;
+    }
+    return static_cast<int>(rampCounter++);
+}
+
+// Delivers fewer samples than a pump batch per read, like a DMA ring that
+// only holds part of a block between two pump() calls
+class TrickleAdcBackend : public ReaderAdcBackend {
+  public:
+    using ReaderAdcBackend::ReaderAdcBackend;
+
+    size_t read(AdcSample *out, size_t max) override {
+        return ReaderAdcBackend::read(out, max < kPerRead ? max : kPerRead);
+    }
+
+    static constexpr size_t kPerRead = ADC_ENGINE_PUMP_BATCH - 16;
+};
+
+void setUp() {
+    rampCounter = 0;
+    mockTaskCreateResult = pdPASS;
+}
+
+void tearDown() {}
+
+void test_not_ready_before_first_block() {
+    ReaderAdcBackend backend(syntheticReader);
+    AdcEngine engine(backend, 16);
+    engine.addChannel(PIN_A);
+    engine.addChannel(PIN_B);
+
+    uint16_t value = 123;
+    TEST_ASSERT_FALSE(engine.isReady());
+    TEST_ASSERT_FALSE(engine.getBlockAverage(PIN_A, value));
+    TEST_ASSERT_EQUAL_UINT16(123, value);
+    TEST_ASSERT_EQUAL_INT(0, engine.reader()(PIN_A));
+}
+
+void test_pump_without_begin_is_noop() {
+    ReaderAdcBackend backend(syntheticReader);
+    AdcEngine engine(backend, 16);
+    engine.addChannel(PIN_A);
+    TEST_ASSERT_EQUAL_UINT32(0, engine.pump());
+    TEST_ASSERT_EQUAL_UINT32(0, engine.blockCount(PIN_A));
+}
+
+void test_block_average_per_channel() {
+    ReaderAdcBackend backend(syntheticReader);
+    AdcEngine engine(backend, 16);
+    engine.addChannel(PIN_A);
+    engine.addChannel(PIN_B);
+    TEST_ASSERT_TRUE(engine.begin());
+
+    engine.pump();
+    TEST_ASSERT_TRUE(engine.isReady());
+
+    uint16_t a = 0;
+    uint16_t b = 0;
+    TEST_ASSERT_TRUE(engine.getBlockAverage(PIN_A, a));
+    TEST_ASSERT_TRUE(engine.getBlockAverage(PIN_B, b));
+    TEST_ASSERT_EQUAL_UINT16(2000, a);
+    // Pin B saw the ramp in blocks of 16, so its latest average is the middle of the last block
+    uint32_t blocks = engine.blockCount(PIN_B);
+    TEST_ASSERT_TRUE(blocks >= 1);
+    uint32_t first = (blocks - 1) * 16;
+    TEST_ASSERT_EQUAL_UINT16(first + 8, b); // mean of first..first+15 is first+7.5, rounded up
+}
+
+void test_block_count_advances() {
+    ReaderAdcBackend backend(syntheticReader);
+    AdcEngine engine(backend, 32);
+    engine.addChannel(PIN_A);
+    TEST_ASSERT_TRUE(engine.begin());
+
+    // A single-channel pump consumes at most one block's worth of batches
+    size_t consumed = engine.pump();
+    TEST_ASSERT_EQUAL_UINT32(ADC_ENGINE_PUMP_BATCH, consumed);
+    TEST_ASSERT_EQUAL_UINT32(ADC_ENGINE_PUMP_BATCH / 32, engine.blockCount(PIN_A));
+
+    engine.pump();
+    TEST_ASSERT_EQUAL_UINT32(2 * ADC_ENGINE_PUMP_BATCH / 32, engine.blockCount(PIN_A));
+}
+
+void test_large_block_spans_pumps() {
+    TrickleAdcBackend backend(syntheticReader);
+    AdcEngine engine(backend, 1024);
+    engine.addChannel(PIN_A);
+    TEST_ASSERT_TRUE(engine.begin());
+
+    // A short read ends the pump, so the block needs ceil(1024 / kPerRead) pumps
+    const size_t pumps = (1024 + TrickleAdcBackend::kPerRead - 1) / TrickleAdcBackend::kPerRead;
+    for (size_t i = 0; i < pumps - 1; i++) {
+        TEST_ASSERT_EQUAL_UINT32(TrickleAdcBackend::kPerRead, engine.pump());
+        TEST_ASSERT_FALSE(engine.isReady());
+    }
+    engine.pump();
+    TEST_ASSERT_TRUE(engine.isReady());
+    TEST_ASSERT_EQUAL_UINT32(1, engine.blockCount(PIN_A));
+
+    uint16_t a = 0;
+    TEST_ASSERT_TRUE(engine.getBlockAverage(PIN_A, a));
+    TEST_ASSERT_EQUAL_UINT16(2000, a);
+}
+
+void test_start_releases_backend_when_task_fails() {
+    ReaderAdcBackend backend(syntheticReader);
+    AdcEngine engine(backend, 16);
+    engine.addChannel(PIN_A);
+
+    mockTaskCreateResult = pdFALSE;
+    TEST_ASSERT_FALSE(engine.start());
+    TEST_ASSERT_EQUAL_UINT32(0, engine.pump()); // Not left running without a task
+    AdcSample sample;
+    TEST_ASSERT_EQUAL_UINT32(0, backend.read(&sample, 1)); // Backend stopped
+
+    // A later begin() (caller pumps) still works
+    TEST_ASSERT_TRUE(engine.begin());
+    TEST_ASSERT_TRUE(engine.pump() > 0);
+}
+
+void test_channel_table_limits() {
+    ReaderAdcBackend backend(syntheticReader);
+    AdcEngine engine(backend, 16);
+    for (uint8_t i = 0; i < ADC_ENGINE_MAX_CHANNELS; i++) {
+        TEST_ASSERT_TRUE(engine.addChannel(32 + i));
+    }
+    TEST_ASSERT_FALSE(engine.addChannel(40));
+    TEST_ASSERT_FALSE(engine.addChannel(32)); // duplicate
+}
+
+void test_unknown_pin() {
+    ReaderAdcBackend backend(syntheticReader);
+    AdcEngine engine(backend, 16);
+    engine.addChannel(PIN_A);
+    engine.begin();
+    engine.pump();
+
+    uint16_t value = 0;
+    TEST_ASSERT_FALSE(engine.getBlockAverage(PIN_B, value));
+    TEST_ASSERT_EQUAL_UINT32(0, engine.blockCount(PIN_B));
+}
+
+void test_moisture_hal_reads_block_average() {
+    ReaderAdcBackend backend([](uint8_t) { return 1862; });
+    AdcEngine engine(backend, 64);
+    engine.addChannel(Config::SOIL_MOISTURE_PIN);
+    engine.begin();
+    engine.pump();
+
+    MoistureSensorHAL sensor(3724, 0, engine.reader(), 1);
+    TEST_ASSERT_INT_WITHIN(1, 50, sensor.readMoistureLevel());
+}
+
+void test_fine_value_keeps_fraction() {
+    // Pin A averages 2000, pin B's ramp block mean ends in .5
+    ReaderAdcBackend backend(syntheticReader);
+    AdcEngine engine(backend, 16);
+    engine.addChannel(PIN_A);
+    engine.addChannel(PIN_B);
+    TEST_ASSERT_TRUE(engine.begin());
+
+    uint16_t fine = 0;
+    TEST_ASSERT_FALSE(engine.getBlockValueFine(PIN_A, fine));
+    engine.pump();
+
+    TEST_ASSERT_TRUE(engine.getBlockValueFine(PIN_A, fine));
+    TEST_ASSERT_EQUAL_UINT16(2000 << (ADC_ENGINE_FINE_BITS - ADC_ENGINE_RAW_BITS), fine);
+    uint32_t first = (engine.blockCount(PIN_B) - 1) * 16;
+    TEST_ASSERT_TRUE(engine.getBlockValueFine(PIN_B, fine));
+    TEST_ASSERT_EQUAL_UINT16((first * 2 + 15) * 8, fine); // (first + 7.5) * 16
+    TEST_ASSERT_EQUAL_INT(fine, engine.fineReader()(PIN_B));
+}
+
+void test_moisture_hal_reads_fine_values() {
+    // 1862.5 counts: halfway between two 12-bit codes
+    ReaderAdcBackend backend([](uint8_t) {
+        static bool high = false;
+        high = !high;
+        return high ? 1863 : 1862;
+    });
+    AdcEngine engine(backend, 64);
+    engine.addChannel(Config::SOIL_MOISTURE_PIN);
+    engine.begin();
+    engine.pump();
+
+    MoistureSensorHAL sensor(3724, 0, engine.fineReader(), 1, PlantMonitor::Utils::SampleReduction::Mean,
+                             ADC_ENGINE_FINE_BITS);
+    float expected = (3724.0f - 1862.5f) * 100.0f / 3724.0f;
+    TEST_ASSERT_FLOAT_WITHIN(0.005f, expected, sensor.readMoisturePercent());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_not_ready_before_first_block);
+    RUN_TEST(test_pump_without_begin_is_noop);
+    RUN_TEST(test_block_average_per_channel);
+    RUN_TEST(test_block_count_advances);
+    RUN_TEST(test_large_block_spans_pumps);
+    RUN_TEST(test_start_releases_backend_when_task_fails);
+    RUN_TEST(test_channel_table_limits);
+    RUN_TEST(test_unknown_pin);
+    RUN_TEST(test_moisture_hal_reads_block_average);
+    RUN_TEST(test_fine_value_keeps_fraction);
+    RUN_TEST(test_moisture_hal_reads_fine_values);
+    return UNITY_END();
+}
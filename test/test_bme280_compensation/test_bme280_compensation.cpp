@@ -0,0 +1,182 @@
+#include <unity.h>
+#include <cmath>
+#include "drivers/sensors/temperature-sensor/bme280-compensation.h"
+#include "drivers/sensors/temperature-sensor/bme280-compensation.cpp"
+
+using namespace PlantMonitor::Drivers;
+
+// Temperature / pressure trimming values from the Bosch datasheet worked example,
+// humidity values from a production sensor.
+static Bme280Calibration makeCalibration() {
+    Bme280Calibration c = {};
+    c.dig_T1 = 27504;
+    c.dig_T2 = 26435;
+    c.dig_T3 = -1000;
+    c.dig_P1 = 36477;
+    c.dig_P2 = -10685;
+    c.dig_P3 = 3024;
+    c.dig_P4 = 2855;
+    c.dig_P5 = 140;
+    c.dig_P6 = -7;
+    c.dig_P7 = 15500;
+    c.dig_P8 = -14600;
+    c.dig_P9 = 6000;
+    c.dig_H1 = 75;
+    c.dig_H2 = 362;
+    c.dig_H3 = 0;
+    c.dig_H4 = 313;
+    c.dig_H5 = 50;
+    c.dig_H6 = 30;
+    return c;
+}
+
+// Double-precision reference formula from the datasheet (section 8.1)
+static double referenceHumidity(const Bme280Calibration &c, int32_t adcH, int32_t tFine) {
+    double h = tFine - 76800.0;
+    h = (adcH - (c.dig_H4 * 64.0 + c.dig_H5 / 16384.0 * h)) *
+        (c.dig_H2 / 65536.0 * (1.0 + c.dig_H6 / 67108864.0 * h * (1.0 + c.dig_H3 / 67108864.0 * h)));
+    h = h * (1.0 - c.dig_H1 * h / 524288.0);
+    return h < 0.0 ? 0.0 : (h > 100.0 ? 100.0 : h);
+}
+
+static void encodeBurst(int32_t adcP, int32_t adcT, int32_t adcH, uint8_t *burst) {
+    burst[0] = adcP >> 12;
+    burst[1] = (adcP >> 4) & 0xFF;
+    burst[2] = (adcP & 0x0F) << 4;
+    burst[3] = adcT >> 12;
+    burst[4] = (adcT >> 4) & 0xFF;
+    burst[5] = (adcT & 0x0F) << 4;
+    burst[6] = adcH >> 8;
+    burst[7] = adcH & 0xFF;
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_datasheet_temperature() {
+    Bme280Calibration c = makeCalibration();
+    int32_t tFine = 0;
+    TEST_ASSERT_EQUAL_INT32(2508, bme280CompensateTemperature(c, 519888, tFine));
+    TEST_ASSERT_EQUAL_INT32(128422, tFine);
+}
+
+void test_datasheet_pressure() {
+    Bme280Calibration c = makeCalibration();
+    int32_t tFine = 0;
+    bme280CompensateTemperature(c, 519888, tFine);
+    uint32_t q248 = bme280CompensatePressure(c, 415148, tFine);
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 100653.27f, q248 / 256.0f);
+}
+
+void test_humidity_matches_reference() {
+    Bme280Calibration c = makeCalibration();
+    int32_t tFine = 0;
+    bme280CompensateTemperature(c, 519888, tFine);
+
+    for (int32_t adcH = 20000; adcH <= 40000; adcH += 2500) {
+        double expected = referenceHumidity(c, adcH, tFine);
+        float actual = bme280CompensateHumidity(c, adcH, tFine) / 1024.0f;
+        TEST_ASSERT_FLOAT_WITHIN(0.05f, (float)expected, actual);
+    }
+}
+
+void test_humidity_is_clamped() {
+    Bme280Calibration c = makeCalibration();
+    int32_t tFine = 0;
+    bme280CompensateTemperature(c, 519888, tFine);
+    TEST_ASSERT_EQUAL_UINT32(0, bme280CompensateHumidity(c, 0, tFine));
+    TEST_ASSERT_EQUAL_UINT32(100 * 1024, bme280CompensateHumidity(c, 65000, tFine));
+}
+
+void test_parse_calibration_registers() {
+    uint8_t tp[BME280_CALIB_TP_LENGTH] = {};
+    uint8_t h[BME280_CALIB_H_LENGTH] = {};
+
+    // T1 = 27504 (0x6B70), T2 = 26435 (0x6743), T3 = -1000 (0xFC18)
+    tp[0] = 0x70; tp[1] = 0x6B;
+    tp[2] = 0x43; tp[3] = 0x67;
+    tp[4] = 0x18; tp[5] = 0xFC;
+    // P9 = 6000 (0x1770)
+    tp[22] = 0x70; tp[23] = 0x17;
+    tp[25] = 75;
+    // H2 = 362, H3 = 0, H4 = 313 (0x139), H5 = 50 (0x032), H6 = -2
+    h[0] = 0x6A; h[1] = 0x01;
+    h[2] = 0;
+    h[3] = 0x13;
+    h[4] = 0x29; // low nibble: H4[3:0] = 9, high nibble: H5[3:0] = 2
+    h[5] = 0x03;
+    h[6] = 0xFE;
+
+    Bme280Calibration c;
+    bme280ParseCalibration(tp, h, c);
+    TEST_ASSERT_EQUAL_UINT16(27504, c.dig_T1);
+    TEST_ASSERT_EQUAL_INT16(26435, c.dig_T2);
+    TEST_ASSERT_EQUAL_INT16(-1000, c.dig_T3);
+    TEST_ASSERT_EQUAL_INT16(6000, c.dig_P9);
+    TEST_ASSERT_EQUAL_UINT8(75, c.dig_H1);
+    TEST_ASSERT_EQUAL_INT16(362, c.dig_H2);
+    TEST_ASSERT_EQUAL_INT16(313, c.dig_H4);
+    TEST_ASSERT_EQUAL_INT16(50, c.dig_H5);
+    TEST_ASSERT_EQUAL_INT8(-2, c.dig_H6);
+}
+
+void test_parse_negative_h4() {
+    uint8_t tp[BME280_CALIB_TP_LENGTH] = {};
+    uint8_t h[BME280_CALIB_H_LENGTH] = {};
+    h[3] = 0xFF; // H4 = 0xFFF = -1 as 12-bit signed
+    h[4] = 0x0F;
+    Bme280Calibration c;
+    bme280ParseCalibration(tp, h, c);
+    TEST_ASSERT_EQUAL_INT16(-1, c.dig_H4);
+}
+
+void test_burst_decodes_all_channels() {
+    Bme280Calibration c = makeCalibration();
+    uint8_t burst[BME280_BURST_LENGTH];
+    encodeBurst(415148, 519888, 30000, burst);
+
+    Bme280Reading r;
+    TEST_ASSERT_TRUE(bme280Compensate(c, burst, r));
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 25.08f, r.temperature);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 1006.53f, r.pressure);
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, (float)referenceHumidity(c, 30000, 128422), r.humidity);
+}
+
+void test_skipped_channels_are_nan() {
+    Bme280Calibration c = makeCalibration();
+    uint8_t burst[BME280_BURST_LENGTH];
+
+    encodeBurst(0x80000, 519888, 0x8000, burst);
+    Bme280Reading r;
+    TEST_ASSERT_TRUE(bme280Compensate(c, burst, r));
+    TEST_ASSERT_FALSE(std::isnan(r.temperature));
+    TEST_ASSERT_TRUE(std::isnan(r.pressure));
+    TEST_ASSERT_TRUE(std::isnan(r.humidity));
+
+    encodeBurst(415148, 0x80000, 30000, burst);
+    TEST_ASSERT_FALSE(bme280Compensate(c, burst, r));
+    TEST_ASSERT_TRUE(std::isnan(r.temperature));
+}
+
+void test_measurement_time() {
+    // x1 on all channels: 1.25 + 2.3 + 2.875 + 2.875 ms
+    TEST_ASSERT_EQUAL_UINT32(9300, bme280MeasurementTimeUs(1, 1, 1));
+    // Temperature only
+    TEST_ASSERT_EQUAL_UINT32(3550, bme280MeasurementTimeUs(1, 0, 0));
+    // x16 on all channels: 1.25 + 36.8 + 37.375 + 37.375 ms
+    TEST_ASSERT_EQUAL_UINT32(112800, bme280MeasurementTimeUs(5, 5, 5));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_datasheet_temperature);
+    RUN_TEST(test_datasheet_pressure);
+    RUN_TEST(test_humidity_matches_reference);
+    RUN_TEST(test_humidity_is_clamped);
+    RUN_TEST(test_parse_calibration_registers);
+    RUN_TEST(test_parse_negative_h4);
+    RUN_TEST(test_burst_decodes_all_channels);
+    RUN_TEST(test_skipped_channels_are_nan);
+    RUN_TEST(test_measurement_time);
+    return UNITY_END();
+}
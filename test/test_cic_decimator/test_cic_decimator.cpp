@@ -0,0 +1,185 @@
+#include <unity.h>
+#include <cmath>
+#include <cstdint>
+#include "utils/cic-decimator/cic-decimator.h"
+
+using namespace PlantMonitor::Utils;
+
+void setUp() {}
+void tearDown() {}
+
+/*!
+ * \brief Deterministic noise source: sum of four uniforms (close to Gaussian)
+ * \return Sample with zero mean and a standard deviation of about 1
+ */
+static float prv_noise(uint32_t &state) {
+    float sum = 0.0f;
+    for (int i = 0; i < 4; i++) {
+        state = state * 1664525u + 1013904223u;
+        sum += static_cast<float>(state >> 8) / 16777216.0f - 0.5f;
+    }
+    return sum * 1.7320508f; // Variance of 4 uniforms is 1/3
+}
+
+/*!
+ * \brief Quantize an analog value the way a 12-bit ADC would
+ */
+static uint32_t prv_adc12(float analog) {
+    long v = lroundf(analog);
+    return static_cast<uint32_t>(v < 0 ? 0 : (v > 4095 ? 4095 : v));
+}
+
+void test_order1_output_is_block_sum() {
+    CicDecimator<1> cic(4);
+    TEST_ASSERT_FALSE(cic.push(10));
+    TEST_ASSERT_FALSE(cic.push(20));
+    TEST_ASSERT_FALSE(cic.push(30));
+    TEST_ASSERT_TRUE(cic.push(41));
+    TEST_ASSERT_EQUAL_UINT32(101, cic.raw());
+    TEST_ASSERT_EQUAL_UINT32(25, cic.value(12, 12)); // 25.25 rounds down
+    TEST_ASSERT_EQUAL_UINT32(1, cic.outputs());
+
+    // Next block is independent of the previous one
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_FALSE(cic.push(100));
+    }
+    TEST_ASSERT_TRUE(cic.push(100));
+    TEST_ASSERT_EQUAL_UINT32(100, cic.value(12, 12));
+}
+
+void test_dc_gain_is_exact() {
+    CicDecimator<3> cic(16);
+    for (int i = 0; i < 16 * 10; i++) {
+        cic.push(4095);
+    }
+    TEST_ASSERT_EQUAL_UINT32(10, cic.outputs());
+    TEST_ASSERT_EQUAL_UINT32(4095u * 16u * 16u * 16u, cic.raw());
+    TEST_ASSERT_EQUAL_UINT32(4095, cic.value(12, 12));
+    TEST_ASSERT_EQUAL_UINT32(65520, cic.value(12, 16)); // 4095 << 4
+}
+
+void test_settling_outputs() {
+    TEST_ASSERT_EQUAL_UINT32(0, CicDecimator<1>::settlingOutputs());
+    TEST_ASSERT_EQUAL_UINT32(2, CicDecimator<3>::settlingOutputs());
+
+    // First output of an order-2 filter is a transient, the second is settled
+    CicDecimator<2> cic(8);
+    for (int i = 0; i < 8; i++) {
+        cic.push(1000);
+    }
+    TEST_ASSERT_TRUE(cic.value(12, 12) < 1000);
+    for (int i = 0; i < 8; i++) {
+        cic.push(1000);
+    }
+    TEST_ASSERT_EQUAL_UINT32(1000, cic.value(12, 12));
+}
+
+void test_wraparound_is_harmless() {
+    // The order-3 integrators overflow 32 bits many times over this run
+    CicDecimator<3> cic(32);
+    uint32_t outputs = 0;
+    for (uint32_t i = 0; i < 32u * 2000u; i++) {
+        if (cic.push(3000) && ++outputs > CicDecimator<3>::settlingOutputs()) {
+            TEST_ASSERT_EQUAL_UINT32(3000, cic.value(12, 12));
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(2000, cic.outputs());
+}
+
+void test_ramp_tracks_block_centre() {
+    // Order 1 on a ramp returns the mean of each block
+    CicDecimator<1> cic(8);
+    uint32_t x = 0;
+    for (int block = 0; block < 5; block++) {
+        for (int i = 0; i < 8; i++) {
+            cic.push(x++);
+        }
+        TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(block * 8) * 16 + 56, cic.value(12, 16)); // (8b + 3.5) * 16
+    }
+}
+
+void test_value_downscales() {
+    CicDecimator<1> cic(2);
+    cic.push(4095);
+    cic.push(4095);
+    TEST_ASSERT_EQUAL_UINT32(255, cic.value(12, 8));
+    TEST_ASSERT_EQUAL_UINT32(4095, cic.value(12, 12));
+}
+
+void test_pending_and_reset() {
+    CicDecimator<2> cic(10);
+    for (int i = 0; i < 25; i++) {
+        cic.push(7);
+    }
+    TEST_ASSERT_EQUAL_UINT32(2, cic.outputs());
+    TEST_ASSERT_EQUAL_UINT32(5, cic.pending());
+
+    cic.reset();
+    TEST_ASSERT_EQUAL_UINT32(0, cic.outputs());
+    TEST_ASSERT_EQUAL_UINT32(0, cic.pending());
+    TEST_ASSERT_EQUAL_UINT32(0, cic.raw());
+    TEST_ASSERT_EQUAL_UINT32(10, cic.decimation());
+
+    cic.configure(0);
+    TEST_ASSERT_EQUAL_UINT32(1, cic.decimation());
+    TEST_ASSERT_TRUE(cic.push(9));
+    TEST_ASSERT_EQUAL_UINT32(9, cic.value(12, 12));
+}
+
+void test_oversampling_lowers_noise_floor() {
+    // 12-bit ADC, true level between two codes, ~2 LSB of white noise
+    const float level = 1000.37f;
+    const uint32_t R = 256;
+    const int blocks = 200;
+    uint32_t seed = 12345;
+
+    // Single reads at 16-bit scale
+    double sum = 0.0;
+    double sumSq = 0.0;
+    for (int i = 0; i < blocks; i++) {
+        double v = prv_adc12(level + 2.0f * prv_noise(seed)) * 16.0;
+        sum += v;
+        sumSq += v * v;
+    }
+    double rawMean = sum / blocks;
+    double rawSd = std::sqrt(sumSq / blocks - rawMean * rawMean);
+
+    CicDecimator<1> cic(R);
+    sum = 0.0;
+    sumSq = 0.0;
+    int n = 0;
+    while (n < blocks) {
+        if (cic.push(prv_adc12(level + 2.0f * prv_noise(seed)))) {
+            double v = cic.value(12, 16);
+            sum += v;
+            sumSq += v * v;
+            n++;
+        }
+    }
+    double fineMean = sum / blocks;
+    double fineSd = std::sqrt(sumSq / blocks - fineMean * fineMean);
+
+    char msg[96];
+    snprintf(msg, sizeof(msg), "noise sd (16-bit LSB): single %.2f, CIC x%u %.2f", rawSd, static_cast<unsigned>(R), fineSd);
+    TEST_MESSAGE(msg);
+
+    // sqrt(256) = 16x less noise; allow for the finite sample estimate
+    TEST_ASSERT_TRUE(rawSd / fineSd > 10.0);
+    // At least 14 effective bits: noise below one 14-bit LSB (4 counts at 16 bits)
+    TEST_ASSERT_TRUE(fineSd < 4.0);
+    // The fraction between the two 12-bit codes is resolved
+    TEST_ASSERT_TRUE(std::fabs(fineMean - level * 16.0) < 2.0);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_order1_output_is_block_sum);
+    RUN_TEST(test_dc_gain_is_exact);
+    RUN_TEST(test_settling_outputs);
+    RUN_TEST(test_wraparound_is_harmless);
+    RUN_TEST(test_ramp_tracks_block_centre);
+    RUN_TEST(test_value_downscales);
+    RUN_TEST(test_pending_and_reset);
+    RUN_TEST(test_oversampling_lowers_noise_floor);
+    return UNITY_END();
+}
@@ -1,5 +1,6 @@
 #include <Arduino.h>
 #include <unity.h>
+#include <cmath>
 #include "utils/configuration/config.h"
 #include "utils/configuration/config.cpp"
 
@@ -100,6 +101,86 @@ void test_parse_whitespace_handling() {
     TEST_ASSERT_EQUAL(2, cfg.params.size());
 }
 
+void test_parse_null_param_is_nan() {
+    AppConfig cfg;
+    std::string msg = R"({"ssid":"Net","pass":"pw","params":[2, null, 30]})";
+    TEST_ASSERT_TRUE(ConfigHandler::parseAppCfg(msg, cfg));
+    TEST_ASSERT_EQUAL(3, cfg.params.size());
+    TEST_ASSERT_TRUE(std::isnan(cfg.params[1]));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 30.0f, cfg.params[2]);
+}
+
+// ============ Sparse params tests ============
+
+void test_sparse_set_and_find() {
+    AppConfig cfg;
+    TEST_ASSERT_TRUE(ConfigHandler::setParam(cfg, 8, 7.0f));
+    TEST_ASSERT_TRUE(ConfigHandler::setParam(cfg, 0, 3.0f));
+    TEST_ASSERT_TRUE(ConfigHandler::setParam(cfg, 2, 28.0f));
+    TEST_ASSERT_TRUE(ConfigHandler::setParam(cfg, 8, 9.0f)); // Replaces
+    TEST_ASSERT_EQUAL_UINT32((1u << 0) | (1u << 2) | (1u << 8), cfg.paramMask);
+    TEST_ASSERT_EQUAL(3, cfg.params.size()); // Only what was set
+
+    float v = 0.0f;
+    TEST_ASSERT_TRUE(ConfigHandler::findParam(cfg, 0, v));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 3.0f, v);
+    TEST_ASSERT_TRUE(ConfigHandler::findParam(cfg, 2, v));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 28.0f, v);
+    TEST_ASSERT_TRUE(ConfigHandler::findParam(cfg, 8, v));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 9.0f, v);
+    TEST_ASSERT_FALSE(ConfigHandler::findParam(cfg, 1, v));
+    TEST_ASSERT_FALSE(ConfigHandler::findParam(cfg, 31, v));
+    TEST_ASSERT_FALSE(ConfigHandler::setParam(cfg, ConfigHandler::kMaxParams, 1.0f));
+}
+
+void test_dense_set_and_find() {
+    AppConfig cfg;
+    cfg.params = {1.0f, 2.0f};
+    TEST_ASSERT_TRUE(ConfigHandler::setParam(cfg, 4, 5.0f));
+    TEST_ASSERT_EQUAL_UINT32(0, cfg.paramMask);
+    TEST_ASSERT_EQUAL(5, cfg.params.size());
+    TEST_ASSERT_TRUE(std::isnan(cfg.params[3])); // Gap marked "not set"
+
+    float v = 0.0f;
+    TEST_ASSERT_TRUE(ConfigHandler::findParam(cfg, 1, v));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 2.0f, v);
+    TEST_ASSERT_FALSE(ConfigHandler::findParam(cfg, 5, v));
+}
+
+void test_sparse_roundtrip_keeps_mask() {
+    AppConfig saved;
+    saved.ssid = "Net";
+    saved.password = "pw";
+    ConfigHandler::setParam(saved, 0, 4.0f);
+    ConfigHandler::setParam(saved, 8, 12.0f);
+    TEST_ASSERT_TRUE(ConfigHandler::save(saved));
+
+    AppConfig loaded;
+    TEST_ASSERT_TRUE(ConfigHandler::load(loaded));
+    TEST_ASSERT_EQUAL_UINT32(saved.paramMask, loaded.paramMask);
+    TEST_ASSERT_EQUAL(2, loaded.params.size());
+    float v = 0.0f;
+    TEST_ASSERT_TRUE(ConfigHandler::findParam(loaded, 8, v));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 12.0f, v);
+
+    // Saving a dense config afterwards drops the stale mask
+    saved.paramMask = 0;
+    saved.params = {1.0f, 2.0f, 3.0f};
+    TEST_ASSERT_TRUE(ConfigHandler::save(saved));
+    TEST_ASSERT_TRUE(ConfigHandler::load(loaded));
+    TEST_ASSERT_EQUAL_UINT32(0, loaded.paramMask);
+    TEST_ASSERT_EQUAL(3, loaded.params.size());
+}
+
+void test_save_rejects_mask_count_mismatch() {
+    AppConfig cfg;
+    cfg.ssid = "Net";
+    cfg.password = "pw";
+    cfg.params = {1.0f};
+    cfg.paramMask = (1u << 0) | (1u << 3);
+    TEST_ASSERT_FALSE(ConfigHandler::save(cfg));
+}
+
 // ============ NVS save/load roundtrip tests ============
 
 void test_save_and_load_roundtrip() {
@@ -179,6 +260,13 @@ int main() {
     RUN_TEST(test_parse_escape_in_password);
     RUN_TEST(test_parse_negative_float_params);
     RUN_TEST(test_parse_whitespace_handling);
+    RUN_TEST(test_parse_null_param_is_nan);
+
+    // Sparse params tests
+    RUN_TEST(test_sparse_set_and_find);
+    RUN_TEST(test_dense_set_and_find);
+    RUN_TEST(test_sparse_roundtrip_keeps_mask);
+    RUN_TEST(test_save_rejects_mask_count_mismatch);
 
     // NVS roundtrip tests
     RUN_TEST(test_save_and_load_roundtrip);
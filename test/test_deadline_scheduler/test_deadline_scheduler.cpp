@@ -0,0 +1,117 @@
+#include <unity.h>
+#include "utils/deadline-scheduler/deadline-scheduler.h"
+
+using PlantMonitor::Utils::DeadlineScheduler;
+
+void setUp() {}
+void tearDown() {}
+
+void test_add_source_limits() {
+    DeadlineScheduler<2> scheduler;
+    TEST_ASSERT_EQUAL_INT(-1, scheduler.addSource(0));
+    TEST_ASSERT_EQUAL_INT(0, scheduler.addSource(100));
+    TEST_ASSERT_EQUAL_INT(1, scheduler.addSource(200));
+    TEST_ASSERT_EQUAL_INT(-1, scheduler.addSource(300));
+    TEST_ASSERT_EQUAL(2, scheduler.size());
+}
+
+void test_phase_offsets_first_deadline() {
+    DeadlineScheduler<3> scheduler;
+    scheduler.addSource(1000);
+    scheduler.addSource(1000, 250);
+    scheduler.addSource(10000, 500);
+    scheduler.start(5000);
+
+    TEST_ASSERT_EQUAL_UINT32(0b001, scheduler.collectDue(5000));
+    TEST_ASSERT_EQUAL_UINT32(250, scheduler.timeUntilNext(5000));
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.collectDue(5249));
+    TEST_ASSERT_EQUAL_UINT32(0b010, scheduler.collectDue(5250));
+    TEST_ASSERT_EQUAL_UINT32(0b100, scheduler.collectDue(5500));
+    TEST_ASSERT_EQUAL_UINT32(6000, scheduler.nextDeadline());
+}
+
+void test_late_service_does_not_drift() {
+    DeadlineScheduler<1> scheduler;
+    scheduler.addSource(100);
+    scheduler.start(0);
+
+    TEST_ASSERT_EQUAL_UINT32(1, scheduler.collectDue(0));
+    // Serviced 30 ticks late: the next deadline stays on the 100-tick grid
+    TEST_ASSERT_EQUAL_UINT32(1, scheduler.collectDue(130));
+    TEST_ASSERT_EQUAL_UINT32(200, scheduler.nextDeadline());
+    TEST_ASSERT_EQUAL_UINT32(70, scheduler.timeUntilNext(130));
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.overruns(0));
+}
+
+void test_missed_periods_are_skipped_and_counted() {
+    DeadlineScheduler<1> scheduler;
+    scheduler.addSource(100, 10);
+    scheduler.start(0);
+
+    // Deadlines at 10, 110, 210, 310 all passed: fire once, skip three
+    TEST_ASSERT_EQUAL_UINT32(1, scheduler.collectDue(350));
+    TEST_ASSERT_EQUAL_UINT32(3, scheduler.overruns(0));
+    TEST_ASSERT_EQUAL_UINT32(410, scheduler.nextDeadline());
+}
+
+void test_time_until_next_is_zero_when_due() {
+    DeadlineScheduler<2> scheduler;
+    scheduler.addSource(100);
+    scheduler.addSource(300, 50);
+    scheduler.start(0);
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.timeUntilNext(0));
+    scheduler.collectDue(0);
+    TEST_ASSERT_EQUAL_UINT32(50, scheduler.timeUntilNext(0));
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.timeUntilNext(60));
+}
+
+void test_tick_counter_wraparound() {
+    DeadlineScheduler<1> scheduler;
+    scheduler.addSource(100);
+    const uint32_t start = UINT32_MAX - 149;
+    scheduler.start(start);
+
+    TEST_ASSERT_EQUAL_UINT32(1, scheduler.collectDue(start));
+    TEST_ASSERT_EQUAL_UINT32(1, scheduler.collectDue(start + 100));
+    // Next deadline (start + 200) lies past the wrap
+    TEST_ASSERT_EQUAL_UINT32(start + 200, scheduler.nextDeadline());
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.collectDue(start + 199));
+    TEST_ASSERT_EQUAL_UINT32(1, scheduler.collectDue(start + 200));
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.overruns(0));
+}
+
+void test_fire_counts_match_rates() {
+    DeadlineScheduler<3> scheduler;
+    int fast = scheduler.addSource(1000);
+    int mid = scheduler.addSource(2000, 100);
+    int slow = scheduler.addSource(10000, 200);
+    scheduler.start(0);
+
+    uint32_t counts[3] = { 0, 0, 0 };
+    uint32_t now = 0;
+    while (now < 60000) {
+        uint32_t due = scheduler.collectDue(now);
+        for (int i = 0; i < 3; i++) {
+            if (due & (1u << i)) {
+                counts[i]++;
+            }
+        }
+        now += scheduler.timeUntilNext(now) + 7; // Wake-up latency
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(60, counts[fast]);
+    TEST_ASSERT_EQUAL_UINT32(30, counts[mid]);
+    TEST_ASSERT_EQUAL_UINT32(6, counts[slow]);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_add_source_limits);
+    RUN_TEST(test_phase_offsets_first_deadline);
+    RUN_TEST(test_late_service_does_not_drift);
+    RUN_TEST(test_missed_periods_are_skipped_and_counted);
+    RUN_TEST(test_time_until_next_is_zero_when_due);
+    RUN_TEST(test_tick_counter_wraparound);
+    RUN_TEST(test_fire_counts_match_rates);
+    return UNITY_END();
+}
@@ -3,8 +3,10 @@
 #include "utils/moving-average/moving-average.cpp"
 #include "utils/derivative-filter/derivative-filter.h"
 #include "utils/derivative-filter/derivative-filter.cpp"
+#include "utils/derivative-filter/timed-derivative-filter.h"
 
 using PlantMonitor::Utils::DerivativeFilter;
+using PlantMonitor::Utils::TimedDerivativeFilter;
 
 void setUp() {}
 void tearDown() {}
@@ -68,6 +70,84 @@ void test_zero_scale_always_zero() {
     TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.0f, df.apply(999.0f));
 }
 
+void test_timed_needs_two_samples() {
+    TimedDerivativeFilter<4> df;
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.0f, df.apply(1000, 5.0f));
+    TEST_ASSERT_EQUAL(1, df.getCount());
+}
+
+void test_timed_rate_is_per_second() {
+    TimedDerivativeFilter<2> df;
+    df.apply(1000, 10.0f);
+    // +2 over 500 ms = 4 per second
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 4.0f, df.apply(1500, 12.0f));
+}
+
+void test_timed_variable_dt() {
+    // Jittered timestamps on a 3 units/s ramp: the rate must not depend on spacing
+    TimedDerivativeFilter<8> df;
+    const uint32_t times[] = { 0, 900, 2100, 2950, 4000, 5200, 5900, 7100 };
+    float rate = 0.0f;
+    for (uint32_t t : times) {
+        rate = df.apply(t, 3.0f * (t / 1000.0f));
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 3.0f, rate);
+    TEST_ASSERT_EQUAL_UINT32(7100, df.getSpanMs());
+}
+
+void test_timed_dropped_samples() {
+    TimedDerivativeFilter<4> df;
+    df.apply(0, 0.0f);
+    df.apply(1000, -0.5f);
+    // Two samples missed: the gap is 3 s, not 1
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, -0.5f, df.apply(4000, -2.0f));
+}
+
+void test_timed_noisy_linear_input() {
+    TimedDerivativeFilter<16> df;
+    const float noise[] = { 0.4f, -0.3f, 0.2f, -0.4f };
+    float rate = 0.0f;
+    for (uint32_t i = 0; i < 32; i++) {
+        rate = df.apply(i * 1000, 2.0f * i + noise[i % 4]);
+    }
+    // A two-point difference would swing by up to 0.8 around the true rate
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 2.0f, rate);
+    TEST_ASSERT_EQUAL(16, df.getCount());
+}
+
+void test_timed_rejects_older_timestamp() {
+    TimedDerivativeFilter<4> df;
+    df.apply(1000, 0.0f);
+    float rate = df.apply(2000, 1.0f);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, rate, df.apply(1500, 100.0f));
+    TEST_ASSERT_EQUAL(2, df.getCount());
+}
+
+void test_timed_same_timestamp_replaces_sample() {
+    TimedDerivativeFilter<4> df;
+    df.apply(0, 0.0f);
+    df.apply(1000, 5.0f);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 1.0f, df.apply(1000, 1.0f));
+    TEST_ASSERT_EQUAL(2, df.getCount());
+}
+
+void test_timed_millis_wraparound() {
+    TimedDerivativeFilter<4> df;
+    df.apply(0xFFFFFC18u, 0.0f); // 1 s before wrap
+    df.apply(0xFFFFFFFFu, 0.999f);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 1.0f, df.apply(1000, 2.0f));
+}
+
+void test_timed_reset() {
+    TimedDerivativeFilter<4> df;
+    df.apply(0, 0.0f);
+    df.apply(1000, 10.0f);
+    df.reset();
+    TEST_ASSERT_EQUAL(0, df.getCount());
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.0f, df.getRate());
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.0f, df.apply(500, 3.0f));
+}
+
 int main() {
     UNITY_BEGIN();
     RUN_TEST(test_first_call_returns_zero);
@@ -78,5 +158,14 @@ int main() {
     RUN_TEST(test_reset_clears_state);
     RUN_TEST(test_with_smoothing_window);
     RUN_TEST(test_zero_scale_always_zero);
+    RUN_TEST(test_timed_needs_two_samples);
+    RUN_TEST(test_timed_rate_is_per_second);
+    RUN_TEST(test_timed_variable_dt);
+    RUN_TEST(test_timed_dropped_samples);
+    RUN_TEST(test_timed_noisy_linear_input);
+    RUN_TEST(test_timed_rejects_older_timestamp);
+    RUN_TEST(test_timed_same_timestamp_replaces_sample);
+    RUN_TEST(test_timed_millis_wraparound);
+    RUN_TEST(test_timed_reset);
     return UNITY_END();
 }
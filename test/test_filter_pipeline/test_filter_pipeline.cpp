@@ -0,0 +1,125 @@
+#include <unity.h>
+#include "utils/filter-pipeline/filter-pipeline.h"
+
+using namespace PlantMonitor::Utils;
+
+void setUp() {}
+void tearDown() {}
+
+void test_empty_pipeline_passes_through() {
+    Pipeline<> p;
+    TEST_ASSERT_EQUAL(0, Pipeline<>::size());
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 12.5f, p.apply(12.5f));
+}
+
+void test_median_rejects_spike() {
+    Median<3> m;
+    m.apply(10.0f);
+    m.apply(11.0f);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 11.0f, m.apply(500.0f));
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 12.0f, m.apply(12.0f));
+}
+
+void test_median_partial_window() {
+    Median<5> m;
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 4.0f, m.apply(4.0f));
+    m.apply(1.0f);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 4.0f, m.apply(9.0f)); // {1, 4, 9}
+}
+
+void test_ema_seeds_with_first_sample() {
+    Ema<1, 4> e;
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 20.0f, e.apply(20.0f));
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 21.0f, e.apply(24.0f)); // 20 + (24 - 20) / 4
+    e.reset();
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 5.0f, e.apply(5.0f));
+}
+
+void test_clamp_limits_range() {
+    Clamp<-40, 85> c;
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, -40.0f, c.apply(-100.0f));
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 85.0f, c.apply(150.0f));
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 22.5f, c.apply(22.5f));
+}
+
+void test_average_stage() {
+    Average<4> a;
+    a.apply(2.0f);
+    a.apply(4.0f);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 4.0f, a.apply(6.0f));
+}
+
+void test_stages_apply_in_order() {
+    // Clamp before the median: the spike is clipped, then outvoted
+    Pipeline<Clamp<0, 100>, Median<3>> clampFirst;
+    // Median before the clamp: the clamp only sees the median
+    Pipeline<Median<3>, Clamp<0, 50>> medianFirst;
+
+    const float in[] = { 40.0f, 60.0f, 200.0f };
+    float a = 0.0f;
+    float b = 0.0f;
+    for (float v : in) {
+        a = clampFirst.apply(v);
+        b = medianFirst.apply(v);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 60.0f, a);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 50.0f, b);
+}
+
+void test_block_apply_matches_sample_apply() {
+    Pipeline<Median<5>, Ema<1, 2>, Clamp<0, 100>> single;
+    Pipeline<Median<5>, Ema<1, 2>, Clamp<0, 100>> block;
+
+    float buffer[32];
+    float expected[32];
+    for (int i = 0; i < 32; i++) {
+        buffer[i] = (i % 7 == 0) ? 250.0f : 40.0f + i;
+        expected[i] = single.apply(buffer[i]);
+    }
+
+    block.apply(buffer, 32);
+    for (int i = 0; i < 32; i++) {
+        TEST_ASSERT_FLOAT_WITHIN(0.0001f, expected[i], buffer[i]);
+    }
+}
+
+void test_block_apply_to_separate_output() {
+    Pipeline<Clamp<0, 10>> p;
+    const float in[] = { -5.0f, 5.0f, 15.0f };
+    float out[3];
+    p.apply(in, out, 3);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.0f, out[0]);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 5.0f, out[1]);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 10.0f, out[2]);
+}
+
+void test_reset_clears_every_stage() {
+    Pipeline<Median<3>, Ema<1, 2>> p;
+    p.apply(100.0f);
+    p.apply(100.0f);
+    p.reset();
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 7.0f, p.apply(7.0f));
+}
+
+void test_stage_access() {
+    Pipeline<Median<3>, Ema<1, 2>> p;
+    TEST_ASSERT_EQUAL(2, p.size());
+    p.apply(8.0f);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 9.0f, p.stage<1>().apply(10.0f)); // 8 + (10 - 8) / 2
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_empty_pipeline_passes_through);
+    RUN_TEST(test_median_rejects_spike);
+    RUN_TEST(test_median_partial_window);
+    RUN_TEST(test_ema_seeds_with_first_sample);
+    RUN_TEST(test_clamp_limits_range);
+    RUN_TEST(test_average_stage);
+    RUN_TEST(test_stages_apply_in_order);
+    RUN_TEST(test_block_apply_matches_sample_apply);
+    RUN_TEST(test_block_apply_to_separate_output);
+    RUN_TEST(test_reset_clears_every_stage);
+    RUN_TEST(test_stage_access);
+    return UNITY_END();
+}
@@ -0,0 +1,135 @@
+#include <unity.h>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include "utils/frame-mailbox/frame-mailbox.h"
+
+using PlantMonitor::Utils::FrameMailbox;
+
+static constexpr size_t kFrameBytes = 256;
+
+alignas(4) static uint8_t s_buffers[3][kFrameBytes];
+
+void setUp() {
+    memset(s_buffers, 0, sizeof(s_buffers));
+}
+
+void tearDown() {}
+
+// ============ FrameMailbox tests ============
+
+void test_nothing_to_take_initially() {
+    FrameMailbox mailbox(s_buffers[2]);
+    TEST_ASSERT_FALSE(mailbox.pending());
+    TEST_ASSERT_NULL(mailbox.take(s_buffers[1]));
+}
+
+void test_publish_then_take_swaps_buffers() {
+    FrameMailbox mailbox(s_buffers[2]);
+    uint8_t *back = s_buffers[0];
+    uint8_t *front = s_buffers[1];
+
+    bool superseded = true;
+    back = mailbox.publish(back, &superseded);
+    TEST_ASSERT_FALSE(superseded);
+    TEST_ASSERT_EQUAL_PTR(s_buffers[2], back); // Renderer continues in the spare
+    TEST_ASSERT_TRUE(mailbox.pending());
+
+    front = mailbox.take(front);
+    TEST_ASSERT_EQUAL_PTR(s_buffers[0], front);
+    TEST_ASSERT_FALSE(mailbox.pending());
+    TEST_ASSERT_NULL(mailbox.take(front)); // Taken only once
+}
+
+void test_newest_frame_wins() {
+    FrameMailbox mailbox(s_buffers[2]);
+    uint8_t *back = s_buffers[0];
+
+    back[0] = 1;
+    back = mailbox.publish(back);
+    back[0] = 2;
+    bool superseded = false;
+    back = mailbox.publish(back, &superseded);
+    TEST_ASSERT_TRUE(superseded);
+    TEST_ASSERT_EQUAL_PTR(s_buffers[0], back); // Frame 1 recycled unsent
+
+    uint8_t *front = mailbox.take(s_buffers[1]);
+    TEST_ASSERT_EQUAL_UINT8(2, front[0]);
+}
+
+void test_three_buffers_stay_distinct() {
+    FrameMailbox mailbox(s_buffers[2]);
+    uint8_t *back = s_buffers[0];
+    uint8_t *front = s_buffers[1];
+
+    for (int i = 0; i < 10; ++i) {
+        back = mailbox.publish(back);
+        if (i % 3 == 0) {
+            front = mailbox.take(front);
+        }
+        TEST_ASSERT_TRUE(back != front);
+    }
+}
+
+// Renderer stamps every byte of a frame with its number; the flusher must only
+// ever see whole frames, in increasing order
+void test_concurrent_frames_are_never_torn() {
+    FrameMailbox mailbox(s_buffers[2]);
+    std::atomic<bool> done(false);
+    std::atomic<uint32_t> torn(0);
+    std::atomic<uint32_t> reordered(0);
+    std::atomic<uint32_t> received(0);
+    const uint32_t frames = 200000;
+
+    std::thread flusher([&] {
+        uint8_t *front = s_buffers[1];
+        uint32_t last = 0;
+        while (!done.load() || mailbox.pending()) {
+            uint8_t *frame = mailbox.take(front);
+            if (frame == nullptr) {
+                std::this_thread::yield();
+                continue;
+            }
+            front = frame;
+            uint32_t stamp;
+            memcpy(&stamp, front, sizeof(stamp));
+            for (size_t i = 0; i < kFrameBytes; i += sizeof(stamp)) {
+                uint32_t word;
+                memcpy(&word, front + i, sizeof(word));
+                if (word != stamp) {
+                    torn++;
+                    break;
+                }
+            }
+            if (stamp <= last) {
+                reordered++;
+            }
+            last = stamp;
+            received++;
+        }
+    });
+
+    uint8_t *back = s_buffers[0];
+    for (uint32_t n = 1; n <= frames; ++n) {
+        for (size_t i = 0; i < kFrameBytes; i += sizeof(n)) {
+            memcpy(back + i, &n, sizeof(n));
+        }
+        back = mailbox.publish(back);
+    }
+    done = true;
+    flusher.join();
+
+    TEST_ASSERT_EQUAL_UINT32(0, torn.load());
+    TEST_ASSERT_EQUAL_UINT32(0, reordered.load());
+    TEST_ASSERT_TRUE(received.load() > 0);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_nothing_to_take_initially);
+    RUN_TEST(test_publish_then_take_swaps_buffers);
+    RUN_TEST(test_newest_frame_wins);
+    RUN_TEST(test_three_buffers_stay_distinct);
+    RUN_TEST(test_concurrent_frames_are_never_torn);
+    return UNITY_END();
+}
@@ -0,0 +1,213 @@
+#include <unity.h>
+#include <chrono>
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include "utils/glyph-font/glyph-font.h"
+
+using PlantMonitor::Utils::formatFixed;
+using PlantMonitor::Utils::GlyphFont;
+
+static constexpr int16_t kWidth = 128;
+static constexpr uint8_t kPages = 16;
+
+static uint8_t s_glyphFrame[kWidth * kPages];
+static uint8_t s_gfxFrame[kWidth * kPages];
+
+void setUp() {
+    memset(s_glyphFrame, 0, sizeof(s_glyphFrame));
+    memset(s_gfxFrame, 0, sizeof(s_gfxFrame));
+}
+
+void tearDown() {}
+
+// ============ Reference: the Adafruit GFX text path ============
+
+// Adafruit_GrayOLED::drawPixel (rotation 0, white)
+static void gfxDrawPixel(int16_t x, int16_t y) {
+    if (x >= 0 && x < kWidth && y >= 0 && y < kPages * 8) {
+        s_gfxFrame[x + (y / 8) * kWidth] |= static_cast<uint8_t>(1u << (y & 7));
+    }
+}
+
+// Adafruit_GFX::writeFillRect -> drawFastVLine -> drawPixel
+static void gfxFillRect(int16_t x, int16_t y, int16_t w, int16_t h) {
+    for (int16_t i = x; i < x + w; ++i) {
+        for (int16_t j = y; j < y + h; ++j) {
+            gfxDrawPixel(i, j);
+        }
+    }
+}
+
+// Adafruit_GFX::drawChar (classic font, transparent background)
+static void gfxDrawChar(int16_t x, int16_t y, char c, uint8_t size) {
+    int index = PlantMonitor::Utils::detail::glyphIndex(c);
+    if (index < 0) {
+        return;
+    }
+    for (int8_t i = 0; i < 5; ++i) {
+        uint8_t line = PlantMonitor::Utils::detail::kGlyphSource[index][i];
+        for (int8_t j = 0; j < 8; ++j, line >>= 1) {
+            if (line & 1) {
+                if (size == 1) {
+                    gfxDrawPixel(x + i, y + j);
+                } else {
+                    gfxFillRect(x + i * size, y + j * size, size, size);
+                }
+            }
+        }
+    }
+}
+
+// DisplayHAL::printf: vsnprintf into a stack buffer, then print() char by char
+static void gfxPrintf(int16_t x, int16_t y, uint8_t size, const char *format, ...) {
+    char buffer[128];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    for (const char *c = buffer; *c != '\0'; ++c, x += 6 * size) {
+        gfxDrawChar(x, y, *c, size);
+    }
+}
+
+// Old prv_draw_centered_value value path
+static void gfxDrawValue(float value, uint8_t decimals) {
+    char buffer[16];
+    snprintf(buffer, sizeof(buffer), "%.*f", decimals, value);
+    int16_t x = (128 - static_cast<int16_t>(strlen(buffer)) * 18) / 2;
+    gfxPrintf(x, 64, 3, "%s", buffer);
+}
+
+// New prv_draw_centered_value value path
+static void glyphDrawValue(float value, uint8_t decimals) {
+    char buffer[16];
+    formatFixed(value, decimals, buffer, sizeof(buffer));
+    GlyphFont<3>::draw(s_glyphFrame, kWidth, kPages, (128 - GlyphFont<3>::textWidth(buffer)) / 2, 8, buffer);
+}
+
+// ============ Glyph bitmaps ============
+
+void test_every_glyph_matches_gfx_at_each_size() {
+    const char glyphs[] = { '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '.', '-', '%', 'C', 'F', GLYPH_FONT_DEGREE };
+    for (char c : glyphs) {
+        const char text[] = { c, '\0' };
+        setUp();
+        GlyphFont<1>::draw(s_glyphFrame, kWidth, kPages, 3, 1, text);
+        GlyphFont<2>::draw(s_glyphFrame, kWidth, kPages, 20, 4, text);
+        GlyphFont<3>::draw(s_glyphFrame, kWidth, kPages, 50, 8, text);
+        GlyphFont<4>::draw(s_glyphFrame, kWidth, kPages, 90, 11, text);
+        gfxDrawChar(3, 8, c, 1);
+        gfxDrawChar(20, 32, c, 2);
+        gfxDrawChar(50, 64, c, 3);
+        gfxDrawChar(90, 88, c, 4);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(s_gfxFrame, s_glyphFrame, sizeof(s_gfxFrame));
+    }
+}
+
+void test_value_page_matches_gfx() {
+    const float values[] = { 23.4f, -5.2f, 0.0f, 100.0f, 9.96f, 1234.0f };
+    for (float value : values) {
+        for (uint8_t decimals = 0; decimals <= 1; ++decimals) {
+            setUp();
+            glyphDrawValue(value, decimals);
+            gfxDrawValue(value, decimals);
+            TEST_ASSERT_EQUAL_UINT8_ARRAY(s_gfxFrame, s_glyphFrame, sizeof(s_gfxFrame));
+        }
+    }
+}
+
+void test_unknown_character_advances_like_space() {
+    GlyphFont<2>::draw(s_glyphFrame, kWidth, kPages, 0, 0, "1x1");
+    gfxDrawChar(0, 0, '1', 2);
+    gfxDrawChar(24, 0, '1', 2);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(s_gfxFrame, s_glyphFrame, sizeof(s_gfxFrame));
+    TEST_ASSERT_EQUAL_INT16(36, GlyphFont<2>::textWidth("1x1"));
+}
+
+void test_draw_is_clipped_to_the_frame() {
+    // Leave a guard byte on both sides of a one-page frame
+    uint8_t frame[kWidth + 2] = {};
+    GlyphFont<3>::draw(frame + 1, kWidth, 1, -7, 0, "88");
+    GlyphFont<3>::draw(frame + 1, kWidth, 1, 120, 0, "88");
+    GlyphFont<3>::draw(frame + 1, kWidth, 1, 200, 0, "8");
+    TEST_ASSERT_EQUAL_UINT8(0, frame[0]);
+    TEST_ASSERT_EQUAL_UINT8(0, frame[kWidth + 1]);
+    TEST_ASSERT_NOT_EQUAL(0, frame[1]);      // Clipped left glyph still inked
+    TEST_ASSERT_NOT_EQUAL(0, frame[kWidth]); // Right glyph reaches the last column
+
+    GlyphFont<3>::draw(s_glyphFrame, kWidth, kPages, 0, 15, "8"); // Bottom pages fall off the frame
+    gfxDrawChar(0, 120, '8', 3);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(s_gfxFrame, s_glyphFrame, sizeof(s_gfxFrame));
+}
+
+// ============ formatFixed ============
+
+void test_format_matches_printf() {
+    const float values[] = { 0.0f, 1.0f, 23.44f, 23.46f, -5.26f, 99.94f, 99.96f, 0.04f, 0.51f, 4095.0f, 123456.0f };
+    char expected[32];
+    char actual[16];
+    for (float value : values) {
+        for (uint8_t decimals = 0; decimals <= 3; ++decimals) {
+            snprintf(expected, sizeof(expected), "%.*f", decimals, value);
+            size_t length = formatFixed(value, decimals, actual, sizeof(actual));
+            TEST_ASSERT_EQUAL_STRING(expected, actual);
+            TEST_ASSERT_EQUAL(strlen(expected), length);
+        }
+    }
+}
+
+void test_format_edge_cases() {
+    char out[8];
+    formatFixed(-0.04f, 1, out, sizeof(out));
+    TEST_ASSERT_EQUAL_STRING("0.0", out); // No "-0.0"
+    formatFixed(0.25f, 1, out, sizeof(out));
+    TEST_ASSERT_EQUAL_STRING("0.3", out); // Halves round away from zero
+    formatFixed(NAN, 1, out, sizeof(out));
+    TEST_ASSERT_EQUAL_STRING("--", out);
+    formatFixed(INFINITY, 1, out, sizeof(out));
+    TEST_ASSERT_EQUAL_STRING("--", out);
+    formatFixed(1234567.0f, 1, out, sizeof(out)); // "1234567.0" needs 10 bytes
+    TEST_ASSERT_EQUAL_STRING("--", out);
+    formatFixed(1.23456f, 9, out, sizeof(out)); // Decimals capped at 4
+    TEST_ASSERT_EQUAL_STRING("1.2346", out);
+}
+
+// ============ Benchmark ============
+
+template <typename Draw>
+static double nsPerFrame(Draw draw) {
+    const float values[] = { 21.3f, 48.7f, 65.0f, 18.9f, 99.9f, 3.2f, 27.5f, 41.1f };
+    const int rounds = 20000;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        draw(values[r % 8]);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / rounds;
+}
+
+void test_benchmark_glyph_vs_gfx() {
+    double gfx = nsPerFrame([](float v) { gfxDrawValue(v, 1); });
+    double glyph = nsPerFrame([](float v) { glyphDrawValue(v, 1); });
+
+    char msg[96];
+    snprintf(msg, sizeof(msg), "ns per value: gfx size 3 %.0f, glyph blit %.0f (%.1fx)", gfx, glyph, gfx / glyph);
+    TEST_MESSAGE(msg);
+
+    // Host timings only bound the cost; the ratio on the ESP32 differs
+    TEST_ASSERT_TRUE(glyph < gfx);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_every_glyph_matches_gfx_at_each_size);
+    RUN_TEST(test_value_page_matches_gfx);
+    RUN_TEST(test_unknown_character_advances_like_space);
+    RUN_TEST(test_draw_is_clipped_to_the_frame);
+    RUN_TEST(test_format_matches_printf);
+    RUN_TEST(test_format_edge_cases);
+    RUN_TEST(test_benchmark_glyph_vs_gfx);
+    return UNITY_END();
+}
@@ -0,0 +1,273 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <atomic>
+#include <thread>
+#include "tasks/sensor/sensor-history.h"
+
+using PlantMonitor::Utils::HistoryRing;
+using namespace PlantMonitor::Tasks;
+
+struct Rec {
+    uint32_t timestamp;
+    uint32_t value;
+};
+
+void setUp() {}
+void tearDown() {}
+
+// ============ HistoryRing tests ============
+
+void test_empty_ring() {
+    HistoryRing<Rec, 4> ring;
+    Rec r;
+    TEST_ASSERT_EQUAL(0, ring.size());
+    TEST_ASSERT_FALSE(ring.latest(r));
+    TEST_ASSERT_FALSE(ring.all().next(r));
+}
+
+void test_push_and_iterate_in_order() {
+    HistoryRing<Rec, 4> ring;
+    for (uint32_t i = 0; i < 3; i++) {
+        ring.push({ i * 10, i });
+    }
+
+    auto cursor = ring.all();
+    Rec r;
+    for (uint32_t i = 0; i < 3; i++) {
+        TEST_ASSERT_TRUE(cursor.next(r));
+        TEST_ASSERT_EQUAL_UINT32(i, r.value);
+    }
+    TEST_ASSERT_FALSE(cursor.next(r));
+}
+
+void test_overwrite_keeps_newest() {
+    HistoryRing<Rec, 4> ring;
+    for (uint32_t i = 0; i < 10; i++) {
+        ring.push({ i, i });
+    }
+
+    TEST_ASSERT_EQUAL(4, ring.size());
+    TEST_ASSERT_EQUAL_UINT32(10, ring.written());
+    TEST_ASSERT_EQUAL_UINT32(6, ring.oldestIndex());
+
+    Rec r;
+    TEST_ASSERT_FALSE(ring.at(5, r));
+    TEST_ASSERT_TRUE(ring.at(6, r));
+    TEST_ASSERT_EQUAL_UINT32(6, r.value);
+    TEST_ASSERT_TRUE(ring.latest(r));
+    TEST_ASSERT_EQUAL_UINT32(9, r.value);
+}
+
+void test_range_query() {
+    HistoryRing<Rec, 16> ring;
+    for (uint32_t i = 0; i < 16; i++) {
+        ring.push({ i * 60, i });
+    }
+
+    // [120, 300] -> timestamps 120, 180, 240, 300
+    auto cursor = ring.range(120, 300);
+    Rec r;
+    uint32_t count = 0;
+    uint32_t first = 0;
+    while (cursor.next(r)) {
+        if (count == 0)
+            first = r.timestamp;
+        TEST_ASSERT_TRUE(r.timestamp >= 120 && r.timestamp <= 300);
+        count++;
+    }
+    TEST_ASSERT_EQUAL_UINT32(4, count);
+    TEST_ASSERT_EQUAL_UINT32(120, first);
+}
+
+void test_range_between_records() {
+    HistoryRing<Rec, 8> ring;
+    for (uint32_t i = 0; i < 8; i++) {
+        ring.push({ i * 60, i });
+    }
+
+    // No exact match on bounds: [61, 179] -> only 120
+    auto cursor = ring.range(61, 179);
+    Rec r;
+    TEST_ASSERT_TRUE(cursor.next(r));
+    TEST_ASSERT_EQUAL_UINT32(120, r.timestamp);
+    TEST_ASSERT_FALSE(cursor.next(r));
+
+    // Entirely after the newest record
+    TEST_ASSERT_FALSE(ring.range(1000, 2000).next(r));
+}
+
+void test_range_after_wraparound() {
+    HistoryRing<Rec, 8> ring;
+    for (uint32_t i = 0; i < 20; i++) {
+        ring.push({ i * 60, i });
+    }
+
+    // Oldest surviving record is #12 (t=720); earlier bounds clamp to it
+    auto cursor = ring.range(0, 780);
+    Rec r;
+    TEST_ASSERT_TRUE(cursor.next(r));
+    TEST_ASSERT_EQUAL_UINT32(720, r.timestamp);
+    TEST_ASSERT_TRUE(cursor.next(r));
+    TEST_ASSERT_EQUAL_UINT32(780, r.timestamp);
+    TEST_ASSERT_FALSE(cursor.next(r));
+}
+
+void test_cursor_skips_overwritten_records() {
+    HistoryRing<Rec, 4> ring;
+    for (uint32_t i = 0; i < 4; i++) {
+        ring.push({ i, i });
+    }
+
+    auto cursor = ring.all();
+    Rec r;
+    TEST_ASSERT_TRUE(cursor.next(r));
+    TEST_ASSERT_EQUAL_UINT32(0, r.value);
+
+    // Writer laps the cursor: records 1..5 are gone
+    for (uint32_t i = 4; i < 10; i++) {
+        ring.push({ i, i });
+    }
+
+    TEST_ASSERT_TRUE(cursor.next(r));
+    TEST_ASSERT_EQUAL_UINT32(6, r.value);
+}
+
+void test_concurrent_readers_see_valid_records() {
+    constexpr uint32_t kPushes = 100000;
+    HistoryRing<Rec, 64> ring;
+    std::atomic<bool> done(false);
+    std::atomic<uint32_t> bad(0);
+
+    std::thread reader([&]() {
+        Rec r;
+        while (!done.load(std::memory_order_relaxed)) {
+            auto cursor = ring.all();
+            uint32_t last = 0;
+            bool first = true;
+            while (cursor.next(r)) {
+                // Each record carries value == timestamp, strictly increasing
+                if (r.value != r.timestamp || (!first && r.timestamp <= last)) {
+                    bad.fetch_add(1, std::memory_order_relaxed);
+                }
+                last = r.timestamp;
+                first = false;
+            }
+        }
+    });
+
+    for (uint32_t i = 0; i < kPushes; i++) {
+        ring.push({ i, i });
+    }
+    done.store(true);
+    reader.join();
+
+    TEST_ASSERT_EQUAL_UINT32(0, bad.load());
+}
+
+// ============ SensorHistoryAggregator tests ============
+
+void test_record_is_compact() {
+    TEST_ASSERT_EQUAL(12, sizeof(SensorHistoryRecord));
+    TEST_ASSERT_TRUE(sizeof(SensorHistory) < 20 * 1024);
+}
+
+// Readings the aggregator packs; the fields it ignores stay zero
+static SensorData sample(float temperature, float humidity, float moisture, bool lightDetected) {
+    SensorData data = {};
+    data.temperature = temperature;
+    data.humidity = humidity;
+    data.moisture = moisture;
+    data.lightDetected = lightDetected;
+    return data;
+}
+
+void test_aggregator_empty_flush() {
+    SensorHistoryAggregator agg;
+    SensorHistoryRecord rec;
+    TEST_ASSERT_FALSE(agg.flush(60, rec));
+}
+
+void test_aggregator_packs_means() {
+    SensorHistoryAggregator agg;
+    agg.add(sample(21.0f, 40.0f, 30.0f, true));
+    agg.add(sample(22.5f, 50.0f, 40.0f, false));
+    agg.add(sample(24.0f, 60.0f, 50.0f, true));
+    agg.add(sample(22.5f, 50.0f, 40.0f, true));
+
+    SensorHistoryRecord rec;
+    TEST_ASSERT_TRUE(agg.flush(120, rec));
+    TEST_ASSERT_EQUAL_UINT32(120, rec.timestamp);
+    TEST_ASSERT_EQUAL_INT16(2250, rec.temperature);
+    TEST_ASSERT_EQUAL_UINT16(5000, rec.humidity);
+    TEST_ASSERT_EQUAL_UINT8(40, rec.moisture);
+    TEST_ASSERT_EQUAL_UINT8(75, rec.light);
+    TEST_ASSERT_EQUAL_UINT16(4, rec.samples);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 22.5f, historyTemperature(rec));
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 50.0f, historyHumidity(rec));
+
+    // Flush resets the interval
+    TEST_ASSERT_EQUAL(0, agg.samples());
+}
+
+void test_aggregator_negative_temperature() {
+    SensorHistoryAggregator agg;
+    agg.add(sample(-5.25f, 10.0f, 0.0f, false));
+
+    SensorHistoryRecord rec;
+    TEST_ASSERT_TRUE(agg.flush(60, rec));
+    TEST_ASSERT_EQUAL_INT16(-525, rec.temperature);
+    TEST_ASSERT_EQUAL_UINT8(0, rec.light);
+}
+
+void test_history_timestamps_survive_millis_wrap() {
+    // Boot 49.7 days ago: millis() wraps 3 minutes into the recording
+    const int64_t wrapUs = (int64_t(UINT32_MAX) + 1) * 1000;
+    SensorHistory *history = new SensorHistory(); // ~17 KB, keep it off the stack
+    SensorHistoryAggregator agg;
+    SensorHistoryRecord rec;
+
+    mockEspTimerMicros = wrapUs - 3 * 60 * 1000000LL;
+    for (int minute = 0; minute < 6; minute++) {
+        mockEspTimerMicros += SENSOR_HISTORY_INTERVAL_S * 1000000LL;
+        mockMillisValue = static_cast<uint32_t>(mockEspTimerMicros / 1000); // Wraps like the real one
+        agg.add(sample(20.0f + minute, 50.0f, 40.0f, true));
+        TEST_ASSERT_TRUE(agg.flush(historyNowS(), rec));
+        history->push(rec);
+    }
+    TEST_ASSERT_TRUE(mockMillisValue <= 3 * 60000u); // millis() did wrap
+
+    // Timestamps kept ascending, so the binary-searched range still works
+    const uint32_t wrapS = static_cast<uint32_t>(wrapUs / 1000000);
+    auto cursor = history->range(wrapS, wrapS + 2 * SENSOR_HISTORY_INTERVAL_S);
+    TEST_ASSERT_TRUE(cursor.next(rec));
+    TEST_ASSERT_EQUAL_UINT32(wrapS, rec.timestamp);
+    TEST_ASSERT_EQUAL_INT16(2200, rec.temperature);
+    TEST_ASSERT_TRUE(cursor.next(rec));
+    TEST_ASSERT_TRUE(cursor.next(rec));
+    TEST_ASSERT_EQUAL_INT16(2400, rec.temperature);
+    TEST_ASSERT_FALSE(cursor.next(rec));
+    delete history;
+}
+
+int main() {
+    UNITY_BEGIN();
+
+    // HistoryRing
+    RUN_TEST(test_empty_ring);
+    RUN_TEST(test_push_and_iterate_in_order);
+    RUN_TEST(test_overwrite_keeps_newest);
+    RUN_TEST(test_range_query);
+    RUN_TEST(test_range_between_records);
+    RUN_TEST(test_range_after_wraparound);
+    RUN_TEST(test_cursor_skips_overwritten_records);
+    RUN_TEST(test_concurrent_readers_see_valid_records);
+
+    // SensorHistoryAggregator
+    RUN_TEST(test_record_is_compact);
+    RUN_TEST(test_aggregator_empty_flush);
+    RUN_TEST(test_aggregator_packs_means);
+    RUN_TEST(test_aggregator_negative_temperature);
+    RUN_TEST(test_history_timestamps_survive_millis_wrap);
+
+    return UNITY_END();
+}
@@ -0,0 +1,130 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "drivers/i2c/i2c-bus.h"
+#include "drivers/i2c/i2c-bus.cpp"
+
+using namespace PlantMonitor::Drivers;
+
+void setUp() {
+    mockMicrosValue = 0;
+    I2cBus::begin();
+    I2cBus::resetStats();
+}
+
+void tearDown() {}
+
+void test_acquire_accounts_busy_time() {
+    mockMicrosValue = 1000;
+    TEST_ASSERT_TRUE(I2cBus::acquire(I2cClient::Bme280, I2cPriority::High));
+    mockMicrosValue = 1350;
+    I2cBus::release(I2cClient::Bme280);
+
+    I2cClientStats stats;
+    TEST_ASSERT_TRUE(I2cBus::getStats(I2cClient::Bme280, stats));
+    TEST_ASSERT_EQUAL_UINT32(1, stats.leases);
+    TEST_ASSERT_EQUAL_UINT32(350, (uint32_t)stats.busyUs);
+    TEST_ASSERT_EQUAL_UINT32(350, stats.maxBusyUs);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.maxWaitUs);
+}
+
+void test_stats_are_per_client() {
+    mockMicrosValue = 0;
+    I2cBus::acquire(I2cClient::Display, I2cPriority::Normal);
+    mockMicrosValue = 2000;
+    I2cBus::release(I2cClient::Display);
+
+    mockMicrosValue = 2100;
+    I2cBus::acquire(I2cClient::Bme280, I2cPriority::High);
+    mockMicrosValue = 2200;
+    I2cBus::release(I2cClient::Bme280);
+
+    I2cClientStats display;
+    I2cClientStats bme;
+    I2cBus::getStats(I2cClient::Display, display);
+    I2cBus::getStats(I2cClient::Bme280, bme);
+    TEST_ASSERT_EQUAL_UINT32(2000, (uint32_t)display.busyUs);
+    TEST_ASSERT_EQUAL_UINT32(100, (uint32_t)bme.busyUs);
+}
+
+void test_max_busy_tracks_longest_lease() {
+    uint32_t durations[] = { 100, 700, 300 };
+    uint32_t t = 0;
+    for (uint32_t d : durations) {
+        mockMicrosValue = t;
+        I2cBus::acquire(I2cClient::Display, I2cPriority::Normal);
+        t += d;
+        mockMicrosValue = t;
+        I2cBus::release(I2cClient::Display);
+    }
+
+    I2cClientStats stats;
+    I2cBus::getStats(I2cClient::Display, stats);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.leases);
+    TEST_ASSERT_EQUAL_UINT32(1100, (uint32_t)stats.busyUs);
+    TEST_ASSERT_EQUAL_UINT32(700, stats.maxBusyUs);
+}
+
+void test_lease_releases_on_scope_exit() {
+    mockMicrosValue = 10;
+    {
+        I2cLease lease(I2cClient::Bme280, I2cPriority::High);
+        TEST_ASSERT_TRUE(lease.held());
+        mockMicrosValue = 60;
+    }
+
+    I2cClientStats stats;
+    I2cBus::getStats(I2cClient::Bme280, stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.leases);
+    TEST_ASSERT_EQUAL_UINT32(50, (uint32_t)stats.busyUs);
+}
+
+void test_yield_without_contention_keeps_lease() {
+    I2cLease lease(I2cClient::Display, I2cPriority::Normal);
+    TEST_ASSERT_FALSE(I2cBus::shouldYield());
+    TEST_ASSERT_TRUE(lease.yieldIfContended());
+    TEST_ASSERT_TRUE(lease.held());
+}
+
+void test_invalid_client_is_rejected() {
+    I2cClientStats stats;
+    TEST_ASSERT_FALSE(I2cBus::acquire(I2cClient::Count, I2cPriority::High));
+    TEST_ASSERT_FALSE(I2cBus::getStats(I2cClient::Count, stats));
+}
+
+void test_reset_stats() {
+    I2cBus::acquire(I2cClient::Display, I2cPriority::Normal);
+    I2cBus::release(I2cClient::Display);
+    I2cBus::resetStats();
+
+    I2cClientStats stats;
+    I2cBus::getStats(I2cClient::Display, stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.leases);
+    TEST_ASSERT_EQUAL_UINT32(0, (uint32_t)stats.busyUs);
+}
+
+void test_stats_readable_while_holding_lease() {
+    mockMicrosValue = 0;
+    I2cBus::acquire(I2cClient::Display, I2cPriority::Normal);
+    mockMicrosValue = 400;
+    I2cBus::release(I2cClient::Display);
+
+    I2cLease lease(I2cClient::Bme280, I2cPriority::High);
+    int held = mockSemaphoresHeld;
+    I2cClientStats stats;
+    TEST_ASSERT_TRUE(I2cBus::getStats(I2cClient::Display, stats));
+    TEST_ASSERT_EQUAL_UINT32(1, stats.leases);
+    TEST_ASSERT_EQUAL_INT(held, mockSemaphoresHeld);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_acquire_accounts_busy_time);
+    RUN_TEST(test_stats_are_per_client);
+    RUN_TEST(test_max_busy_tracks_longest_lease);
+    RUN_TEST(test_lease_releases_on_scope_exit);
+    RUN_TEST(test_yield_without_contention_keeps_lease);
+    RUN_TEST(test_invalid_client_is_rejected);
+    RUN_TEST(test_reset_stats);
+    RUN_TEST(test_stats_readable_while_holding_lease);
+    return UNITY_END();
+}
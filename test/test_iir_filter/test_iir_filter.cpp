@@ -0,0 +1,196 @@
+#include <unity.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include "utils/iir-filter/iir-filter.h"
+
+using namespace PlantMonitor::Utils;
+namespace FP = PlantMonitor::Utils::FixedPoint;
+
+void setUp() {}
+void tearDown() {}
+
+// Coefficients must be usable in constant expressions
+constexpr BiquadCoefficients kLowPass = biquadLowPass(1.0, 50.0);
+constexpr BiquadCoefficients kNotch = biquadNotch(10.0, 100.0);
+static_assert(FP::sin(FP::kPi / 6.0) > 0.4999999 && FP::sin(FP::kPi / 6.0) < 0.5000001, "constexpr sin");
+static_assert(kLowPass.a1 < -1.5 && kLowPass.a2 > 0.5, "low-pass poles near DC");
+static_assert(toQ30(kNotch).b0 == toQ30(kNotch).b2, "notch is symmetric");
+
+/*! \brief Deterministic test signal: slow sine + hum + noise, amplitude < 0.9 */
+static float prv_signal(int n) {
+    static uint32_t lcg = 12345;
+    lcg = lcg * 1664525u + 1013904223u;
+    float noise = ((lcg >> 9) / 8388608.0f - 0.5f) * 0.1f;
+    return 0.5f * std::sin(2.0f * 3.14159265f * n / 200.0f) + 0.3f * std::sin(2.0f * 3.14159265f * n / 10.0f) + noise;
+}
+
+void test_constexpr_math_matches_std() {
+    for (double x = -7.0; x <= 7.0; x += 0.37) {
+        TEST_ASSERT_TRUE(std::fabs(std::sin(x) - FP::sin(x)) < 1e-12);
+        TEST_ASSERT_TRUE(std::fabs(std::cos(x) - FP::cos(x)) < 1e-12);
+        TEST_ASSERT_TRUE(std::fabs(std::exp(x) - FP::exp(x)) < 1e-12 * std::exp(x));
+    }
+}
+
+void test_q_conversions_round_and_saturate() {
+    TEST_ASSERT_EQUAL_INT16(16384, FP::toQ15(0.5));
+    TEST_ASSERT_EQUAL_INT16(INT16_MAX, FP::toQ15(1.0));
+    TEST_ASSERT_EQUAL_INT16(INT16_MIN, FP::toQ15(-2.0));
+    TEST_ASSERT_EQUAL_INT32(INT32_MAX, FP::toQ31(3.0));
+    TEST_ASSERT_EQUAL_INT32(-1073741824, FP::toQ31(-0.5));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.25f, FP::fromQ31(FP::toQ31(0.25)));
+}
+
+void test_ema_alpha_design() {
+    TEST_ASSERT_TRUE(std::fabs(1.0 - std::exp(-2.0 * FP::kPi / 20.0) - emaAlpha(1.0, 20.0)) < 1e-12);
+}
+
+void test_low_pass_unity_dc_gain() {
+    double gain = (kLowPass.b0 + kLowPass.b1 + kLowPass.b2) / (1.0 + kLowPass.a1 + kLowPass.a2);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 1.0f, gain);
+
+    BiquadQ15 q15(kLowPass);
+    q15_t y = 0;
+    for (int i = 0; i < 500; i++) {
+        y = q15.apply(FP::toQ15(0.5));
+    }
+    TEST_ASSERT_INT_WITHIN(2, FP::toQ15(0.5), y);
+}
+
+void test_biquad_q31_tracks_float_reference() {
+    BiquadFloat ref(kLowPass);
+    BiquadQ31 q31(kLowPass);
+    float maxErr = 0.0f;
+    for (int n = 0; n < 4000; n++) {
+        float x = prv_signal(n);
+        float err = std::fabs(ref.apply(x) - FP::fromQ31(q31.apply(FP::toQ31(x))));
+        maxErr = err > maxErr ? err : maxErr;
+    }
+    TEST_ASSERT_LESS_THAN_FLOAT(1e-5f, maxErr);
+}
+
+void test_biquad_q15_tracks_float_reference() {
+    BiquadFloat ref(kLowPass);
+    BiquadQ15 q15(kLowPass);
+    float maxErr = 0.0f;
+    for (int n = 0; n < 4000; n++) {
+        float x = prv_signal(n);
+        float err = std::fabs(ref.apply(x) - FP::fromQ15(q15.apply(FP::toQ15(x))));
+        maxErr = err > maxErr ? err : maxErr;
+    }
+    // Input quantization (half an LSB) plus output rounding: a few Q15 LSBs
+    TEST_ASSERT_LESS_THAN_FLOAT(4.0f / 32768.0f, maxErr);
+}
+
+void test_notch_rejects_center_frequency() {
+    BiquadQ15 notch(kNotch);
+    int peak = 0;
+    for (int n = 0; n < 2000; n++) {
+        q15_t y = notch.apply(FP::toQ15(0.8 * std::sin(2.0 * FP::kPi * n / 10.0)));
+        if (n > 1000 && std::abs(y) > peak) {
+            peak = std::abs(y);
+        }
+    }
+    TEST_ASSERT_LESS_THAN_INT(FP::toQ15(0.01), peak);
+}
+
+void test_ema_fixed_point_tracks_float_reference() {
+    const double alpha = emaAlpha(0.5, 20.0);
+    EmaFloat ref(alpha);
+    EmaQ31 q31(alpha);
+    EmaQ15 q15(alpha);
+    float err31 = 0.0f;
+    float err15 = 0.0f;
+    for (int n = 0; n < 4000; n++) {
+        float x = prv_signal(n);
+        float r = ref.apply(x);
+        float e31 = std::fabs(r - FP::fromQ31(q31.apply(FP::toQ31(x))));
+        float e15 = std::fabs(r - FP::fromQ15(q15.apply(FP::toQ15(x))));
+        err31 = e31 > err31 ? e31 : err31;
+        err15 = e15 > err15 ? e15 : err15;
+    }
+    TEST_ASSERT_LESS_THAN_FLOAT(1e-5f, err31);
+    TEST_ASSERT_LESS_THAN_FLOAT(2.0f / 32768.0f, err15);
+}
+
+void test_ema_q15_has_no_dead_band() {
+    // alpha * 1 LSB rounds to zero in 16-bit state; the Q31 state still converges
+    EmaQ15 ema(emaAlpha(0.1, 100.0));
+    ema.apply(0);
+    q15_t y = 0;
+    for (int i = 0; i < 20000; i++) {
+        y = ema.apply(100);
+    }
+    TEST_ASSERT_EQUAL_INT16(100, y);
+}
+
+void test_reset_restarts_filters() {
+    BiquadQ31 bq(kLowPass);
+    EmaQ15 ema(0.5);
+    bq.apply(FP::toQ31(0.9));
+    ema.apply(1000);
+    bq.reset();
+    ema.reset();
+    TEST_ASSERT_EQUAL_INT32(0, bq.apply(0));
+    TEST_ASSERT_EQUAL_INT16(-42, ema.apply(-42));
+}
+
+template <typename Filter, typename Sample>
+static double prv_ns_per_sample(Filter &filter, const Sample *in, size_t count, int rounds) {
+    volatile Sample sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (size_t i = 0; i < count; i++) {
+            sink = filter.apply(in[i]);
+        }
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    (void)sink;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / (static_cast<double>(count) * rounds);
+}
+
+void test_throughput() {
+    static float inF[1024];
+    static q31_t in31[1024];
+    static q15_t in15[1024];
+    for (int i = 0; i < 1024; i++) {
+        inF[i] = prv_signal(i);
+        in31[i] = FP::toQ31(inF[i]);
+        in15[i] = FP::toQ15(inF[i]);
+    }
+
+    BiquadFloat bf(kLowPass);
+    BiquadQ31 b31(kLowPass);
+    BiquadQ15 b15(kLowPass);
+    EmaQ15 e15(0.1);
+
+    double nsF = prv_ns_per_sample(bf, inF, 1024, 200);
+    double ns31 = prv_ns_per_sample(b31, in31, 1024, 200);
+    double ns15 = prv_ns_per_sample(b15, in15, 1024, 200);
+    double nsE = prv_ns_per_sample(e15, in15, 1024, 200);
+
+    char msg[128];
+    snprintf(msg, sizeof(msg), "ns/sample: biquad float %.2f, q31 %.2f, q15 %.2f; ema q15 %.2f", nsF, ns31, ns15, nsE);
+    TEST_MESSAGE(msg);
+
+    // Host timings only bound the cost; the relative float/fixed speed is target specific
+    TEST_ASSERT_TRUE(ns15 < 1000.0);
+    TEST_ASSERT_TRUE(ns31 < 1000.0);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_constexpr_math_matches_std);
+    RUN_TEST(test_q_conversions_round_and_saturate);
+    RUN_TEST(test_ema_alpha_design);
+    RUN_TEST(test_low_pass_unity_dc_gain);
+    RUN_TEST(test_biquad_q31_tracks_float_reference);
+    RUN_TEST(test_biquad_q15_tracks_float_reference);
+    RUN_TEST(test_notch_rejects_center_frequency);
+    RUN_TEST(test_ema_fixed_point_tracks_float_reference);
+    RUN_TEST(test_ema_q15_has_no_dead_band);
+    RUN_TEST(test_reset_restarts_filters);
+    RUN_TEST(test_throughput);
+    return UNITY_END();
+}
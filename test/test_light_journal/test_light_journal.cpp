@@ -0,0 +1,167 @@
+#include <Arduino.h>
+#include <Preferences.h>
+#include <unity.h>
+
+#include "tasks/plant/light-journal.cpp"
+
+using namespace PlantMonitor::Tasks;
+
+void setUp() {
+    Preferences::resetAllMockStorage();
+}
+
+void tearDown() {}
+
+static LightDayRecord makeDay(uint16_t day, uint16_t minutes, uint8_t peak = 50) {
+    LightDayRecord record = {};
+    record.day = day;
+    record.lightMinutes = minutes;
+    record.peakPercent = peak;
+    return record;
+}
+
+// ============ LightJournal tests ============
+
+void test_empty_journal() {
+    LightJournal journal;
+    LightDayRecord record;
+    LightJournalSummary summary;
+    TEST_ASSERT_FALSE(journal.load());
+    TEST_ASSERT_EQUAL(0, journal.size());
+    TEST_ASSERT_FALSE(journal.at(0, record));
+    TEST_ASSERT_FALSE(journal.summarize(7, summary));
+    TEST_ASSERT_EQUAL_UINT8(0, journal.trailingDaysBelow(600));
+}
+
+void test_append_and_read_back() {
+    LightJournal journal;
+    TEST_ASSERT_TRUE(journal.append(makeDay(100, 300)));
+    TEST_ASSERT_TRUE(journal.append(makeDay(101, 420, 80)));
+
+    LightDayRecord record;
+    TEST_ASSERT_EQUAL(2, journal.size());
+    TEST_ASSERT_TRUE(journal.at(0, record));
+    TEST_ASSERT_EQUAL_UINT16(101, record.day);
+    TEST_ASSERT_EQUAL_UINT16(420, record.lightMinutes);
+    TEST_ASSERT_EQUAL_UINT8(80, record.peakPercent);
+    TEST_ASSERT_TRUE(journal.at(1, record));
+    TEST_ASSERT_EQUAL_UINT16(100, record.day);
+    TEST_ASSERT_FALSE(journal.at(2, record));
+}
+
+void test_reload_finds_newest() {
+    {
+        LightJournal journal;
+        for (uint16_t day = 0; day < 5; day++) {
+            journal.append(makeDay(day, day * 10));
+        }
+    }
+
+    LightJournal reloaded;
+    LightDayRecord record;
+    TEST_ASSERT_TRUE(reloaded.load());
+    TEST_ASSERT_EQUAL(5, reloaded.size());
+    TEST_ASSERT_TRUE(reloaded.at(0, record));
+    TEST_ASSERT_EQUAL_UINT16(4, record.day);
+}
+
+void test_wrap_keeps_last_days() {
+    LightJournal journal;
+    for (uint16_t day = 0; day < LIGHT_JOURNAL_DAYS + 7; day++) {
+        journal.append(makeDay(day, day));
+    }
+    TEST_ASSERT_EQUAL(LIGHT_JOURNAL_DAYS, journal.size());
+
+    // A reboot after the wrap still finds the newest record
+    LightJournal reloaded;
+    LightDayRecord record;
+    TEST_ASSERT_TRUE(reloaded.load());
+    TEST_ASSERT_EQUAL(LIGHT_JOURNAL_DAYS, reloaded.size());
+    TEST_ASSERT_TRUE(reloaded.at(0, record));
+    TEST_ASSERT_EQUAL_UINT16(LIGHT_JOURNAL_DAYS + 6, record.day);
+    TEST_ASSERT_TRUE(reloaded.at(LIGHT_JOURNAL_DAYS - 1, record));
+    TEST_ASSERT_EQUAL_UINT16(7, record.day);
+
+    // The next append reuses the oldest slot
+    TEST_ASSERT_TRUE(reloaded.append(makeDay(500, 1)));
+    TEST_ASSERT_TRUE(reloaded.at(LIGHT_JOURNAL_DAYS - 1, record));
+    TEST_ASSERT_EQUAL_UINT16(8, record.day);
+}
+
+void test_summarize_recent_days() {
+    LightJournal journal;
+    journal.append(makeDay(1, 999, 100)); // Outside the 3-day window
+    journal.append(makeDay(2, 120, 30));
+    journal.append(makeDay(3, 360, 70));
+    journal.append(makeDay(4, 240, 40));
+
+    LightJournalSummary summary;
+    TEST_ASSERT_TRUE(journal.summarize(3, summary));
+    TEST_ASSERT_EQUAL_UINT16(3, summary.days);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 240.0f, summary.meanMinutes);
+    TEST_ASSERT_EQUAL_UINT16(120, summary.minMinutes);
+    TEST_ASSERT_EQUAL_UINT16(360, summary.maxMinutes);
+    TEST_ASSERT_EQUAL_UINT8(70, summary.peakPercent);
+
+    // Asking for more days than stored covers what exists
+    TEST_ASSERT_TRUE(journal.summarize(30, summary));
+    TEST_ASSERT_EQUAL_UINT16(4, summary.days);
+    TEST_ASSERT_EQUAL_UINT16(999, summary.maxMinutes);
+}
+
+void test_trailing_days_below() {
+    LightJournal journal;
+    journal.append(makeDay(1, 100));
+    journal.append(makeDay(2, 700));
+    journal.append(makeDay(3, 200));
+    journal.append(makeDay(4, 599));
+
+    TEST_ASSERT_EQUAL_UINT8(2, journal.trailingDaysBelow(600));
+    TEST_ASSERT_EQUAL_UINT8(0, journal.trailingDaysBelow(100));
+    TEST_ASSERT_EQUAL_UINT8(4, journal.trailingDaysBelow(1000));
+}
+
+void test_progress_checkpoint() {
+    LightJournal journal;
+    LightDayRecord record;
+    TEST_ASSERT_FALSE(journal.loadProgress(record));
+
+    TEST_ASSERT_TRUE(journal.saveProgress(makeDay(42, 90, 60)));
+    TEST_ASSERT_TRUE(journal.saveProgress(makeDay(42, 120, 70)));
+    TEST_ASSERT_TRUE(journal.loadProgress(record));
+    TEST_ASSERT_EQUAL_UINT16(42, record.day);
+    TEST_ASSERT_EQUAL_UINT16(120, record.lightMinutes);
+    TEST_ASSERT_EQUAL_UINT8(70, record.peakPercent);
+
+    // The checkpoint is not a journal record
+    TEST_ASSERT_FALSE(journal.load());
+    TEST_ASSERT_EQUAL(0, journal.size());
+}
+
+void test_clear() {
+    LightJournal journal;
+    journal.append(makeDay(1, 100));
+    journal.saveProgress(makeDay(2, 10));
+    journal.clear();
+    TEST_ASSERT_EQUAL(0, journal.size());
+
+    LightJournal reloaded;
+    LightDayRecord record;
+    TEST_ASSERT_FALSE(reloaded.load());
+    TEST_ASSERT_FALSE(reloaded.loadProgress(record));
+}
+
+int main() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_empty_journal);
+    RUN_TEST(test_append_and_read_back);
+    RUN_TEST(test_reload_finds_newest);
+    RUN_TEST(test_wrap_keeps_last_days);
+    RUN_TEST(test_summarize_recent_days);
+    RUN_TEST(test_trailing_days_below);
+    RUN_TEST(test_progress_checkpoint);
+    RUN_TEST(test_clear);
+
+    return UNITY_END();
+}
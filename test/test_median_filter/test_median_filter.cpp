@@ -0,0 +1,150 @@
+#include <unity.h>
+#include <algorithm>
+#include <cmath>
+#include "utils/median-filter/median-filter.h"
+#include "utils/filter-pipeline/filter-pipeline.h"
+
+using namespace PlantMonitor::Utils;
+
+void setUp() {}
+void tearDown() {}
+
+template <size_t N>
+static bool prv_network_sorts_all_binary_inputs() {
+    // 0-1 principle: a network that sorts every 0/1 input sorts every input
+    for (uint32_t bits = 0; bits < (1u << N); bits++) {
+        uint8_t v[N];
+        for (size_t i = 0; i < N; i++) {
+            v[i] = (bits >> i) & 1u;
+        }
+        sortingNetwork<uint8_t, N>(v);
+        if (!std::is_sorted(v, v + N)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void test_sorting_networks_are_complete() {
+    TEST_ASSERT_TRUE(prv_network_sorts_all_binary_inputs<2>());
+    TEST_ASSERT_TRUE(prv_network_sorts_all_binary_inputs<3>());
+    TEST_ASSERT_TRUE(prv_network_sorts_all_binary_inputs<5>());
+    TEST_ASSERT_TRUE(prv_network_sorts_all_binary_inputs<6>());
+    TEST_ASSERT_TRUE(prv_network_sorts_all_binary_inputs<7>());
+    TEST_ASSERT_TRUE(prv_network_sorts_all_binary_inputs<9>());
+    TEST_ASSERT_TRUE(prv_network_sorts_all_binary_inputs<10>());
+    TEST_ASSERT_TRUE(prv_network_sorts_all_binary_inputs<11>());
+    TEST_ASSERT_TRUE(prv_network_sorts_all_binary_inputs<12>());
+    TEST_ASSERT_TRUE(prv_network_sorts_all_binary_inputs<13>());
+    TEST_ASSERT_TRUE(prv_network_sorts_all_binary_inputs<14>());
+    TEST_ASSERT_TRUE(prv_network_sorts_all_binary_inputs<15>());
+}
+
+void test_runtime_median_matches_sort() {
+    uint32_t lcg = 7;
+    for (size_t n = 1; n <= MEDIAN_MAX_WINDOW; n++) {
+        for (int trial = 0; trial < 50; trial++) {
+            uint16_t v[MEDIAN_MAX_WINDOW];
+            uint16_t ref[MEDIAN_MAX_WINDOW];
+            for (size_t i = 0; i < n; i++) {
+                lcg = lcg * 1664525u + 1013904223u;
+                v[i] = ref[i] = (lcg >> 20) & 0x0FFF;
+            }
+            std::sort(ref, ref + n);
+            uint16_t expected = (n % 2) ? ref[n / 2] : (ref[n / 2 - 1] + ref[n / 2]) / 2;
+            TEST_ASSERT_EQUAL_UINT16(expected, medianOf(v, n));
+        }
+    }
+}
+
+void test_fixed_median_rejects_spike() {
+    int v[5] = { 1000, 1002, 4095, 998, 1001 };
+    TEST_ASSERT_EQUAL_INT(1001, (medianOf<int, 5>(v)));
+}
+
+void test_out_of_range_window() {
+    uint16_t v[16] = {};
+    TEST_ASSERT_FALSE(sortSmall(v, 0));
+    TEST_ASSERT_FALSE(sortSmall(v, 16));
+    TEST_ASSERT_EQUAL_UINT16(0, medianOf(v, 16));
+}
+
+void test_hampel_mean_drops_outliers() {
+    // One spike in ten reads: the mean is pulled by ~300 counts, Hampel is not
+    uint16_t v[10] = { 1000, 1004, 996, 1002, 998, 4095, 1001, 999, 1003, 997 };
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 1000.0f, hampelMean(v, 10));
+
+    uint16_t m[10] = { 1000, 1004, 996, 1002, 998, 4095, 1001, 999, 1003, 997 };
+    TEST_ASSERT_TRUE(reduceSamples(m, 10, SampleReduction::Mean) > 1250.0f);
+}
+
+void test_hampel_mean_keeps_clean_noise() {
+    // Without outliers Hampel is the plain mean
+    float v[7] = { 10.0f, 11.0f, 9.0f, 10.5f, 9.5f, 10.2f, 9.8f };
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 10.0f, hampelMean(v, 7));
+}
+
+void test_hampel_mean_flat_window() {
+    uint16_t v[5] = { 512, 512, 512, 512, 0 };
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 512.0f, hampelMean(v, 5));
+}
+
+void test_reduce_samples_modes() {
+    uint16_t a[3] = { 10, 20, 90 };
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 40.0f, reduceSamples(a, 3, SampleReduction::Mean));
+    uint16_t b[3] = { 10, 20, 90 };
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 20.0f, reduceSamples(b, 3, SampleReduction::Median));
+    uint16_t c[3] = { 0, 0, 0 };
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 0.0f, reduceSamples(c, 0, SampleReduction::Hampel));
+}
+
+void test_streaming_hampel_replaces_spike() {
+    HampelFilter<5> h;
+    const float in[] = { 20.0f, 20.2f, 19.9f, 20.1f, 35.0f, 20.0f };
+    float out[6];
+    for (int i = 0; i < 6; i++) {
+        out[i] = h.apply(in[i]);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.2f, 20.0f, out[4]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 20.0f, out[5]);
+    TEST_ASSERT_EQUAL_UINT32(1, h.outliers());
+}
+
+void test_streaming_hampel_follows_a_real_step() {
+    HampelFilter<5> h;
+    float y = 0.0f;
+    for (int i = 0; i < 5; i++) {
+        h.apply(10.0f + 0.1f * (i % 2));
+    }
+    for (int i = 0; i < 5; i++) {
+        y = h.apply(30.0f + 0.1f * (i % 2));
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.2f, 30.0f, y);
+}
+
+void test_hampel_as_pipeline_stage() {
+    Pipeline<HampelFilter<5>, Clamp<0, 100>> p;
+    p.apply(50.0f);
+    p.apply(51.0f);
+    p.apply(49.0f);
+    p.apply(50.0f);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 50.0f, p.apply(250.0f));
+    p.reset();
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 75.0f, p.apply(75.0f));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_sorting_networks_are_complete);
+    RUN_TEST(test_runtime_median_matches_sort);
+    RUN_TEST(test_fixed_median_rejects_spike);
+    RUN_TEST(test_out_of_range_window);
+    RUN_TEST(test_hampel_mean_drops_outliers);
+    RUN_TEST(test_hampel_mean_keeps_clean_noise);
+    RUN_TEST(test_hampel_mean_flat_window);
+    RUN_TEST(test_reduce_samples_modes);
+    RUN_TEST(test_streaming_hampel_replaces_spike);
+    RUN_TEST(test_streaming_hampel_follows_a_real_step);
+    RUN_TEST(test_hampel_as_pipeline_stage);
+    return UNITY_END();
+}
@@ -74,6 +74,33 @@ void test_custom_reader_averaging() {
     TEST_ASSERT_TRUE_MESSAGE(level <= 100, "Averaged moisture level out of bounds");
 }
 
+void test_hampel_reduction_ignores_spike() {
+    // 1862 is ~50 %; one read glitches to the rail
+    int values[] = {1860, 1864, 4095, 1862, 1861};
+    int idx = 0;
+    MoistureSensorHAL::AnalogReader spikyReader = [&](uint8_t) {
+        return values[idx++ % 5];
+    };
+
+    MoistureSensorHAL meanSensor(3724, 0, spikyReader, 5);
+    MoistureSensorHAL hampelSensor(3724, 0, spikyReader, 5, PlantMonitor::Utils::SampleReduction::Hampel);
+
+    // The mean is dragged ~12 points towards dry by a single read
+    TEST_ASSERT_TRUE(meanSensor.readMoistureLevel() < 45);
+    TEST_ASSERT_INT_WITHIN(2, 50, hampelSensor.readMoistureLevel());
+}
+
+void test_median_reduction() {
+    int values[] = {0, 1862, 3724};
+    int idx = 0;
+    MoistureSensorHAL::AnalogReader reader = [&](uint8_t) {
+        return values[idx++ % 3];
+    };
+
+    MoistureSensorHAL medianSensor(3724, 0, reader, 3, PlantMonitor::Utils::SampleReduction::Median);
+    TEST_ASSERT_INT_WITHIN(2, 50, medianSensor.readMoistureLevel());
+}
+
 int main() {
     UNITY_BEGIN();
     RUN_TEST(test_initialization);
@@ -84,5 +111,7 @@ int main() {
     RUN_TEST(test_saturation_low);
     RUN_TEST(test_multiple_reads_stable);
     RUN_TEST(test_custom_reader_averaging);
+    RUN_TEST(test_hampel_reduction_ignores_spike);
+    RUN_TEST(test_median_reduction);
     return UNITY_END();
 }
@@ -3,6 +3,7 @@
 #include "utils/moving-average/moving-average.cpp"
 
 using PlantMonitor::Utils::MovingAverage;
+using PlantMonitor::Utils::StaticMovingAverage;
 
 void setUp() {}
 void tearDown() {}
@@ -94,6 +95,107 @@ void test_negative_values() {
     TEST_ASSERT_FLOAT_WITHIN(0.001f, -20.0f, ma.getAverage());
 }
 
+void test_zero_size_behaves_as_one() {
+    MovingAverage ma(0);
+    ma.addSample(3.0f);
+    ma.addSample(4.0f);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 4.0f, ma.getAverage());
+}
+
+void test_long_run_has_no_drift() {
+    // Values with no exact binary representation: a naive running sum drifts
+    MovingAverage ma(8);
+    for (int i = 0; i < 100000; i++) {
+        ma.addSample(0.1f * static_cast<float>(i % 7) + 1000.3f);
+    }
+    float expected = 0.0f;
+    for (int i = 100000 - 8; i < 100000; i++) {
+        expected += 0.1f * static_cast<float>(i % 7) + 1000.3f;
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, expected / 8.0f, ma.getAverage());
+}
+
+// ============ StaticMovingAverage tests ============
+
+void test_static_empty_returns_zero() {
+    StaticMovingAverage<float, 4> ma;
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.0f, ma.getAverage());
+    TEST_ASSERT_EQUAL(0, ma.getCount());
+}
+
+void test_static_matches_runtime_class() {
+    StaticMovingAverage<float, 5> fixed;
+    MovingAverage runtime(5);
+    for (int i = 0; i < 37; i++) {
+        float sample = static_cast<float>((i * 13) % 11) - 3.5f;
+        fixed.addSample(sample);
+        runtime.addSample(sample);
+        TEST_ASSERT_FLOAT_WITHIN(0.0001f, runtime.getAverage(), fixed.getAverage());
+    }
+}
+
+void test_static_integer_accumulation() {
+    StaticMovingAverage<uint16_t, 4> adc;
+    adc.addSample(4095);
+    adc.addSample(4095);
+    adc.addSample(4095);
+    adc.addSample(4095);
+    TEST_ASSERT_EQUAL_UINT16(4095, adc.getAverage());
+    TEST_ASSERT_EQUAL_UINT32(4 * 4095, adc.getSum());
+
+    adc.addSample(0); // Replaces the oldest 4095
+    TEST_ASSERT_EQUAL_UINT32(3 * 4095, adc.getSum());
+    TEST_ASSERT_EQUAL_UINT16(3071, adc.getAverage()); // 3071.25 rounded
+}
+
+void test_static_integer_rounds_to_nearest() {
+    StaticMovingAverage<uint16_t, 2> ma;
+    ma.addSample(1);
+    ma.addSample(2);
+    TEST_ASSERT_EQUAL_UINT16(2, ma.getAverage()); // 1.5 rounds up
+
+    StaticMovingAverage<int16_t, 2> signedMa;
+    signedMa.addSample(-1);
+    signedMa.addSample(-2);
+    TEST_ASSERT_EQUAL_INT16(-2, signedMa.getAverage()); // -1.5 rounds away from zero
+}
+
+void test_static_default_accumulator_types() {
+    using PlantMonitor::Utils::MovingAverageAccumulator;
+    TEST_ASSERT_TRUE((std::is_same<MovingAverageAccumulator<uint16_t>::type, uint32_t>::value));
+    TEST_ASSERT_TRUE((std::is_same<MovingAverageAccumulator<int16_t>::type, int32_t>::value));
+    TEST_ASSERT_TRUE((std::is_same<MovingAverageAccumulator<int32_t>::type, int64_t>::value));
+    TEST_ASSERT_TRUE((std::is_same<MovingAverageAccumulator<float>::type, float>::value));
+}
+
+void test_static_wraparound_and_clear() {
+    StaticMovingAverage<int32_t, 3> ma;
+    for (int32_t v = 1; v <= 10; v++) {
+        ma.addSample(v * 100);
+    }
+    // Last 3 values: 800, 900, 1000
+    TEST_ASSERT_EQUAL_INT32(900, ma.getAverage());
+    TEST_ASSERT_EQUAL(3, ma.getCount());
+
+    ma.clear();
+    TEST_ASSERT_EQUAL_INT32(0, ma.getAverage());
+    ma.addSample(-7);
+    TEST_ASSERT_EQUAL_INT32(-7, ma.getAverage());
+}
+
+void test_static_large_window_of_adc_counts() {
+    StaticMovingAverage<uint16_t, 1024> ma;
+    for (uint32_t i = 0; i < 5000; i++) {
+        ma.addSample(static_cast<uint16_t>(i & 0x0FFF));
+    }
+    // Exact integer sum of the last 1024 samples
+    uint32_t expected = 0;
+    for (uint32_t i = 5000 - 1024; i < 5000; i++) {
+        expected += i & 0x0FFF;
+    }
+    TEST_ASSERT_EQUAL_UINT32(expected, ma.getSum());
+}
+
 int main() {
     UNITY_BEGIN();
     RUN_TEST(test_empty_average_returns_zero);
@@ -106,5 +208,14 @@ int main() {
     RUN_TEST(test_window_size_one);
     RUN_TEST(test_large_number_of_samples);
     RUN_TEST(test_negative_values);
+    RUN_TEST(test_zero_size_behaves_as_one);
+    RUN_TEST(test_long_run_has_no_drift);
+    RUN_TEST(test_static_empty_returns_zero);
+    RUN_TEST(test_static_matches_runtime_class);
+    RUN_TEST(test_static_integer_accumulation);
+    RUN_TEST(test_static_integer_rounds_to_nearest);
+    RUN_TEST(test_static_default_accumulator_types);
+    RUN_TEST(test_static_wraparound_and_clear);
+    RUN_TEST(test_static_large_window_of_adc_counts);
     return UNITY_END();
 }
@@ -6,33 +6,24 @@
 // Include source units under test (and their transitive deps)
 #include "utils/moving-average/moving-average.cpp"
 #include "utils/derivative-filter/derivative-filter.cpp"
+#include "utils/timer/timer-wheel.cpp"
+#include "utils/timer/timer-service.cpp"
 #include "utils/timer/periodic-timer.cpp"
 #include "utils/configuration/config.cpp"
 
-// Include sensor-task.h for SensorData definition before our stub
+// Include sensor-task.h for SensorData definition
 #include "tasks/sensor/sensor-task.h"
 
-// Provide the getLatestSensorData stub required by plant-state-machine.cpp
-namespace PlantMonitor {
-namespace Tasks {
-
-static SensorData s_mockSensorData = {25.0f, 50.0f, 50.0f, true};
-static bool s_mockSensorAvailable = true;
-
-bool getLatestSensorData(SensorData &out) {
-    if (!s_mockSensorAvailable) return false;
-    out = s_mockSensorData;
-    return true;
-}
-
-} // namespace Tasks
-} // namespace PlantMonitor
+// Sample fed to updatePlantState() by the FSM tests
+static PlantMonitor::Tasks::SensorData s_mockSensorData = {25.0f, 50.0f, 50.0f, true, 0.0f, 0.0f, 0};
 
+#include "tasks/plant/light-journal.cpp"
 #include "tasks/plant/plant-state-machine.cpp"
 
 using namespace PlantMonitor::Tasks;
 
 void setUp() {
+    PlantMonitor::Utils::TimerService::begin(); // Done by setup() on the device
     Preferences::resetAllMockStorage();
     mockMillisValue = 0;
 }
@@ -46,52 +37,52 @@ static PlantThresholds makeThresholds() {
 }
 
 void test_all_sensors_in_range() {
-    SensorData data = {22.0f, 50.0f, 50.0f, true};
+    SensorData data = {22.0f, 50.0f, 50.0f, true, 0.0f, 0.0f, 0};
     TEST_ASSERT_TRUE(areSensorsInRange(data, makeThresholds()));
 }
 
 void test_temperature_below_min() {
-    SensorData data = {10.0f, 50.0f, 50.0f, true};
+    SensorData data = {10.0f, 50.0f, 50.0f, true, 0.0f, 0.0f, 0};
     TEST_ASSERT_FALSE(areSensorsInRange(data, makeThresholds()));
 }
 
 void test_temperature_above_max() {
-    SensorData data = {35.0f, 50.0f, 50.0f, true};
+    SensorData data = {35.0f, 50.0f, 50.0f, true, 0.0f, 0.0f, 0};
     TEST_ASSERT_FALSE(areSensorsInRange(data, makeThresholds()));
 }
 
 void test_humidity_below_min() {
-    SensorData data = {22.0f, 10.0f, 50.0f, true};
+    SensorData data = {22.0f, 10.0f, 50.0f, true, 0.0f, 0.0f, 0};
     TEST_ASSERT_FALSE(areSensorsInRange(data, makeThresholds()));
 }
 
 void test_humidity_above_max() {
-    SensorData data = {22.0f, 95.0f, 50.0f, true};
+    SensorData data = {22.0f, 95.0f, 50.0f, true, 0.0f, 0.0f, 0};
     TEST_ASSERT_FALSE(areSensorsInRange(data, makeThresholds()));
 }
 
 void test_moisture_below_min() {
-    SensorData data = {22.0f, 50.0f, 5.0f, true};
+    SensorData data = {22.0f, 50.0f, 5.0f, true, 0.0f, 0.0f, 0};
     TEST_ASSERT_FALSE(areSensorsInRange(data, makeThresholds()));
 }
 
 void test_moisture_above_max() {
-    SensorData data = {22.0f, 50.0f, 95.0f, true};
+    SensorData data = {22.0f, 50.0f, 95.0f, true, 0.0f, 0.0f, 0};
     TEST_ASSERT_FALSE(areSensorsInRange(data, makeThresholds()));
 }
 
 void test_boundary_at_min() {
-    SensorData data = {15.0f, 30.0f, 20.0f, true};
+    SensorData data = {15.0f, 30.0f, 20.0f, true, 0.0f, 0.0f, 0};
     TEST_ASSERT_TRUE(areSensorsInRange(data, makeThresholds()));
 }
 
 void test_boundary_at_max() {
-    SensorData data = {30.0f, 80.0f, 80.0f, true};
+    SensorData data = {30.0f, 80.0f, 80.0f, true, 0.0f, 0.0f, 0};
     TEST_ASSERT_TRUE(areSensorsInRange(data, makeThresholds()));
 }
 
 void test_multiple_sensors_out_of_range() {
-    SensorData data = {5.0f, 5.0f, 5.0f, false};
+    SensorData data = {5.0f, 5.0f, 5.0f, false, 0.0f, 0.0f, 0};
     TEST_ASSERT_FALSE(areSensorsInRange(data, makeThresholds()));
 }
 
@@ -108,15 +99,93 @@ void test_load_thresholds_valid_config() {
     TEST_ASSERT_FLOAT_WITHIN(0.01f, 70.0f, t.humidityMax);
     TEST_ASSERT_FLOAT_WITHIN(0.01f, 25.0f, t.moistureMin);
     TEST_ASSERT_FLOAT_WITHIN(0.01f, 75.0f, t.moistureMax);
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, 6.0f, t.lightMin);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 6.0f * LIGHT_HOURS_TO_INTEGRAL, t.lightMin);
     TEST_ASSERT_FLOAT_WITHIN(0.01f, 24.0f, t.lightMax);
 }
 
-void test_load_thresholds_insufficient_params() {
+void test_load_thresholds_profile_fills_missing_params() {
+    AppConfig cfg;
+    cfg.params = {1.0f, 12.0f, 28.0f}; // Succulent with temperature overrides only
+    PlantThresholds t;
+    TEST_ASSERT_TRUE(loadThresholdsFromConfig(cfg, t));
+    const PlantThresholds &profile = PLANT_PROFILES[1].thresholds;
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 12.0f, t.tempMin);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 28.0f, t.tempMax);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, profile.humidityMin, t.humidityMin);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, profile.moistureMax, t.moistureMax);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, profile.lightMin, t.lightMin);
+}
+
+void test_load_thresholds_plant_type_only() {
+    AppConfig cfg;
+    cfg.params = {static_cast<float>(PlantTypeId::Fern)};
+    PlantThresholds t;
+    TEST_ASSERT_TRUE(loadThresholdsFromConfig(cfg, t));
+    const PlantThresholds &profile = findPlantProfile(static_cast<uint32_t>(PlantTypeId::Fern))->thresholds;
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, profile.tempMin, t.tempMin);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, profile.humidityMax, t.humidityMax);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, profile.lightMin, t.lightMin);
+}
+
+void test_load_thresholds_no_params_uses_generic() {
+    AppConfig cfg;
+    PlantThresholds t;
+    TEST_ASSERT_TRUE(loadThresholdsFromConfig(cfg, t));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 15.0f, t.tempMin);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 4.0f, t.lightMin);
+}
+
+void test_load_thresholds_nan_keeps_profile_value() {
+    AppConfig cfg;
+    cfg.params = {0.0f, NAN, 32.0f};
+    PlantThresholds t;
+    TEST_ASSERT_TRUE(loadThresholdsFromConfig(cfg, t));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 15.0f, t.tempMin);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 32.0f, t.tempMax);
+}
+
+void test_load_thresholds_sparse_device_id_keeps_profile() {
+    AppConfig cfg;
+    ConfigHandler::setParam(cfg, static_cast<size_t>(ParamIndex::PlantTypeId), static_cast<float>(PlantTypeId::Herb));
+    ConfigHandler::setParam(cfg, static_cast<size_t>(ParamIndex::DeviceId), 7.0f);
+    PlantThresholds t;
+    TEST_ASSERT_TRUE(loadThresholdsFromConfig(cfg, t));
+    const PlantThresholds &profile = findPlantProfile(static_cast<uint32_t>(PlantTypeId::Herb))->thresholds;
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, profile.tempMin, t.tempMin);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, profile.humidityMax, t.humidityMax);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, profile.moistureMin, t.moistureMin);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, profile.lightMin, t.lightMin);
+    TEST_ASSERT_EQUAL_INT(7, getDeviceIdFromConfig(cfg));
+}
+
+void test_load_thresholds_sparse_override() {
+    AppConfig cfg;
+    ConfigHandler::setParam(cfg, static_cast<size_t>(ParamIndex::MoistureMin), 0.0f); // Explicit 0 is kept
+    ConfigHandler::setParam(cfg, static_cast<size_t>(ParamIndex::LightHoursMin), 10.0f);
+    PlantThresholds t;
+    TEST_ASSERT_TRUE(loadThresholdsFromConfig(cfg, t)); // No plant type: Generic
+    const PlantThresholds &generic = findPlantProfile(static_cast<uint32_t>(PlantTypeId::Generic))->thresholds;
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, generic.tempMin, t.tempMin);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0f, t.moistureMin);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, generic.moistureMax, t.moistureMax);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 10.0f * LIGHT_HOURS_TO_INTEGRAL, t.lightMin);
+}
+
+void test_load_thresholds_unknown_plant_type_uses_generic() {
+    const PlantThresholds &generic = findPlantProfile(static_cast<uint32_t>(PlantTypeId::Generic))->thresholds;
     AppConfig cfg;
-    cfg.params = {0.0f, 15.0f, 30.0f}; // only 3 params, need 8
+    cfg.params = {static_cast<float>(PLANT_PROFILE_COUNT), 12.0f};
     PlantThresholds t;
-    TEST_ASSERT_FALSE(loadThresholdsFromConfig(cfg, t));
+    TEST_ASSERT_TRUE(loadThresholdsFromConfig(cfg, t));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 12.0f, t.tempMin); // Overrides still apply
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, generic.tempMax, t.tempMax);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, generic.moistureMin, t.moistureMin);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, generic.lightMin, t.lightMin);
+
+    cfg.params = {-1.0f};
+    TEST_ASSERT_TRUE(loadThresholdsFromConfig(cfg, t));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, generic.tempMin, t.tempMin);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, generic.humidityMax, t.humidityMax);
 }
 
 void test_load_thresholds_exactly_eight_params() {
@@ -125,7 +194,144 @@ void test_load_thresholds_exactly_eight_params() {
     PlantThresholds t;
     TEST_ASSERT_TRUE(loadThresholdsFromConfig(cfg, t));
     TEST_ASSERT_FLOAT_WITHIN(0.01f, 10.0f, t.tempMin);
-    TEST_ASSERT_FLOAT_WITHIN(0.01f, 12.0f, t.lightMin);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 12.0f * LIGHT_HOURS_TO_INTEGRAL, t.lightMin);
+}
+
+// ============ Daily light integral tests ============
+
+static void resetLightTracking() {
+    s_lightTracking = { 0.0f, -1, 0, 0, 0.0f, 0, 0, false };
+    s_thresholds = makeThresholds();
+}
+
+static SensorData lightSample(float level, uint32_t timestampMs) {
+    return {25.0f, 50.0f, 50.0f, level >= LIGHT_DETECTION_THRESHOLD_PERCENT, 0.0f, level, timestampMs};
+}
+
+void test_light_integral_trapezoid() {
+    resetLightTracking();
+    prv_update_light_tracking(lightSample(0.0f, 1000));
+    prv_update_light_tracking(lightSample(100.0f, 1000 + 60000));  // Ramp: 0.5 full-scale minutes
+    prv_update_light_tracking(lightSample(50.0f, 1000 + 120000)); // 0.75 full-scale minutes
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 1.25f / 60.0f, getDailyLightIntegral());
+    TEST_ASSERT_EQUAL_UINT8(100, s_lightTracking.peakPercent);
+}
+
+void test_light_integral_ignores_repeated_sample() {
+    resetLightTracking();
+    prv_update_light_tracking(lightSample(50.0f, 1000));
+    prv_update_light_tracking(lightSample(50.0f, 1000 + 60000));
+    float once = getDailyLightIntegral();
+    prv_update_light_tracking(lightSample(50.0f, 1000 + 60000)); // Deadline re-evaluation
+    TEST_ASSERT_FLOAT_WITHIN(0.00001f, once, getDailyLightIntegral());
+}
+
+void test_light_integral_skips_long_gap() {
+    resetLightTracking();
+    prv_update_light_tracking(lightSample(100.0f, 1000));
+    prv_update_light_tracking(lightSample(100.0f, 1000 + LIGHT_INTEGRAL_MAX_GAP_MS + 1));
+    TEST_ASSERT_FLOAT_WITHIN(0.00001f, 0.0f, getDailyLightIntegral());
+    prv_update_light_tracking(lightSample(100.0f, 1000 + LIGHT_INTEGRAL_MAX_GAP_MS + 1 + 3600000 / 60));
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 1.0f / 60.0f, getDailyLightIntegral());
+}
+
+void test_light_integral_resumes_from_checkpoint() {
+    resetLightTracking();
+    prv_update_light_tracking(lightSample(100.0f, 1000));
+    prv_update_light_tracking(lightSample(100.0f, 1000 + 600000)); // 10 full-scale minutes
+    s_lightJournal.saveProgress(prv_light_day_record());
+    int32_t today = s_lightTracking.currentDay;
+
+    // Reboot: tracking is rebuilt from NVS on the first sample
+    resetLightTracking();
+    prv_update_light_tracking(lightSample(100.0f, 5000));
+    TEST_ASSERT_EQUAL_INT32(today, s_lightTracking.currentDay);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 10.0f / 60.0f, getDailyLightIntegral());
+}
+
+// A config written before the light integral carries params[7] in light hours
+void test_legacy_light_hours_config_normal_day_is_lit() {
+    resetLightTracking();
+    AppConfig cfg;
+    cfg.params = {0.0f, 15.0f, 30.0f, 30.0f, 80.0f, 20.0f, 80.0f, 8.0f}; // "8 h of light per day"
+    TEST_ASSERT_TRUE(loadThresholdsFromConfig(cfg, s_thresholds));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 8.0f * LIGHT_HOURS_TO_INTEGRAL, s_thresholds.lightMin);
+
+    // A normally lit day: 10 h at 60 % of full scale (6 full-scale hours)
+    for (uint32_t minute = 0; minute <= 600; minute++) {
+        prv_update_light_tracking(lightSample(60.0f, 1000 + minute * 60000));
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 6.0f, getDailyLightIntegral());
+
+    // Midnight: the finished day must not count as dark
+    s_lightTracking.currentDay--;
+    s_lightTracking.daysWithoutEnoughLight = 0;
+    prv_update_light_tracking(lightSample(0.0f, 1000 + 601 * 60000));
+    TEST_ASSERT_EQUAL_UINT8(0, s_lightTracking.daysWithoutEnoughLight);
+    TEST_ASSERT_TRUE(prv_is_light_ok());
+}
+
+// ============ Health FSM tests ============
+
+// Configure the device, start the FSM and let it see one in-range sample
+static void startConfiguredFsm() {
+    AppConfig cfg;
+    cfg.ssid = "ssid";
+    cfg.password = "pass";
+    cfg.params = {0.0f, 15.0f, 30.0f, 30.0f, 80.0f, 20.0f, 80.0f, 8.0f, 1.0f};
+    ConfigHandler::save(cfg);
+    s_thresholdsLoaded = false;
+    s_lastAllOk = true;
+    s_lastConditionChangeTime = 0;
+    s_mockSensorData = {25.0f, 50.0f, 50.0f, true, 0.0f, 0.0f, 0};
+    initPlantStateMachine();
+    updatePlantState(s_mockSensorData);
+}
+
+void test_fsm_happy_to_angry_after_debounce() {
+    startConfiguredFsm();
+    s_mockSensorData.temperature = 40.0f;
+
+    mockMillisValue = 1000;
+    updatePlantState(s_mockSensorData);
+    TEST_ASSERT_TRUE(getCurrentPlantState() == PlantState::PLANT_HAPPY);
+
+    mockMillisValue = 1000 + STATE_DEBOUNCE_MS;
+    TEST_ASSERT_TRUE(updatePlantState(s_mockSensorData)); // Reports the change once
+    TEST_ASSERT_TRUE(getCurrentPlantState() == PlantState::PLANT_ANGRY);
+    TEST_ASSERT_TRUE(s_timerStarted);
+
+    mockMillisValue += 2000;
+    TEST_ASSERT_FALSE(updatePlantState(s_mockSensorData));
+}
+
+void test_fsm_angry_to_dying_on_timer() {
+    startConfiguredFsm();
+    s_mockSensorData.temperature = 40.0f;
+    mockMillisValue = 1000;
+    updatePlantState(s_mockSensorData);
+    mockMillisValue = 1000 + STATE_DEBOUNCE_MS;
+    updatePlantState(s_mockSensorData);
+
+    mockEspTimerMicros += DYING_TIMEOUT_MINUTES * 60ULL * 1000000ULL;
+    PlantMonitor::Utils::TimerService::poll();
+    updatePlantState(s_mockSensorData);
+    TEST_ASSERT_TRUE(getCurrentPlantState() == PlantState::PLANT_DYING);
+}
+
+void test_fsm_dying_recovers_to_happy() {
+    test_fsm_angry_to_dying_on_timer();
+    s_mockSensorData.temperature = 25.0f;
+
+    mockMillisValue += 1000;
+    updatePlantState(s_mockSensorData);
+    TEST_ASSERT_TRUE(getCurrentPlantState() == PlantState::PLANT_DYING);
+
+    mockMillisValue += STATE_DEBOUNCE_MS;
+    updatePlantState(s_mockSensorData);
+    TEST_ASSERT_TRUE(getCurrentPlantState() == PlantState::PLANT_HAPPY);
+    TEST_ASSERT_FALSE(s_timerStarted); // Leaving Unwell stops the dying timer
+    TEST_ASSERT_EQUAL_UINT32(3, s_machine.transitionCount());
 }
 
 // ============ plantStateToString tests ============
@@ -159,9 +365,27 @@ int main() {
 
     // loadThresholdsFromConfig
     RUN_TEST(test_load_thresholds_valid_config);
-    RUN_TEST(test_load_thresholds_insufficient_params);
+    RUN_TEST(test_load_thresholds_profile_fills_missing_params);
+    RUN_TEST(test_load_thresholds_plant_type_only);
+    RUN_TEST(test_load_thresholds_no_params_uses_generic);
+    RUN_TEST(test_load_thresholds_nan_keeps_profile_value);
+    RUN_TEST(test_load_thresholds_sparse_device_id_keeps_profile);
+    RUN_TEST(test_load_thresholds_sparse_override);
+    RUN_TEST(test_load_thresholds_unknown_plant_type_uses_generic);
     RUN_TEST(test_load_thresholds_exactly_eight_params);
 
+    // Daily light integral
+    RUN_TEST(test_light_integral_trapezoid);
+    RUN_TEST(test_light_integral_ignores_repeated_sample);
+    RUN_TEST(test_light_integral_skips_long_gap);
+    RUN_TEST(test_light_integral_resumes_from_checkpoint);
+    RUN_TEST(test_legacy_light_hours_config_normal_day_is_lit);
+
+    // Health FSM
+    RUN_TEST(test_fsm_happy_to_angry_after_debounce);
+    RUN_TEST(test_fsm_angry_to_dying_on_timer);
+    RUN_TEST(test_fsm_dying_recovers_to_happy);
+
     // plantStateToString
     RUN_TEST(test_state_to_string_happy);
     RUN_TEST(test_state_to_string_angry);
@@ -0,0 +1,465 @@
+#include <Arduino.h>
+#include <Preferences.h>
+#include <WiFi.h>
+#include <unity.h>
+#include <esp_timer.h>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+
+/*!
+ * \file test_plant_replay.cpp
+ * \brief Accelerated trace replay of the plant health state machine
+ *
+ * Sensor traces (synthetic generators or recorded CSV) are fed to
+ * updatePlantState() under a virtual clock that drives millis(), the
+ * TimerService (esp_timer_get_time()) and the wall clock (time()). Between
+ * two samples the harness re-evaluates the held sample every
+ * PLANT_EVAL_INTERVAL_MS, like the plant task's deadline. Weeks of simulated
+ * time run in seconds with production timeouts, and every transition is
+ * reported with its simulated timestamp.
+ *
+ * Set PLANT_REPLAY_TRACE to a CSV file (seconds,temperature,humidity,moisture,light)
+ * to replay a recorded trace as well.
+ */
+
+#include "utils/moving-average/moving-average.cpp"
+#include "utils/derivative-filter/derivative-filter.cpp"
+#include "utils/timer/timer-wheel.cpp"
+#include "utils/timer/timer-service.cpp"
+#include "utils/timer/periodic-timer.cpp"
+#include "utils/configuration/config.cpp"
+#include "tasks/sensor/sensor-task.h"
+#include "tasks/plant/light-journal.cpp"
+#include "tasks/plant/plant-state-machine.cpp"
+
+using namespace PlantMonitor::Tasks;
+
+#define REPLAY_DYING_TIMEOUT_MINUTES 720        //!< Production dying timeout
+#define REPLAY_EPOCH_START 1772323200LL         //!< 2026-03-01 00:00:00 UTC
+#define REPLAY_SAMPLE_PERIOD_MS (60ull * 1000)  //!< Synthetic sample period
+#define REPLAY_MS_PER_HOUR (3600ull * 1000)
+#define REPLAY_MS_PER_DAY (24ull * REPLAY_MS_PER_HOUR)
+
+// ============ Virtual clock ============
+
+static uint64_t s_virtualMs = 0; // Simulated time since the start of the replay
+
+/*!
+ * \brief Wall clock seen by the code under test (interposes the C library)
+ */
+extern "C" time_t time(time_t *out) noexcept {
+    time_t now = static_cast<time_t>(REPLAY_EPOCH_START + static_cast<int64_t>(s_virtualMs / 1000));
+    if (out) {
+        *out = now;
+    }
+    return now;
+}
+
+/*!
+ * \brief Move every clock forward and run the timers that expired
+ */
+static void prv_clock_advance_to(uint64_t ms) {
+    if (ms <= s_virtualMs) {
+        return;
+    }
+    mockEspTimerMicros += static_cast<int64_t>(ms - s_virtualMs) * 1000;
+    s_virtualMs = ms;
+    mockMillisValue = static_cast<uint32_t>(ms + 1); // millis() never reads 0 after boot
+    PlantMonitor::Utils::TimerService::poll();
+}
+
+// ============ Trace sources ============
+
+/*!
+ * \brief Source of timestamped sensor samples
+ */
+class ReplaySource {
+  public:
+    virtual ~ReplaySource() {}
+
+    /*!
+     * \brief Produce the next sample
+     * \param[out] atMs Simulated time of the sample
+     * \param[out] data Sample (lightTimestampMs is filled by the replay)
+     * \return false at the end of the trace
+     */
+    virtual bool next(uint64_t &atMs, SensorData &data) = 0;
+};
+
+/*!
+ * \struct SyntheticProfile
+ * \brief Parameters of a generated trace
+ */
+struct SyntheticProfile {
+    uint32_t days;           //!< Trace length
+    float lightPeak;         //!< Noon light level (%)
+    float moistureStart;     //!< Soil moisture at t = 0 (%)
+    float dryingPerHour;     //!< Moisture loss (% per hour)
+    float waterBelow;        //!< Watering threshold (%), 0 = never watered
+    uint32_t wateringHour;   //!< Single watering at this hour of the trace (0 = none)
+    float heatPeak;          //!< Afternoon temperature (°C)
+};
+
+/*!
+ * \brief Diurnal temperature / humidity / light and a drying pot
+ */
+class SyntheticSource : public ReplaySource {
+  public:
+    explicit SyntheticSource(const SyntheticProfile &profile)
+        : m_profile(profile), m_atMs(0), m_moisture(profile.moistureStart) {}
+
+    bool next(uint64_t &atMs, SensorData &data) override {
+        if (m_atMs >= m_profile.days * REPLAY_MS_PER_DAY) {
+            return false;
+        }
+        float hourOfDay = static_cast<float>(m_atMs % REPLAY_MS_PER_DAY) / REPLAY_MS_PER_HOUR;
+        float daylight = sinf((hourOfDay - 7.0f) * static_cast<float>(M_PI) / 12.0f); // 07:00-19:00
+        float diurnal = cosf((hourOfDay - 15.0f) * static_cast<float>(M_PI) / 12.0f); // Warmest at 15:00
+
+        m_moisture -= m_profile.dryingPerHour * (REPLAY_SAMPLE_PERIOD_MS / static_cast<float>(REPLAY_MS_PER_HOUR));
+        if (m_profile.waterBelow > 0.0f && m_moisture < m_profile.waterBelow) {
+            m_moisture = m_profile.moistureStart;
+        }
+        if (m_profile.wateringHour != 0 && m_atMs == m_profile.wateringHour * REPLAY_MS_PER_HOUR) {
+            m_moisture = m_profile.moistureStart;
+        }
+
+        data = {};
+        data.temperature = m_profile.heatPeak - 4.0f + 4.0f * diurnal;
+        data.humidity = 55.0f - 10.0f * diurnal;
+        data.moisture = m_moisture < 0.0f ? 0.0f : m_moisture;
+        data.lightLevel = daylight > 0.0f ? m_profile.lightPeak * daylight : 2.0f;
+        data.lightDetected = data.lightLevel >= LIGHT_DETECTION_THRESHOLD_PERCENT;
+
+        atMs = m_atMs;
+        m_atMs += REPLAY_SAMPLE_PERIOD_MS;
+        return true;
+    }
+
+  private:
+    SyntheticProfile m_profile;
+    uint64_t m_atMs;
+    float m_moisture;
+};
+
+/*!
+ * \brief Recorded trace: one "seconds,temperature,humidity,moisture,light" row per line
+ *
+ * Blank lines and lines starting with '#' are skipped.
+ */
+class CsvSource : public ReplaySource {
+  public:
+    explicit CsvSource(const std::string &text) : m_text(text), m_pos(0) {}
+
+    bool next(uint64_t &atMs, SensorData &data) override {
+        while (m_pos < m_text.size()) {
+            size_t end = m_text.find('\n', m_pos);
+            if (end == std::string::npos) {
+                end = m_text.size();
+            }
+            std::string line = m_text.substr(m_pos, end - m_pos);
+            m_pos = end + 1;
+
+            double seconds;
+            float t, h, m, l;
+            if (line.empty() || line[0] == '#' ||
+                sscanf(line.c_str(), "%lf,%f,%f,%f,%f", &seconds, &t, &h, &m, &l) != 5) {
+                continue;
+            }
+            data = {};
+            data.temperature = t;
+            data.humidity = h;
+            data.moisture = m;
+            data.lightLevel = l;
+            data.lightDetected = l >= LIGHT_DETECTION_THRESHOLD_PERCENT;
+            atMs = static_cast<uint64_t>(seconds * 1000.0);
+            return true;
+        }
+        return false;
+    }
+
+  private:
+    std::string m_text;
+    size_t m_pos;
+};
+
+// ============ Replay ============
+
+/*!
+ * \struct ReplayTransition
+ * \brief One reported state change
+ */
+struct ReplayTransition {
+    uint64_t atMs;
+    PlantFsmState from;
+    PlantFsmState to;
+    PlantFsmEvent event;
+};
+
+/*!
+ * \struct ReplayReport
+ * \brief Outcome of one replay
+ */
+struct ReplayReport {
+    std::vector<ReplayTransition> transitions;
+    uint32_t samples;        //!< Samples from the trace
+    uint32_t evaluations;    //!< updatePlantState() calls (samples + deadline re-evaluations)
+    double meanEvalNs;       //!< Mean cost of updatePlantState()
+    double maxEvalNs;        //!< Worst updatePlantState() call
+    double wallSeconds;      //!< Host time spent replaying
+    uint64_t simulatedMs;    //!< Simulated time covered
+};
+
+static ReplayReport *s_report = nullptr;
+
+static void prv_record_transition(const PlantMachine::Trace &entry) {
+    if (s_report) {
+        s_report->transitions.push_back({ s_virtualMs, entry.from, entry.to, entry.event });
+    }
+}
+
+/*!
+ * \brief Print a simulated timestamp as "d<day> hh:mm:ss"
+ */
+static void prv_format_time(uint64_t ms, char *buf, size_t size) {
+    uint64_t s = ms / 1000;
+    snprintf(buf, size, "d%llu %02llu:%02llu:%02llu",
+             static_cast<unsigned long long>(s / 86400),
+             static_cast<unsigned long long>(s / 3600 % 24),
+             static_cast<unsigned long long>(s / 60 % 60),
+             static_cast<unsigned long long>(s % 60));
+}
+
+static void prv_print_report(const char *name, const ReplayReport &report) {
+    printf("[REPLAY] %s: %.1f days, %u samples, %u evaluations, %.3f s\n",
+           name, report.simulatedMs / static_cast<double>(REPLAY_MS_PER_DAY),
+           report.samples, report.evaluations, report.wallSeconds);
+    for (const ReplayTransition &t : report.transitions) {
+        char at[32];
+        prv_format_time(t.atMs, at, sizeof(at));
+        printf("[REPLAY]   %s  %s -> %s (%s)\n", at,
+               PlantMachine::stateName(t.from),
+               PlantMachine::stateName(t.to),
+               PlantMachine::eventName(t.event));
+    }
+}
+
+/*!
+ * \brief Configure the device and start the plant FSM from a cold boot
+ */
+static void prv_boot(const std::vector<float> &params) {
+    Preferences::resetAllMockStorage();
+    AppConfig cfg;
+    cfg.ssid = "ssid";
+    cfg.password = "pass";
+    cfg.params = params;
+    ConfigHandler::save(cfg);
+
+    s_virtualMs = 0;
+    mockMillisValue = 1;
+
+    s_thresholdsLoaded = false;
+    s_lastAllOk = true;
+    s_lastConditionChangeTime = 0;
+    s_lightTracking = { 0.0f, -1, 0, 0, 0.0f, 0, 0, false };
+    initPlantStateMachine(REPLAY_DYING_TIMEOUT_MINUTES);
+    s_machine.setTraceHook(prv_record_transition);
+}
+
+static void prv_evaluate(const SensorData &data, ReplayReport &report) {
+    auto start = std::chrono::steady_clock::now();
+    updatePlantState(data);
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    report.meanEvalNs += ns;
+    if (ns > report.maxEvalNs) {
+        report.maxEvalNs = ns;
+    }
+    report.evaluations++;
+}
+
+/*!
+ * \brief Replay a trace through the plant FSM
+ * \param source Samples to replay (timestamps relative to the boot)
+ * \param params Configuration params (plant type and overrides)
+ */
+static ReplayReport prv_replay(ReplaySource &source, const std::vector<float> &params = { 0.0f }) {
+    ReplayReport report = {};
+    s_report = &report;
+    prv_boot(params);
+
+    auto wallStart = std::chrono::steady_clock::now();
+    uint64_t atMs;
+    SensorData sample;
+    SensorData held = {};
+    bool haveSample = false;
+    while (source.next(atMs, sample)) {
+        // Deadline re-evaluations of the held sample while no new one arrives
+        while (haveSample && s_virtualMs + PLANT_EVAL_INTERVAL_MS < atMs) {
+            prv_clock_advance_to(s_virtualMs + PLANT_EVAL_INTERVAL_MS);
+            prv_evaluate(held, report);
+        }
+        prv_clock_advance_to(atMs);
+        sample.lightTimestampMs = millis();
+        held = sample;
+        haveSample = true;
+        report.samples++;
+        prv_evaluate(held, report);
+    }
+    report.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    report.simulatedMs = s_virtualMs;
+    if (report.evaluations > 0) {
+        report.meanEvalNs /= report.evaluations;
+    }
+
+    s_report = nullptr;
+    return report;
+}
+
+/*!
+ * \brief Check one reported transition and its time (within one sample period)
+ */
+static void prv_assert_transition(const ReplayReport &report, size_t index,
+                                  PlantFsmState to, uint64_t expectedMs) {
+    TEST_ASSERT_TRUE(index < report.transitions.size());
+    const ReplayTransition &t = report.transitions[index];
+    TEST_ASSERT_EQUAL_STRING(PlantMachine::stateName(to), PlantMachine::stateName(t.to));
+    TEST_ASSERT_TRUE(t.atMs >= expectedMs);
+    TEST_ASSERT_TRUE(t.atMs <= expectedMs + REPLAY_SAMPLE_PERIOD_MS);
+}
+
+void setUp() {
+    PlantMonitor::Utils::TimerService::begin(); // Done by setup() on the device
+}
+void tearDown() {}
+
+// ============ Scenarios ============
+
+static const SyntheticProfile kHealthy = { 14, 80.0f, 60.0f, 0.5f, 30.0f, 0, 25.0f };
+
+void test_replay_healthy_two_weeks() {
+    SyntheticSource source(kHealthy);
+    ReplayReport report = prv_replay(source);
+    prv_print_report("healthy", report);
+
+    TEST_ASSERT_EQUAL(0, report.transitions.size());
+    TEST_ASSERT_TRUE(getCurrentPlantState() == PlantState::PLANT_HAPPY);
+    TEST_ASSERT_EQUAL(13, s_lightJournal.size()); // Every finished day was journaled
+    TEST_ASSERT_EQUAL_UINT8(0, s_lightTracking.daysWithoutEnoughLight);
+}
+
+void test_replay_drought_dies_after_production_timeout() {
+    // Dries 1 %/h from 60 %: below 20 % after 40 h, watered at 72 h
+    SyntheticProfile drought = kHealthy;
+    drought.days = 4;
+    drought.dryingPerHour = 1.0f;
+    drought.waterBelow = 0.0f;
+    drought.wateringHour = 72;
+    SyntheticSource source(drought);
+    ReplayReport report = prv_replay(source);
+    prv_print_report("drought", report);
+
+    uint64_t dryMs = 40 * REPLAY_MS_PER_HOUR;
+    TEST_ASSERT_EQUAL(3, report.transitions.size());
+    prv_assert_transition(report, 0, PlantFsmState::Angry, dryMs + STATE_DEBOUNCE_MS);
+    prv_assert_transition(report, 1, PlantFsmState::Dying,
+                          report.transitions[0].atMs + REPLAY_DYING_TIMEOUT_MINUTES * 60ull * 1000);
+    prv_assert_transition(report, 2, PlantFsmState::Happy, 72 * REPLAY_MS_PER_HOUR + STATE_DEBOUNCE_MS);
+}
+
+void test_replay_dark_days() {
+    // 10 % at noon is far below the 4 h full-scale minimum
+    SyntheticProfile dark = kHealthy;
+    dark.days = 3;
+    dark.lightPeak = 10.0f;
+    SyntheticSource source(dark);
+    ReplayReport report = prv_replay(source);
+    prv_print_report("dark", report);
+
+    // The first dark day is counted at midnight; the 12 h dying timer then
+    // expires before the second dark day ends
+    TEST_ASSERT_EQUAL(2, report.transitions.size());
+    prv_assert_transition(report, 0, PlantFsmState::Angry, LIGHT_ANGRY_DAYS * REPLAY_MS_PER_DAY + STATE_DEBOUNCE_MS);
+    prv_assert_transition(report, 1, PlantFsmState::Dying,
+                          report.transitions[0].atMs + REPLAY_DYING_TIMEOUT_MINUTES * 60ull * 1000);
+    TEST_ASSERT_EQUAL_UINT8(2, s_lightTracking.daysWithoutEnoughLight);
+    TEST_ASSERT_TRUE(getCurrentPlantState() == PlantState::PLANT_DYING);
+}
+
+// Heat wave logged every 10 minutes, then the logger stopped for 3 h
+static const char kRecordedHeatWave[] =
+    "# seconds,temperature,humidity,moisture,light\n"
+    "0,24.0,55,50,60\n"
+    "600,27.5,52,50,65\n"
+    "1200,31.2,48,49,70\n"
+    "1800,33.0,45,49,72\n"
+    "2400,32.1,46,49,70\n"
+    "3000,29.0,50,48,66\n"
+    "3600,26.5,53,48,60\n"
+    "14400,25.0,55,47,40\n";
+
+void test_replay_recorded_trace() {
+    CsvSource source(kRecordedHeatWave);
+    ReplayReport report = prv_replay(source);
+    prv_print_report("recorded", report);
+
+    TEST_ASSERT_EQUAL(8, report.samples);
+    TEST_ASSERT_TRUE(report.evaluations > report.samples); // The 3 h gap was bridged by deadlines
+    TEST_ASSERT_EQUAL(2, report.transitions.size());
+    TEST_ASSERT_EQUAL_STRING("ANGRY", PlantMachine::stateName(report.transitions[0].to));
+    TEST_ASSERT_EQUAL_UINT64(1200 * 1000 + STATE_DEBOUNCE_MS, report.transitions[0].atMs);
+    TEST_ASSERT_EQUAL_STRING("HAPPY", PlantMachine::stateName(report.transitions[1].to));
+}
+
+void test_replay_trace_file() {
+    const char *path = getenv("PLANT_REPLAY_TRACE");
+    if (!path) {
+        TEST_IGNORE_MESSAGE("PLANT_REPLAY_TRACE not set");
+        return;
+    }
+    FILE *file = fopen(path, "r");
+    TEST_ASSERT_NOT_NULL(file);
+    std::string text;
+    char buf[512];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), file)) > 0) {
+        text.append(buf, n);
+    }
+    fclose(file);
+
+    CsvSource source(text);
+    ReplayReport report = prv_replay(source);
+    prv_print_report(path, report);
+    TEST_ASSERT_TRUE(report.samples > 0);
+}
+
+void test_replay_evaluation_cost() {
+    SyntheticProfile month = kHealthy;
+    month.days = 28;
+    SyntheticSource source(month);
+    ReplayReport report = prv_replay(source);
+
+    char msg[160];
+    snprintf(msg, sizeof(msg), "updatePlantState: mean %.0f ns, max %.0f ns per sample; %.0f simulated days/s",
+             report.meanEvalNs, report.maxEvalNs,
+             (report.simulatedMs / static_cast<double>(REPLAY_MS_PER_DAY)) / report.wallSeconds);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_EQUAL(28 * 24 * 60, report.samples);
+}
+
+int main() {
+    setenv("TZ", "UTC0", 1); // Day rollovers at virtual midnight
+    tzset();
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_replay_healthy_two_weeks);
+    RUN_TEST(test_replay_drought_dies_after_production_timeout);
+    RUN_TEST(test_replay_dark_days);
+    RUN_TEST(test_replay_recorded_trace);
+    RUN_TEST(test_replay_trace_file);
+    RUN_TEST(test_replay_evaluation_cost);
+
+    return UNITY_END();
+}
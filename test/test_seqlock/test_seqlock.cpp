@@ -0,0 +1,153 @@
+#include <unity.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "utils/seqlock/seqlock.h"
+
+using PlantMonitor::Utils::SeqLock;
+
+// Mirrors the layout of Tasks::SensorData
+struct Sample {
+    float temperature;
+    float humidity;
+    float moisture;
+    bool lightDetected;
+};
+
+// Every field is derived from the same counter, so a torn copy is detectable
+static Sample makeSample(uint32_t n) {
+    return { static_cast<float>(n), static_cast<float>(n) * 2.0f, static_cast<float>(n % 101), (n & 1u) != 0 };
+}
+
+static bool isConsistent(const Sample &s) {
+    uint32_t n = static_cast<uint32_t>(s.temperature);
+    return s.humidity == static_cast<float>(n) * 2.0f &&
+           s.moisture == static_cast<float>(n % 101) &&
+           s.lightDetected == ((n & 1u) != 0);
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_initial_sequence_is_zero() {
+    SeqLock<Sample> lock;
+    TEST_ASSERT_EQUAL_UINT32(0, lock.sequence());
+
+    Sample out;
+    uint32_t seq = 99;
+    TEST_ASSERT_TRUE(lock.tryRead(out, seq));
+    TEST_ASSERT_EQUAL_UINT32(0, seq);
+}
+
+void test_write_then_read() {
+    SeqLock<Sample> lock;
+    lock.write(makeSample(7));
+
+    Sample out;
+    uint32_t seq = lock.read(out);
+    TEST_ASSERT_EQUAL_UINT32(1, seq);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 7.0f, out.temperature);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 14.0f, out.humidity);
+    TEST_ASSERT_TRUE(out.lightDetected);
+}
+
+void test_sequence_counts_writes() {
+    SeqLock<Sample> lock;
+    for (uint32_t i = 1; i <= 5; i++) {
+        lock.write(makeSample(i));
+        TEST_ASSERT_EQUAL_UINT32(i, lock.sequence());
+    }
+}
+
+void test_latest_write_wins() {
+    SeqLock<Sample> lock;
+    lock.write(makeSample(1));
+    lock.write(makeSample(2));
+    lock.write(makeSample(3));
+
+    Sample out;
+    lock.read(out);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 3.0f, out.temperature);
+}
+
+void test_odd_sized_payload() {
+    struct Odd {
+        uint8_t bytes[7];
+    };
+    SeqLock<Odd> lock;
+    Odd in = { { 1, 2, 3, 4, 5, 6, 7 } };
+    lock.write(in);
+
+    Odd out = {};
+    lock.read(out);
+    TEST_ASSERT_EQUAL_MEMORY(in.bytes, out.bytes, sizeof(in.bytes));
+}
+
+void test_stress_no_torn_reads() {
+    constexpr uint32_t kWrites = 200000;
+    constexpr int kReaders = 3;
+
+    SeqLock<Sample> lock;
+    std::atomic<bool> done(false);
+    std::atomic<uint32_t> torn(0);
+    std::atomic<uint32_t> regressions(0);
+    std::atomic<uint64_t> reads(0);
+    std::atomic<int> started(0);
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < kReaders; r++) {
+        readers.emplace_back([&]() {
+            uint32_t lastSeq = 0;
+            uint32_t lastValue = 0;
+            Sample out;
+            uint32_t seq;
+            started.fetch_add(1);
+            while (!done.load(std::memory_order_relaxed)) {
+                if (!lock.tryRead(out, seq)) {
+                    continue;
+                }
+                reads.fetch_add(1, std::memory_order_relaxed);
+                if (seq == 0) {
+                    continue;
+                }
+                if (!isConsistent(out) || static_cast<uint32_t>(out.temperature) != seq) {
+                    torn.fetch_add(1, std::memory_order_relaxed);
+                }
+                if (seq < lastSeq || static_cast<uint32_t>(out.temperature) < lastValue) {
+                    regressions.fetch_add(1, std::memory_order_relaxed);
+                }
+                lastSeq = seq;
+                lastValue = static_cast<uint32_t>(out.temperature);
+            }
+        });
+    }
+
+    while (started.load() < kReaders) {
+        std::this_thread::yield();
+    }
+
+    for (uint32_t n = 1; n <= kWrites; n++) {
+        lock.write(makeSample(n));
+    }
+    done.store(true);
+
+    for (auto &t : readers) {
+        t.join();
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(0, torn.load());
+    TEST_ASSERT_EQUAL_UINT32(0, regressions.load());
+    TEST_ASSERT_EQUAL_UINT32(kWrites, lock.sequence());
+    TEST_ASSERT_TRUE(reads.load() > 0);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_initial_sequence_is_zero);
+    RUN_TEST(test_write_then_read);
+    RUN_TEST(test_sequence_counts_writes);
+    RUN_TEST(test_latest_write_wins);
+    RUN_TEST(test_odd_sized_payload);
+    RUN_TEST(test_stress_no_torn_reads);
+    return UNITY_END();
+}
@@ -0,0 +1,126 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "utils/shadow-frame/shadow-frame.h"
+
+using PlantMonitor::Utils::FrameSpan;
+using PlantMonitor::Utils::ShadowFrame;
+
+using Shadow = ShadowFrame<128, 16, 16>;
+
+static uint8_t s_frame[128 * 16];
+
+void setUp() {
+    memset(s_frame, 0, sizeof(s_frame));
+}
+
+void tearDown() {}
+
+// Send every dirty span, as DisplayHAL::update() does; returns the data bytes
+static size_t flush(Shadow &shadow) {
+    size_t bytes = 0;
+    for (uint8_t page = 0; page < 16; ++page) {
+        FrameSpan spans[Shadow::kMaxSpans];
+        size_t n = shadow.dirtySpans(s_frame, page, spans);
+        for (size_t i = 0; i < n; ++i) {
+            bytes += spans[i].length;
+            shadow.commit(s_frame, spans[i]);
+        }
+    }
+    return bytes;
+}
+
+// ============ ShadowFrame tests ============
+
+void test_first_flush_sends_everything() {
+    Shadow shadow;
+    TEST_ASSERT_TRUE(shadow.differs(s_frame)); // Even an all-black frame
+    FrameSpan spans[Shadow::kMaxSpans];
+    TEST_ASSERT_EQUAL(1, shadow.dirtySpans(s_frame, 3, spans));
+    TEST_ASSERT_EQUAL_UINT8(3, spans[0].page);
+    TEST_ASSERT_EQUAL_UINT8(0, spans[0].column);
+    TEST_ASSERT_EQUAL_UINT8(128, spans[0].length);
+    TEST_ASSERT_EQUAL(128 * 16, flush(shadow));
+}
+
+void test_identical_frame_is_skipped() {
+    Shadow shadow;
+    s_frame[100] = 0x5A;
+    flush(shadow);
+    TEST_ASSERT_FALSE(shadow.differs(s_frame));
+    TEST_ASSERT_EQUAL(0, flush(shadow));
+}
+
+void test_single_pixel_sends_one_block() {
+    Shadow shadow;
+    flush(shadow);
+
+    s_frame[5 * 128 + 37] |= 0x01; // Page 5, column 37 -> block 32..47
+    TEST_ASSERT_TRUE(shadow.differs(s_frame));
+    FrameSpan spans[Shadow::kMaxSpans];
+    TEST_ASSERT_EQUAL(0, shadow.dirtySpans(s_frame, 4, spans));
+    TEST_ASSERT_EQUAL(1, shadow.dirtySpans(s_frame, 5, spans));
+    TEST_ASSERT_EQUAL_UINT8(32, spans[0].column);
+    TEST_ASSERT_EQUAL_UINT8(16, spans[0].length);
+    TEST_ASSERT_EQUAL(16, flush(shadow));
+    TEST_ASSERT_FALSE(shadow.differs(s_frame));
+}
+
+void test_adjacent_blocks_merge() {
+    Shadow shadow;
+    flush(shadow);
+
+    s_frame[0 * 128 + 15] = 1;  // Block 0
+    s_frame[0 * 128 + 16] = 1;  // Block 1
+    s_frame[0 * 128 + 127] = 1; // Block 7
+    FrameSpan spans[Shadow::kMaxSpans];
+    TEST_ASSERT_EQUAL(2, shadow.dirtySpans(s_frame, 0, spans));
+    TEST_ASSERT_EQUAL_UINT8(0, spans[0].column);
+    TEST_ASSERT_EQUAL_UINT8(32, spans[0].length);
+    TEST_ASSERT_EQUAL_UINT8(112, spans[1].column);
+    TEST_ASSERT_EQUAL_UINT8(16, spans[1].length);
+}
+
+void test_worst_case_span_count() {
+    Shadow shadow;
+    flush(shadow);
+
+    for (size_t block = 0; block < Shadow::kBlocks; block += 2) {
+        s_frame[2 * 128 + block * 16] = 0xFF;
+    }
+    FrameSpan spans[Shadow::kMaxSpans];
+    TEST_ASSERT_EQUAL(Shadow::kMaxSpans, shadow.dirtySpans(s_frame, 2, spans));
+}
+
+void test_uncommitted_span_is_resent() {
+    Shadow shadow;
+    flush(shadow);
+
+    s_frame[7 * 128 + 64] = 0x80;
+    FrameSpan spans[Shadow::kMaxSpans];
+    TEST_ASSERT_EQUAL(1, shadow.dirtySpans(s_frame, 7, spans));
+    // Transfer failed: nothing committed, the next flush sends it again
+    TEST_ASSERT_TRUE(shadow.differs(s_frame));
+    TEST_ASSERT_EQUAL(16, flush(shadow));
+}
+
+void test_invalidate_forces_full_flush() {
+    Shadow shadow;
+    flush(shadow);
+    shadow.invalidate();
+    TEST_ASSERT_TRUE(shadow.differs(s_frame));
+    TEST_ASSERT_EQUAL(128 * 16, flush(shadow));
+}
+
+int main() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_first_flush_sends_everything);
+    RUN_TEST(test_identical_frame_is_skipped);
+    RUN_TEST(test_single_pixel_sends_one_block);
+    RUN_TEST(test_adjacent_blocks_merge);
+    RUN_TEST(test_worst_case_span_count);
+    RUN_TEST(test_uncommitted_span_is_resent);
+    RUN_TEST(test_invalidate_forces_full_flush);
+
+    return UNITY_END();
+}
@@ -0,0 +1,268 @@
+#include <unity.h>
+#include <string>
+#include "utils/state-machine/state-machine.h"
+
+using namespace PlantMonitor::Utils;
+
+// Off and Powered are top-level; Powered holds Idle and Running
+enum class Motor : uint8_t { Off, Powered, Idle, Running };
+enum class MotorEvent : uint8_t { PowerOn, PowerOff, Start, Stop, Poke };
+
+struct MotorContext {
+    std::string log;  // Entry/exit/action trail
+    bool armed;       // Guard of Start
+    int pokes;        // Internal transition counter
+};
+
+static void onEnterPowered(MotorContext &c) { c.log += "+P"; }
+static void onExitPowered(MotorContext &c) { c.log += "-P"; }
+static void onEnterIdle(MotorContext &c) { c.log += "+I"; }
+static void onExitIdle(MotorContext &c) { c.log += "-I"; }
+static void onEnterRunning(MotorContext &c) { c.log += "+R"; }
+static void onExitRunning(MotorContext &c) { c.log += "-R"; }
+static void onEnterOff(MotorContext &c) { c.log += "+O"; }
+static void onExitOff(MotorContext &c) { c.log += "-O"; }
+static bool isArmed(MotorContext &c) { return c.armed; }
+static void markAction(MotorContext &c) { c.log += "!"; }
+static void countPoke(MotorContext &c) { c.pokes++; }
+
+struct MotorFsm {
+    using State = Motor;
+    using Event = MotorEvent;
+    using Context = MotorContext;
+    static constexpr size_t kStateCount = 4;
+    static constexpr size_t kEventCount = 5;
+    static constexpr HsmState<State, Context> states[kStateCount] = {
+        {Motor::Off, Motor::Off, "OFF", &onEnterOff, &onExitOff},
+        {Motor::Powered, Motor::Powered, "POWERED", &onEnterPowered, &onExitPowered},
+        {Motor::Idle, Motor::Powered, "IDLE", &onEnterIdle, &onExitIdle},
+        {Motor::Running, Motor::Powered, "RUNNING", &onEnterRunning, &onExitRunning},
+    };
+    static constexpr const char *events[kEventCount] = {"POWER_ON", "POWER_OFF", "START", "STOP", "POKE"};
+    static constexpr HsmTransition<State, Event, Context> transitions[] = {
+        {Motor::Off, MotorEvent::PowerOn, Motor::Idle, nullptr, &markAction},
+        {Motor::Idle, MotorEvent::Start, Motor::Running, &isArmed, nullptr},
+        {Motor::Running, MotorEvent::Stop, Motor::Idle, nullptr, nullptr},
+        {Motor::Running, MotorEvent::Poke, Motor::Running, nullptr, &countPoke},
+        {Motor::Powered, MotorEvent::PowerOff, Motor::Off, nullptr, &markAction},
+        {Motor::Powered, MotorEvent::Poke, Motor::Idle, nullptr, nullptr},
+    };
+};
+
+using MotorMachine = StateMachine<MotorFsm>;
+
+static MotorContext s_ctx;
+static int s_hookCalls = 0;
+static MotorMachine::Trace s_lastHook;
+
+static void traceHook(const MotorMachine::Trace &entry) {
+    s_hookCalls++;
+    s_lastHook = entry;
+}
+
+void setUp() {
+    s_ctx = MotorContext{ "", true, 0 };
+    s_hookCalls = 0;
+}
+
+void tearDown() {}
+
+void test_start_enters_from_top() {
+    MotorMachine m(s_ctx);
+    m.start(Motor::Idle, 100);
+
+    TEST_ASSERT_TRUE(m.state() == Motor::Idle);
+    TEST_ASSERT_EQUAL_STRING("+P+I", s_ctx.log.c_str());
+    TEST_ASSERT_TRUE(m.isIn(Motor::Powered));
+    TEST_ASSERT_FALSE(m.isIn(Motor::Off));
+    TEST_ASSERT_EQUAL_UINT32(0, m.transitionCount());
+}
+
+void test_dispatch_before_start_is_ignored() {
+    MotorMachine m(s_ctx);
+    TEST_ASSERT_FALSE(m.dispatch(MotorEvent::PowerOn, 0));
+    TEST_ASSERT_FALSE(m.isIn(Motor::Off));
+}
+
+void test_exit_action_entry_order() {
+    MotorMachine m(s_ctx);
+    m.start(Motor::Off, 0);
+    s_ctx.log.clear();
+
+    TEST_ASSERT_TRUE(m.dispatch(MotorEvent::PowerOn, 10));
+    TEST_ASSERT_EQUAL_STRING("-O!+P+I", s_ctx.log.c_str());
+    TEST_ASSERT_TRUE(m.state() == Motor::Idle);
+}
+
+void test_sibling_transition_keeps_parent() {
+    MotorMachine m(s_ctx);
+    m.start(Motor::Idle, 0);
+    s_ctx.log.clear();
+
+    TEST_ASSERT_TRUE(m.dispatch(MotorEvent::Start, 10));
+    TEST_ASSERT_EQUAL_STRING("-I+R", s_ctx.log.c_str());
+    TEST_ASSERT_EQUAL_UINT32(1, m.entryCount(Motor::Powered));
+}
+
+void test_event_bubbles_to_parent() {
+    MotorMachine m(s_ctx);
+    m.start(Motor::Running, 0);
+    s_ctx.log.clear();
+
+    // Running has no PowerOff row: Powered handles it and both are exited
+    TEST_ASSERT_TRUE(m.dispatch(MotorEvent::PowerOff, 10));
+    TEST_ASSERT_EQUAL_STRING("-R-P!+O", s_ctx.log.c_str());
+    TEST_ASSERT_TRUE(m.state() == Motor::Off);
+}
+
+void test_child_row_overrides_parent() {
+    MotorMachine m(s_ctx);
+    m.start(Motor::Running, 0);
+
+    // Running handles Poke internally; Idle inherits Powered's Poke -> Idle
+    TEST_ASSERT_TRUE(m.dispatch(MotorEvent::Poke, 10));
+    TEST_ASSERT_TRUE(m.state() == Motor::Running);
+    TEST_ASSERT_EQUAL_INT(1, s_ctx.pokes);
+
+    m.dispatch(MotorEvent::Stop, 20);
+    s_ctx.log.clear();
+    TEST_ASSERT_TRUE(m.dispatch(MotorEvent::Poke, 30));
+    TEST_ASSERT_TRUE(m.state() == Motor::Idle);
+    TEST_ASSERT_EQUAL_STRING("", s_ctx.log.c_str());
+}
+
+void test_internal_transition_is_not_traced() {
+    MotorMachine m(s_ctx);
+    m.start(Motor::Running, 0);
+    s_ctx.log.clear();
+
+    m.dispatch(MotorEvent::Poke, 10);
+    TEST_ASSERT_EQUAL_STRING("", s_ctx.log.c_str());
+    TEST_ASSERT_EQUAL_UINT32(0, m.transitionCount());
+    TEST_ASSERT_EQUAL_UINT32(1, m.entryCount(Motor::Running));
+}
+
+void test_guard_blocks_transition() {
+    MotorMachine m(s_ctx);
+    m.start(Motor::Idle, 0);
+    s_ctx.armed = false;
+
+    TEST_ASSERT_FALSE(m.dispatch(MotorEvent::Start, 10));
+    TEST_ASSERT_TRUE(m.state() == Motor::Idle);
+
+    s_ctx.armed = true;
+    TEST_ASSERT_TRUE(m.dispatch(MotorEvent::Start, 20));
+    TEST_ASSERT_TRUE(m.state() == Motor::Running);
+}
+
+void test_unhandled_event_returns_false() {
+    MotorMachine m(s_ctx);
+    m.start(Motor::Off, 0);
+    s_ctx.log.clear();
+
+    TEST_ASSERT_FALSE(m.dispatch(MotorEvent::Stop, 10));
+    TEST_ASSERT_FALSE(m.dispatch(MotorEvent::Poke, 10));
+    TEST_ASSERT_TRUE(m.state() == Motor::Off);
+    TEST_ASSERT_EQUAL_STRING("", s_ctx.log.c_str());
+}
+
+void test_time_in_state() {
+    MotorMachine m(s_ctx);
+    m.start(Motor::Idle, 1000);
+    m.dispatch(MotorEvent::Start, 1300);    // Idle 300
+    m.dispatch(MotorEvent::Stop, 1500);     // Running 200
+    m.dispatch(MotorEvent::PowerOff, 1600); // Idle 100, Powered 600
+
+    TEST_ASSERT_EQUAL_UINT32(400, m.timeInState(Motor::Idle, 2000));
+    TEST_ASSERT_EQUAL_UINT32(200, m.timeInState(Motor::Running, 2000));
+    TEST_ASSERT_EQUAL_UINT32(600, m.timeInState(Motor::Powered, 2000));
+    TEST_ASSERT_EQUAL_UINT32(400, m.timeInState(Motor::Off, 2000)); // Still active
+    TEST_ASSERT_EQUAL_UINT32(400, m.timeInCurrent(2000));
+    TEST_ASSERT_EQUAL_UINT32(2, m.entryCount(Motor::Idle));
+}
+
+void test_time_in_parent_spans_children() {
+    MotorMachine m(s_ctx);
+    m.start(Motor::Idle, 0);
+    m.dispatch(MotorEvent::Start, 50);
+
+    TEST_ASSERT_EQUAL_UINT32(80, m.timeInState(Motor::Powered, 80));
+    TEST_ASSERT_EQUAL_UINT32(30, m.timeInCurrent(80));
+}
+
+void test_time_survives_millis_wrap() {
+    MotorMachine m(s_ctx);
+    m.start(Motor::Idle, 0xFFFFFF00u);
+    TEST_ASSERT_EQUAL_UINT32(0x200, m.timeInCurrent(0x100));
+}
+
+void test_trace_records_transitions() {
+    MotorMachine m(s_ctx);
+    m.setTraceHook(traceHook);
+    m.start(Motor::Off, 0);
+    m.dispatch(MotorEvent::PowerOn, 5);
+    m.dispatch(MotorEvent::Start, 7);
+
+    TEST_ASSERT_EQUAL_UINT32(2, m.transitionCount());
+    TEST_ASSERT_EQUAL_UINT32(2, m.traceSize());
+    TEST_ASSERT_TRUE(m.traceAt(0).from == Motor::Off);
+    TEST_ASSERT_TRUE(m.traceAt(0).to == Motor::Idle);
+    TEST_ASSERT_TRUE(m.traceAt(0).event == MotorEvent::PowerOn);
+    TEST_ASSERT_EQUAL_UINT32(5, m.traceAt(0).timeMs);
+    TEST_ASSERT_TRUE(m.traceAt(1).to == Motor::Running);
+
+    TEST_ASSERT_EQUAL_INT(2, s_hookCalls);
+    TEST_ASSERT_TRUE(s_lastHook.from == Motor::Idle);
+    TEST_ASSERT_EQUAL_UINT32(7, s_lastHook.timeMs);
+}
+
+void test_trace_ring_keeps_latest() {
+    MotorMachine m(s_ctx);
+    m.start(Motor::Idle, 0);
+    for (uint32_t i = 0; i < HSM_TRACE_DEPTH + 3; i++) {
+        m.dispatch((i & 1u) ? MotorEvent::Stop : MotorEvent::Start, i);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(HSM_TRACE_DEPTH + 3, m.transitionCount());
+    TEST_ASSERT_EQUAL_UINT32(HSM_TRACE_DEPTH, m.traceSize());
+    TEST_ASSERT_EQUAL_UINT32(3, m.traceAt(0).timeMs);
+    TEST_ASSERT_EQUAL_UINT32(HSM_TRACE_DEPTH + 2, m.traceAt(HSM_TRACE_DEPTH - 1).timeMs);
+}
+
+void test_restart_clears_counters() {
+    MotorMachine m(s_ctx);
+    m.start(Motor::Idle, 0);
+    m.dispatch(MotorEvent::Start, 10);
+    m.start(Motor::Off, 20);
+
+    TEST_ASSERT_EQUAL_UINT32(0, m.transitionCount());
+    TEST_ASSERT_EQUAL_UINT32(0, m.entryCount(Motor::Running));
+    TEST_ASSERT_EQUAL_UINT32(0, m.timeInState(Motor::Idle, 30));
+    TEST_ASSERT_TRUE(m.state() == Motor::Off);
+}
+
+void test_names() {
+    TEST_ASSERT_EQUAL_STRING("RUNNING", MotorMachine::stateName(Motor::Running));
+    TEST_ASSERT_EQUAL_STRING("POWER_OFF", MotorMachine::eventName(MotorEvent::PowerOff));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_start_enters_from_top);
+    RUN_TEST(test_dispatch_before_start_is_ignored);
+    RUN_TEST(test_exit_action_entry_order);
+    RUN_TEST(test_sibling_transition_keeps_parent);
+    RUN_TEST(test_event_bubbles_to_parent);
+    RUN_TEST(test_child_row_overrides_parent);
+    RUN_TEST(test_internal_transition_is_not_traced);
+    RUN_TEST(test_guard_blocks_transition);
+    RUN_TEST(test_unhandled_event_returns_false);
+    RUN_TEST(test_time_in_state);
+    RUN_TEST(test_time_in_parent_spans_children);
+    RUN_TEST(test_time_survives_millis_wrap);
+    RUN_TEST(test_trace_records_transitions);
+    RUN_TEST(test_trace_ring_keeps_latest);
+    RUN_TEST(test_restart_clears_counters);
+    RUN_TEST(test_names);
+    return UNITY_END();
+}
@@ -0,0 +1,165 @@
+#include <unity.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "utils/streaming-stats/streaming-stats.h"
+#include "utils/streaming-stats/streaming-stats.cpp"
+
+using PlantMonitor::Utils::P2Quantile;
+using PlantMonitor::Utils::StatsSummary;
+using PlantMonitor::Utils::StreamingStats;
+
+void setUp() {}
+void tearDown() {}
+
+/*! \brief Deterministic uniform samples in [0, 1) */
+static float prv_uniform() {
+    static uint32_t lcg = 2024;
+    lcg = lcg * 1664525u + 1013904223u;
+    return (lcg >> 8) / 16777216.0f;
+}
+
+static float prv_exact_quantile(std::vector<float> v, float p) {
+    std::sort(v.begin(), v.end());
+    float pos = p * (v.size() - 1);
+    size_t lo = static_cast<size_t>(pos);
+    if (lo + 1 >= v.size()) {
+        return v[lo];
+    }
+    return v[lo] + (pos - lo) * (v[lo + 1] - v[lo]);
+}
+
+void test_empty_summary_is_nan() {
+    StreamingStats stats;
+    StatsSummary s = stats.summary();
+    TEST_ASSERT_EQUAL(0, s.count);
+    TEST_ASSERT_TRUE(std::isnan(s.mean));
+    TEST_ASSERT_TRUE(std::isnan(s.min));
+    TEST_ASSERT_TRUE(std::isnan(s.p50));
+}
+
+void test_single_sample() {
+    StreamingStats stats;
+    stats.add(21.5f);
+    StatsSummary s = stats.summary();
+    TEST_ASSERT_EQUAL(1, s.count);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 21.5f, s.mean);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.0f, s.stddev);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 21.5f, s.min);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 21.5f, s.max);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 21.5f, s.p90);
+}
+
+void test_mean_variance_min_max() {
+    StreamingStats stats;
+    const float v[] = { 2.0f, 4.0f, 4.0f, 4.0f, 5.0f, 5.0f, 7.0f, 9.0f };
+    for (float x : v) {
+        stats.add(x);
+    }
+    StatsSummary s = stats.summary();
+    TEST_ASSERT_EQUAL(8, s.count);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 5.0f, s.mean);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 32.0f / 7.0f, stats.variance());
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 2.0f, s.min);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 9.0f, s.max);
+}
+
+void test_welford_is_stable_with_large_offset() {
+    // Naive sum-of-squares in float loses everything at this offset
+    StreamingStats stats;
+    for (int i = 0; i < 10000; i++) {
+        stats.add(1000.0f + ((i % 2) ? 0.5f : -0.5f));
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 1000.0f, stats.mean());
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.25f, stats.variance());
+}
+
+void test_nan_samples_are_ignored() {
+    StreamingStats stats;
+    stats.add(1.0f);
+    stats.add(NAN);
+    stats.add(3.0f);
+    TEST_ASSERT_EQUAL(2, stats.count());
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 2.0f, stats.mean());
+}
+
+void test_quantiles_exact_during_warmup() {
+    P2Quantile median(0.5f);
+    median.add(9.0f);
+    median.add(1.0f);
+    median.add(5.0f);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 5.0f, median.get());
+    median.add(7.0f);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 6.0f, median.get());
+}
+
+void test_p2_tracks_exact_quantiles() {
+    StreamingStats stats;
+    std::vector<float> all;
+    for (int i = 0; i < 5000; i++) {
+        float x = 20.0f + 10.0f * prv_uniform();
+        stats.add(x);
+        all.push_back(x);
+    }
+    StatsSummary s = stats.summary();
+    TEST_ASSERT_FLOAT_WITHIN(0.2f, prv_exact_quantile(all, 0.1f), s.p10);
+    TEST_ASSERT_FLOAT_WITHIN(0.2f, prv_exact_quantile(all, 0.5f), s.p50);
+    TEST_ASSERT_FLOAT_WITHIN(0.2f, prv_exact_quantile(all, 0.9f), s.p90);
+}
+
+void test_p2_skewed_distribution() {
+    // Mostly low values with rare high spikes: the median must ignore the spikes
+    P2Quantile median(0.5f);
+    P2Quantile p90(0.9f);
+    std::vector<float> all;
+    for (int i = 0; i < 2000; i++) {
+        float x = (i % 20 == 0) ? 500.0f : 10.0f + prv_uniform();
+        median.add(x);
+        p90.add(x);
+        all.push_back(x);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, prv_exact_quantile(all, 0.5f), median.get());
+    // 5 % spikes sit above the 90th percentile; P² interpolates across the gap
+    // so it is only approximate there, but must not be pulled up to the spikes
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, prv_exact_quantile(all, 0.9f), p90.get());
+}
+
+void test_quantiles_are_ordered() {
+    StreamingStats stats;
+    for (int i = 0; i < 300; i++) {
+        stats.add(prv_uniform() * prv_uniform());
+    }
+    StatsSummary s = stats.summary();
+    TEST_ASSERT_TRUE(s.min <= s.p10);
+    TEST_ASSERT_TRUE(s.p10 <= s.p50);
+    TEST_ASSERT_TRUE(s.p50 <= s.p90);
+    TEST_ASSERT_TRUE(s.p90 <= s.max);
+}
+
+void test_reset_starts_a_new_interval() {
+    StreamingStats stats;
+    for (int i = 0; i < 50; i++) {
+        stats.add(100.0f + i);
+    }
+    stats.reset();
+    stats.add(1.0f);
+    StatsSummary s = stats.summary();
+    TEST_ASSERT_EQUAL(1, s.count);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 1.0f, s.max);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 1.0f, s.p50);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_empty_summary_is_nan);
+    RUN_TEST(test_single_sample);
+    RUN_TEST(test_mean_variance_min_max);
+    RUN_TEST(test_welford_is_stable_with_large_offset);
+    RUN_TEST(test_nan_samples_are_ignored);
+    RUN_TEST(test_quantiles_exact_during_warmup);
+    RUN_TEST(test_p2_tracks_exact_quantiles);
+    RUN_TEST(test_p2_skewed_distribution);
+    RUN_TEST(test_quantiles_are_ordered);
+    RUN_TEST(test_reset_starts_a_new_interval);
+    return UNITY_END();
+}
@@ -0,0 +1,100 @@
+#include <unity.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "utils/subscriber-table/subscriber-table.h"
+
+using PlantMonitor::Utils::SubscriberTable;
+
+struct Entry {
+    int id;
+    uint32_t bits;
+};
+
+void setUp() {}
+void tearDown() {}
+
+void test_starts_empty() {
+    SubscriberTable<Entry, 3> table;
+    int visited = 0;
+    table.forEach([&](const Entry &) { ++visited; });
+    TEST_ASSERT_EQUAL_INT(0, visited);
+    TEST_ASSERT_EQUAL_UINT32(0, table.size());
+    TEST_ASSERT_EQUAL_UINT32(3, table.capacity());
+}
+
+void test_add_until_full() {
+    SubscriberTable<Entry, 2> table;
+    TEST_ASSERT_TRUE(table.add({1, 0x1}));
+    TEST_ASSERT_TRUE(table.add({2, 0x2}));
+    TEST_ASSERT_FALSE(table.add({3, 0x4}));
+    TEST_ASSERT_EQUAL_UINT32(2, table.size());
+
+    uint32_t bits = 0;
+    table.forEach([&](const Entry &e) { bits |= e.bits; });
+    TEST_ASSERT_EQUAL_UINT32(0x3, bits);
+}
+
+void test_remove_matching_frees_slot() {
+    SubscriberTable<Entry, 2> table;
+    table.add({1, 0x1});
+    table.add({2, 0x2});
+
+    TEST_ASSERT_EQUAL_UINT32(1, table.remove([](const Entry &e) { return e.id == 1; }));
+    TEST_ASSERT_EQUAL_UINT32(1, table.size());
+    TEST_ASSERT_TRUE(table.add({3, 0x4}));
+
+    uint32_t bits = 0;
+    table.forEach([&](const Entry &e) { bits |= e.bits; });
+    TEST_ASSERT_EQUAL_UINT32(0x6, bits);
+}
+
+void test_remove_all_duplicates() {
+    SubscriberTable<Entry, 4> table;
+    table.add({7, 0x1});
+    table.add({8, 0x2});
+    table.add({7, 0x4});
+
+    TEST_ASSERT_EQUAL_UINT32(2, table.remove([](const Entry &e) { return e.id == 7; }));
+    TEST_ASSERT_EQUAL_UINT32(0, table.remove([](const Entry &e) { return e.id == 7; }));
+    TEST_ASSERT_EQUAL_UINT32(1, table.size());
+}
+
+void test_concurrent_add_claims_each_slot_once() {
+    constexpr int kThreads = 8;
+    SubscriberTable<Entry, 4> table;
+    std::atomic<int> added(0);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t]() {
+            if (table.add({t, 1u << t})) {
+                added.fetch_add(1);
+            }
+        });
+    }
+    for (std::thread &th : threads) {
+        th.join();
+    }
+
+    TEST_ASSERT_EQUAL_INT(4, added.load());
+    uint32_t bits = 0;
+    int visited = 0;
+    table.forEach([&](const Entry &e) {
+        TEST_ASSERT_EQUAL_UINT32(1u << e.id, e.bits);
+        bits |= e.bits;
+        ++visited;
+    });
+    TEST_ASSERT_EQUAL_INT(4, visited);
+    TEST_ASSERT_EQUAL_INT(4, __builtin_popcount(bits));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_starts_empty);
+    RUN_TEST(test_add_until_full);
+    RUN_TEST(test_remove_matching_frees_slot);
+    RUN_TEST(test_remove_all_duplicates);
+    RUN_TEST(test_concurrent_add_claims_each_slot_once);
+    return UNITY_END();
+}
@@ -0,0 +1,406 @@
+#include <Arduino.h>
+#include <unity.h>
+#include "utils/timer/timer-wheel.cpp"
+#include "utils/timer/timer-service.cpp"
+#include "utils/timer/periodic-timer.cpp"
+
+using namespace PlantMonitor::Utils;
+
+// Expiry record filled by prv_on_expire
+struct Expiry {
+    uint32_t count;
+    uint32_t lastTick;
+};
+
+static TimerWheel *s_wheel = nullptr;
+
+static void prv_on_expire(void *context, uint32_t) {
+    Expiry *e = static_cast<Expiry *>(context);
+    e->count++;
+    e->lastTick = s_wheel ? s_wheel->now() : 0;
+}
+
+void setUp() {
+    s_wheel = nullptr;
+}
+
+void tearDown() {}
+
+void test_one_shot_fires_on_its_tick() {
+    TimerWheel wheel;
+    s_wheel = &wheel;
+    Expiry e = {};
+
+    TimerId id = wheel.schedule(10, 0, prv_on_expire, &e, 0);
+    TEST_ASSERT_NOT_EQUAL(TIMER_WHEEL_INVALID_ID, id);
+    TEST_ASSERT_TRUE(wheel.isActive(id));
+    TEST_ASSERT_EQUAL_UINT32(10, wheel.remaining(id));
+
+    TEST_ASSERT_EQUAL_UINT32(0, wheel.advance(9));
+    TEST_ASSERT_EQUAL_UINT32(0, e.count);
+    TEST_ASSERT_EQUAL_UINT32(1, wheel.remaining(id));
+
+    TEST_ASSERT_EQUAL_UINT32(1, wheel.advance(1));
+    TEST_ASSERT_EQUAL_UINT32(1, e.count);
+    TEST_ASSERT_EQUAL_UINT32(10, e.lastTick);
+    TEST_ASSERT_FALSE(wheel.isActive(id));
+    TEST_ASSERT_EQUAL_UINT32(0, wheel.activeCount());
+
+    wheel.advance(1000);
+    TEST_ASSERT_EQUAL_UINT32(1, e.count);
+}
+
+void test_periodic_does_not_drift() {
+    TimerWheel wheel;
+    s_wheel = &wheel;
+    Expiry e = {};
+
+    wheel.schedule(7, 100, prv_on_expire, &e, 0);
+    wheel.advance(7 + 100 * 999);
+    TEST_ASSERT_EQUAL_UINT32(1000, e.count);
+    TEST_ASSERT_EQUAL_UINT32(7 + 100 * 999, e.lastTick);
+}
+
+void test_every_level_fires_on_time() {
+    // Delays on both sides of each wheel boundary, up to the longest one
+    const uint32_t delays[] = { 1, 63, 64, 65, 127, 4095, 4096, 4097, 262143, 262144, 262145,
+                                1000000, 4320000, TimerWheel::maxDelay() };
+    const size_t n = sizeof(delays) / sizeof(delays[0]);
+    TEST_ASSERT_TRUE(n <= TIMER_WHEEL_MAX_TIMERS);
+
+    // Start mid-wheel so slot indices are not aligned to the boundaries
+    TimerWheel wheel;
+    s_wheel = &wheel;
+    wheel.advanceTo(12345);
+    Expiry e[n] = {};
+    for (size_t i = 0; i < n; i++) {
+        TEST_ASSERT_NOT_EQUAL(TIMER_WHEEL_INVALID_ID, wheel.schedule(delays[i], 0, prv_on_expire, &e[i], 0));
+    }
+
+    wheel.advance(TimerWheel::maxDelay());
+    for (size_t i = 0; i < n; i++) {
+        TEST_ASSERT_EQUAL_UINT32(1, e[i].count);
+        TEST_ASSERT_EQUAL_UINT32(12345 + delays[i], e[i].lastTick);
+    }
+}
+
+void test_cancel_and_stale_handles() {
+    TimerWheel wheel;
+    s_wheel = &wheel;
+    Expiry e = {};
+
+    TimerId id = wheel.schedule(5000, 0, prv_on_expire, &e, 0); // Level 2
+    TEST_ASSERT_TRUE(wheel.cancel(id));
+    TEST_ASSERT_FALSE(wheel.cancel(id));
+    TEST_ASSERT_FALSE(wheel.isActive(id));
+    TEST_ASSERT_EQUAL_UINT32(0, wheel.remaining(id));
+
+    // The freed slot is reused under a new handle; the old one stays dead
+    TimerId reused = wheel.schedule(5, 0, prv_on_expire, &e, 0);
+    TEST_ASSERT_NOT_EQUAL(id, reused);
+    TEST_ASSERT_FALSE(wheel.cancel(id));
+    TEST_ASSERT_TRUE(wheel.isActive(reused));
+
+    wheel.advance(6000);
+    TEST_ASSERT_EQUAL_UINT32(1, e.count);
+    TEST_ASSERT_FALSE(wheel.cancel(TIMER_WHEEL_INVALID_ID));
+}
+
+void test_pool_exhaustion() {
+    TimerWheel wheel;
+    Expiry e = {};
+    TimerId ids[TIMER_WHEEL_MAX_TIMERS];
+    for (size_t i = 0; i < TIMER_WHEEL_MAX_TIMERS; i++) {
+        ids[i] = wheel.schedule(100, 0, prv_on_expire, &e, 0);
+        TEST_ASSERT_NOT_EQUAL(TIMER_WHEEL_INVALID_ID, ids[i]);
+    }
+    TEST_ASSERT_EQUAL_UINT32(TIMER_WHEEL_INVALID_ID, wheel.schedule(100, 0, prv_on_expire, &e, 0));
+    TEST_ASSERT_EQUAL_UINT32(TIMER_WHEEL_INVALID_ID, TimerWheel().schedule(1, 0, nullptr, nullptr, 0));
+
+    wheel.cancel(ids[3]);
+    TEST_ASSERT_NOT_EQUAL(TIMER_WHEEL_INVALID_ID, wheel.schedule(100, 0, prv_on_expire, &e, 0));
+
+    wheel.clear();
+    TEST_ASSERT_EQUAL_UINT32(0, wheel.activeCount());
+    TEST_ASSERT_FALSE(wheel.isActive(ids[0]));
+}
+
+void test_zero_and_oversized_delays() {
+    TimerWheel wheel;
+    s_wheel = &wheel;
+    Expiry e = {};
+
+    TimerId id = wheel.schedule(0, 0, prv_on_expire, &e, 0);
+    TEST_ASSERT_EQUAL_UINT32(1, wheel.remaining(id));
+
+    id = wheel.schedule(0xFFFFFFFFu, 0, prv_on_expire, &e, 0);
+    TEST_ASSERT_EQUAL_UINT32(TimerWheel::maxDelay(), wheel.remaining(id));
+}
+
+static TimerId s_victim = TIMER_WHEEL_INVALID_ID;
+
+static void prv_cancel_victim(void *context, uint32_t) {
+    static_cast<TimerWheel *>(context)->cancel(s_victim);
+}
+
+void test_callback_may_cancel_a_timer_in_the_same_slot() {
+    TimerWheel wheel;
+    s_wheel = &wheel;
+    Expiry e = {};
+
+    // Inserted last, so the canceller sits at the head of the slot and runs first
+    s_victim = wheel.schedule(20, 0, prv_on_expire, &e, 0);
+    wheel.schedule(20, 0, prv_cancel_victim, &wheel, 0);
+
+    TEST_ASSERT_EQUAL_UINT32(1, wheel.advance(20));
+    TEST_ASSERT_EQUAL_UINT32(0, e.count);
+    TEST_ASSERT_EQUAL_UINT32(0, wheel.activeCount());
+}
+
+void test_tick_counter_wraparound() {
+    TimerWheel wheel;
+    s_wheel = &wheel;
+    Expiry e = {};
+
+    wheel.advance(0xFFFFFF00u); // Empty wheel: jumps straight there
+    wheel.schedule(5000, 0, prv_on_expire, &e, 0);
+    wheel.advance(4999);
+    TEST_ASSERT_EQUAL_UINT32(0, e.count);
+    wheel.advance(1);
+    TEST_ASSERT_EQUAL_UINT32(1, e.count);
+    TEST_ASSERT_EQUAL_UINT32(0xFFFFFF00u + 5000u, e.lastTick);
+
+    // Times before the wheel's clock are ignored
+    TEST_ASSERT_EQUAL_UINT32(0, wheel.advanceTo(e.lastTick - 10));
+    TEST_ASSERT_EQUAL_UINT32(e.lastTick, wheel.now());
+}
+
+void test_collect_defers_callbacks() {
+    TimerWheel wheel;
+    s_wheel = &wheel;
+    Expiry a = {};
+    Expiry b = {};
+    wheel.schedule(5, 0, prv_on_expire, &a, 1);
+    wheel.schedule(3, 3, prv_on_expire, &b, 2);
+
+    uint32_t ticks = 0;
+    TEST_ASSERT_TRUE(wheel.nextExpiry(ticks));
+    TEST_ASSERT_EQUAL_UINT32(3, ticks);
+
+    TimerWheel::Expiry out[2 * TIMER_WHEEL_MAX_TIMERS];
+    TEST_ASSERT_EQUAL_UINT32(3, wheel.collect(6, out, 2 * TIMER_WHEEL_MAX_TIMERS)); // b@3, a@5, b@6
+    TEST_ASSERT_EQUAL_UINT32(6, wheel.now());
+    TEST_ASSERT_EQUAL_UINT32(0, a.count + b.count); // Nothing invoked
+    TEST_ASSERT_EQUAL_UINT32(2, out[0].value);
+    TEST_ASSERT_EQUAL_UINT32(1, out[1].value);
+    TEST_ASSERT_EQUAL_PTR(&b, out[2].context);
+
+    TEST_ASSERT_TRUE(wheel.nextExpiry(ticks));
+    TEST_ASSERT_EQUAL_UINT32(3, ticks); // Periodic b re-armed for 9
+    wheel.clear();
+    TEST_ASSERT_FALSE(wheel.nextExpiry(ticks));
+    TEST_ASSERT_EQUAL_UINT32(0, wheel.collect(1000, out, 2 * TIMER_WHEEL_MAX_TIMERS));
+    TEST_ASSERT_EQUAL_UINT32(1000, wheel.now());
+}
+
+void test_collect_stops_before_overflowing() {
+    TimerWheel wheel;
+    Expiry e = {};
+    for (int i = 0; i < TIMER_WHEEL_MAX_TIMERS; i++) {
+        wheel.schedule(1, 1, prv_on_expire, &e, 0);
+    }
+
+    // Every tick fires the whole pool: two ticks fill the buffer
+    TimerWheel::Expiry out[2 * TIMER_WHEEL_MAX_TIMERS];
+    TEST_ASSERT_EQUAL_UINT32(2 * TIMER_WHEEL_MAX_TIMERS, wheel.collect(100, out, 2 * TIMER_WHEEL_MAX_TIMERS));
+    TEST_ASSERT_EQUAL_UINT32(2, wheel.now());
+    TEST_ASSERT_EQUAL_UINT32(0, wheel.collect(100, out, TIMER_WHEEL_MAX_TIMERS - 1)); // Too small to tick
+    TEST_ASSERT_EQUAL_UINT32(2, wheel.now());
+}
+
+void test_service_delivers_notification_bits() {
+    TaskHandle_t task = reinterpret_cast<TaskHandle_t>(0x1234);
+    mockNotifiedTask = nullptr;
+    mockNotifiedValue = 0;
+
+    TEST_ASSERT_TRUE(TimerService::begin());
+    TimerId id = TimerService::startNotify(task, 1u << 3, 95, 100); // 95 ms rounds up to 10 ticks
+    TEST_ASSERT_TRUE(TimerService::isActive(id));
+    TEST_ASSERT_EQUAL_UINT32(100, TimerService::remainingMs(id));
+
+    mockEspTimerMicros += 99000;
+    TEST_ASSERT_EQUAL_UINT32(0, TimerService::poll());
+    TEST_ASSERT_EQUAL_UINT32(0, mockNotifiedValue);
+
+    mockEspTimerMicros += 1000;
+    TEST_ASSERT_EQUAL_UINT32(1, TimerService::poll());
+    TEST_ASSERT_EQUAL_PTR(task, mockNotifiedTask);
+    TEST_ASSERT_EQUAL_UINT32(1u << 3, mockNotifiedValue);
+
+    // A late poll catches up on every missed period
+    mockEspTimerMicros += 350000;
+    TEST_ASSERT_EQUAL_UINT32(3, TimerService::poll());
+
+    TEST_ASSERT_TRUE(TimerService::cancel(id));
+    TEST_ASSERT_FALSE(TimerService::isActive(id));
+    TEST_ASSERT_EQUAL_UINT32(TIMER_WHEEL_INVALID_ID, TimerService::startNotify(nullptr, 1, 10));
+}
+
+void test_service_arms_one_shot_for_next_expiry() {
+    TaskHandle_t task = reinterpret_cast<TaskHandle_t>(0x1234);
+    mockEspTimerMicros = (mockEspTimerMicros / 10000 + 1) * 10000 + 4000; // 4 ms into a tick
+
+    TimerId slow = TimerService::startNotify(task, 1, 1000, 1000);
+    TEST_ASSERT_EQUAL_INT64(1000000 - 4000, mockEspTimerArmedUs);
+    TimerId fast = TimerService::startNotify(task, 2, 300);
+    TEST_ASSERT_EQUAL_INT64(300000 - 4000, mockEspTimerArmedUs);
+
+    // Firing the fast timer re-arms for the slow one instead of ticking
+    mockEspTimerMicros += 300000 - 4000;
+    TEST_ASSERT_EQUAL_UINT32(1, TimerService::poll());
+    TEST_ASSERT_FALSE(TimerService::isActive(fast));
+    TEST_ASSERT_EQUAL_INT64(700000, mockEspTimerArmedUs);
+
+    // Nothing armed: no wake-ups at all
+    TEST_ASSERT_TRUE(TimerService::cancel(slow));
+    TEST_ASSERT_EQUAL_INT64(-1, mockEspTimerArmedUs);
+}
+
+static TimerId s_restarted = TIMER_WHEEL_INVALID_ID;
+
+static void prv_restart_from_callback(void *context, uint32_t) {
+    // Would deadlock if poll() still held the service lock
+    TEST_ASSERT_EQUAL_INT(0, mockSemaphoresHeld);
+    s_restarted = TimerService::startCallback(prv_on_expire, context, 0, 50);
+}
+
+void test_service_callbacks_run_outside_the_lock() {
+    Expiry e = {};
+    mockSemaphoresHeld = 0;
+    TimerService::startCallback(prv_restart_from_callback, &e, 0, 100);
+
+    mockEspTimerMicros += 100000;
+    TEST_ASSERT_EQUAL_UINT32(1, TimerService::poll());
+    TEST_ASSERT_TRUE(TimerService::isActive(s_restarted));
+    TEST_ASSERT_EQUAL_INT(0, mockSemaphoresHeld);
+
+    mockEspTimerMicros += 50000;
+    TEST_ASSERT_EQUAL_UINT32(1, TimerService::poll());
+    TEST_ASSERT_EQUAL_UINT32(1, e.count);
+}
+
+void test_periodic_send_timer_runs_on_the_service() {
+    PeriodicSendTimer timer;
+    TEST_ASSERT_TRUE(timer.begin(1000, false));
+    TEST_ASSERT_FALSE(timer.isRunning());
+
+    TEST_ASSERT_TRUE(timer.start());
+    mockEspTimerMicros += 999000;
+    TimerService::poll();
+    TEST_ASSERT_FALSE(timer.take());
+
+    mockEspTimerMicros += 1000;
+    TimerService::poll();
+    TEST_ASSERT_TRUE(timer.peek());
+    TEST_ASSERT_TRUE(timer.take());
+    TEST_ASSERT_FALSE(timer.take());
+
+    mockEspTimerMicros += 3000000;
+    TimerService::poll();
+    TEST_ASSERT_EQUAL_UINT32(4, timer.fireCount());
+
+    timer.stop();
+    mockEspTimerMicros += 5000000;
+    TimerService::poll();
+    TEST_ASSERT_EQUAL_UINT32(4, timer.fireCount());
+    TEST_ASSERT_TRUE(timer.setPeriodMs(500));
+    TEST_ASSERT_EQUAL_UINT32(500, timer.periodMs());
+}
+
+static void prv_sleep_and_fire(TickType_t ticks) {
+    // Hook for xTaskNotifyWait: the task sleeps, the clock moves, due timers fire
+    TickType_t step = (ticks == portMAX_DELAY) ? pdMS_TO_TICKS(1000) : ticks;
+    mockEspTimerMicros += static_cast<int64_t>(step) * 1000;
+    TimerService::poll();
+}
+
+void test_wait_for_consumes_a_pending_fire() {
+    PeriodicSendTimer timer;
+    TEST_ASSERT_TRUE(timer.begin(200));
+    mockEspTimerMicros += 200000;
+    TimerService::poll();
+
+    TEST_ASSERT_TRUE(timer.waitFor(0));
+    TEST_ASSERT_FALSE(timer.peek());
+}
+
+void test_wait_for_times_out() {
+    PeriodicSendTimer timer;
+    TEST_ASSERT_TRUE(timer.begin(1000));
+
+    TickType_t before = mockTickCount;
+    TEST_ASSERT_FALSE(timer.waitFor(100));
+    TEST_ASSERT_TRUE(mockTickCount - before >= pdMS_TO_TICKS(100));
+    TEST_ASSERT_EQUAL_UINT32(0, timer.fireCount());
+}
+
+void test_wait_for_wakes_on_the_fire() {
+    PeriodicSendTimer timer;
+    TEST_ASSERT_TRUE(timer.begin(1000));
+    mockNotifiedTask = nullptr;
+    mockNotifiedValue = 0;
+    mockNotifyWaitHook = prv_sleep_and_fire;
+
+    TEST_ASSERT_TRUE(timer.waitFor(PERIODIC_TIMER_WAIT_FOREVER));
+    TEST_ASSERT_EQUAL_PTR(mockCurrentTask, mockNotifiedTask);
+    TEST_ASSERT_EQUAL_UINT32(0, mockNotifiedValue & PERIODIC_TIMER_NOTIFY_BIT); // Cleared on exit
+    TEST_ASSERT_EQUAL_UINT32(1, timer.fireCount());
+
+    // Once the wait is over, fires no longer notify the task
+    mockNotifyWaitHook = nullptr;
+    mockNotifiedTask = nullptr;
+    mockEspTimerMicros += 1000000;
+    TimerService::poll();
+    TEST_ASSERT_NULL(mockNotifiedTask);
+    TEST_ASSERT_TRUE(timer.take());
+}
+
+void test_fires_accumulate_while_unconsumed() {
+    PeriodicSendTimer timer;
+    TEST_ASSERT_TRUE(timer.begin(100));
+
+    // Every fire is counted even if nobody takes the flag in between
+    for (int i = 0; i < 50; i++) {
+        mockEspTimerMicros += 100000;
+        TimerService::poll();
+    }
+    TEST_ASSERT_EQUAL_UINT32(50, timer.fireCount());
+    TEST_ASSERT_TRUE(timer.take());
+    TEST_ASSERT_FALSE(timer.take());
+
+    timer.clear();
+    TEST_ASSERT_FALSE(timer.peek());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_one_shot_fires_on_its_tick);
+    RUN_TEST(test_periodic_does_not_drift);
+    RUN_TEST(test_every_level_fires_on_time);
+    RUN_TEST(test_cancel_and_stale_handles);
+    RUN_TEST(test_pool_exhaustion);
+    RUN_TEST(test_zero_and_oversized_delays);
+    RUN_TEST(test_callback_may_cancel_a_timer_in_the_same_slot);
+    RUN_TEST(test_tick_counter_wraparound);
+    RUN_TEST(test_collect_defers_callbacks);
+    RUN_TEST(test_collect_stops_before_overflowing);
+    RUN_TEST(test_service_delivers_notification_bits);
+    RUN_TEST(test_service_arms_one_shot_for_next_expiry);
+    RUN_TEST(test_service_callbacks_run_outside_the_lock);
+    RUN_TEST(test_periodic_send_timer_runs_on_the_service);
+    RUN_TEST(test_wait_for_consumes_a_pending_fire);
+    RUN_TEST(test_wait_for_times_out);
+    RUN_TEST(test_wait_for_wakes_on_the_fire);
+    RUN_TEST(test_fires_accumulate_while_unconsumed);
+    return UNITY_END();
+}